@@ -119,4 +119,19 @@ Engine::Engine(core::Engine *engine) : m_Engine(engine) {}
 ADIOS2_FOREACH_TYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+#define declare_template_instantiation(T)                                      \
+    template typename Variable<T>::Span Engine::Put(Variable<T>, const size_t, \
+                                                    const T &);                \
+    template typename Variable<T>::Span Engine::Put(Variable<T>);
+
+ADIOS2_FOREACH_PRIMITIVE_TYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+#define declare_template_instantiation(T)                                      \
+    template void Engine::GetInRange(Variable<T>, const T &, const T &,        \
+                                     std::vector<Dims> &, std::vector<T> &);
+
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_TYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 } // end namespace adios2
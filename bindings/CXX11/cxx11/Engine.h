@@ -150,6 +150,31 @@ public:
     void Put(const std::string &variableName, const T &datum,
              const Mode launch = Mode::Deferred);
 
+    /**
+     * Put version that reserves the block payload in the engine buffer, the
+     * application fills the returned span in place instead of passing its
+     * own memory. Block min and max are computed at EndStep.
+     * @param variable contains variable metadata information
+     * @param bufferID engine buffer holding the payload, 0 for engines with
+     * a single buffer
+     * @param value initial value of all span elements
+     * @return span valid until EndStep, the address returned by
+     * Span::data() might change after other Put calls
+     * @exception std::invalid_argument for invalid variable or if the engine
+     * doesn't support spans
+     */
+    template <class T>
+    typename Variable<T>::Span Put(Variable<T> variable, const size_t bufferID,
+                                   const T &value);
+
+    /**
+     * Put span version with bufferID = 0 and value = T()
+     * @param variable contains variable metadata information
+     * @return span valid until EndStep
+     */
+    template <class T>
+    typename Variable<T>::Span Put(Variable<T> variable);
+
     /** Perform all Put calls in Deferred mode up to this point */
     void PerformPuts();
 
@@ -355,6 +380,25 @@ public:
     std::vector<typename Variable<T>::Info>
     BlocksInfo(const Variable<T> variable, const size_t step) const;
 
+    /**
+     * Value range query: gets the elements of the variable selection, at its
+     * single selected step, with values in [min, max]. Only the blocks whose
+     * min and max can match are read, blocks written without min and max are
+     * always read.
+     * Valid in read mode only, for global arrays. Calls PerformGets: Gets
+     * deferred before this call are performed too.
+     * @param variable input selection and step selection
+     * @param min lowest value, inclusive
+     * @param max highest value, inclusive
+     * @param coordinates output global coordinates of each matching element
+     * @param values output value of each matching element, same order
+     * @exception std::invalid_argument for invalid variable, step selection
+     * or range
+     */
+    template <class T>
+    void GetInRange(Variable<T> variable, const T &min, const T &max,
+                    std::vector<Dims> &coordinates, std::vector<T> &values);
+
 private:
     Engine(core::Engine *engine);
     core::Engine *m_Engine = nullptr;
@@ -392,6 +436,22 @@ private:
 ADIOS2_FOREACH_TYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+#define declare_template_instantiation(T)                                      \
+    extern template typename Variable<T>::Span Engine::Put(                    \
+        Variable<T>, const size_t, const T &);                                 \
+    extern template typename Variable<T>::Span Engine::Put(Variable<T>);
+
+ADIOS2_FOREACH_PRIMITIVE_TYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+#define declare_template_instantiation(T)                                      \
+    extern template void Engine::GetInRange(Variable<T>, const T &,            \
+                                            const T &, std::vector<Dims> &,    \
+                                            std::vector<T> &);
+
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_TYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 } // end namespace adios2
 
 #endif /* ADIOS2_BINDINGS_CXX11_CXX11_ENGINE_H_ */
@@ -95,6 +95,27 @@ void Engine::Put(const std::string &variableName, const T &datum,
     m_Engine->Put(variableName, reinterpret_cast<const IOType &>(datum));
 }
 
+template <class T>
+typename Variable<T>::Span Engine::Put(Variable<T> variable,
+                                       const size_t bufferID, const T &value)
+{
+    using IOType = typename TypeInfo<T>::IOType;
+    adios2::helper::CheckForNullptr(m_Engine, "in call to Engine::Put");
+    adios2::helper::CheckForNullptr(variable.m_Variable,
+                                    "for variable in call to Engine::Put");
+    typename core::Variable<IOType>::Span &coreSpan =
+        m_Engine->Put(*variable.m_Variable, bufferID,
+                      reinterpret_cast<const IOType &>(value));
+    return typename Variable<T>::Span(
+        reinterpret_cast<typename Variable<T>::Span::CoreSpan *>(&coreSpan));
+}
+
+template <class T>
+typename Variable<T>::Span Engine::Put(Variable<T> variable)
+{
+    return Put(variable, 0, T());
+}
+
 template <class T>
 void Engine::Get(Variable<T> variable, T *data, const Mode launch)
 {
@@ -230,6 +251,20 @@ Engine::BlocksInfo(const Variable<T> variable, const size_t step) const
     return ToBlocksInfo<T>(blocksInfo);
 }
 
+template <class T>
+void Engine::GetInRange(Variable<T> variable, const T &min, const T &max,
+                        std::vector<Dims> &coordinates, std::vector<T> &values)
+{
+    using IOType = typename TypeInfo<T>::IOType;
+    adios2::helper::CheckForNullptr(m_Engine, "in call to Engine::GetInRange");
+    adios2::helper::CheckForNullptr(
+        variable.m_Variable, "for variable in call to Engine::GetInRange");
+    m_Engine->GetInRange(*variable.m_Variable,
+                         reinterpret_cast<const IOType &>(min),
+                         reinterpret_cast<const IOType &>(max), coordinates,
+                         reinterpret_cast<std::vector<IOType> &>(values));
+}
+
 } // end namespace adios2
 
 #endif /* ADIOS2_BINDINGS_CXX11_CXX11_ENGINE_TCC_ */
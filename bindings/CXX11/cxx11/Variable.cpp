@@ -224,4 +224,44 @@ namespace adios2
 ADIOS2_FOREACH_TYPE_1ARG(declare_type)
 #undef declare_type
 
+#define declare_type(T)                                                        \
+                                                                               \
+    template <>                                                                \
+    Variable<T>::Span::Span(CoreSpan *span) : m_Span(span)                     \
+    {                                                                          \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    size_t Variable<T>::Span::size() const noexcept                            \
+    {                                                                          \
+        return reinterpret_cast<core::Variable<IOType>::Span *>(m_Span)        \
+            ->Size();                                                          \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    T *Variable<T>::Span::data() const noexcept                                \
+    {                                                                          \
+        return reinterpret_cast<T *>(                                          \
+            reinterpret_cast<core::Variable<IOType>::Span *>(m_Span)->Data()); \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    T &Variable<T>::Span::at(const size_t position)                            \
+    {                                                                          \
+        return reinterpret_cast<T &>(                                          \
+            reinterpret_cast<core::Variable<IOType>::Span *>(m_Span)->At(      \
+                position));                                                    \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    T &Variable<T>::Span::operator[](const size_t position)                    \
+    {                                                                          \
+        return reinterpret_cast<T &>(                                          \
+            (*reinterpret_cast<core::Variable<IOType>::Span *>(                \
+                m_Span))[position]);                                           \
+    }
+
+ADIOS2_FOREACH_PRIMITIVE_TYPE_1ARG(declare_type)
+#undef declare_type
+
 } // end namespace adios2
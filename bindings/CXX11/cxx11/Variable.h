@@ -255,6 +255,38 @@ public:
         const CoreInfo *m_Info;
     };
 
+    /**
+     * Block payload reserved in the engine buffer by Engine::Put(variable,
+     * bufferID, value), filled in place by the application before EndStep
+     */
+    class Span
+    {
+    public:
+        Span() = delete;
+        ~Span() = default;
+
+        /** @return number of elements */
+        size_t size() const noexcept;
+
+        /** @return address in the engine buffer, might change after other
+         * Put calls */
+        T *data() const noexcept;
+
+        /** element access, throws std::invalid_argument if out of bounds */
+        T &at(const size_t position);
+
+        T &operator[](const size_t position);
+
+        // allow Engine to set m_Span
+        friend class Engine;
+
+    private:
+        class CoreSpan;
+        CoreSpan *m_Span = nullptr;
+
+        Span(CoreSpan *span);
+    };
+
     /**
      * Read mode only and random-access (no BeginStep/EndStep) with file engines
      * only. Allows inspection of variable info on a per relative step (returned
@@ -49,6 +49,26 @@ if(MGARD_FOUND)
   set(ADIOS2_HAVE_MGARD TRUE)
 endif()
 
+# LZ4
+if(ADIOS2_USE_LZ4 STREQUAL AUTO)
+  find_package(LZ4)
+elseif(ADIOS2_USE_LZ4)
+  find_package(LZ4 REQUIRED)
+endif()
+if(LZ4_FOUND)
+  set(ADIOS2_HAVE_LZ4 TRUE)
+endif()
+
+# Zstd
+if(ADIOS2_USE_Zstd STREQUAL AUTO)
+  find_package(Zstd)
+elseif(ADIOS2_USE_Zstd)
+  find_package(Zstd REQUIRED)
+endif()
+if(ZSTD_FOUND)
+  set(ADIOS2_HAVE_Zstd TRUE)
+endif()
+
 set(mpi_find_components C)
 
 # Fortran
@@ -192,6 +212,24 @@ else()
   set(ADIOS2_HAVE_SysVShMem OFF)
 endif()
 
+# Sst shared memory data plane
+if(ADIOS2_HAVE_SST AND ADIOS2_HAVE_SysVShMem)
+  set(ADIOS2_SST_HAVE_SHM TRUE)
+endif()
+
+# Linux native AIO
+if(ADIOS2_USE_AIO)
+  if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    include(CheckIncludeFile)
+    CHECK_INCLUDE_FILE(linux/aio_abi.h HAVE_linux_aio_abi_h)
+  endif()
+  if(HAVE_linux_aio_abi_h)
+    set(ADIOS2_HAVE_AIO TRUE)
+  elseif(NOT ADIOS2_USE_AIO STREQUAL AUTO)
+    message(FATAL_ERROR "AIO requires Linux with linux/aio_abi.h")
+  endif()
+endif()
+
 if(ADIOS2_USE_Endian_Reverse STREQUAL ON)
   set(ADIOS2_HAVE_Endian_Reverse TRUE)
 endif()
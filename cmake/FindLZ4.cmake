@@ -0,0 +1,59 @@
+#------------------------------------------------------------------------------#
+# Distributed under the OSI-approved Apache License, Version 2.0.  See
+# accompanying file Copyright.txt for details.
+#------------------------------------------------------------------------------#
+#
+# FindLZ4
+# -----------
+#
+# Try to find the LZ4 library
+#
+# This module defines the following variables:
+#
+#   LZ4_FOUND        - System has LZ4
+#   LZ4_INCLUDE_DIRS - The LZ4 include directory
+#   LZ4_LIBRARIES    - Link these to use LZ4
+#
+# and the following imported targets:
+#   LZ4::LZ4 - The LZ4 compression library target
+#
+# You can also set the following variable to help guide the search:
+#   LZ4_ROOT - The install prefix for LZ4 containing the
+#              include and lib folders
+#              Note: this can be set as a CMake variable or an
+#                    environment variable.  If specified as a CMake
+#                    variable, it will override any setting specified
+#                    as an environment variable.
+
+if(NOT LZ4_FOUND)
+  if((NOT LZ4_ROOT) AND (NOT (ENV{LZ4_ROOT} STREQUAL "")))
+    set(LZ4_ROOT "$ENV{LZ4_ROOT}")
+  endif()
+  if(LZ4_ROOT)
+    set(LZ4_INCLUDE_OPTS HINTS ${LZ4_ROOT}/include NO_DEFAULT_PATHS)
+    set(LZ4_LIBRARY_OPTS
+      HINTS ${LZ4_ROOT}/lib ${LZ4_ROOT}/lib64
+      NO_DEFAULT_PATHS
+    )
+  endif()
+
+  find_path(LZ4_INCLUDE_DIR lz4.h ${LZ4_INCLUDE_OPTS})
+  find_library(LZ4_LIBRARY NAMES lz4 ${LZ4_LIBRARY_OPTS})
+
+  include(FindPackageHandleStandardArgs)
+  find_package_handle_standard_args(LZ4
+    FOUND_VAR LZ4_FOUND
+    REQUIRED_VARS LZ4_LIBRARY LZ4_INCLUDE_DIR
+  )
+  if(LZ4_FOUND)
+    set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+    set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+    if(LZ4_FOUND AND NOT TARGET LZ4::LZ4)
+      add_library(LZ4::LZ4 UNKNOWN IMPORTED)
+      set_target_properties(LZ4::LZ4 PROPERTIES
+        IMPORTED_LOCATION             "${LZ4_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${LZ4_INCLUDE_DIR}"
+      )
+    endif()
+  endif()
+endif()
@@ -0,0 +1,59 @@
+#------------------------------------------------------------------------------#
+# Distributed under the OSI-approved Apache License, Version 2.0.  See
+# accompanying file Copyright.txt for details.
+#------------------------------------------------------------------------------#
+#
+# FindZstd
+# -----------
+#
+# Try to find the Zstd library
+#
+# This module defines the following variables:
+#
+#   ZSTD_FOUND        - System has Zstd
+#   ZSTD_INCLUDE_DIRS - The Zstd include directory
+#   ZSTD_LIBRARIES    - Link these to use Zstd
+#
+# and the following imported targets:
+#   Zstd::Zstd - The Zstd compression library target
+#
+# You can also set the following variable to help guide the search:
+#   ZSTD_ROOT - The install prefix for Zstd containing the
+#              include and lib folders
+#              Note: this can be set as a CMake variable or an
+#                    environment variable.  If specified as a CMake
+#                    variable, it will override any setting specified
+#                    as an environment variable.
+
+if(NOT ZSTD_FOUND)
+  if((NOT ZSTD_ROOT) AND (NOT (ENV{ZSTD_ROOT} STREQUAL "")))
+    set(ZSTD_ROOT "$ENV{ZSTD_ROOT}")
+  endif()
+  if(ZSTD_ROOT)
+    set(ZSTD_INCLUDE_OPTS HINTS ${ZSTD_ROOT}/include NO_DEFAULT_PATHS)
+    set(ZSTD_LIBRARY_OPTS
+      HINTS ${ZSTD_ROOT}/lib ${ZSTD_ROOT}/lib64
+      NO_DEFAULT_PATHS
+    )
+  endif()
+
+  find_path(ZSTD_INCLUDE_DIR zstd.h ${ZSTD_INCLUDE_OPTS})
+  find_library(ZSTD_LIBRARY NAMES zstd ${ZSTD_LIBRARY_OPTS})
+
+  include(FindPackageHandleStandardArgs)
+  find_package_handle_standard_args(Zstd
+    FOUND_VAR ZSTD_FOUND
+    REQUIRED_VARS ZSTD_LIBRARY ZSTD_INCLUDE_DIR
+  )
+  if(ZSTD_FOUND)
+    set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+    set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+    if(ZSTD_FOUND AND NOT TARGET Zstd::Zstd)
+      add_library(Zstd::Zstd UNKNOWN IMPORTED)
+      set_target_properties(Zstd::Zstd PROPERTIES
+        IMPORTED_LOCATION             "${ZSTD_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIR}"
+      )
+    endif()
+  endif()
+endif()
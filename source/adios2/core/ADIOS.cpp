@@ -36,6 +36,14 @@
 #include "adios2/operator/compress/CompressMGARD.h"
 #endif
 
+#ifdef ADIOS2_HAVE_LZ4
+#include "adios2/operator/compress/CompressLZ4.h"
+#endif
+
+#ifdef ADIOS2_HAVE_ZSTD
+#include "adios2/operator/compress/CompressZstd.h"
+#endif
+
 // callbacks
 #include "adios2/operator/callback/Signature1.h"
 #include "adios2/operator/callback/Signature2.h"
@@ -229,6 +237,32 @@ Operator &ADIOS::DefineOperator(const std::string name, const std::string type,
         throw std::invalid_argument(
             "ERROR: this version of ADIOS2 didn't compile with the "
             "MGARD library (minimum v0.0.0.1), in call to DefineOperator\n");
+#endif
+    }
+    else if (typeLowerCase == "lz4")
+    {
+#ifdef ADIOS2_HAVE_LZ4
+        auto itPair = m_Operators.emplace(
+            name,
+            std::make_shared<compress::CompressLZ4>(parameters, m_DebugMode));
+        operatorPtr = itPair.first->second;
+#else
+        throw std::invalid_argument(
+            "ERROR: this version of ADIOS2 didn't compile with the "
+            "LZ4 library, in call to DefineOperator\n");
+#endif
+    }
+    else if (typeLowerCase == "zstd")
+    {
+#ifdef ADIOS2_HAVE_ZSTD
+        auto itPair = m_Operators.emplace(
+            name,
+            std::make_shared<compress::CompressZstd>(parameters, m_DebugMode));
+        operatorPtr = itPair.first->second;
+#else
+        throw std::invalid_argument(
+            "ERROR: this version of ADIOS2 didn't compile with the "
+            "Zstd library, in call to DefineOperator\n");
 #endif
     }
     else
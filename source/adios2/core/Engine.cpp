@@ -78,6 +78,12 @@ void Engine::Close(const int transportIndex)
 
 void Engine::Flush(const int /*transportIndex*/) { ThrowUp("Flush"); }
 
+char *Engine::BufferData(const size_t /*payloadPosition*/,
+                         const size_t /*bufferID*/) noexcept
+{
+    return nullptr;
+}
+
 // PROTECTED
 void Engine::Init() {}
 void Engine::InitParameters() {}
@@ -93,6 +99,15 @@ void Engine::InitTransports() {}
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
+#define declare_type(T)                                                        \
+    void Engine::DoPut(Variable<T> &, typename Variable<T>::Span &,            \
+                       const size_t, const T &)                                \
+    {                                                                          \
+        ThrowUp("DoPut");                                                      \
+    }
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
 // DoGet*
 #define declare_type(T)                                                        \
     void Engine::DoGetSync(Variable<T> &, T *) { ThrowUp("DoGetSync"); }       \
@@ -190,5 +205,20 @@ void Engine::CheckOpenModes(const std::set<Mode> &modes,
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+#define declare_template_instantiation(T)                                      \
+    template void Engine::GetInRange(Variable<T> &, const T &, const T &,      \
+                                     std::vector<Dims> &, std::vector<T> &);
+
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+#define declare_template_instantiation(T)                                      \
+    template typename Variable<T>::Span &Engine::Put(Variable<T> &,            \
+                                                     const size_t, const T &); \
+    template typename Variable<T>::Span &Engine::Put(Variable<T> &);
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 } // end namespace core
 } // end namespace adios2
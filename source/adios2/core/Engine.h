@@ -183,6 +183,31 @@ public:
     template <class T>
     void Put(const std::string &variableName, const T &datum);
 
+    /**
+     * Put version that reserves the block payload in the engine buffer
+     * instead of copying it from application memory. The application fills
+     * the returned span in place before EndStep (or Close), which computes
+     * the block min and max.
+     * @param variable contains variable metadata information
+     * @param bufferID engine buffer holding the payload, 0 for engines with
+     * a single buffer
+     * @param value initial value of all span elements
+     * @return span valid until EndStep, the address returned by Span::Data
+     * might change after other Put calls
+     * @exception std::invalid_argument if not supported by the engine
+     */
+    template <class T>
+    typename Variable<T>::Span &Put(Variable<T> &variable,
+                                    const size_t bufferID, const T &value);
+
+    /**
+     * Put span version with bufferID = 0 and value = T()
+     * @param variable contains variable metadata information
+     * @return span valid until EndStep
+     */
+    template <class T>
+    typename Variable<T>::Span &Put(Variable<T> &variable);
+
     /**
      * @brief Get associates an existing variable selections and populates data
      * from adios2 Engine in Read Mode.
@@ -369,6 +394,17 @@ public:
      */
     virtual void Flush(const int transportIndex = -1);
 
+    /**
+     * This function is internal, for public interface use
+     * Variable<T>::Span::Data
+     * @param payloadPosition span payload position set by the engine
+     * @param bufferID span buffer
+     * @return current address of the payload, nullptr if the engine doesn't
+     * support spans
+     */
+    virtual char *BufferData(const size_t payloadPosition,
+                             const size_t bufferID = 0) noexcept;
+
     /**
      * Extracts all available blocks information for a particular
      * variable. This can be an expensive function, memory scales up with
@@ -408,6 +444,24 @@ public:
     std::vector<typename Variable<T>::Info>
     BlocksInfo(const Variable<T> &variable, const size_t step) const;
 
+    /**
+     * Value range query: gets the elements of the variable selection, at its
+     * single selected step, with values in [min, max]. Blocks are skipped
+     * from their Min/Max metadata, blocks written without min and max are
+     * always read. Only the part of the candidate blocks inside the
+     * selection is read. Valid in read mode only, for global arrays.
+     * Calls PerformGets: Gets deferred by the caller before this call are
+     * performed too.
+     * @param variable input selection and step selection, restored on exit
+     * @param min lowest value, inclusive
+     * @param max highest value, inclusive
+     * @param coordinates output global coordinates of each matching element
+     * @param values output value of each matching element, same order
+     */
+    template <class T>
+    void GetInRange(Variable<T> &variable, const T &min, const T &max,
+                    std::vector<Dims> &coordinates, std::vector<T> &values);
+
 protected:
     /** from ADIOS class passed to Engine created with Open
      *  if no new communicator is passed */
@@ -440,6 +494,13 @@ protected:
     ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
+#define declare_type(T)                                                        \
+    virtual void DoPut(Variable<T> &variable,                                  \
+                       typename Variable<T>::Span &span,                       \
+                       const size_t bufferID, const T &value);
+    ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
 // Get
 #define declare_type(T)                                                        \
     virtual void DoGetSync(Variable<T> &, T *);                                \
@@ -542,6 +603,22 @@ private:
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+#define declare_template_instantiation(T)                                      \
+    extern template void Engine::GetInRange(Variable<T> &, const T &,          \
+                                            const T &, std::vector<Dims> &,    \
+                                            std::vector<T> &);
+
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+#define declare_template_instantiation(T)                                      \
+    extern template typename Variable<T>::Span &Engine::Put(                   \
+        Variable<T> &, const size_t, const T &);                               \
+    extern template typename Variable<T>::Span &Engine::Put(Variable<T> &);
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 } // end namespace core
 } // end namespace adios2
 
@@ -13,6 +13,7 @@
 
 #include "Engine.h"
 
+#include <iterator> //std::next
 #include <stdexcept>
 
 #include "adios2/helper/adiosFunctions.h" // CheckforNullptr
@@ -70,6 +71,40 @@ void Engine::Put(const std::string &variableName, const T &datum)
     Put(FindVariable<T>(variableName, "in call to Put"), datum);
 }
 
+template <class T>
+typename Variable<T>::Span &Engine::Put(Variable<T> &variable,
+                                        const size_t bufferID, const T &value)
+{
+    if (m_DebugMode)
+    {
+        helper::CheckForNullptr(&variable,
+                                "for variable argument, in call to Put");
+        variable.CheckDimensions("in call to Put");
+        CheckOpenModes({{Mode::Write, Mode::Append}},
+                       " for variable " + variable.m_Name + ", in call to Put");
+    }
+
+    auto itSpan = variable.m_BlocksSpan.emplace(
+        variable.m_BlocksSpan.size(),
+        typename Variable<T>::Span(*this, variable.TotalSize()));
+    try
+    {
+        DoPut(variable, itSpan.first->second, bufferID, value);
+    }
+    catch (...)
+    {
+        variable.m_BlocksSpan.erase(itSpan.first);
+        throw;
+    }
+    return itSpan.first->second;
+}
+
+template <class T>
+typename Variable<T>::Span &Engine::Put(Variable<T> &variable)
+{
+    return Put(variable, 0, T());
+}
+
 // Get
 template <class T>
 void Engine::Get(Variable<T> &variable, T *data, const Mode launch)
@@ -194,6 +229,165 @@ Engine::BlocksInfo(const Variable<T> &variable, const size_t step) const
     return DoBlocksInfo(variable, step);
 }
 
+template <class T>
+void Engine::GetInRange(Variable<T> &variable, const T &min, const T &max,
+                        std::vector<Dims> &coordinates, std::vector<T> &values)
+{
+    const std::string hint("in call to GetInRange");
+
+    if (m_DebugMode)
+    {
+        helper::CheckForNullptr(&variable, "for variable argument, " + hint);
+        CheckOpenModes({{Mode::Read}},
+                       " for variable " + variable.m_Name + ", " + hint);
+
+        if (variable.m_ShapeID != ShapeID::GlobalArray)
+        {
+            throw std::invalid_argument(
+                "ERROR: variable " + variable.m_Name +
+                " is not a global array, " + hint + "\n");
+        }
+
+        if (variable.m_StepsCount != 1)
+        {
+            throw std::invalid_argument(
+                "ERROR: steps count " + std::to_string(variable.m_StepsCount) +
+                " from SetStepSelection of variable " + variable.m_Name +
+                " must be 1, a single step is queried, " + hint + "\n");
+        }
+
+        if (max < min)
+        {
+            throw std::invalid_argument("ERROR: min is larger than max for "
+                                        "variable " +
+                                        variable.m_Name + ", " + hint + "\n");
+        }
+    }
+
+    coordinates.clear();
+    values.clear();
+
+    size_t step = variable.m_StepsStart;
+    if (!variable.m_FirstStreamingStep)
+    {
+        step = CurrentStep();
+    }
+    else if (step < variable.m_AvailableStepBlockIndexOffsets.size())
+    {
+        // relative to the variable steps, available steps start at 1
+        step = std::next(variable.m_AvailableStepBlockIndexOffsets.begin(),
+                         step)
+                   ->first -
+               1;
+    }
+
+    const std::vector<typename Variable<T>::Info> blocksInfo =
+        BlocksInfo(variable, step);
+
+    // restores the caller's selection and memory selection on every exit,
+    // including exceptions from Get and PerformGets
+    struct SelectionGuard
+    {
+        Variable<T> &GuardedVariable;
+        Dims Start;
+        Dims Count;
+        Dims MemoryStart;
+        Dims MemoryCount;
+        SelectionType Selection;
+
+        ~SelectionGuard()
+        {
+            GuardedVariable.m_Start = std::move(Start);
+            GuardedVariable.m_Count = std::move(Count);
+            GuardedVariable.m_MemoryStart = std::move(MemoryStart);
+            GuardedVariable.m_MemoryCount = std::move(MemoryCount);
+            GuardedVariable.m_SelectionType = Selection;
+        }
+    };
+    SelectionGuard selectionGuard{variable, variable.m_Start, variable.m_Count,
+                                  variable.m_MemoryStart,
+                                  variable.m_MemoryCount,
+                                  variable.m_SelectionType};
+    variable.m_MemoryStart.clear();
+    variable.m_MemoryCount.clear();
+
+    const Box<Dims> selectionBox =
+        helper::StartEndBox(selectionGuard.Start, selectionGuard.Count);
+
+    // deferred Gets of the selected part of each candidate block
+    std::vector<Box<Dims>> readBoxes;
+    std::vector<std::vector<T>> readData;
+    readBoxes.reserve(blocksInfo.size());
+    readData.reserve(blocksInfo.size());
+
+    for (const typename Variable<T>::Info &blockInfo : blocksInfo)
+    {
+        if (blockInfo.IsValue || helper::GetTotalSize(blockInfo.Count) == 0)
+        {
+            continue;
+        }
+
+        // blocks without stored min and max are always candidates
+        if (blockInfo.HasMinMax &&
+            (blockInfo.Max < min || max < blockInfo.Min))
+        {
+            continue;
+        }
+
+        Box<Dims> intersectionBox = helper::IntersectionBox(
+            selectionBox,
+            helper::StartEndBox(blockInfo.Start, blockInfo.Count));
+        if (intersectionBox.first.empty())
+        {
+            continue;
+        }
+
+        const Box<Dims> readBox = helper::StartCountBox(
+            intersectionBox.first, intersectionBox.second);
+        variable.SetSelection(readBox);
+
+        readData.emplace_back(helper::GetTotalSize(readBox.second));
+        Get(variable, readData.back().data(), Mode::Deferred);
+        readBoxes.push_back(std::move(intersectionBox));
+    }
+
+    if (readData.empty())
+    {
+        return;
+    }
+    PerformGets();
+
+    const bool isRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
+
+    for (size_t b = 0; b < readData.size(); ++b)
+    {
+        const Box<Dims> &readBox = readBoxes[b];
+        const size_t dimensions = readBox.first.size();
+        Dims position = readBox.first;
+
+        for (const T &value : readData[b])
+        {
+            if (!(value < min) && !(max < value))
+            {
+                coordinates.push_back(position);
+                values.push_back(value);
+            }
+
+            // next element, the fastest dimension is last in row-major
+            for (size_t i = 0; i < dimensions; ++i)
+            {
+                const size_t d = isRowMajor ? dimensions - 1 - i : i;
+                if (position[d] < readBox.second[d])
+                {
+                    ++position[d];
+                    break;
+                }
+                position[d] = readBox.first[d];
+            }
+        }
+    }
+}
+
 // PROTECTED
 template <class T>
 Variable<T> &Engine::FindVariable(const std::string &variableName,
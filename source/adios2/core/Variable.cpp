@@ -95,6 +95,44 @@ namespace core
     Variable<T>::AllStepsBlocksInfo() const                                    \
     {                                                                          \
         return DoAllStepsBlocksInfo();                                         \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    Variable<T>::Span::Span(Engine &engine, const size_t size)                 \
+    : m_Engine(engine), m_Size(size)                                           \
+    {                                                                          \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    size_t Variable<T>::Span::Size() const noexcept                            \
+    {                                                                          \
+        return m_Size;                                                         \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    T *Variable<T>::Span::Data() const noexcept                                \
+    {                                                                          \
+        return reinterpret_cast<T *>(                                          \
+            m_Engine.BufferData(m_PayloadPosition, m_BufferID));               \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    T &Variable<T>::Span::operator[](const size_t position)                    \
+    {                                                                          \
+        return Data()[position];                                               \
+    }                                                                          \
+                                                                               \
+    template <>                                                                \
+    T &Variable<T>::Span::At(const size_t position)                            \
+    {                                                                          \
+        if (position >= m_Size)                                                \
+        {                                                                      \
+            throw std::invalid_argument(                                       \
+                "ERROR: position " + std::to_string(position) +               \
+                " is out of bounds for span of size " +                        \
+                std::to_string(m_Size) + ", in call to T& Span::At\n");        \
+        }                                                                      \
+        return (*this)[position];                                              \
     }
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
@@ -28,6 +28,8 @@ namespace adios2
 namespace core
 {
 
+class Engine; // friend
+
 /**
  * @param Base (parent) class for template derived (child) class Variable.
  */
@@ -75,11 +77,45 @@ public:
         std::vector<T> BufferV;
         SelectionType Selection = SelectionType::BoundingBox;
         bool IsValue = false;
+        /** false if Min and Max were not stored by the writer */
+        bool HasMinMax = false;
     };
 
     /** use for multiblock info */
     std::vector<Info> m_BlocksInfo;
 
+    /**
+     * Block payload reserved in the engine buffer by Engine::Put(variable,
+     * bufferID, value), filled in place by the application before EndStep
+     */
+    class Span
+    {
+    public:
+        /** payload start position in the engine buffer, set by the engine */
+        size_t m_PayloadPosition = 0;
+        /** engine buffer holding the payload */
+        size_t m_BufferID = 0;
+
+        Span(Engine &engine, const size_t size);
+        ~Span() = default;
+
+        size_t Size() const noexcept;
+
+        /** address in the engine buffer, might change after other Puts */
+        T *Data() const noexcept;
+
+        T &At(const size_t position);
+
+        T &operator[](const size_t position);
+
+    private:
+        Engine &m_Engine;
+        size_t m_Size = 0;
+    };
+
+    /** spans put in the current step, key: order of the Put calls */
+    std::map<size_t, Span> m_BlocksSpan;
+
     Variable<T>(const std::string &name, const Dims &shape, const Dims &start,
                 const Dims &count, const bool constantShape,
                 const bool debugMode);
@@ -90,7 +90,21 @@ void BP3Reader::ReadVariableBlocks(Variable<T> &variable)
 
                     m_SubFileManager.OpenFileID(
                         subFileName, subStreamBoxInfo.SubStreamID, Mode::Read,
-                        {{"transport", "File"}}, profile);
+                        m_IO.m_TransportsParameters[0], profile);
+                }
+
+                // memory mapped subfiles: clip directly from the mapped
+                // pages, no staging copy into the thread buffer
+                const char *mappedData = m_SubFileManager.GetFileMappedData(
+                    subStreamBoxInfo.SubStreamID);
+
+                if (mappedData != nullptr &&
+                    subStreamBoxInfo.OperationsInfo.empty())
+                {
+                    m_BP3Deserializer.ClipPayload(
+                        variable, blockInfo, subStreamBoxInfo,
+                        mappedData + subStreamBoxInfo.Seeks.first);
+                    continue;
                 }
 
                 char *buffer = nullptr;
@@ -11,6 +11,11 @@
 #include "BP4Reader.h"
 #include "BP4Reader.tcc"
 
+#include <algorithm> //std::sort
+#include <chrono>
+#include <future> //std::async
+#include <thread> //std::this_thread::sleep_for
+
 #include "adios2/helper/adiosFunctions.h" // MPI BroadcastVector
 
 namespace adios2
@@ -34,10 +39,12 @@ StepStatus BP4Reader::BeginStep(StepMode mode, const float timeoutSeconds)
 {
     if (m_DebugMode)
     {
-        if (mode != StepMode::NextAvailable)
+        if (mode != StepMode::NextAvailable &&
+            mode != StepMode::LatestAvailable)
         {
             throw std::invalid_argument("ERROR: mode is not supported yet, "
-                                        "only NextAvailable is valid for "
+                                        "only NextAvailable and "
+                                        "LatestAvailable are valid for "
                                         "engine BP4Reader, in call to "
                                         "BeginStep\n");
         }
@@ -51,13 +58,33 @@ StepStatus BP4Reader::BeginStep(StepMode mode, const float timeoutSeconds)
         }
     }
 
-    if (m_FirstStep)
+    const size_t nextStep = m_FirstStep ? 0 : m_CurrentStep + 1;
+
+    if (m_BP4Deserializer.m_StreamReader &&
+        (nextStep >= m_BP4Deserializer.m_MetadataSet.StepsCount ||
+         mode == StepMode::LatestAvailable))
     {
-        m_FirstStep = false;
+        // LatestAvailable with unread steps only checks for newer ones
+        const float timeout =
+            (nextStep < m_BP4Deserializer.m_MetadataSet.StepsCount)
+                ? 0.f
+                : timeoutSeconds;
+        UpdateStreamMetadata(nextStep, timeout);
     }
-    else
+
+    if (nextStep >= m_BP4Deserializer.m_MetadataSet.StepsCount &&
+        m_BP4Deserializer.m_StreamReader && m_WriterIsActive)
+    {
+        // timeout expired, the same step is requested in the next call
+        return StepStatus::NotReady;
+    }
+
+    m_FirstStep = false;
+    m_CurrentStep = nextStep;
+    if (mode == StepMode::LatestAvailable &&
+        m_CurrentStep < m_BP4Deserializer.m_MetadataSet.StepsCount)
     {
-        ++m_CurrentStep;
+        m_CurrentStep = m_BP4Deserializer.m_MetadataSet.StepsCount - 1;
     }
 
     // used to inquire for variables in streaming mode
@@ -94,8 +121,21 @@ StepStatus BP4Reader::BeginStep(StepMode mode, const float timeoutSeconds)
 #undef declare_type
     }
     */
+    if (m_BP4Deserializer.m_LazyMetadata)
+    {
+        m_BP4Deserializer.ParseVariablesIndexUpToStep(m_CurrentStep + 1);
+    }
+
     m_IO.ResetVariablesStepSelection(false, "in call to BP4 Reader BeginStep");
 
+    // skipped steps and steps added by a stream reader need the variables
+    // to point at the current step explicitly
+    if (m_BP4Deserializer.m_LazyMetadata || m_BP4Deserializer.m_StreamReader ||
+        mode == StepMode::LatestAvailable)
+    {
+        m_BP4Deserializer.SetVariablesStreamingStep(m_IO, m_CurrentStep + 1);
+    }
+
     return StepStatus::OK;
 }
 
@@ -149,10 +189,18 @@ void BP4Reader::Init()
         }
     }
 
+    InitParameters();
     InitTransports();
     InitBuffer();
 }
 
+void BP4Reader::InitParameters()
+{
+    m_BP4Deserializer.InitParameters(m_IO.m_Parameters);
+    m_BP4Deserializer.m_BlockCache.SetCapacity(
+        m_BP4Deserializer.m_BlockCacheSize);
+}
+
 void BP4Reader::InitTransports()
 {
     if (m_IO.m_TransportsParameters.empty())
@@ -183,6 +231,13 @@ void BP4Reader::InitTransports()
 
 void BP4Reader::InitBuffer()
 {
+    if (m_BP4Deserializer.m_StreamReader)
+    {
+        // steps completed so far, BeginStep waits for the rest
+        UpdateStreamMetadata(0, 0.f);
+        return;
+    }
+
     // Put all metadata in buffer
     if (m_BP4Deserializer.m_RankMPI == 0)
     {
@@ -202,12 +257,24 @@ void BP4Reader::InitBuffer()
             m_BP4Deserializer.m_MetadataIndex.m_Buffer.data(),
             metadataIndexFileSize);
     }
-    // broadcast buffer to all ranks from zero
-    helper::BroadcastVector(m_BP4Deserializer.m_Metadata.m_Buffer, m_MPIComm);
+    if (m_BP4Deserializer.m_NodeMetadataBroadcast)
+    {
+        // one copy per node over the network, then shared memory
+        helper::BroadcastVectorNodeShared(m_BP4Deserializer.m_Metadata.m_Buffer,
+                                          m_MPIComm);
+        helper::BroadcastVectorNodeShared(
+            m_BP4Deserializer.m_MetadataIndex.m_Buffer, m_MPIComm);
+    }
+    else
+    {
+        // broadcast buffer to all ranks from zero
+        helper::BroadcastVector(m_BP4Deserializer.m_Metadata.m_Buffer,
+                                m_MPIComm);
 
-    // broadcast metadata index buffer to all ranks from zero
-    helper::BroadcastVector(m_BP4Deserializer.m_MetadataIndex.m_Buffer,
-                            m_MPIComm);
+        // broadcast metadata index buffer to all ranks from zero
+        helper::BroadcastVector(m_BP4Deserializer.m_MetadataIndex.m_Buffer,
+                                m_MPIComm);
+    }
 
     /* Parse metadata index table */
     m_BP4Deserializer.ParseMetadataIndex(m_BP4Deserializer.m_MetadataIndex);
@@ -216,13 +283,229 @@ void BP4Reader::InitBuffer()
     m_BP4Deserializer.ParseMetadata(m_BP4Deserializer.m_Metadata, *this);
 }
 
+void BP4Reader::UpdateStreamMetadata(const size_t minSteps,
+                                     const float timeoutSeconds)
+{
+    auto &metadataIndex = m_BP4Deserializer.m_MetadataIndex.m_Buffer;
+    auto &metadata = m_BP4Deserializer.m_Metadata.m_Buffer;
+    const size_t indexStart = metadataIndex.size();
+    const size_t metadataStart = metadata.size();
+
+    if (m_BP4Deserializer.m_RankMPI == 0)
+    {
+        const size_t headerSize = m_BP4Deserializer.m_IndexHeaderSize;
+        const size_t recordSize = m_BP4Deserializer.m_IndexRecordSize;
+        const auto pollPeriod = std::chrono::milliseconds(100);
+        const auto timeStart = std::chrono::steady_clock::now();
+
+        while (true)
+        {
+            ReadNewMetadata();
+
+            const size_t steps =
+                (metadataIndex.size() < headerSize)
+                    ? 0
+                    : (metadataIndex.size() - headerSize) / recordSize;
+            if (steps > minSteps || !m_WriterIsActive)
+            {
+                break;
+            }
+
+            const std::chrono::duration<float> elapsed =
+                std::chrono::steady_clock::now() - timeStart;
+            if (timeoutSeconds >= 0.f && elapsed.count() >= timeoutSeconds)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(pollPeriod);
+        }
+    }
+
+    // send only what was appended by rank 0
+    std::vector<char> newIndex(metadataIndex.begin() + indexStart,
+                               metadataIndex.end());
+    std::vector<char> newMetadata(metadata.begin() + metadataStart,
+                                  metadata.end());
+    helper::BroadcastVector(newIndex, m_MPIComm);
+    helper::BroadcastVector(newMetadata, m_MPIComm);
+    m_WriterIsActive = helper::BroadcastValue(
+                           static_cast<size_t>(m_WriterIsActive), m_MPIComm) ==
+                       1;
+
+    if (m_BP4Deserializer.m_RankMPI != 0)
+    {
+        metadataIndex.insert(metadataIndex.end(), newIndex.begin(),
+                             newIndex.end());
+        metadata.insert(metadata.end(), newMetadata.begin(), newMetadata.end());
+    }
+
+    if (metadataIndex.size() > indexStart)
+    {
+        m_BP4Deserializer.ParseMetadataIndex(m_BP4Deserializer.m_MetadataIndex,
+                                             indexStart);
+    }
+
+    // new variables and attributes, sets StepsCount
+    m_BP4Deserializer.ParseMetadata(m_BP4Deserializer.m_Metadata, *this);
+}
+
+void BP4Reader::ReadNewMetadata()
+{
+    auto &metadataIndex = m_BP4Deserializer.m_MetadataIndex.m_Buffer;
+    auto &metadata = m_BP4Deserializer.m_Metadata.m_Buffer;
+    const size_t headerSize = m_BP4Deserializer.m_IndexHeaderSize;
+    const size_t recordSize = m_BP4Deserializer.m_IndexRecordSize;
+    const size_t activeFlagPosition = m_BP4Deserializer.m_ActiveFlagPosition;
+
+    if (m_FileMetadataIndexManager.GetFileSize(0) < headerSize)
+    {
+        // header is written with the first step
+        return;
+    }
+
+    // read the flag before the entries, once cleared all entries are written
+    char active = 1;
+    m_FileMetadataIndexManager.ReadFile(&active, 1, activeFlagPosition);
+    m_WriterIsActive = (active != 0);
+
+    // skip a partially written entry
+    const size_t indexFileSize = m_FileMetadataIndexManager.GetFileSize(0);
+    const size_t indexEnd =
+        headerSize + (indexFileSize - headerSize) / recordSize * recordSize;
+    const size_t indexStart = metadataIndex.size();
+    if (indexEnd <= indexStart)
+    {
+        return;
+    }
+
+    metadataIndex.resize(indexEnd);
+    m_FileMetadataIndexManager.ReadFile(metadataIndex.data() + indexStart,
+                                        indexEnd - indexStart, indexStart);
+
+    if (indexEnd == headerSize)
+    {
+        return;
+    }
+
+    // last entry field is the end position of its step in the metadata file,
+    // header byte 28 is the endianness
+    const bool isLittleEndian = (metadataIndex[28] == 0);
+    size_t position = indexEnd - sizeof(uint64_t);
+    const size_t metadataEnd = static_cast<size_t>(
+        helper::ReadValue<uint64_t>(metadataIndex, position, isLittleEndian));
+
+    const size_t metadataStart = metadata.size();
+    if (metadataEnd > metadataStart)
+    {
+        metadata.resize(metadataEnd);
+        m_FileManager.ReadFile(metadata.data() + metadataStart,
+                               metadataEnd - metadataStart, metadataStart);
+    }
+}
+
+void BP4Reader::ReadPayloads(
+    std::map<size_t, std::vector<PayloadRequest>> &requests)
+{
+    const size_t gap = m_BP4Deserializer.m_ReadGapThreshold;
+    const size_t maxExtentSize = m_BP4Deserializer.m_ReadMaxExtentSize;
+    const unsigned int threads = m_BP4Deserializer.m_Threads;
+
+    // m_ThreadBuffers is not thread safe, get the buffers before launching
+    std::vector<std::vector<char> *> buffers(threads);
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        buffers[t] = &m_BP4Deserializer.m_ThreadBuffers[t][0];
+    }
+
+    auto lf_ClipExtent = [](const std::vector<PayloadRequest> &subFileRequests,
+                            const size_t first, const size_t last,
+                            const std::vector<char> &buffer,
+                            const size_t extentStart) {
+        for (size_t r = first; r < last; ++r)
+        {
+            const PayloadRequest &request = subFileRequests[r];
+            request.Clip(buffer.data() + request.Start - extentStart);
+        }
+    };
+
+    std::vector<std::future<void>> asyncs(threads);
+    unsigned int t = 0;
+
+    for (auto &subFilePair : requests)
+    {
+        const size_t subStreamID = subFilePair.first;
+        std::vector<PayloadRequest> &subFileRequests = subFilePair.second;
+
+        std::sort(subFileRequests.begin(), subFileRequests.end(),
+                  [](const PayloadRequest &a, const PayloadRequest &b) {
+                      return a.Start < b.Start;
+                  });
+
+        size_t first = 0;
+        while (first < subFileRequests.size())
+        {
+            const size_t extentStart = subFileRequests[first].Start;
+            size_t extentEnd = subFileRequests[first].End;
+            size_t last = first + 1;
+            while (last < subFileRequests.size() &&
+                   subFileRequests[last].Start <= extentEnd + gap &&
+                   subFileRequests[last].End - extentStart <= maxExtentSize)
+            {
+                extentEnd = std::max(extentEnd, subFileRequests[last].End);
+                ++last;
+            }
+
+            // the buffer of this slot is free once its last clip is done
+            if (asyncs[t].valid())
+            {
+                asyncs[t].get();
+            }
+
+            std::vector<char> &buffer = *buffers[t];
+            buffer.resize(extentEnd - extentStart);
+            m_SubFileManager.ReadFile(buffer.data(), buffer.size(),
+                                      extentStart, subStreamID);
+
+            if (threads == 1)
+            {
+                lf_ClipExtent(subFileRequests, first, last, buffer,
+                              extentStart);
+            }
+            else
+            {
+                asyncs[t] = std::async(std::launch::async, lf_ClipExtent,
+                                       std::cref(subFileRequests), first, last,
+                                       std::cref(buffer), extentStart);
+                t = (t + 1) % threads;
+            }
+            first = last;
+        }
+    }
+
+    for (auto &async : asyncs)
+    {
+        if (async.valid())
+        {
+            async.get();
+        }
+    }
+}
+
 #define declare_type(T)                                                        \
     void BP4Reader::DoGetSync(Variable<T> &variable, T *data)                  \
     {                                                                          \
+        if (m_BP4Deserializer.m_LazyMetadata)                                  \
+        {                                                                      \
+            m_BP4Deserializer.ParseVariablesIndexForSelection(variable);       \
+        }                                                                      \
         GetSyncCommon(variable, data);                                         \
     }                                                                          \
     void BP4Reader::DoGetDeferred(Variable<T> &variable, T *data)              \
     {                                                                          \
+        if (m_BP4Deserializer.m_LazyMetadata)                                  \
+        {                                                                      \
+            m_BP4Deserializer.ParseVariablesIndexForSelection(variable);       \
+        }                                                                      \
         GetDeferredCommon(variable, data);                                     \
     }
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
@@ -239,12 +522,21 @@ void BP4Reader::DoClose(const int transportIndex)
     std::map<size_t, std::vector<typename Variable<T>::Info>>                  \
     BP4Reader::DoAllStepsBlocksInfo(const Variable<T> &variable) const         \
     {                                                                          \
+        if (m_BP4Deserializer.m_LazyMetadata)                                  \
+        {                                                                      \
+            m_BP4Deserializer.ParseVariablesIndexUpToStep(                     \
+                m_BP4Deserializer.m_MetadataSet.StepsCount);                   \
+        }                                                                      \
         return m_BP4Deserializer.AllStepsBlocksInfo(variable);                 \
     }                                                                          \
                                                                                \
     std::vector<typename Variable<T>::Info> BP4Reader::DoBlocksInfo(           \
         const Variable<T> &variable, const size_t step) const                  \
     {                                                                          \
+        if (m_BP4Deserializer.m_LazyMetadata)                                  \
+        {                                                                      \
+            m_BP4Deserializer.ParseVariablesIndexUpToStep(step + 1);           \
+        }                                                                      \
         return m_BP4Deserializer.BlocksInfo(variable, step);                   \
     }
 
@@ -11,6 +11,12 @@
 #ifndef ADIOS2_ENGINE_BP4_BP4READER_H_
 #define ADIOS2_ENGINE_BP4_BP4READER_H_
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <functional>
+#include <map>
+#include <vector>
+/// \endcond
+
 #include "adios2/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
 #include "adios2/toolkit/format/bp4/BP4.h" //format::BP4Deserializer
@@ -59,10 +65,39 @@ private:
     size_t m_CurrentStep = 0;
     bool m_FirstStep = true;
 
+    /** raw payload of a block in a subfile, clipped once read */
+    struct PayloadRequest
+    {
+        size_t Start;
+        size_t End;
+        std::function<void(const char *)> Clip;
+    };
+
+    /** StreamReader: false once the writer closed the file */
+    bool m_WriterIsActive = true;
+
     void Init();
+    void InitParameters() final;
     void InitTransports();
     void InitBuffer();
 
+    /**
+     * StreamReader: rank 0 polls the metadata files for complete steps until
+     * there are more than minSteps, the writer closes the file or the timeout
+     * expires, then all ranks receive and parse the new metadata
+     * @param minSteps steps already consumed
+     * @param timeoutSeconds < 0 waits until the writer closes the file,
+     * 0 checks once
+     */
+    void UpdateStreamMetadata(const size_t minSteps,
+                              const float timeoutSeconds);
+
+    /**
+     * StreamReader rank 0: appends complete metadata index entries and their
+     * metadata to the deserializer buffers, updates m_WriterIsActive
+     */
+    void ReadNewMetadata();
+
 #define declare_type(T)                                                        \
     void DoGetSync(Variable<T> &, T *) final;                                  \
     void DoGetDeferred(Variable<T> &, T *) final;
@@ -80,6 +115,15 @@ private:
     template <class T>
     void ReadVariableBlocks(Variable<T> &variable);
 
+    /**
+     * Sorts the requests of each subfile by position and merges the ones
+     * closer than ReadGapThreshold into a single read of at most
+     * ReadMaxExtentSize bytes. Clipping runs in up to
+     * Threads asynchronous tasks overlapped with the next reads.
+     * @param requests key: subfile ID
+     */
+    void ReadPayloads(std::map<size_t, std::vector<PayloadRequest>> &requests);
+
 #define declare_type(T)                                                        \
     std::map<size_t, std::vector<typename Variable<T>::Info>>                  \
     DoAllStepsBlocksInfo(const Variable<T> &variable) const final;             \
@@ -65,6 +65,9 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
 {
     const bool profile = m_BP4Deserializer.m_Profiler.IsActive;
 
+    // raw payloads are read at the end, sorted and merged per subfile
+    std::map<size_t, std::vector<PayloadRequest>> payloadRequests;
+
     for (typename Variable<T>::Info &blockInfo : variable.m_BlocksInfo)
     {
         T *originalBlockData = blockInfo.Data;
@@ -90,7 +93,74 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
 
                     m_SubFileManager.OpenFileID(
                         subFileName, subStreamBoxInfo.SubStreamID, Mode::Read,
-                        {{"transport", "File"}}, profile);
+                        m_IO.m_TransportsParameters[0], profile);
+                }
+
+                // a followed subfile grows, GetFileSize extends the mapping
+                if (m_BP4Deserializer.m_StreamReader)
+                {
+                    m_SubFileManager.GetFileSize(subStreamBoxInfo.SubStreamID);
+                }
+
+                // memory mapped subfiles: clip directly from the mapped
+                // pages, no staging copy into the thread buffer
+                const char *mappedData = m_SubFileManager.GetFileMappedData(
+                    subStreamBoxInfo.SubStreamID);
+
+                if (mappedData != nullptr &&
+                    subStreamBoxInfo.OperationsInfo.empty())
+                {
+                    const size_t payloadEnd = subStreamBoxInfo.Seeks.second;
+                    if (payloadEnd > m_SubFileManager.GetFileMappedSize(
+                                         subStreamBoxInfo.SubStreamID))
+                    {
+                        // remaps if the file grew since it was mapped
+                        m_SubFileManager.GetFileSize(
+                            subStreamBoxInfo.SubStreamID);
+                        mappedData = m_SubFileManager.GetFileMappedData(
+                            subStreamBoxInfo.SubStreamID);
+                    }
+
+                    const size_t mappedSize =
+                        m_SubFileManager.GetFileMappedSize(
+                            subStreamBoxInfo.SubStreamID);
+                    if (payloadEnd > mappedSize)
+                    {
+                        throw std::ios_base::failure(
+                            "ERROR: payload of variable " + variable.m_Name +
+                            " ends at " + std::to_string(payloadEnd) +
+                            " past the mapped size " +
+                            std::to_string(mappedSize) + " of subfile " +
+                            std::to_string(subStreamBoxInfo.SubStreamID) +
+                            ", in call to Get\n");
+                    }
+
+                    m_BP4Deserializer.ClipPayload(
+                        variable, blockInfo, blockInfo.Data, subStreamBoxInfo,
+                        mappedData + subStreamBoxInfo.Seeks.first);
+                    continue;
+                }
+
+                if (subStreamBoxInfo.OperationsInfo.empty())
+                {
+                    T *blockData = blockInfo.Data;
+                    payloadRequests[subStreamBoxInfo.SubStreamID].push_back(
+                        {subStreamBoxInfo.Seeks.first,
+                         subStreamBoxInfo.Seeks.second,
+                         [this, &variable, &blockInfo, blockData,
+                          &subStreamBoxInfo](const char *payload) {
+                             m_BP4Deserializer.ClipPayload(
+                                 variable, blockInfo, blockData,
+                                 subStreamBoxInfo, payload);
+                         }});
+                    continue;
+                }
+
+                if (m_BP4Deserializer.CachedDataRead(
+                        variable, blockInfo, subStreamBoxInfo,
+                        helper::IsRowMajor(m_IO.m_HostLanguage), 0))
+                {
+                    continue;
                 }
 
                 char *buffer = nullptr;
@@ -112,6 +182,8 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
         } // steps loop
         blockInfo.Data = originalBlockData;
     } // deferred blocks loop
+
+    ReadPayloads(payloadRequests);
 }
 
 } // end namespace engine
@@ -24,6 +24,26 @@ namespace core
 namespace engine
 {
 
+namespace
+{
+
+/** segments followed by the first size bytes of buffer, in file order */
+std::vector<Transport::Segment>
+GatherSegments(const std::vector<std::vector<char>> &segments,
+               const char *buffer, const size_t size)
+{
+    std::vector<Transport::Segment> gathered;
+    gathered.reserve(segments.size() + 1);
+    for (const auto &segment : segments)
+    {
+        gathered.push_back({segment.data(), segment.size()});
+    }
+    gathered.push_back({buffer, size});
+    return gathered;
+}
+
+} // end anonymous namespace
+
 BP4Writer::BP4Writer(IO &io, const std::string &name, const Mode mode,
                      MPI_Comm mpiComm)
 : Engine("BP4Writer", io, name, mode, mpiComm),
@@ -37,13 +57,14 @@ BP4Writer::BP4Writer(IO &io, const std::string &name, const Mode mode,
     Init();
 }
 
-BP4Writer::~BP4Writer() = default;
+BP4Writer::~BP4Writer() { AsyncWriteStop(false); }
 
 StepStatus BP4Writer::BeginStep(StepMode mode, const float timeoutSeconds)
 {
     m_BP4Serializer.m_DeferredVariables.clear();
     m_BP4Serializer.m_DeferredVariablesDataSize = 0;
     m_IO.m_ReadStreaming = false;
+    m_BP4Serializer.m_Tracer.SetStep(CurrentStep());
     return StepStatus::OK;
 }
 
@@ -94,6 +115,7 @@ void BP4Writer::EndStep()
     {
         PerformPuts();
     }
+    PutSpansBounds();
 
     // true: advances step
     m_BP4Serializer.SerializeData(m_IO, true);
@@ -109,6 +131,14 @@ void BP4Writer::EndStep()
 
 void BP4Writer::Flush(const int transportIndex)
 {
+    if (!m_SpanVariables.empty())
+    {
+        // flushing resets m_Data under the reserved span payloads
+        throw std::runtime_error(
+            "ERROR: buffer can't be flushed while spans are pending, call "
+            "EndStep first, in call to Flush\n");
+    }
+
     DoFlush(false, transportIndex);
     m_BP4Serializer.ResetBuffer(m_BP4Serializer.m_Data);
 
@@ -118,12 +148,21 @@ void BP4Writer::Flush(const int transportIndex)
     }
 }
 
+char *BP4Writer::BufferData(const size_t payloadPosition,
+                            const size_t /*bufferID*/) noexcept
+{
+    size_t position = payloadPosition;
+    std::vector<char> &segment = m_BP4Serializer.m_Data.GetSegment(position);
+    return segment.data() + position;
+}
+
 // PRIVATE
 void BP4Writer::Init()
 {
     InitParameters();
     InitTransports();
     InitBPBuffer();
+    AsyncWriteStart();
 }
 
 #define declare_type(T)                                                        \
@@ -140,6 +179,45 @@ void BP4Writer::Init()
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
+#define declare_type(T)                                                        \
+    void BP4Writer::DoPut(Variable<T> &variable,                               \
+                          typename Variable<T>::Span &span,                    \
+                          const size_t /*bufferID*/, const T &value)           \
+    {                                                                          \
+        PutSpanCommon(variable, span, value);                                  \
+    }
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+void BP4Writer::PutSpansBounds()
+{
+    for (const std::string &variableName : m_SpanVariables)
+    {
+        const std::string type = m_IO.InquireVariableType(variableName);
+        if (type == "compound")
+        {
+            // not supported
+        }
+#define declare_template_instantiation(T)                                      \
+    else if (type == helper::GetType<T>())                                     \
+    {                                                                          \
+        Variable<T> &variable =                                                \
+            FindVariable<T>(variableName, "in call to EndStep or Close");      \
+                                                                               \
+        for (const auto &spanPair : variable.m_BlocksSpan)                     \
+        {                                                                      \
+            m_BP4Serializer.PutSpanBounds(variable, spanPair.second);          \
+        }                                                                      \
+        variable.m_BlocksSpan.clear();                                         \
+    }
+
+        ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+    }
+    m_SpanVariables.clear();
+}
+
 void BP4Writer::InitParameters()
 {
     m_BP4Serializer.InitParameters(m_IO.m_Parameters);
@@ -158,7 +236,7 @@ void BP4Writer::InitTransports()
     // only consumers will interact with transport managers
     std::vector<std::string> bpSubStreamNames;
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         // Names passed to IO AddTransport option with key "Name"
         const std::vector<std::string> transportsNames =
@@ -169,12 +247,19 @@ void BP4Writer::InitTransports()
         bpSubStreamNames = m_BP4Serializer.GetBPSubStreamNames(transportsNames);
     }
 
-    m_BP4Serializer.ProfilerStart("mkdir");
+    if (m_BP4Serializer.m_Tracer.IsActive)
+    {
+        m_FileDataManager.SetTracer(&m_BP4Serializer.m_Tracer);
+        m_FileMetadataManager.SetTracer(&m_BP4Serializer.m_Tracer);
+        m_FileMetadataIndexManager.SetTracer(&m_BP4Serializer.m_Tracer);
+    }
+
+    m_BP4Serializer.ProfilerStart(profiling::TraceEvent::Mkdir);
     m_FileDataManager.MkDirsBarrier(bpSubStreamNames,
                                     m_BP4Serializer.m_NodeLocal);
-    m_BP4Serializer.ProfilerStop("mkdir");
+    m_BP4Serializer.ProfilerStop(profiling::TraceEvent::Mkdir);
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         m_FileDataManager.OpenFiles(bpSubStreamNames, m_OpenMode,
                                     m_IO.m_TransportsParameters,
@@ -221,7 +306,7 @@ void BP4Writer::InitBPBuffer()
 
 void BP4Writer::DoFlush(const bool isFinal, const int transportIndex)
 {
-    if (m_BP4Serializer.m_Aggregator.m_IsActive)
+    if (m_BP4Serializer.m_Aggregator->m_IsActive)
     {
         AggregateWriteData(isFinal, transportIndex);
     }
@@ -233,11 +318,18 @@ void BP4Writer::DoFlush(const bool isFinal, const int transportIndex)
 
 void BP4Writer::DoClose(const int transportIndex)
 {
+    PutSpansBounds();
+
     if (m_BP4Serializer.m_DeferredVariables.size() > 0)
     {
         PerformPuts();
 
         DoFlush(false, transportIndex);
+        if (m_AsyncWrite)
+        {
+            // data buffer was handed to the background writer
+            m_BP4Serializer.ResetBuffer(m_BP4Serializer.m_Data);
+        }
 
         if (m_BP4Serializer.m_CollectiveMetadata &&
             m_FileDataManager.AllTransportsClosed())
@@ -247,8 +339,9 @@ void BP4Writer::DoClose(const int transportIndex)
     }
 
     DoFlush(true, transportIndex);
+    AsyncWriteStop();
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         m_FileDataManager.CloseFiles(transportIndex);
     }
@@ -258,6 +351,7 @@ void BP4Writer::DoClose(const int transportIndex)
     {
         WriteCollectiveMetadataFile(true);
     }
+    m_BP4Serializer.FreeMetadataGroupComm();
 
     if (m_BP4Serializer.m_Profiler.IsActive &&
         m_FileDataManager.AllTransportsClosed())
@@ -265,13 +359,37 @@ void BP4Writer::DoClose(const int transportIndex)
         // std::cout << "write profiling file!" << std::endl;
         WriteProfilingJSONFile();
     }
-    if (m_BP4Serializer.m_Aggregator.m_IsActive)
+
+    if (m_BP4Serializer.m_Tracer.IsActive &&
+        m_FileDataManager.AllTransportsClosed())
+    {
+        WriteTraceJSONFile();
+    }
+
+    if (m_BP4Serializer.m_Aggregator->m_IsActive)
     {
-        m_BP4Serializer.m_Aggregator.Close();
+        m_BP4Serializer.m_Aggregator->Close();
+    }
+
+    if (m_BP4Serializer.m_BufferPool)
+    {
+        m_BP4Serializer.m_Data.ReleaseToPool();
     }
 
     if (m_BP4Serializer.m_RankMPI == 0)
     {
+        // no more steps, clear the active flag in the metadata index header
+        // (Append files are opened with O_APPEND, positioned writes append)
+        const size_t activeFlagPosition =
+            m_BP4Serializer.m_ActiveFlagPosition;
+        if (m_OpenMode == Mode::Write &&
+            m_FileMetadataIndexManager.GetFileSize(0) > activeFlagPosition)
+        {
+            const char inactive = 0;
+            m_FileMetadataIndexManager.WriteFilesAt(&inactive, 1,
+                                                    activeFlagPosition);
+        }
+
         // close metadata file
         m_FileMetadataManager.CloseFiles();
 
@@ -314,6 +432,22 @@ void BP4Writer::WriteProfilingJSONFile()
     }
 }
 
+void BP4Writer::WriteTraceJSONFile()
+{
+    const std::vector<char> traceJSON(m_BP4Serializer.AggregateProfilingJSON(
+        m_BP4Serializer.m_Tracer.GetChromeTraceEvents(
+            m_BP4Serializer.m_RankMPI)));
+
+    if (m_BP4Serializer.m_RankMPI == 0)
+    {
+        transport::FileFStream traceJSONStream(m_MPIComm, m_DebugMode);
+        auto bpBaseNames = m_BP4Serializer.GetBPBaseNames({m_Name});
+        traceJSONStream.Open(bpBaseNames[0] + "/trace.json", Mode::Write);
+        traceJSONStream.Write(traceJSON.data(), traceJSON.size());
+        traceJSONStream.Close();
+    }
+}
+
 /*generate the header for the metadata index file*/
 void BP4Writer::PopulateMetadataIndexFileHeader(std::vector<char> &buffer,
                                                 size_t &position,
@@ -363,7 +497,11 @@ void BP4Writer::PopulateMetadataIndexFileHeader(std::vector<char> &buffer,
         helper::CopyToBuffer(buffer, position, &zeros2);
     }
     helper::CopyToBuffer(buffer, position, &version);
-    position += 16;
+
+    // stream readers wait for new steps while this flag is set
+    const uint8_t active = 1;
+    helper::CopyToBuffer(buffer, position, &active);
+    position += 15;
 }
 
 /*write the content of metadata index file*/
@@ -383,16 +521,27 @@ void BP4Writer::PopulateMetadataIndexFileContent(
 
 void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
 {
+    const int64_t traceStart = m_BP4Serializer.m_Tracer.Now();
 
     m_BP4Serializer.AggregateCollectiveMetadata(
         m_MPIComm, m_BP4Serializer.m_Metadata, true);
 
+    const size_t metadataSize = m_BP4Serializer.m_Metadata.m_Position;
+
+    // other ranks may still be writing the data of previous steps
+    const size_t drainedSteps = m_AsyncWrite ? AsyncDrainedSteps() : 0;
+
     if (m_BP4Serializer.m_RankMPI == 0)
     {
+        // all data is written once AsyncWrite is stopped at Close
+        AsyncPublishIndex(drainedSteps);
+
         if (isFinal && m_BP4Serializer.m_MetadataSet.metadataFileLength > 0)
         {
             // if some metadata has already been written, don't need to write
             // it at close.
+            m_BP4Serializer.m_Tracer.Record(profiling::TraceEvent::Metadata,
+                                            traceStart, metadataSize);
             return;
         }
         // first init metadata files
@@ -414,10 +563,9 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
         //     m_IO.m_TransportsParameters,
         //     m_BP4Serializer.m_Profiler.IsActive);
 
-        m_FileMetadataManager.WriteFiles(
-            m_BP4Serializer.m_Metadata.m_Buffer.data(),
-            m_BP4Serializer.m_Metadata.m_Position);
-        m_FileMetadataManager.FlushFiles();
+        WriteMetadataFiles(m_FileMetadataManager,
+                           m_BP4Serializer.m_Metadata.m_Buffer.data(),
+                           m_BP4Serializer.m_Metadata.m_Position);
 
         /*record the starting position of indices in metadata file*/
         const uint64_t pgIndexStartMetadataFile =
@@ -469,8 +617,9 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
         {
             PopulateMetadataIndexFileHeader(metadataIndex.m_Buffer,
                                             metadataIndex.m_Position, 4, true);
-            m_FileMetadataIndexManager.WriteFiles(metadataIndex.m_Buffer.data(),
-                                                  metadataIndex.m_Position);
+            WriteMetadataFiles(m_FileMetadataIndexManager,
+                               metadataIndex.m_Buffer.data(),
+                               metadataIndex.m_Position);
 
             metadataIndex.m_Buffer.resize(48);
             metadataIndex.m_Buffer.assign(metadataIndex.m_Buffer.size(), '\0');
@@ -483,9 +632,20 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
             currentStepEndPos, metadataIndex.m_Buffer,
             metadataIndex.m_Position);
 
-        m_FileMetadataIndexManager.WriteFiles(metadataIndex.m_Buffer.data(),
-                                              metadataIndex.m_Position);
-        m_FileMetadataIndexManager.FlushFiles();
+        if (m_AsyncWrite)
+        {
+            // readers find a step by its md.idx entry, publish it only after
+            // every rank wrote its data
+            metadataIndex.m_Buffer.resize(metadataIndex.m_Position);
+            m_AsyncIndexPending.push_back(std::move(metadataIndex.m_Buffer));
+            AsyncPublishIndex(drainedSteps);
+        }
+        else
+        {
+            WriteMetadataFiles(m_FileMetadataIndexManager,
+                               metadataIndex.m_Buffer.data(),
+                               metadataIndex.m_Position);
+        }
 
         m_BP4Serializer.m_MetadataSet.metadataFileLength +=
             m_BP4Serializer.m_Metadata.m_Position;
@@ -501,6 +661,9 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
     /*Clear the local indices buffer at the end of each step*/
     m_BP4Serializer.ResetBuffer(m_BP4Serializer.m_Metadata, true);
     m_BP4Serializer.ResetIndicesBuffer();
+
+    m_BP4Serializer.m_Tracer.Record(profiling::TraceEvent::Metadata,
+                                    traceStart, metadataSize);
 }
 
 void BP4Writer::WriteData(const bool isFinal, const int transportIndex)
@@ -515,45 +678,87 @@ void BP4Writer::WriteData(const bool isFinal, const int transportIndex)
     else
     {
         m_BP4Serializer.CloseStream(m_IO);
+
+        if (m_AsyncWrite)
+        {
+            AsyncWriteData(dataSize, transportIndex);
+            return;
+        }
     }
 
-    m_FileDataManager.WriteFiles(m_BP4Serializer.m_Data.m_Buffer.data(),
-                                 dataSize, transportIndex);
+    if (m_AsyncWrite)
+    {
+        // final buffer is written after all queued steps
+        AsyncWriteWait();
+    }
+
+    const int64_t traceStart = m_BP4Serializer.m_Tracer.Now();
+
+    const BufferSTL &data = m_BP4Serializer.m_Data;
+    if (data.m_Segments.empty())
+    {
+        m_FileDataManager.WriteFiles(data.m_Buffer.data(), dataSize,
+                                     transportIndex);
+    }
+    else
+    {
+        // single gathered write, segments are not joined
+        m_FileDataManager.WriteFiles(
+            GatherSegments(data.m_Segments, data.m_Buffer.data(), dataSize),
+            transportIndex);
+    }
 
     m_FileDataManager.FlushFiles(transportIndex);
+
+    m_BP4Serializer.m_Tracer.Record(profiling::TraceEvent::Write, traceStart,
+                                    dataSize);
 }
 
 void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
 {
     m_BP4Serializer.CloseStream(m_IO, false);
 
+    // aggregators exchange contiguous buffers
+    m_BP4Serializer.m_Data.JoinSegments("in call to AggregateWriteData");
+
     // async?
-    for (int r = 0; r < m_BP4Serializer.m_Aggregator.m_Size; ++r)
+    for (int r = 0; r < m_BP4Serializer.m_Aggregator->m_Size; ++r)
     {
+        const int64_t traceStart = m_BP4Serializer.m_Tracer.Now();
+
         std::vector<MPI_Request> dataRequests =
-            m_BP4Serializer.m_Aggregator.IExchange(m_BP4Serializer.m_Data, r);
+            m_BP4Serializer.m_Aggregator->IExchange(m_BP4Serializer.m_Data, r);
 
         std::vector<MPI_Request> absolutePositionRequests =
-            m_BP4Serializer.m_Aggregator.IExchangeAbsolutePosition(
+            m_BP4Serializer.m_Aggregator->IExchangeAbsolutePosition(
                 m_BP4Serializer.m_Data, r);
 
-        if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+        if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
         {
             const BufferSTL &bufferSTL =
-                m_BP4Serializer.m_Aggregator.GetConsumerBuffer(
+                m_BP4Serializer.m_Aggregator->GetConsumerBuffer(
                     m_BP4Serializer.m_Data);
 
+            const int64_t writeStart = m_BP4Serializer.m_Tracer.Now();
+
             m_FileDataManager.WriteFiles(bufferSTL.m_Buffer.data(),
                                          bufferSTL.m_Position, transportIndex);
 
             m_FileDataManager.FlushFiles(transportIndex);
+
+            m_BP4Serializer.m_Tracer.Record(profiling::TraceEvent::Write,
+                                            writeStart, bufferSTL.m_Position);
         }
 
-        m_BP4Serializer.m_Aggregator.WaitAbsolutePosition(
+        m_BP4Serializer.m_Aggregator->WaitAbsolutePosition(
             absolutePositionRequests, r);
 
-        m_BP4Serializer.m_Aggregator.Wait(dataRequests, r);
-        m_BP4Serializer.m_Aggregator.SwapBuffers(r);
+        m_BP4Serializer.m_Aggregator->Wait(dataRequests, r);
+        m_BP4Serializer.m_Aggregator->SwapBuffers(r);
+
+        m_BP4Serializer.m_Tracer.Record(profiling::TraceEvent::Aggregation,
+                                        traceStart,
+                                        m_BP4Serializer.m_Data.m_Position);
     }
 
     m_BP4Serializer.UpdateOffsetsInMetadata();
@@ -564,19 +769,255 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
         m_BP4Serializer.ResetBuffer(bufferSTL, false, false);
 
         m_BP4Serializer.AggregateCollectiveMetadata(
-            m_BP4Serializer.m_Aggregator.m_Comm, bufferSTL, false);
+            m_BP4Serializer.m_Aggregator->m_Comm, bufferSTL, false);
 
-        if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+        if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
         {
             m_FileDataManager.WriteFiles(bufferSTL.m_Buffer.data(),
                                          bufferSTL.m_Position, transportIndex);
 
             m_FileDataManager.FlushFiles(transportIndex);
         }
-        m_BP4Serializer.m_Aggregator.Close();
+        m_BP4Serializer.m_Aggregator->Close();
+    }
+
+    m_BP4Serializer.m_Aggregator->ResetBuffers();
+}
+
+void BP4Writer::AsyncWriteStart()
+{
+    // aggregation requires all ranks in the aggregator comm to take part of
+    // every write, so it stays synchronous
+    if (!m_BP4Serializer.m_AsyncWrite ||
+        m_BP4Serializer.m_Aggregator->m_IsActive)
+    {
+        return;
+    }
+
+    m_AsyncWrite = true;
+    m_AsyncStop = false;
+    m_AsyncThread = std::thread(&BP4Writer::AsyncWriteLoop, this);
+    // no write is queued yet, so its first traced span doesn't allocate
+    m_BP4Serializer.m_Tracer.RegisterThread(m_AsyncThread.get_id());
+}
+
+void BP4Writer::AsyncWriteLoop()
+{
+    while (true)
+    {
+        AsyncWriteTask task;
+        {
+            std::unique_lock<std::mutex> lock(m_AsyncMutex);
+            m_AsyncTaskCV.wait(
+                lock, [&] { return m_AsyncStop || !m_AsyncTasks.empty(); });
+
+            if (m_AsyncTasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(m_AsyncTasks.front());
+            m_AsyncTasks.pop_front();
+            m_AsyncIsWriting = true;
+
+            // after an error keep draining so callers never block forever
+            if (m_AsyncException)
+            {
+                task.Manager = nullptr;
+            }
+        }
+
+        if (task.Manager != nullptr)
+        {
+            const int64_t traceStart = m_BP4Serializer.m_Tracer.Now();
+            try
+            {
+                if (task.Segments.empty())
+                {
+                    task.Manager->WriteFiles(task.Buffer.data(), task.Size,
+                                             task.TransportIndex);
+                }
+                else
+                {
+                    task.Manager->WriteFiles(
+                        GatherSegments(task.Segments, task.Buffer.data(),
+                                       task.Size),
+                        task.TransportIndex);
+                }
+                task.Manager->FlushFiles(task.TransportIndex);
+
+                // recorded in the background thread's own buffer
+                m_BP4Serializer.m_Tracer.Record(profiling::TraceEvent::Write,
+                                                traceStart, task.Size);
+
+                if (task.IsData)
+                {
+                    std::lock_guard<std::mutex> lock(m_AsyncMutex);
+                    ++m_AsyncDataWritten;
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_AsyncMutex);
+                m_AsyncException = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_AsyncMutex);
+            if (task.IsData)
+            {
+                --m_AsyncPendingBuffers;
+                if (m_AsyncFreeBuffers.size() <
+                    m_BP4Serializer.m_AsyncQueueDepth)
+                {
+                    m_AsyncFreeBuffers.push_back(std::move(task.Buffer));
+                }
+            }
+            m_AsyncIsWriting = false;
+        }
+        m_AsyncDoneCV.notify_all();
+    }
+}
+
+void BP4Writer::AsyncWriteData(const size_t dataSize, const int transportIndex)
+{
+    AsyncWriteTask task;
+    task.Manager = &m_FileDataManager;
+    task.Size = dataSize;
+    task.TransportIndex = transportIndex;
+    task.IsData = true;
+
+    {
+        // blocking fallback when the queue is full
+        std::unique_lock<std::mutex> lock(m_AsyncMutex);
+        m_AsyncDoneCV.wait(lock, [&] {
+            return m_AsyncPendingBuffers < m_BP4Serializer.m_AsyncQueueDepth ||
+                   m_AsyncException;
+        });
+
+        if (m_AsyncException)
+        {
+            std::rethrow_exception(m_AsyncException);
+        }
+
+        ++m_AsyncPendingBuffers;
+        ++m_AsyncDataQueued;
+        if (!m_AsyncFreeBuffers.empty())
+        {
+            task.Buffer = std::move(m_AsyncFreeBuffers.back());
+            m_AsyncFreeBuffers.pop_back();
+        }
     }
 
-    m_BP4Serializer.m_Aggregator.ResetBuffers();
+    // the application keeps serializing into the recycled buffer, contents
+    // are reset by the caller
+    std::vector<char> &dataBuffer = m_BP4Serializer.m_Data.m_Buffer;
+    task.Buffer.resize(dataBuffer.size());
+    task.Buffer.swap(dataBuffer);
+    task.Segments.swap(m_BP4Serializer.m_Data.m_Segments);
+    m_BP4Serializer.m_Data.ClearSegments();
+
+    {
+        std::lock_guard<std::mutex> lock(m_AsyncMutex);
+        m_AsyncTasks.push_back(std::move(task));
+    }
+    m_AsyncTaskCV.notify_one();
+}
+
+void BP4Writer::WriteMetadataFiles(transportman::TransportMan &manager,
+                                   const char *buffer, const size_t size)
+{
+    if (!m_AsyncWrite)
+    {
+        manager.WriteFiles(buffer, size);
+        manager.FlushFiles();
+        return;
+    }
+
+    AsyncWriteTask task;
+    task.Manager = &manager;
+    task.Buffer.assign(buffer, buffer + size);
+    task.Size = size;
+
+    {
+        std::lock_guard<std::mutex> lock(m_AsyncMutex);
+        if (m_AsyncException)
+        {
+            std::rethrow_exception(m_AsyncException);
+        }
+        m_AsyncTasks.push_back(std::move(task));
+    }
+    m_AsyncTaskCV.notify_one();
+}
+
+size_t BP4Writer::AsyncDrainedSteps()
+{
+    // data queued up to this step on this rank
+    m_AsyncStepsData.push_back(m_AsyncDataQueued);
+
+    size_t dataWritten;
+    {
+        std::lock_guard<std::mutex> lock(m_AsyncMutex);
+        dataWritten = m_AsyncDataWritten;
+    }
+
+    while (!m_AsyncStepsData.empty() &&
+           m_AsyncStepsData.front() <= dataWritten)
+    {
+        m_AsyncStepsData.pop_front();
+        ++m_AsyncStepsDrained;
+    }
+
+    return helper::ReduceValues(m_AsyncStepsDrained, m_MPIComm, MPI_MIN);
+}
+
+void BP4Writer::AsyncPublishIndex(const size_t drainedSteps)
+{
+    while (!m_AsyncIndexPending.empty() &&
+           (!m_AsyncWrite || m_AsyncIndexPublished < drainedSteps))
+    {
+        const std::vector<char> &entry = m_AsyncIndexPending.front();
+        WriteMetadataFiles(m_FileMetadataIndexManager, entry.data(),
+                           entry.size());
+        m_AsyncIndexPending.pop_front();
+        ++m_AsyncIndexPublished;
+    }
+}
+
+void BP4Writer::AsyncWriteWait()
+{
+    std::unique_lock<std::mutex> lock(m_AsyncMutex);
+    m_AsyncDoneCV.wait(
+        lock, [&] { return m_AsyncTasks.empty() && !m_AsyncIsWriting; });
+
+    if (m_AsyncException)
+    {
+        std::rethrow_exception(m_AsyncException);
+    }
+}
+
+void BP4Writer::AsyncWriteStop(const bool rethrow)
+{
+    if (!m_AsyncThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_AsyncMutex);
+        m_AsyncStop = true;
+    }
+    m_AsyncTaskCV.notify_one();
+    m_AsyncThread.join();
+
+    m_AsyncWrite = false;
+    m_AsyncFreeBuffers.clear();
+
+    if (rethrow && m_AsyncException)
+    {
+        std::rethrow_exception(m_AsyncException);
+    }
 }
 
 } // end namespace engine
@@ -11,6 +11,17 @@
 #ifndef ADIOS2_ENGINE_BP4_BP4WRITER_H_
 #define ADIOS2_ENGINE_BP4_BP4WRITER_H_
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+/// \endcond
+
 #include "adios2/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
 #include "adios2/toolkit/format/bp4/BP4.h"
@@ -45,6 +56,9 @@ public:
     void EndStep() final;
     void Flush(const int transportIndex = -1) final;
 
+    char *BufferData(const size_t payloadPosition,
+                     const size_t bufferID = 0) noexcept final;
+
 private:
     /** Single object controlling BP buffering */
     format::BP4Serializer m_BP4Serializer;
@@ -58,6 +72,77 @@ private:
     /* transport manager for managing the metadata index file */
     transportman::TransportMan m_FileMetadataIndexManager;
 
+    /** buffer waiting in the background write queue */
+    struct AsyncWriteTask
+    {
+        transportman::TransportMan *Manager = nullptr;
+        std::vector<char> Buffer;
+        /** data buffer segments written before Buffer */
+        std::vector<std::vector<char>> Segments;
+        size_t Size = 0;
+        int TransportIndex = -1;
+        /** true: m_BP4Serializer.m_Data buffer, recycled after writing */
+        bool IsData = false;
+    };
+
+    /** true: flushed buffers are written by m_AsyncThread */
+    bool m_AsyncWrite = false;
+
+    /** data buffers handed to m_AsyncThread, application thread only */
+    size_t m_AsyncDataQueued = 0;
+
+    /**
+     * m_AsyncDataQueued at each collective metadata step not yet known to be
+     * written by this rank, application thread only
+     */
+    std::deque<size_t> m_AsyncStepsData;
+
+    /** collective metadata steps whose data this rank wrote */
+    size_t m_AsyncStepsDrained = 0;
+
+    /**
+     * rank 0: md.idx entries held back until all ranks wrote the data of
+     * their step, the front entry is step m_AsyncIndexPublished
+     */
+    std::deque<std::vector<char>> m_AsyncIndexPending;
+
+    /** rank 0: md.idx entries handed to WriteMetadataFiles */
+    size_t m_AsyncIndexPublished = 0;
+
+    /** background thread writing m_AsyncTasks in order */
+    std::thread m_AsyncThread;
+
+    /** protects all m_Async* members below */
+    std::mutex m_AsyncMutex;
+
+    /** notifies m_AsyncThread of new tasks or stop */
+    std::condition_variable m_AsyncTaskCV;
+
+    /** notifies the application thread of completed tasks */
+    std::condition_variable m_AsyncDoneCV;
+
+    std::deque<AsyncWriteTask> m_AsyncTasks;
+
+    /** data buffers queued or being written, bounded by AsyncQueueDepth */
+    size_t m_AsyncPendingBuffers = 0;
+
+    /** data buffers written successfully by m_AsyncThread */
+    size_t m_AsyncDataWritten = 0;
+
+    /** true: m_AsyncThread is writing a task already popped from the queue */
+    bool m_AsyncIsWriting = false;
+
+    bool m_AsyncStop = false;
+
+    /** written data buffers reused by the next flush to avoid allocations */
+    std::vector<std::vector<char>> m_AsyncFreeBuffers;
+
+    /** first exception thrown in m_AsyncThread, rethrown by the next call */
+    std::exception_ptr m_AsyncException;
+
+    /** variables with spans put in the current step */
+    std::set<std::string> m_SpanVariables;
+
     void Init() final;
 
     /** Parses parameters from IO SetParameters */
@@ -74,6 +159,13 @@ private:
     ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
+#define declare_type(T)                                                        \
+    void DoPut(Variable<T> &variable, typename Variable<T>::Span &span,        \
+               const size_t bufferID, const T &value) final;
+
+    ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
     /**
      * Common function for primitive PutSync, puts variables in buffer
      * @param variable
@@ -86,6 +178,16 @@ private:
     template <class T>
     void PutDeferredCommon(Variable<T> &variable, const T *data);
 
+    template <class T>
+    void PutSpanCommon(Variable<T> &variable,
+                       typename Variable<T>::Span &span, const T &value);
+
+    /**
+     * Sets min and max of all blocks in m_SpanVariables once the application
+     * filled their spans, called before serializing the step metadata
+     */
+    void PutSpansBounds();
+
     void DoFlush(const bool isFinal = false, const int transportIndex = -1);
 
     void DoClose(const int transportIndex = -1) final;
@@ -94,6 +196,10 @@ private:
      * profilers*/
     void WriteProfilingJSONFile();
 
+    /** Write a trace.json file with the m_Tracer spans of all ranks, Chrome
+     * trace format */
+    void WriteTraceJSONFile();
+
     void PopulateMetadataIndexFileHeader(std::vector<char> &buffer,
                                          size_t &position, const uint8_t,
                                          const bool addSubfiles);
@@ -117,6 +223,55 @@ private:
      * @param transportIndex
      */
     void AggregateWriteData(const bool isFinal, const int transportIndex = -1);
+
+    /** Starts m_AsyncThread if AsyncWrite is On and there is no aggregation */
+    void AsyncWriteStart();
+
+    /** m_AsyncThread body, writes and flushes m_AsyncTasks in order */
+    void AsyncWriteLoop();
+
+    /**
+     * Swaps m_BP4Serializer.m_Data buffer with a recycled one and queues it
+     * for writing. Blocks if AsyncQueueDepth buffers are already pending.
+     * @param dataSize bytes to write from the current data buffer
+     * @param transportIndex
+     */
+    void AsyncWriteData(const size_t dataSize, const int transportIndex);
+
+    /**
+     * Writes and flushes buffer to all transports in manager, a copy is
+     * queued if AsyncWrite is active to keep the order with this rank's data
+     * writes
+     * @param manager metadata or metadata index transport manager
+     * @param buffer
+     * @param size
+     */
+    void WriteMetadataFiles(transportman::TransportMan &manager,
+                            const char *buffer, const size_t size);
+
+    /**
+     * Collective, returns on rank 0 the number of collective metadata steps
+     * whose data all ranks wrote. Called from the application thread, the
+     * background writer never calls MPI.
+     */
+    size_t AsyncDrainedSteps();
+
+    /**
+     * Rank 0: writes the pending md.idx entries of drained steps, or all of
+     * them once AsyncWrite is stopped
+     * @param drainedSteps from AsyncDrainedSteps
+     */
+    void AsyncPublishIndex(const size_t drainedSteps);
+
+    /** Blocks until all queued tasks are written, rethrows their errors */
+    void AsyncWriteWait();
+
+    /**
+     * Drains the queue and joins m_AsyncThread, afterwards all writes are
+     * synchronous
+     * @param rethrow true: rethrow errors from m_AsyncThread
+     */
+    void AsyncWriteStop(const bool rethrow = true);
 };
 
 } // end namespace engine
@@ -23,6 +23,8 @@ template <class T>
 void BP4Writer::PutSyncCommon(Variable<T> &variable,
                               const typename Variable<T>::Info &blockInfo)
 {
+    const int64_t traceStart = m_BP4Serializer.m_Tracer.Now();
+
     // if first timestep Write create a new pg index
     if (!m_BP4Serializer.m_MetadataSet.DataPGIsOpen)
     {
@@ -31,8 +33,12 @@ void BP4Writer::PutSyncCommon(Variable<T> &variable,
             m_FileDataManager.GetTransportsTypes());
     }
 
+    // operations write their output directly in the buffer
     const size_t dataSize =
-        helper::PayloadSize(blockInfo.Data, blockInfo.Count) +
+        m_BP4Serializer.GetOperationPayloadMaxSize(
+            blockInfo.Operations,
+            helper::PayloadSize(blockInfo.Data, blockInfo.Count),
+            sizeof(T)) +
         m_BP4Serializer.GetBPIndexSizeInData(variable.m_Name, blockInfo.Count);
 
     const format::BP4Base::ResizeResult resizeResult =
@@ -41,6 +47,14 @@ void BP4Writer::PutSyncCommon(Variable<T> &variable,
 
     if (resizeResult == format::BP4Base::ResizeResult::Flush)
     {
+        if (!m_SpanVariables.empty())
+        {
+            throw std::runtime_error(
+                "ERROR: buffer can't be flushed while spans are pending, "
+                "increase MaxBufferSize, in call to variable " +
+                variable.m_Name + " Put\n");
+        }
+
         DoFlush(false);
         m_BP4Serializer.ResetBuffer(m_BP4Serializer.m_Data);
 
@@ -48,12 +62,18 @@ void BP4Writer::PutSyncCommon(Variable<T> &variable,
         m_BP4Serializer.PutProcessGroupIndex(
             m_IO.m_Name, m_IO.m_HostLanguage,
             m_FileDataManager.GetTransportsTypes());
+
+        m_BP4Serializer.ResizeBuffer(dataSize, "in call to variable " +
+                                                   variable.m_Name + " Put");
     }
 
     // WRITE INDEX to data buffer and metadata structure (in memory)//
     const bool sourceRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
     m_BP4Serializer.PutVariableMetadata(variable, blockInfo, sourceRowMajor);
     m_BP4Serializer.PutVariablePayload(variable, blockInfo, sourceRowMajor);
+
+    m_BP4Serializer.m_Tracer.Record(profiling::TraceEvent::Serialize,
+                                    traceStart, dataSize);
 }
 
 template <class T>
@@ -74,6 +94,55 @@ void BP4Writer::PutDeferredCommon(Variable<T> &variable, const T *data)
                                                  blockInfo.Count));
 }
 
+template <class T>
+void BP4Writer::PutSpanCommon(Variable<T> &variable,
+                              typename Variable<T>::Span &span, const T &value)
+{
+    if (!variable.m_Operations.empty() || variable.m_SingleValue)
+    {
+        throw std::invalid_argument(
+            "ERROR: variable " + variable.m_Name +
+            " with operations or single value can't be put with a span, "
+            "in call to Put\n");
+    }
+
+    if (!m_BP4Serializer.m_MetadataSet.DataPGIsOpen)
+    {
+        m_BP4Serializer.PutProcessGroupIndex(
+            m_IO.m_Name, m_IO.m_HostLanguage,
+            m_FileDataManager.GetTransportsTypes());
+    }
+
+    const size_t dataSize =
+        span.Size() * sizeof(T) +
+        m_BP4Serializer.GetBPIndexSizeInData(variable.m_Name, variable.m_Count);
+
+    const format::BP4Base::ResizeResult resizeResult =
+        m_BP4Serializer.ResizeBuffer(dataSize, "in call to variable " +
+                                                   variable.m_Name + " Put");
+
+    if (resizeResult == format::BP4Base::ResizeResult::Flush)
+    {
+        throw std::runtime_error(
+            "ERROR: span of variable " + variable.m_Name +
+            " doesn't fit in MaxBufferSize and spans can't be flushed before "
+            "EndStep, in call to Put\n");
+    }
+
+    // value stands for the data until the payload is filled
+    typename Variable<T>::Info blockInfo =
+        variable.SetBlockInfo(&value, CurrentStep());
+    variable.m_BlocksInfo.pop_back();
+    // the payload is reserved packed
+    blockInfo.MemoryStart.clear();
+    blockInfo.MemoryCount.clear();
+
+    const bool sourceRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
+    m_BP4Serializer.PutVariableMetadata(variable, blockInfo, sourceRowMajor);
+    m_BP4Serializer.PutSpanPayload(variable, span, value);
+    m_SpanVariables.insert(variable.m_Name);
+}
+
 } // end namespace engine
 } // end namespace core
 } // end namespace adios2
@@ -31,6 +31,7 @@ DataManCommon::DataManCommon(const std::string engineType, IO &io,
     m_IsRowMajor = helper::IsRowMajor(io.m_HostLanguage);
     GetStringParameter(m_IO.m_Parameters, "WorkflowMode", m_WorkflowMode);
     GetStringParameter(m_IO.m_Parameters, "Format", m_Format);
+    GetStringParameter(m_IO.m_Parameters, "MetadataFormat", m_MetadataFormat);
     m_TransportChannels = m_IO.m_TransportsParameters.size();
     if (m_TransportChannels == 0)
     {
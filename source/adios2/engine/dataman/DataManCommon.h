@@ -39,6 +39,7 @@ protected:
     int m_TransportChannels;
     std::string m_Format = "dataman";
     std::string m_WorkflowMode = "p2p";
+    std::string m_MetadataFormat = "string";
     size_t m_BufferSize = 1024 * 1024 * 1024;
     bool m_DoMonitor = false;
     int64_t m_CurrentStep = -1;
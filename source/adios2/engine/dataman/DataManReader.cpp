@@ -25,7 +25,8 @@ namespace engine
 DataManReader::DataManReader(IO &io, const std::string &name, const Mode mode,
                              MPI_Comm mpiComm)
 : DataManCommon("DataManReader", io, name, mode, mpiComm),
-  m_DataManSerializer(m_IsRowMajor, m_ContiguousMajor, m_IsLittleEndian)
+  m_DataManSerializer(m_IsRowMajor, m_ContiguousMajor, m_IsLittleEndian,
+                      m_MetadataFormat)
 {
     m_EndMessage = " in call to IO Open DataManReader " + m_Name + "\n";
     Init();
@@ -171,13 +172,16 @@ void DataManReader::IOThread(std::shared_ptr<transportman::WANMan> man)
 {
     while (m_Listening)
     {
-        std::shared_ptr<std::vector<char>> buffer = man->Read(0);
-        if (buffer != nullptr)
+        for (int i = 0; i < m_TransportChannels; ++i)
         {
-            int ret = m_DataManSerializer.PutPack(buffer);
-            if (ret > 0)
+            std::shared_ptr<std::vector<char>> buffer = man->Read(i);
+            if (buffer != nullptr)
             {
-                m_FinalStep = ret;
+                int ret = m_DataManSerializer.PutPack(buffer);
+                if (ret > 0)
+                {
+                    m_FinalStep = ret;
+                }
             }
         }
     }
@@ -38,7 +38,15 @@ StepStatus DataManWriter::BeginStep(StepMode mode, const float timeout_sec)
     {
         for (size_t i = 0; i < m_TransportChannels; ++i)
         {
-            m_DataManSerializer[i]->New(m_BufferSize);
+            if (m_WANMan == nullptr)
+            {
+                m_DataManSerializer[i]->New(m_BufferSize);
+            }
+            else
+            {
+                m_DataManSerializer[i]->New(
+                    m_WANMan->AcquireBuffer(m_BufferSize));
+            }
         }
     }
     else if (m_Format == "binary")
@@ -77,7 +85,9 @@ void DataManWriter::EndStep()
             }
             const std::shared_ptr<std::vector<char>> buf =
                 m_DataManSerializer[i]->GetLocalPack();
-            m_BufferSize = buf->size() * 2;
+            // recycled buffers keep their capacity, so the next step only
+            // needs the size of this one
+            m_BufferSize = buf->size();
             m_WANMan->Write(buf, i);
         }
     }
@@ -116,7 +126,8 @@ void DataManWriter::Init()
         {
             m_DataManSerializer.push_back(
                 std::make_shared<format::DataManSerializer>(
-                    m_IsRowMajor, m_ContiguousMajor, m_IsLittleEndian));
+                    m_IsRowMajor, m_ContiguousMajor, m_IsLittleEndian,
+                    m_MetadataFormat));
         }
     }
     else if (m_Format == "binary")
@@ -10,6 +10,7 @@
 
 #include "adios2/helper/adiosFunctions.h"
 #include "adios2/toolkit/format/bp3/BP3.h"
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -389,6 +390,8 @@ void SstReader::PerformGets()
             return;
         }
 
+        // queue the reads of all deferred variables so that they can be
+        // merged per writer rank
         for (const std::string &name : m_BP3Deserializer->m_DeferredVariables)
         {
             const std::string type = m_IO.InquireVariableType(name);
@@ -405,13 +408,36 @@ void SstReader::PerformGets()
         {                                                                      \
             m_BP3Deserializer->SetVariableBlockInfo(variable, blockInfo);      \
         }                                                                      \
-        ReadVariableBlocks(variable);                                          \
+        QueueVariableBlocks(variable);                                         \
+    }
+            ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+        }
+
+        PerformReadRequests();
+
+        size_t bufferIndex = 0;
+        for (const std::string &name : m_BP3Deserializer->m_DeferredVariables)
+        {
+            const std::string type = m_IO.InquireVariableType(name);
+
+            if (type == "compound")
+            {
+            }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetType<T>())                                     \
+    {                                                                          \
+        Variable<T> &variable =                                                \
+            FindVariable<T>(name, "in call to PerformGets, EndStep or Close"); \
+        ClipVariableBlocks(variable, bufferIndex);                             \
         variable.m_BlocksInfo.clear();                                         \
     }
             ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
         }
 
+        m_ReadRequests.clear();
+        m_ReadBuffers.clear();
         m_BP3Deserializer->m_DeferredVariables.clear();
     }
     else
@@ -420,6 +446,94 @@ void SstReader::PerformGets()
     }
 }
 
+void SstReader::PerformReadRequests()
+{
+    std::sort(m_ReadRequests.begin(), m_ReadRequests.end(),
+              [](const ReadRequest &a, const ReadRequest &b) {
+                  return a.Rank < b.Rank ||
+                         (a.Rank == b.Rank && a.Offset < b.Offset);
+              });
+
+    // one read covering m_ReadRequests[First, Last), Buffer is empty when
+    // a single request is read straight into its destination
+    struct MergedRead
+    {
+        size_t First;
+        size_t Last;
+        size_t Offset;
+        std::vector<char> Buffer;
+        void *Handle;
+    };
+    std::vector<MergedRead> reads;
+
+    const size_t gap = static_cast<size_t>(std::max(m_ReadCoalesceGap, 0));
+    size_t first = 0;
+    while (first < m_ReadRequests.size())
+    {
+        const size_t rank = m_ReadRequests[first].Rank;
+        const size_t offset = m_ReadRequests[first].Offset;
+        size_t end = offset + m_ReadRequests[first].Length;
+        size_t last = first + 1;
+        while (last < m_ReadRequests.size() &&
+               m_ReadRequests[last].Rank == rank &&
+               m_ReadRequests[last].Offset <= end + gap)
+        {
+            end = std::max(end, m_ReadRequests[last].Offset +
+                                    m_ReadRequests[last].Length);
+            ++last;
+        }
+
+        void *dp_info = NULL;
+        if (m_CurrentStepMetaData->DP_TimestepInfo)
+        {
+            dp_info = m_CurrentStepMetaData->DP_TimestepInfo[rank];
+        }
+
+        reads.push_back({first, last, offset, std::vector<char>(), nullptr});
+        MergedRead &read = reads.back();
+        char *destination = m_ReadRequests[first].Destination;
+        if (last - first > 1)
+        {
+            read.Buffer.resize(end - offset);
+            destination = read.Buffer.data();
+        }
+        read.Handle =
+            SstReadRemoteMemory(m_Input, static_cast<int>(rank), CurrentStep(),
+                                offset, end - offset, destination, dp_info);
+        first = last;
+    }
+
+    // wait for all SstRead requests to finish
+    bool failed = false;
+    for (const MergedRead &read : reads)
+    {
+        if (SstWaitForCompletion(m_Input, read.Handle) != SstSuccess)
+        {
+            failed = true;
+        }
+    }
+    if (failed)
+    {
+        throw std::runtime_error("ERROR: Writer failed before returning data, "
+                                 "in call to PerformGets\n");
+    }
+
+    for (const MergedRead &read : reads)
+    {
+        if (read.Buffer.empty())
+        {
+            continue;
+        }
+        for (size_t i = read.First; i < read.Last; ++i)
+        {
+            const ReadRequest &request = m_ReadRequests[i];
+            std::memcpy(request.Destination,
+                        read.Buffer.data() + request.Offset - read.Offset,
+                        request.Length);
+        }
+    }
+}
+
 void SstReader::DoClose(const int transportIndex) { SstReaderClose(m_Input); }
 
 #define declare_type(T)                                                        \
@@ -52,8 +52,35 @@ public:
     void Flush(const int transportIndex = -1) final;
 
 private:
+    /** one read of a range of a writer rank's data block */
+    struct ReadRequest
+    {
+        size_t Rank;
+        size_t Offset;
+        size_t Length;
+        char *Destination;
+    };
+
+    /**
+     * Queues the reads for the deferred blocks of variable into
+     * m_ReadRequests, staging non-contiguous selections in m_ReadBuffers
+     */
+    template <class T>
+    void QueueVariableBlocks(Variable<T> &variable);
+
+    /**
+     * Clips the staged non-contiguous selections of variable into place,
+     * in the order QueueVariableBlocks staged them
+     */
     template <class T>
-    void ReadVariableBlocks(Variable<T> &variable);
+    void ClipVariableBlocks(Variable<T> &variable, size_t &bufferIndex);
+
+    /**
+     * Sorts m_ReadRequests by writer rank and offset, merges requests
+     * closer than ReadCoalesceGap bytes into one read, issues all reads and
+     * waits for them
+     */
+    void PerformReadRequests();
 
     template <class T>
     void SstBPPerformGets();
@@ -64,6 +91,8 @@ private:
     /* --- Used only with BP marshaling --- */
     SstFullMetadata m_CurrentStepMetaData = NULL;
     format::BP3Deserializer *m_BP3Deserializer;
+    std::vector<ReadRequest> m_ReadRequests;
+    std::vector<std::vector<char>> m_ReadBuffers;
     /* --- Used only with BP marshaling --- */
 
     struct _SstParams Params;
@@ -24,11 +24,8 @@ namespace engine
 {
 
 template <class T>
-void SstReader::ReadVariableBlocks(Variable<T> &variable)
+void SstReader::QueueVariableBlocks(Variable<T> &variable)
 {
-    std::vector<void *> sstReadHandlers;
-    std::vector<std::vector<char>> buffers;
-
     for (typename Variable<T>::Info &blockInfo : variable.m_BlocksInfo)
     {
         T *originalBlockData = blockInfo.Data;
@@ -39,15 +36,17 @@ void SstReader::ReadVariableBlocks(Variable<T> &variable)
             for (const helper::SubStreamBoxInfo &subStreamInfo : subStreamsInfo)
             {
                 const size_t rank = subStreamInfo.SubStreamID;
-                void *dp_info = NULL;
-                if (m_CurrentStepMetaData->DP_TimestepInfo)
-                {
-                    dp_info = m_CurrentStepMetaData->DP_TimestepInfo[rank];
-                }
                 // if remote data buffer is compressed
                 if (subStreamInfo.OperationsInfo.size() > 0)
                 {
+                    // decompression goes through the deserializer's thread
+                    // buffers, so compressed blocks are read one at a time
                     // TODO test with compression
+                    void *dp_info = NULL;
+                    if (m_CurrentStepMetaData->DP_TimestepInfo)
+                    {
+                        dp_info = m_CurrentStepMetaData->DP_TimestepInfo[rank];
+                    }
                     char *buffer = nullptr;
                     size_t payloadSize = 0, payloadStart = 0;
 
@@ -58,7 +57,16 @@ void SstReader::ReadVariableBlocks(Variable<T> &variable)
                     auto ret = SstReadRemoteMemory(m_Input, rank, CurrentStep(),
                                                    payloadStart, payloadSize,
                                                    buffer, dp_info);
-                    sstReadHandlers.push_back(ret);
+                    if (SstWaitForCompletion(m_Input, ret) != SstSuccess)
+                    {
+                        throw std::runtime_error(
+                            "ERROR: Writer failed before returning data of "
+                            "variable " +
+                            variable.m_Name + ", in call to PerformGets\n");
+                    }
+                    m_BP3Deserializer->PostDataRead(
+                        variable, blockInfo, subStreamInfo,
+                        helper::IsRowMajor(m_IO.m_HostLanguage), 0);
                 }
                 // if remote data buffer is not compressed
                 else
@@ -68,7 +76,7 @@ void SstReader::ReadVariableBlocks(Variable<T> &variable)
                     const size_t writerBlockSize = seeks.second - seeks.first;
                     size_t elementOffset, dummy;
                     // if both input and output are contiguous memory then
-                    // directly issue SstRead and put data in place
+                    // read straight into place
                     if (helper::IsIntersectionContiguousSubarray(
                             subStreamInfo.BlockBox,
                             subStreamInfo.IntersectionBox,
@@ -80,23 +88,20 @@ void SstReader::ReadVariableBlocks(Variable<T> &variable)
                             subStreamInfo.IntersectionBox,
                             m_BP3Deserializer->m_IsRowMajor, elementOffset))
                     {
-                        auto ret = SstReadRemoteMemory(
-                            m_Input, rank, CurrentStep(), writerBlockStart,
-                            writerBlockSize, blockInfo.Data + elementOffset,
-                            dp_info);
-                        sstReadHandlers.push_back(ret);
+                        m_ReadRequests.push_back(
+                            {rank, writerBlockStart, writerBlockSize,
+                             reinterpret_cast<char *>(blockInfo.Data +
+                                                      elementOffset)});
                     }
                     // if either input or output is not contiguous memory then
-                    // find all contiguous parts.
+                    // read the writer block and clip it after all reads
+                    // completed
                     else
                     {
-                        // batch all read requests
-                        buffers.emplace_back();
-                        buffers.back().resize(writerBlockSize);
-                        auto ret = SstReadRemoteMemory(
-                            m_Input, rank, CurrentStep(), writerBlockStart,
-                            writerBlockSize, buffers.back().data(), dp_info);
-                        sstReadHandlers.push_back(ret);
+                        m_ReadBuffers.emplace_back(writerBlockSize);
+                        m_ReadRequests.push_back({rank, writerBlockStart,
+                                                  writerBlockSize,
+                                                  m_ReadBuffers.back().data()});
                     }
                 }
             }
@@ -106,15 +111,11 @@ void SstReader::ReadVariableBlocks(Variable<T> &variable)
         // move back to original position
         blockInfo.Data = originalBlockData;
     }
+}
 
-    // wait for all SstRead requests to finish
-    for (const auto &i : sstReadHandlers)
-    {
-        SstWaitForCompletion(m_Input, i);
-    }
-
-    size_t iter = 0;
-
+template <class T>
+void SstReader::ClipVariableBlocks(Variable<T> &variable, size_t &bufferIndex)
+{
     for (typename Variable<T>::Info &blockInfo : variable.m_BlocksInfo)
     {
         T *originalBlockData = blockInfo.Data;
@@ -124,59 +125,27 @@ void SstReader::ReadVariableBlocks(Variable<T> &variable)
                 stepPair.second;
             for (const helper::SubStreamBoxInfo &subStreamInfo : subStreamsInfo)
             {
-                // if remote data buffer is compressed
+                // compressed blocks were already placed by QueueVariableBlocks
                 if (subStreamInfo.OperationsInfo.size() > 0)
                 {
-                    // const bool identity =
-                    //    m_BP3Deserializer->IdentityOperation<T>(
-                    //        blockInfo.Operations);
-                    // const helper::BlockOperationInfo
-                    //    &blockOperationInfo =
-                    //        m_BP3Deserializer->InitPostOperatorBlockData(
-                    //            subStreamInfo.OperationsInfo,
-                    //            variable.m_RawMemory[1],
-                    //            identity);
-                    // m_BP3Deserializer->GetPreOperatorBlockData(
-                    //    buffers[iter], blockOperationInfo,
-                    //    variable.m_RawMemory[0]);
-                    // helper::ClipVector(variable.m_RawMemory[0],
-                    //    subStreamInfo.Seeks.first,
-                    //    subStreamInfo.Seeks.second);
-                    // m_BP3Deserializer->ClipContiguousMemory<T>(
-                    //    blockInfo,
-                    //    variable.m_RawMemory[0],
-                    //    subStreamInfo.BlockBox,
-                    //    subStreamInfo.IntersectionBox);
-
-                    m_BP3Deserializer->PostDataRead(
-                        variable, blockInfo, subStreamInfo,
-                        helper::IsRowMajor(m_IO.m_HostLanguage), 0);
-                    ++iter;
+                    continue;
                 }
-                // if remote data buffer is not compressed
-                else
+
+                size_t dummy;
+                if (helper::IsIntersectionContiguousSubarray(
+                        subStreamInfo.BlockBox, subStreamInfo.IntersectionBox,
+                        m_BP3Deserializer->m_IsRowMajor, dummy) == false ||
+                    helper::IsIntersectionContiguousSubarray(
+                        helper::StartEndBox(
+                            blockInfo.Start, blockInfo.Count,
+                            m_BP3Deserializer->m_ReverseDimensions),
+                        subStreamInfo.IntersectionBox,
+                        m_BP3Deserializer->m_IsRowMajor, dummy) == false)
                 {
-                    size_t dummy;
-                    // if both input and output are contiguous memory then
-                    // directly issue SstRead and put data in place
-                    if (helper::IsIntersectionContiguousSubarray(
-                            subStreamInfo.BlockBox,
-                            subStreamInfo.IntersectionBox,
-                            m_BP3Deserializer->m_IsRowMajor, dummy) == false ||
-                        helper::IsIntersectionContiguousSubarray(
-                            helper::StartEndBox(
-                                blockInfo.Start, blockInfo.Count,
-                                m_BP3Deserializer->m_ReverseDimensions),
-                            subStreamInfo.IntersectionBox,
-                            m_BP3Deserializer->m_IsRowMajor, dummy) == false)
-                    {
-                        size_t blockID = 0;
-                        m_BP3Deserializer->ClipContiguousMemory<T>(
-                            variable.m_BlocksInfo.at(blockID), buffers[iter],
-                            subStreamInfo.BlockBox,
-                            subStreamInfo.IntersectionBox);
-                        ++iter;
-                    }
+                    m_BP3Deserializer->ClipContiguousMemory<T>(
+                        blockInfo, m_ReadBuffers[bufferIndex],
+                        subStreamInfo.BlockBox, subStreamInfo.IntersectionBox);
+                    ++bufferIndex;
                 }
             }
             // advance pointer to next step
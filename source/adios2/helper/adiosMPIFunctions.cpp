@@ -10,6 +10,10 @@
 #include "adiosMPIFunctions.h"
 #include "adiosMPIFunctions.tcc"
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <cstring> //std::memcpy
+/// \endcond
+
 #include "adios2/ADIOSMPI.h"
 #include "adios2/ADIOSTypes.h"
 
@@ -57,6 +61,91 @@ void CheckMPIReturn(const int value, const std::string hint)
     throw std::runtime_error("ERROR: ADIOS2 detected " + error + ", " + hint);
 }
 
+void BroadcastVectorNodeShared(std::vector<char> &vector, MPI_Comm mpiComm)
+{
+#if defined(ADIOS2_HAVE_MPI) && MPI_VERSION >= 3
+    int size;
+    MPI_Comm_size(mpiComm, &size);
+
+    if (size == 1)
+    {
+        return;
+    }
+
+    int rank;
+    MPI_Comm_rank(mpiComm, &rank);
+
+    // ordered by rank, so rank 0 leads its node and the leaders
+    MPI_Comm nodeComm;
+    CheckMPIReturn(MPI_Comm_split_type(mpiComm, MPI_COMM_TYPE_SHARED, rank,
+                                       MPI_INFO_NULL, &nodeComm),
+                   "in call to MPI_Comm_split_type\n");
+
+    int nodeRank, nodeSize;
+    MPI_Comm_rank(nodeComm, &nodeRank);
+    MPI_Comm_size(nodeComm, &nodeSize);
+
+    MPI_Comm leadersComm;
+    CheckMPIReturn(MPI_Comm_split(mpiComm, (nodeRank == 0) ? 0 : MPI_UNDEFINED,
+                                  rank, &leadersComm),
+                   "in call to MPI_Comm_split\n");
+
+    if (leadersComm != MPI_COMM_NULL)
+    {
+        BroadcastVector(vector, leadersComm);
+        MPI_Comm_free(&leadersComm);
+    }
+
+    const size_t vectorSize = BroadcastValue(vector.size(), nodeComm);
+
+    if (nodeSize == 1 || vectorSize == 0)
+    {
+        if (nodeRank != 0)
+        {
+            vector.clear();
+        }
+        MPI_Comm_free(&nodeComm);
+        return;
+    }
+
+    char *shared = nullptr;
+    MPI_Win window;
+    CheckMPIReturn(
+        MPI_Win_allocate_shared(
+            static_cast<MPI_Aint>((nodeRank == 0) ? vectorSize : 0), 1,
+            MPI_INFO_NULL, nodeComm, &shared, &window),
+        "in call to MPI_Win_allocate_shared\n");
+
+    if (nodeRank != 0)
+    {
+        MPI_Aint sharedSize;
+        int displacementUnit;
+        MPI_Win_shared_query(window, 0, &sharedSize, &displacementUnit,
+                             &shared);
+    }
+
+    MPI_Win_fence(0, window);
+    if (nodeRank == 0)
+    {
+        std::memcpy(shared, vector.data(), vectorSize);
+    }
+    MPI_Win_fence(0, window);
+
+    if (nodeRank != 0)
+    {
+        vector.resize(vectorSize);
+        std::memcpy(vector.data(), shared, vectorSize);
+    }
+
+    // leader memory must outlive all copies
+    MPI_Barrier(nodeComm);
+    MPI_Win_free(&window);
+    MPI_Comm_free(&nodeComm);
+#else
+    BroadcastVector(vector, mpiComm);
+#endif
+}
+
 std::string BroadcastFile(const std::string &fileName, MPI_Comm mpiComm,
                           const std::string hint, const int rankSource)
 {
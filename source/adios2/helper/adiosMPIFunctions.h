@@ -30,6 +30,16 @@ template <class T>
 void BroadcastVector(std::vector<T> &vector, MPI_Comm mpiComm,
                      const int rankSource = 0);
 
+/**
+ * Broadcasts a char vector from rank 0 in two levels: first between one
+ * leader rank per shared memory node, then inside each node by copying out of
+ * an MPI-3 shared memory window filled once by the leader. Falls back to
+ * BroadcastVector without MPI-3.
+ * @param vector input in rank 0, output in all other ranks
+ * @param mpiComm communicator establishing the domain
+ */
+void BroadcastVectorNodeShared(std::vector<char> &vector, MPI_Comm mpiComm);
+
 template <class T>
 T ReduceValues(const T source, MPI_Comm mpiComm, MPI_Op operation = MPI_SUM,
                const int rankDestination = 0);
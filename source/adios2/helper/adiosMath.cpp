@@ -13,7 +13,6 @@
 #include <algorithm> //std::transform, std::reverse
 #include <cmath>
 #include <functional> //std::minus<T>
-#include <iterator>   //std::back_inserter
 #include <numeric>    //std::accumulate
 #include <utility>    //std::pair
 
@@ -62,17 +61,17 @@ size_t NextExponentialSize(const size_t requiredSize, const size_t currentSize,
     return nextExponentialSize;
 }
 
-Box<Dims> StartEndBox(const Dims &start, const Dims &count,
-                      const bool reverse) noexcept
+Box<SmallDims> StartEndBox(const SmallDims &start, const SmallDims &count,
+                           const bool reverse) noexcept
 {
-    Box<Dims> box;
+    Box<SmallDims> box;
     box.first = start;
     const size_t size = start.size();
-    box.second.reserve(size);
+    box.second.resize(size);
 
     for (size_t d = 0; d < size; ++d)
     {
-        box.second.push_back(start[d] + count[d] - 1); // end inclusive
+        box.second[d] = start[d] + count[d] - 1; // end inclusive
     }
 
     if (reverse)
@@ -84,24 +83,26 @@ Box<Dims> StartEndBox(const Dims &start, const Dims &count,
     return box;
 }
 
-Box<Dims> StartCountBox(const Dims &start, const Dims &end) noexcept
+Box<SmallDims> StartCountBox(const SmallDims &start,
+                             const SmallDims &end) noexcept
 {
-    Box<Dims> box;
+    Box<SmallDims> box;
     box.first = start;
     const size_t size = start.size();
-    box.second.reserve(size);
+    box.second.resize(size);
 
     for (size_t d = 0; d < size; ++d)
     {
-        box.second.push_back(end[d] - start[d] + 1); // end inclusive
+        box.second[d] = end[d] - start[d] + 1; // end inclusive
     }
 
     return box;
 }
 
-Box<Dims> IntersectionBox(const Box<Dims> &box1, const Box<Dims> &box2) noexcept
+Box<SmallDims> IntersectionBox(const Box<SmallDims> &box1,
+                               const Box<SmallDims> &box2) noexcept
 {
-    Box<Dims> intersectionBox;
+    Box<SmallDims> intersectionBox;
     const size_t dimensionsSize = box1.first.size();
 
     for (size_t d = 0; d < dimensionsSize; ++d)
@@ -114,40 +115,31 @@ Box<Dims> IntersectionBox(const Box<Dims> &box1, const Box<Dims> &box2) noexcept
     }
 
     // get the intersection box
-    intersectionBox.first.reserve(dimensionsSize);
-    intersectionBox.second.reserve(dimensionsSize);
+    intersectionBox.first.resize(dimensionsSize);
+    intersectionBox.second.resize(dimensionsSize);
 
     for (size_t d = 0; d < dimensionsSize; ++d)
     {
         // start
-        if (box1.first[d] < box2.first[d])
-        {
-            intersectionBox.first.push_back(box2.first[d]);
-        }
-        else
-        {
-            intersectionBox.first.push_back(box1.first[d]);
-        }
+        intersectionBox.first[d] = box1.first[d] < box2.first[d]
+                                       ? box2.first[d]
+                                       : box1.first[d];
 
         // end, must be inclusive
-        if (box1.second[d] > box2.second[d])
-        {
-            intersectionBox.second.push_back(box2.second[d]);
-        }
-        else
-        {
-            intersectionBox.second.push_back(box1.second[d]);
-        }
+        intersectionBox.second[d] = box1.second[d] > box2.second[d]
+                                        ? box2.second[d]
+                                        : box1.second[d];
     }
 
     return intersectionBox;
 }
 
-Box<Dims> IntersectionStartCount(const Dims &start1, const Dims &count1,
-                                 const Dims &start2,
-                                 const Dims &count2) noexcept
+Box<SmallDims> IntersectionStartCount(const SmallDims &start1,
+                                      const SmallDims &count1,
+                                      const SmallDims &start2,
+                                      const SmallDims &count2) noexcept
 {
-    Box<Dims> intersectionStartCount;
+    Box<SmallDims> intersectionStartCount;
     const size_t dimensionsSize = start1.size();
 
     for (auto d = 0; d < dimensionsSize; ++d)
@@ -162,8 +154,8 @@ Box<Dims> IntersectionStartCount(const Dims &start1, const Dims &count1,
         }
     }
 
-    intersectionStartCount.first.reserve(dimensionsSize);
-    intersectionStartCount.second.reserve(dimensionsSize);
+    intersectionStartCount.first.resize(dimensionsSize);
+    intersectionStartCount.second.resize(dimensionsSize);
 
     for (auto d = 0; d < dimensionsSize; ++d)
     {
@@ -175,15 +167,16 @@ Box<Dims> IntersectionStartCount(const Dims &start1, const Dims &count1,
         const size_t end2 = start2[d] + count2[d] - 1;
         const size_t intersectionEnd = (end1 > end2) ? end2 : end1;
 
-        intersectionStartCount.first.push_back(intersectionStart);
-        intersectionStartCount.second.push_back(intersectionEnd -
-                                                intersectionStart + 1);
+        intersectionStartCount.first[d] = intersectionStart;
+        intersectionStartCount.second[d] =
+            intersectionEnd - intersectionStart + 1;
     }
 
     return intersectionStartCount;
 }
 
-bool IdenticalBoxes(const Box<Dims> &box1, const Box<Dims> &box2) noexcept
+bool IdenticalBoxes(const Box<SmallDims> &box1,
+                    const Box<SmallDims> &box2) noexcept
 {
     const size_t dimensionsSize = box1.first.size();
     for (size_t d = 0; d < dimensionsSize; ++d)
@@ -196,8 +189,8 @@ bool IdenticalBoxes(const Box<Dims> &box1, const Box<Dims> &box2) noexcept
     return true;
 }
 
-bool IsIntersectionContiguousSubarray(const Box<Dims> &blockBox,
-                                      const Box<Dims> &intersectionBox,
+bool IsIntersectionContiguousSubarray(const Box<SmallDims> &blockBox,
+                                      const Box<SmallDims> &intersectionBox,
                                       const bool isRowMajor,
                                       size_t &startOffset) noexcept
 {
@@ -240,11 +233,11 @@ bool IsIntersectionContiguousSubarray(const Box<Dims> &blockBox,
     return true;
 }
 
-size_t LinearIndex(const Dims &start, const Dims &count, const Dims &point,
-                   const bool isRowMajor) noexcept
+size_t LinearIndex(const SmallDims &start, const SmallDims &count,
+                   const SmallDims &point, const bool isRowMajor) noexcept
 {
-    auto lf_RowMajor = [](const Dims &count,
-                          const Dims &normalizedPoint) -> size_t {
+    auto lf_RowMajor = [](const SmallDims &count,
+                          const SmallDims &normalizedPoint) -> size_t {
 
         const size_t countSize = count.size();
         size_t linearIndex = normalizedPoint[countSize - 1]; // fastest
@@ -258,8 +251,8 @@ size_t LinearIndex(const Dims &start, const Dims &count, const Dims &point,
         return linearIndex;
     };
 
-    auto lf_ColumnMajor = [](const Dims &count,
-                             const Dims &normalizedPoint) -> size_t {
+    auto lf_ColumnMajor = [](const SmallDims &count,
+                             const SmallDims &normalizedPoint) -> size_t {
 
         const size_t countSize = count.size();
         size_t linearIndex = normalizedPoint[0]; // fastest
@@ -279,10 +272,9 @@ size_t LinearIndex(const Dims &start, const Dims &count, const Dims &point,
     }
 
     // normalize the point
-    Dims normalizedPoint;
-    normalizedPoint.reserve(point.size());
+    SmallDims normalizedPoint(point.size());
     std::transform(point.begin(), point.end(), start.begin(),
-                   std::back_inserter(normalizedPoint), std::minus<size_t>());
+                   normalizedPoint.begin(), std::minus<size_t>());
 
     size_t linearIndex = MaxSizeT - 1;
 
@@ -298,14 +290,14 @@ size_t LinearIndex(const Dims &start, const Dims &count, const Dims &point,
     return linearIndex;
 }
 
-size_t LinearIndex(const Box<Dims> &startEndBox, const Dims &point,
+size_t LinearIndex(const Box<SmallDims> &startEndBox, const SmallDims &point,
                    const bool isRowMajor) noexcept
 {
-    const Box<Dims> localBoxStartCount =
+    const Box<SmallDims> localBoxStartCount =
         StartCountBox(startEndBox.first, startEndBox.second);
 
-    const Dims &start = localBoxStartCount.first;
-    const Dims &count = localBoxStartCount.second;
+    const SmallDims &start = localBoxStartCount.first;
+    const SmallDims &count = localBoxStartCount.second;
 
     return LinearIndex(start, count, point, isRowMajor);
 }
@@ -16,6 +16,7 @@
 /// \endcond
 
 #include "adios2/ADIOSTypes.h"
+#include "adios2/helper/adiosSmallDims.h"
 
 namespace adios2
 {
@@ -123,10 +124,11 @@ size_t NextExponentialSize(const size_t requiredSize, const size_t currentSize,
  * Row-Major interoperability
  * @return [start, end[ box
  */
-Box<Dims> StartEndBox(const Dims &start, const Dims &count,
-                      const bool reverse = false) noexcept;
+Box<SmallDims> StartEndBox(const SmallDims &start, const SmallDims &count,
+                           const bool reverse = false) noexcept;
 
-Box<Dims> StartCountBox(const Dims &start, const Dims &end) noexcept;
+Box<SmallDims> StartCountBox(const SmallDims &start,
+                             const SmallDims &end) noexcept;
 
 /**
  * Returns the intersection box { start, end } where end is inclusive from box1
@@ -135,12 +137,13 @@ Box<Dims> StartCountBox(const Dims &start, const Dims &end) noexcept;
  * @param box2 {start, end} input (end is exclusive)
  * @return empty if not interception, otherwise intersection box
  */
-Box<Dims> IntersectionBox(const Box<Dims> &box1,
-                          const Box<Dims> &box2) noexcept;
+Box<SmallDims> IntersectionBox(const Box<SmallDims> &box1,
+                               const Box<SmallDims> &box2) noexcept;
 
-Box<Dims> IntersectionStartCount(const Dims &start1, const Dims &count1,
-                                 const Dims &start2,
-                                 const Dims &count2) noexcept;
+Box<SmallDims> IntersectionStartCount(const SmallDims &start1,
+                                      const SmallDims &count1,
+                                      const SmallDims &start2,
+                                      const SmallDims &count2) noexcept;
 
 /**
  * Returns true if the two boxes are identical
@@ -148,7 +151,8 @@ Box<Dims> IntersectionStartCount(const Dims &start1, const Dims &count1,
  * @param box2 {start, end} input
  * @return true if not boxes are identical, false otherwise
  */
-bool IdenticalBoxes(const Box<Dims> &box1, const Box<Dims> &box2) noexcept;
+bool IdenticalBoxes(const Box<SmallDims> &box1,
+                    const Box<SmallDims> &box2) noexcept;
 
 /**
  * Returns true if the intersection box is a contiguous subarray
@@ -162,8 +166,8 @@ bool IdenticalBoxes(const Box<Dims> &box1, const Box<Dims> &box2) noexcept;
  * @return true if intersection box is a contiguous subarray
  * of the block box, false otherwise
  */
-bool IsIntersectionContiguousSubarray(const Box<Dims> &blockBox,
-                                      const Box<Dims> &intersectionBox,
+bool IsIntersectionContiguousSubarray(const Box<SmallDims> &blockBox,
+                                      const Box<SmallDims> &intersectionBox,
                                       const bool isRowMajor,
                                       size_t &startOffset) noexcept;
 
@@ -176,8 +180,8 @@ bool IsIntersectionContiguousSubarray(const Box<Dims> &blockBox,
  * @param isRowMajor
  * @return
  */
-size_t LinearIndex(const Dims &start, const Dims &count, const Dims &point,
-                   const bool isRowMajor) noexcept;
+size_t LinearIndex(const SmallDims &start, const SmallDims &count,
+                   const SmallDims &point, const bool isRowMajor) noexcept;
 
 /**
  * Get a linear index for a point inside a localBox depending on data layout
@@ -187,7 +191,7 @@ size_t LinearIndex(const Dims &start, const Dims &count, const Dims &point,
  * @param isZeroIndex
  * @return linear index for contiguous memory
  */
-size_t LinearIndex(const Box<Dims> &startEndBox, const Dims &point,
+size_t LinearIndex(const Box<SmallDims> &startEndBox, const SmallDims &point,
                    const bool isRowMajor) noexcept;
 
 /**
@@ -40,15 +40,16 @@ void GetMinMaxSelection(const T *values, const Dims &shape, const Dims &start,
         const size_t stride = count.back();
         const size_t startCoord = dimensions - 2;
 
-        Dims currentPoint(start); // current point for contiguous memory
+        SmallDims currentPoint(start); // current point for contiguous memory
+        const SmallDims origin(shape.size(), 0);
         bool run = true;
         bool firstStep = true;
 
         while (run)
         {
             // here copy current linear memory between currentPoint and end
-            const size_t startOffset = helper::LinearIndex(
-                Dims(shape.size(), 0), shape, currentPoint, true);
+            const size_t startOffset =
+                helper::LinearIndex(origin, shape, currentPoint, true);
 
             T minStride, maxStride;
             GetMinMax(values + startOffset, stride, minStride, maxStride);
@@ -106,15 +107,16 @@ void GetMinMaxSelection(const T *values, const Dims &shape, const Dims &start,
         const size_t stride = count.front();
         const size_t startCoord = 1;
 
-        Dims currentPoint(start); // current point for contiguous memory
+        SmallDims currentPoint(start); // current point for contiguous memory
+        const SmallDims origin(shape.size(), 0);
         bool run = true;
         bool firstStep = true;
 
         while (run)
         {
             // here copy current linear memory between currentPoint and end
-            const size_t startOffset = helper::LinearIndex(
-                Dims(shape.size(), 0), shape, currentPoint, false);
+            const size_t startOffset =
+                helper::LinearIndex(origin, shape, currentPoint, false);
 
             T minStride, maxStride;
             GetMinMax(values + startOffset, stride, minStride, maxStride);
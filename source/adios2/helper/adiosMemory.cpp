@@ -12,6 +12,7 @@
 #include "adiosMemory.tcc"
 
 #include <algorithm>
+#include <cstring> //std::memcpy
 
 #include "adios2/helper/adiosType.h"
 
@@ -50,10 +51,10 @@ void CopyPayloadStride(const char *src, const size_t payloadStride, char *dest,
 #endif
 }
 
-Dims DestDimsFinal(const Dims &destDims, const bool destRowMajor,
-                   const bool srcRowMajor)
+SmallDims DestDimsFinal(const Dims &destDims, const bool destRowMajor,
+                        const bool srcRowMajor)
 {
-    Dims destDimsFinal = destDims;
+    SmallDims destDimsFinal = destDims;
     if (srcRowMajor != destRowMajor)
     {
         std::reverse(destDimsFinal.begin(), destDimsFinal.end());
@@ -61,6 +62,18 @@ Dims DestDimsFinal(const Dims &destDims, const bool destRowMajor,
     return destDimsFinal;
 }
 
+/** @return point - start + memStart, memory selection coordinates of point */
+SmallDims MemoryPoint(const SmallDims &point, const SmallDims &start,
+                      const Dims &memStart) noexcept
+{
+    SmallDims memoryPoint(point.size());
+    for (size_t d = 0; d < point.size(); ++d)
+    {
+        memoryPoint[d] = point[d] - start[d] + memStart[d];
+    }
+    return memoryPoint;
+}
+
 void ClipRowMajor(char *dest, const Dims &destStart, const Dims &destCount,
                   const bool destRowMajor, const char *src,
                   const Dims &srcStart, const Dims &srcCount,
@@ -68,13 +81,15 @@ void ClipRowMajor(char *dest, const Dims &destStart, const Dims &destCount,
                   const Dims &srcMemStart, const Dims &srcMemCount,
                   const bool endianReverse, const std::string destType)
 {
-    const Dims destStartFinal = DestDimsFinal(destStart, destRowMajor, true);
-    const Dims destCountFinal = DestDimsFinal(destCount, destRowMajor, true);
-    const Box<Dims> intersectionBox = IntersectionStartCount(
+    const SmallDims destStartFinal =
+        DestDimsFinal(destStart, destRowMajor, true);
+    const SmallDims destCountFinal =
+        DestDimsFinal(destCount, destRowMajor, true);
+    const Box<SmallDims> intersectionBox = IntersectionStartCount(
         destStartFinal, destCountFinal, srcStart, srcCount);
 
-    const Dims &interStart = intersectionBox.first;
-    const Dims &interCount = intersectionBox.second;
+    const SmallDims &interStart = intersectionBox.first;
+    const SmallDims &interCount = intersectionBox.second;
     // loop through intersection start and end and check if it's equal to the
     // srcBox contiguous part
     const size_t dimensions = interStart.size();
@@ -105,7 +120,8 @@ void ClipRowMajor(char *dest, const Dims &destStart, const Dims &destCount,
     //    }
 
     /// start iteration
-    Dims currentPoint(interStart); // current point for memory copy
+    SmallDims currentPoint(interStart); // current point for memory copy
+    const SmallDims srcMemOrigin(srcMemCount.size(), 0);
     const size_t interOffset =
         LinearIndex(srcStart, srcCount, interStart, true);
 
@@ -119,11 +135,9 @@ void ClipRowMajor(char *dest, const Dims &destStart, const Dims &destCount,
             srcMemStart.empty()
                 ? LinearIndex(srcStart, srcCount, currentPoint, true) -
                       interOffset
-                : LinearIndex(Dims(srcMemCount.size(), 0), srcMemCount,
-                              VectorsOp(std::plus<size_t>(),
-                                        VectorsOp(std::minus<size_t>(),
-                                                  currentPoint, interStart),
-                                        srcMemStart),
+                : LinearIndex(srcMemOrigin, srcMemCount,
+                              MemoryPoint(currentPoint, interStart,
+                                          srcMemStart),
                               true);
 
         const size_t destBeginOffset = helper::LinearIndex(
@@ -165,13 +179,15 @@ void ClipColumnMajor(char *dest, const Dims &destStart, const Dims &destCount,
                      const Dims &srcMemCount, const bool endianReverse,
                      const std::string destType)
 {
-    const Dims destStartFinal = DestDimsFinal(destStart, destRowMajor, false);
-    const Dims destCountFinal = DestDimsFinal(destCount, destRowMajor, false);
-    const Box<Dims> intersectionBox = IntersectionStartCount(
+    const SmallDims destStartFinal =
+        DestDimsFinal(destStart, destRowMajor, false);
+    const SmallDims destCountFinal =
+        DestDimsFinal(destCount, destRowMajor, false);
+    const Box<SmallDims> intersectionBox = IntersectionStartCount(
         destStartFinal, destCountFinal, srcStart, srcCount);
 
-    const Dims &interStart = intersectionBox.first;
-    const Dims &interCount = intersectionBox.second;
+    const SmallDims &interStart = intersectionBox.first;
+    const SmallDims &interCount = intersectionBox.second;
     // loop through intersection start and end and check if it's equal to the
     // srcBox contiguous part
     const size_t dimensions = interStart.size();
@@ -192,7 +208,8 @@ void ClipColumnMajor(char *dest, const Dims &destStart, const Dims &destCount,
     //    }
 
     /// start iteration
-    Dims currentPoint(interStart); // current point for memory copy
+    SmallDims currentPoint(interStart); // current point for memory copy
+    const SmallDims srcMemOrigin(srcMemCount.size(), 0);
     const size_t interOffset =
         LinearIndex(srcStart, srcCount, interStart, false);
 
@@ -205,11 +222,9 @@ void ClipColumnMajor(char *dest, const Dims &destStart, const Dims &destCount,
             srcMemStart.empty()
                 ? LinearIndex(srcStart, srcCount, currentPoint, false) -
                       interOffset
-                : LinearIndex(Dims(srcMemCount.size(), 0), srcMemCount,
-                              VectorsOp(std::plus<size_t>(),
-                                        VectorsOp(std::minus<size_t>(),
-                                                  currentPoint, interStart),
-                                        srcMemStart),
+                : LinearIndex(srcMemOrigin, srcMemCount,
+                              MemoryPoint(currentPoint, interStart,
+                                          srcMemStart),
                               false);
 
         const size_t destBeginOffset = helper::LinearIndex(
@@ -243,6 +258,21 @@ void ClipColumnMajor(char *dest, const Dims &destStart, const Dims &destCount,
     }
 }
 
+/**
+ * Transposes an 8x8 bit matrix, row j is byte j of x (least significant
+ * first). It is its own inverse.
+ */
+uint64_t TransposeBits8x8(uint64_t x) noexcept
+{
+    uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
 } // end empty namespace
 
 void CopyPayload(char *dest, const Dims &destStart, const Dims &destCount,
@@ -254,10 +284,10 @@ void CopyPayload(char *dest, const Dims &destStart, const Dims &destCount,
 {
     if (srcStart.size() == 1) // 1D copy memory
     {
-        const Box<Dims> intersectionBox =
+        const Box<SmallDims> intersectionBox =
             IntersectionStartCount(destStart, destCount, srcStart, srcCount);
-        const Dims &interStart = intersectionBox.first;
-        const Dims &interCount = intersectionBox.second;
+        const SmallDims &interStart = intersectionBox.first;
+        const SmallDims &interCount = intersectionBox.second;
 
         const size_t srcBeginOffset =
             srcMemStart.empty()
@@ -286,5 +316,94 @@ void CopyPayload(char *dest, const Dims &destStart, const Dims &destCount,
     }
 }
 
+void ByteShuffle(const char *in, char *out, const size_t size,
+                 const size_t elementSize) noexcept
+{
+    const size_t elements = size / elementSize;
+    for (size_t e = 0; e < elements; ++e)
+    {
+        for (size_t b = 0; b < elementSize; ++b)
+        {
+            out[b * elements + e] = in[e * elementSize + b];
+        }
+    }
+
+    const size_t shuffled = elements * elementSize;
+    std::memcpy(out + shuffled, in + shuffled, size - shuffled);
+}
+
+void ByteUnshuffle(const char *in, char *out, const size_t size,
+                   const size_t elementSize) noexcept
+{
+    const size_t elements = size / elementSize;
+    for (size_t e = 0; e < elements; ++e)
+    {
+        for (size_t b = 0; b < elementSize; ++b)
+        {
+            out[e * elementSize + b] = in[b * elements + e];
+        }
+    }
+
+    const size_t shuffled = elements * elementSize;
+    std::memcpy(out + shuffled, in + shuffled, size - shuffled);
+}
+
+void BitShuffle(const char *in, char *out, const size_t size,
+                const size_t elementSize) noexcept
+{
+    // bit planes are groups / 8 bytes long, one per bit of the element
+    const size_t groups = size / elementSize / 8;
+    for (size_t b = 0; b < elementSize; ++b)
+    {
+        for (size_t g = 0; g < groups; ++g)
+        {
+            uint64_t x = 0;
+            for (size_t j = 0; j < 8; ++j)
+            {
+                const uint8_t byte = static_cast<uint8_t>(
+                    in[(g * 8 + j) * elementSize + b]);
+                x |= static_cast<uint64_t>(byte) << (8 * j);
+            }
+            x = TransposeBits8x8(x);
+            for (size_t k = 0; k < 8; ++k)
+            {
+                out[(b * 8 + k) * groups + g] =
+                    static_cast<char>((x >> (8 * k)) & 0xFF);
+            }
+        }
+    }
+
+    const size_t shuffled = groups * 8 * elementSize;
+    std::memcpy(out + shuffled, in + shuffled, size - shuffled);
+}
+
+void BitUnshuffle(const char *in, char *out, const size_t size,
+                  const size_t elementSize) noexcept
+{
+    const size_t groups = size / elementSize / 8;
+    for (size_t b = 0; b < elementSize; ++b)
+    {
+        for (size_t g = 0; g < groups; ++g)
+        {
+            uint64_t x = 0;
+            for (size_t k = 0; k < 8; ++k)
+            {
+                const uint8_t byte =
+                    static_cast<uint8_t>(in[(b * 8 + k) * groups + g]);
+                x |= static_cast<uint64_t>(byte) << (8 * k);
+            }
+            x = TransposeBits8x8(x);
+            for (size_t j = 0; j < 8; ++j)
+            {
+                out[(g * 8 + j) * elementSize + b] =
+                    static_cast<char>((x >> (8 * j)) & 0xFF);
+            }
+        }
+    }
+
+    const size_t shuffled = groups * 8 * elementSize;
+    std::memcpy(out + shuffled, in + shuffled, size - shuffled);
+}
+
 } // end namespace helper
 } // end namespace adios2
@@ -18,6 +18,7 @@
 /// \endcond
 
 #include "adios2/ADIOSTypes.h"
+#include "adios2/helper/adiosSmallDims.h"
 
 namespace adios2
 {
@@ -66,6 +67,40 @@ void CopyToBufferThreads(std::vector<char> &buffer, size_t &position,
                          const T *source, const size_t elements = 1,
                          const unsigned int threads = 1) noexcept;
 
+/**
+ * Copies data to a specific location in the buffer updating position, and
+ * gets the min and max of the copied data in the same pass over source.
+ * Data is copied in cache-sized blocks whose min and max are taken while they
+ * are still in cache.
+ * Does not update vec.size().
+ * @param buffer data destination
+ * @param position starting position in buffer (in terms of T not bytes)
+ * @param source pointer to source data
+ * @param elements number of elements of source type, must be > 0
+ * @param min of source
+ * @param max of source
+ */
+template <class T>
+void CopyToBufferMinMax(std::vector<char> &buffer, size_t &position,
+                        const T *source, const size_t elements, T &min,
+                        T &max) noexcept;
+
+/**
+ * Threaded version of CopyToBufferMinMax, each thread copies and reduces a
+ * contiguous part of source
+ * @param buffer data destination
+ * @param position starting position in buffer (in terms of T not bytes)
+ * @param source pointer to source data
+ * @param elements number of elements of source type, must be > 0
+ * @param min of source
+ * @param max of source
+ * @param threads number of threads sharing the load
+ */
+template <class T>
+void CopyToBufferMinMaxThreads(std::vector<char> &buffer, size_t &position,
+                               const T *source, const size_t elements, T &min,
+                               T &max, const unsigned int threads = 1) noexcept;
+
 template <class T>
 void ReverseCopyFromBuffer(const std::vector<char> &buffer, size_t &position,
                            T *destination, const size_t elements = 1) noexcept;
@@ -148,8 +183,8 @@ void CopyPayload(char *dest, const Dims &destStart, const Dims &destCount,
 template <class T>
 void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
                           const char *contiguousMemory,
-                          const Box<Dims> &blockBox,
-                          const Box<Dims> &intersectionBox,
+                          const Box<SmallDims> &blockBox,
+                          const Box<SmallDims> &intersectionBox,
                           const bool isRowMajor = true,
                           const bool reverseDimensions = false,
                           const bool endianReverse = false);
@@ -157,8 +192,8 @@ void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
 template <class T>
 void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
                           const std::vector<char> &contiguousMemory,
-                          const Box<Dims> &blockBox,
-                          const Box<Dims> &intersectionBox,
+                          const Box<SmallDims> &blockBox,
+                          const Box<SmallDims> &intersectionBox,
                           const bool isRowMajor = true,
                           const bool reverseDimensions = false,
                           const bool endianReverse = false);
@@ -229,6 +264,39 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
 template <class T>
 size_t PayloadSize(const T *data, const Dims &count) noexcept;
 
+/**
+ * Byte shuffle pre-filter: stores the first byte of every element, then the
+ * second byte of every element, etc. Makes typed data (e.g. floating point)
+ * far more compressible by LZ-type compressors. Trailing bytes that don't
+ * form a whole element are copied as-is.
+ * @param in input of size bytes
+ * @param out output of size bytes, must not overlap in
+ * @param size bytes in input and output
+ * @param elementSize bytes per element
+ */
+void ByteShuffle(const char *in, char *out, const size_t size,
+                 const size_t elementSize) noexcept;
+
+/** Inverse of ByteShuffle, same arguments */
+void ByteUnshuffle(const char *in, char *out, const size_t size,
+                   const size_t elementSize) noexcept;
+
+/**
+ * Bit shuffle pre-filter: like ByteShuffle but at bit granularity, the i-th
+ * bit of every element is stored together. Elements are transposed in groups
+ * of 8, remaining elements and trailing bytes are copied as-is.
+ * @param in input of size bytes
+ * @param out output of size bytes, must not overlap in
+ * @param size bytes in input and output
+ * @param elementSize bytes per element
+ */
+void BitShuffle(const char *in, char *out, const size_t size,
+                const size_t elementSize) noexcept;
+
+/** Inverse of BitShuffle, same arguments */
+void BitUnshuffle(const char *in, char *out, const size_t size,
+                  const size_t elementSize) noexcept;
+
 } // end namespace helper
 } // end namespace adios2
 
@@ -110,6 +110,94 @@ void CopyToBufferThreads(std::vector<char> &buffer, size_t &position,
     position += elements * sizeof(T);
 }
 
+template <class T>
+void CopyToBufferMinMax(std::vector<char> &buffer, size_t &position,
+                        const T *source, const size_t elements, T &min,
+                        T &max) noexcept
+{
+    // merges bounds with GetMinMax so complex types compare by modulus
+    auto lf_Merge = [](T &bound, const T &other, const bool isMin) {
+        const T candidates[2] = {bound, other};
+        T unused;
+        if (isMin)
+        {
+            GetMinMax(candidates, 2, bound, unused);
+        }
+        else
+        {
+            GetMinMax(candidates, 2, unused, bound);
+        }
+    };
+
+    // 16KB blocks stay in L1 between the copy and the min/max
+    const size_t blockElements =
+        std::max(static_cast<size_t>(1), 16384 / sizeof(T));
+    T *destination = reinterpret_cast<T *>(buffer.data() + position);
+
+    for (size_t first = 0; first < elements; first += blockElements)
+    {
+        const size_t count = std::min(blockElements, elements - first);
+        std::memcpy(destination + first, source + first, count * sizeof(T));
+
+        T blockMin, blockMax;
+        GetMinMax(destination + first, count, blockMin, blockMax);
+        if (first == 0)
+        {
+            min = blockMin;
+            max = blockMax;
+        }
+        else
+        {
+            lf_Merge(min, blockMin, true);
+            lf_Merge(max, blockMax, false);
+        }
+    }
+
+    position += elements * sizeof(T);
+}
+
+template <class T>
+void CopyToBufferMinMaxThreads(std::vector<char> &buffer, size_t &position,
+                               const T *source, const size_t elements, T &min,
+                               T &max, const unsigned int threads) noexcept
+{
+    if (threads == 1 || threads > elements)
+    {
+        CopyToBufferMinMax(buffer, position, source, elements, min, max);
+        return;
+    }
+
+    const size_t stride = elements / threads;    // elements per thread
+    const size_t remainder = elements % threads; // remainder if not aligned
+    const size_t last = stride + remainder;
+
+    std::vector<T> mins(threads);
+    std::vector<T> maxs(threads);
+
+    std::vector<std::thread> copyThreads;
+    copyThreads.reserve(threads);
+
+    for (unsigned int t = 0; t < threads; ++t)
+    {
+        const size_t threadElements = (t == threads - 1) ? last : stride;
+        copyThreads.push_back(std::thread([&, t, threadElements]() {
+            size_t threadPosition = position + stride * t * sizeof(T);
+            CopyToBufferMinMax(buffer, threadPosition, source + stride * t,
+                               threadElements, mins[t], maxs[t]);
+        }));
+    }
+
+    for (auto &copyThread : copyThreads)
+    {
+        copyThread.join();
+    }
+
+    T unused;
+    GetMinMax(mins.data(), threads, min, unused);
+    GetMinMax(maxs.data(), threads, unused, max);
+    position += elements * sizeof(T);
+}
+
 template <class T>
 inline void ReverseCopyFromBuffer(const std::vector<char> &buffer,
                                   size_t &position, T *destination,
@@ -244,23 +332,23 @@ void CopyMemory(T *dest, const Dims &destStart, const Dims &destCount,
 template <class T>
 void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
                           const char *contiguousMemory,
-                          const Box<Dims> &blockBox,
-                          const Box<Dims> &intersectionBox,
+                          const Box<SmallDims> &blockBox,
+                          const Box<SmallDims> &intersectionBox,
                           const bool isRowMajor, const bool reverseDimensions,
                           const bool endianReverse)
 {
     auto lf_ClipRowMajor = [](
         T *dest, const Dims &destStart, const Dims &destCount,
-        const char *contiguousMemory, const Box<Dims> &blockBox,
-        const Box<Dims> &intersectionBox, const bool isRowMajor,
+        const char *contiguousMemory, const Box<SmallDims> &blockBox,
+        const Box<SmallDims> &intersectionBox, const bool isRowMajor,
         const bool reverseDimensions, const bool endianReverse) {
 
-        const Dims &start = intersectionBox.first;
-        const Dims &end = intersectionBox.second;
+        const SmallDims &start = intersectionBox.first;
+        const SmallDims &end = intersectionBox.second;
         const size_t stride = (end.back() - start.back() + 1) * sizeof(T);
 
-        Dims currentPoint(start); // current point for memory copy
-        const Box<Dims> selectionBox =
+        SmallDims currentPoint(start); // current point for memory copy
+        const Box<SmallDims> selectionBox =
             helper::StartEndBox(destStart, destCount, reverseDimensions);
 
         const size_t dimensions = start.size();
@@ -322,18 +410,18 @@ void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
 
     auto lf_ClipColumnMajor =
         [](T *dest, const Dims &destStart, const Dims &destCount,
-           const char *contiguousMemory, const Box<Dims> &blockBox,
-           const Box<Dims> &intersectionBox, const bool isRowMajor,
+           const char *contiguousMemory, const Box<SmallDims> &blockBox,
+           const Box<SmallDims> &intersectionBox, const bool isRowMajor,
            const bool reverseDimensions, const bool endianReverse)
 
     {
-        const Dims &start = intersectionBox.first;
-        const Dims &end = intersectionBox.second;
+        const SmallDims &start = intersectionBox.first;
+        const SmallDims &end = intersectionBox.second;
         const size_t stride = (end.front() - start.front() + 1) * sizeof(T);
 
-        Dims currentPoint(start); // current point for memory copy
+        SmallDims currentPoint(start); // current point for memory copy
 
-        const Box<Dims> selectionBox =
+        const Box<SmallDims> selectionBox =
             helper::StartEndBox(destStart, destCount, reverseDimensions);
 
         const size_t dimensions = start.size();
@@ -390,15 +478,15 @@ void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
 
     };
 
-    const Dims &start = intersectionBox.first;
+    const SmallDims &start = intersectionBox.first;
     if (start.size() == 1) // 1D copy memory
     {
         const size_t normalizedStart =
             (start.front() - destStart.front()) * sizeof(T);
         char *rawVariableData = reinterpret_cast<char *>(dest);
 
-        const Dims &start = intersectionBox.first;
-        const Dims &end = intersectionBox.second;
+        const SmallDims &start = intersectionBox.first;
+        const SmallDims &end = intersectionBox.second;
         const size_t stride = (end.back() - start.back() + 1) * sizeof(T);
 
         CopyContiguousMemory(contiguousMemory, stride,
@@ -426,8 +514,8 @@ void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
 template <class T>
 void ClipContiguousMemory(T *dest, const Dims &destStart, const Dims &destCount,
                           const std::vector<char> &contiguousMemory,
-                          const Box<Dims> &blockBox,
-                          const Box<Dims> &intersectionBox,
+                          const Box<SmallDims> &blockBox,
+                          const Box<SmallDims> &intersectionBox,
                           const bool isRowMajor, const bool reverseDimensions,
                           const bool endianReverse)
 {
@@ -493,9 +581,11 @@ void Resize(std::vector<T> &vec, const size_t dataSize, const bool debugMode,
 // calculation complexity for copying each block is minimized to O(1), which is
 // independent of the number of dimensions.
 static void NdCopyRecurDFSeqPadding(size_t curDim, const char *&inOvlpBase,
-                                    char *&outOvlpBase, Dims &inOvlpGapSize,
-                                    Dims &outOvlpGapSize, Dims &ovlpCount,
-                                    size_t &minContDim, size_t &blockSize)
+                                    char *&outOvlpBase,
+                                    SmallDims &inOvlpGapSize,
+                                    SmallDims &outOvlpGapSize,
+                                    SmallDims &ovlpCount, size_t &minContDim,
+                                    size_t &blockSize)
 {
     // note: all elements in and below this node are contiguous on input and
     // output
@@ -537,9 +627,11 @@ static void NdCopyRecurDFSeqPadding(size_t curDim, const char *&inOvlpBase,
 
 static void
 NdCopyRecurDFSeqPaddingRevEndian(size_t curDim, const char *&inOvlpBase,
-                                 char *&outOvlpBase, Dims &inOvlpGapSize,
-                                 Dims &outOvlpGapSize, Dims &ovlpCount,
-                                 size_t minCountDim, size_t blockSize,
+                                 char *&outOvlpBase,
+                                 SmallDims &inOvlpGapSize,
+                                 SmallDims &outOvlpGapSize,
+                                 SmallDims &ovlpCount, size_t minCountDim,
+                                 size_t blockSize,
                                  size_t elmSize, size_t numElmsPerBlock)
 {
     if (curDim == minCountDim)
@@ -575,10 +667,12 @@ NdCopyRecurDFSeqPaddingRevEndian(size_t curDim, const char *&inOvlpBase,
 // the memory address calculation complexity for copying each element is
 // minimized to average O(1), which is independent of the number of dimensions.
 static void NdCopyRecurDFNonSeqDynamic(size_t curDim, const char *inBase,
-                                       char *outBase, Dims &inRltvOvlpSPos,
-                                       Dims &outRltvOvlpSPos, Dims &inStride,
-                                       Dims &outStride, Dims &ovlpCount,
-                                       size_t elmSize)
+                                       char *outBase,
+                                       SmallDims &inRltvOvlpSPos,
+                                       SmallDims &outRltvOvlpSPos,
+                                       SmallDims &inStride,
+                                       SmallDims &outStride,
+                                       SmallDims &ovlpCount, size_t elmSize)
 {
     if (curDim == inStride.size())
     {
@@ -603,9 +697,9 @@ static void NdCopyRecurDFNonSeqDynamic(size_t curDim, const char *inBase,
 // minimized to average O(1), which is independent of the number of dimensions.
 
 static void NdCopyRecurDFNonSeqDynamicRevEndian(
-    size_t curDim, const char *inBase, char *outBase, Dims &inRltvOvlpSPos,
-    Dims &outRltvOvlpSPos, Dims &inStride, Dims &outStride, Dims &ovlpCount,
-    size_t elmSize)
+    size_t curDim, const char *inBase, char *outBase,
+    SmallDims &inRltvOvlpSPos, SmallDims &outRltvOvlpSPos, SmallDims &inStride,
+    SmallDims &outStride, SmallDims &ovlpCount, size_t elmSize)
 {
     if (curDim == inStride.size())
     {
@@ -627,11 +721,12 @@ static void NdCopyRecurDFNonSeqDynamicRevEndian(
 }
 
 static void NdCopyIterDFSeqPadding(const char *&inOvlpBase, char *&outOvlpBase,
-                                   Dims &inOvlpGapSize, Dims &outOvlpGapSize,
-                                   Dims &ovlpCount, size_t minContDim,
+                                   SmallDims &inOvlpGapSize,
+                                   SmallDims &outOvlpGapSize,
+                                   SmallDims &ovlpCount, size_t minContDim,
                                    size_t blockSize)
 {
-    Dims pos(ovlpCount.size(), 0);
+    SmallDims pos(ovlpCount.size(), 0);
     size_t curDim = 0;
     while (true)
     {
@@ -656,11 +751,11 @@ static void NdCopyIterDFSeqPadding(const char *&inOvlpBase, char *&outOvlpBase,
 }
 
 static void NdCopyIterDFSeqPaddingRevEndian(
-    const char *&inOvlpBase, char *&outOvlpBase, Dims &inOvlpGapSize,
-    Dims &outOvlpGapSize, Dims &ovlpCount, size_t minContDim, size_t blockSize,
-    size_t elmSize, size_t numElmsPerBlock)
+    const char *&inOvlpBase, char *&outOvlpBase, SmallDims &inOvlpGapSize,
+    SmallDims &outOvlpGapSize, SmallDims &ovlpCount, size_t minContDim,
+    size_t blockSize, size_t elmSize, size_t numElmsPerBlock)
 {
-    Dims pos(ovlpCount.size(), 0);
+    SmallDims pos(ovlpCount.size(), 0);
     size_t curDim = 0;
     while (true)
     {
@@ -690,12 +785,13 @@ static void NdCopyIterDFSeqPaddingRevEndian(
     }
 }
 static void NdCopyIterDFDynamic(const char *inBase, char *outBase,
-                                Dims &inRltvOvlpSPos, Dims &outRltvOvlpSPos,
-                                Dims &inStride, Dims &outStride,
-                                Dims &ovlpCount, size_t elmSize)
+                                SmallDims &inRltvOvlpSPos,
+                                SmallDims &outRltvOvlpSPos,
+                                SmallDims &inStride, SmallDims &outStride,
+                                SmallDims &ovlpCount, size_t elmSize)
 {
     size_t curDim = 0;
-    Dims pos(ovlpCount.size() + 1, 0);
+    SmallDims pos(ovlpCount.size() + 1, 0);
     std::vector<const char *> inAddr(ovlpCount.size() + 1);
     inAddr[0] = inBase;
     std::vector<char *> outAddr(ovlpCount.size() + 1);
@@ -725,13 +821,14 @@ static void NdCopyIterDFDynamic(const char *inBase, char *outBase,
 }
 
 static void NdCopyIterDFDynamicRevEndian(const char *inBase, char *outBase,
-                                         Dims &inRltvOvlpSPos,
-                                         Dims &outRltvOvlpSPos, Dims &inStride,
-                                         Dims &outStride, Dims &ovlpCount,
-                                         size_t elmSize)
+                                         SmallDims &inRltvOvlpSPos,
+                                         SmallDims &outRltvOvlpSPos,
+                                         SmallDims &inStride,
+                                         SmallDims &outStride,
+                                         SmallDims &ovlpCount, size_t elmSize)
 {
     size_t curDim = 0;
-    Dims pos(ovlpCount.size() + 1, 0);
+    SmallDims pos(ovlpCount.size() + 1, 0);
     std::vector<const char *> inAddr(ovlpCount.size() + 1);
     inAddr[0] = inBase;
     std::vector<char *> outAddr(ovlpCount.size() + 1);
@@ -775,55 +872,58 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
 
     // use values of ioStart and ioCount if ioMemStart and ioMemCount are
     // left as default
-    Dims inMemStartNC = inMemStart.empty() ? inStart : inMemStart;
-    Dims inMemCountNC = inMemCount.empty() ? inCount : inMemCount;
-    Dims outMemStartNC = outMemStart.empty() ? outStart : outMemStart;
-    Dims outMemCountNC = outMemCount.empty() ? outCount : outMemCount;
-
-    Dims inEnd(inStart.size());
-    Dims outEnd(inStart.size());
-    Dims ovlpStart(inStart.size());
-    Dims ovlpEnd(inStart.size());
-    Dims ovlpCount(inStart.size());
-    Dims inStride(inStart.size());
-    Dims outStride(inStart.size());
-    Dims inOvlpGapSize(inStart.size());
-    Dims outOvlpGapSize(inStart.size());
-    Dims inRltvOvlpStartPos(inStart.size());
-    Dims outRltvOvlpStartPos(inStart.size());
+    SmallDims inMemStartNC = inMemStart.empty() ? inStart : inMemStart;
+    SmallDims inMemCountNC = inMemCount.empty() ? inCount : inMemCount;
+    SmallDims outMemStartNC = outMemStart.empty() ? outStart : outMemStart;
+    SmallDims outMemCountNC = outMemCount.empty() ? outCount : outMemCount;
+
+    SmallDims inEnd(inStart.size());
+    SmallDims outEnd(inStart.size());
+    SmallDims ovlpStart(inStart.size());
+    SmallDims ovlpEnd(inStart.size());
+    SmallDims ovlpCount(inStart.size());
+    SmallDims inStride(inStart.size());
+    SmallDims outStride(inStart.size());
+    SmallDims inOvlpGapSize(inStart.size());
+    SmallDims outOvlpGapSize(inStart.size());
+    SmallDims inRltvOvlpStartPos(inStart.size());
+    SmallDims outRltvOvlpStartPos(inStart.size());
     size_t minContDim, blockSize;
     const char *inOvlpBase = nullptr;
     char *outOvlpBase = nullptr;
-    auto GetInEnd = [](Dims &inEnd, const Dims &inStart, const Dims &inCount) {
+    auto GetInEnd = [](SmallDims &inEnd, const SmallDims &inStart,
+                       const SmallDims &inCount) {
         for (size_t i = 0; i < inStart.size(); i++)
             inEnd[i] = inStart[i] + inCount[i] - 1;
     };
-    auto GetOutEnd = [](Dims &outEnd, const Dims &outStart,
-                        const Dims &output_count) {
+    auto GetOutEnd = [](SmallDims &outEnd, const SmallDims &outStart,
+                        const SmallDims &output_count) {
         for (size_t i = 0; i < outStart.size(); i++)
             outEnd[i] = outStart[i] + output_count[i] - 1;
     };
-    auto GetOvlpStart = [](Dims &ovlpStart, const Dims &inStart,
-                           const Dims &outStart) {
+    auto GetOvlpStart = [](SmallDims &ovlpStart, const SmallDims &inStart,
+                           const SmallDims &outStart) {
         for (size_t i = 0; i < ovlpStart.size(); i++)
             ovlpStart[i] = inStart[i] > outStart[i] ? inStart[i] : outStart[i];
     };
-    auto GetOvlpEnd = [](Dims &ovlpEnd, Dims &inEnd, Dims &outEnd) {
+    auto GetOvlpEnd = [](SmallDims &ovlpEnd, SmallDims &inEnd,
+                         SmallDims &outEnd) {
         for (size_t i = 0; i < ovlpEnd.size(); i++)
             ovlpEnd[i] = inEnd[i] < outEnd[i] ? inEnd[i] : outEnd[i];
     };
-    auto GetOvlpCount = [](Dims &ovlpCount, Dims &ovlpStart, Dims &ovlpEnd) {
+    auto GetOvlpCount = [](SmallDims &ovlpCount, SmallDims &ovlpStart,
+                           SmallDims &ovlpEnd) {
         for (size_t i = 0; i < ovlpCount.size(); i++)
             ovlpCount[i] = ovlpEnd[i] - ovlpStart[i] + 1;
     };
-    auto HasOvlp = [](Dims &ovlpStart, Dims &ovlpEnd) {
+    auto HasOvlp = [](SmallDims &ovlpStart, SmallDims &ovlpEnd) {
         for (size_t i = 0; i < ovlpStart.size(); i++)
             if (ovlpEnd[i] < ovlpStart[i])
                 return false;
         return true;
     };
 
-    auto GetIoStrides = [](Dims &ioStride, const Dims &ioCount,
+    auto GetIoStrides = [](SmallDims &ioStride, const SmallDims &ioCount,
                            size_t elmSize) {
         // ioStride[i] holds the total number of elements under each element
         // of the i'th dimension
@@ -846,27 +946,27 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
     };
 
     auto GetInOvlpBase = [](const char *&inOvlpBase, const char *in,
-                            const Dims &inStart, Dims &inStride,
-                            Dims &ovlpStart) {
+                            const SmallDims &inStart, SmallDims &inStride,
+                            SmallDims &ovlpStart) {
         inOvlpBase = in;
         for (size_t i = 0; i < inStart.size(); i++)
             inOvlpBase = inOvlpBase + (ovlpStart[i] - inStart[i]) * inStride[i];
     };
     auto GetOutOvlpBase = [](char *&outOvlpBase, char *out,
-                             const Dims &outStart, Dims &outStride,
-                             Dims &ovlpStart) {
+                             const SmallDims &outStart, SmallDims &outStride,
+                             SmallDims &ovlpStart) {
         outOvlpBase = out;
         for (size_t i = 0; i < outStart.size(); i++)
             outOvlpBase =
                 outOvlpBase + (ovlpStart[i] - outStart[i]) * outStride[i];
     };
-    auto GetIoOvlpGapSize = [](Dims &ioOvlpGapSize, Dims &ioStride,
-                               const Dims &ioCount, Dims &ovlpCount) {
+    auto GetIoOvlpGapSize = [](SmallDims &ioOvlpGapSize, SmallDims &ioStride,
+                               const SmallDims &ioCount, SmallDims &ovlpCount) {
         for (size_t i = 0; i < ioOvlpGapSize.size(); i++)
             ioOvlpGapSize[i] = (ioCount[i] - ovlpCount[i]) * ioStride[i];
     };
-    auto GetMinContDim = [](const Dims &inCount, const Dims outCount,
-                            Dims &ovlpCount) {
+    auto GetMinContDim = [](const SmallDims &inCount, const SmallDims &outCount,
+                            SmallDims &ovlpCount) {
         //    note: minContDim is the first index where its input box and
         //    overlap box
         //    are not fully match. therefore all data below this branch is
@@ -885,15 +985,17 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
         }
         return i;
     };
-    auto GetBlockSize = [](Dims &ovlpCount, size_t minContDim, size_t elmSize) {
+    auto GetBlockSize = [](SmallDims &ovlpCount, size_t minContDim,
+                           size_t elmSize) {
         size_t res = elmSize;
         for (size_t i = minContDim; i < ovlpCount.size(); i++)
             res *= ovlpCount[i];
         return res;
     };
 
-    auto GetRltvOvlpStartPos = [](Dims &ioRltvOvlpStart, const Dims &ioStart,
-                                  Dims &ovlpStart) {
+    auto GetRltvOvlpStartPos = [](SmallDims &ioRltvOvlpStart,
+                                  const SmallDims &ioStart,
+                                  SmallDims &ovlpStart) {
         for (size_t i = 0; i < ioStart.size(); i++)
             ioRltvOvlpStart[i] = ovlpStart[i] - ioStart[i];
     };
@@ -961,8 +1063,8 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
     // padding
     else
     {
-        //        Dims revInCount(inCount);
-        //        Dims revOutCount(outCount);
+        //        SmallDims revInCount(inCount);
+        //        SmallDims revOutCount(outCount);
         //
         // col-major ==> col-major mode
         if (!inIsRowMajor && !outIsRowMajor)
@@ -985,8 +1087,8 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
         // row-major ==> col-major mode
         else if (inIsRowMajor && !outIsRowMajor)
         {
-            Dims revOutStart(outStart);
-            Dims revOutCount(outCount);
+            SmallDims revOutStart(outStart);
+            SmallDims revOutCount(outCount);
 
             std::reverse(outMemStartNC.begin(), outMemStartNC.end());
             std::reverse(outMemCountNC.begin(), outMemCountNC.end());
@@ -1011,7 +1113,7 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
             GetRltvOvlpStartPos(inRltvOvlpStartPos, inMemStartNC, ovlpStart);
 
             // get reversed order outOvlpStart
-            Dims revOvlpStart(ovlpStart);
+            SmallDims revOvlpStart(ovlpStart);
             std::reverse(revOvlpStart.begin(), revOvlpStart.end());
             GetRltvOvlpStartPos(outRltvOvlpStartPos, outMemStartNC,
                                 revOvlpStart);
@@ -1019,8 +1121,8 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
         // col-major ==> row-major mode
         else if (!inIsRowMajor && outIsRowMajor)
         {
-            Dims revInStart(inStart);
-            Dims revInCount(inCount);
+            SmallDims revInStart(inStart);
+            SmallDims revInCount(inCount);
             std::reverse(inMemStartNC.begin(), inMemStartNC.end());
             std::reverse(inMemCountNC.begin(), inMemCountNC.end());
 
@@ -1041,7 +1143,7 @@ int NdCopy(const char *in, const Dims &inStart, const Dims &inCount,
             std::reverse(inStride.begin(), inStride.end());
 
             // get reversed order inOvlpStart
-            Dims revOvlpStart(ovlpStart);
+            SmallDims revOvlpStart(ovlpStart);
             std::reverse(revOvlpStart.begin(), revOvlpStart.end());
             GetRltvOvlpStartPos(inRltvOvlpStartPos, inMemStartNC, revOvlpStart);
             // get normal order outOvlpStart
@@ -0,0 +1,167 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosSmallDims.h dimensions container with inline storage, used instead of
+ * Dims on per-block hot paths to avoid heap allocations
+ */
+
+#ifndef ADIOS2_HELPER_ADIOSSMALLDIMS_H_
+#define ADIOS2_HELPER_ADIOSSMALLDIMS_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::copy, std::equal, std::fill
+#include <initializer_list>
+#include <vector>
+/// \endcond
+
+#include "adios2/ADIOSTypes.h"
+
+namespace adios2
+{
+namespace helper
+{
+
+/**
+ * Subset of the std::vector<size_t> interface used by the box arithmetic.
+ * Up to InlineCapacity dimensions are stored in place, more dimensions fall
+ * back to the heap. Converts implicitly from and to Dims.
+ */
+class SmallDims
+{
+public:
+    static constexpr size_t InlineCapacity = 8;
+
+    using value_type = size_t;
+    using size_type = size_t;
+    using iterator = size_t *;
+    using const_iterator = const size_t *;
+
+    SmallDims() noexcept = default;
+
+    explicit SmallDims(const size_t size, const size_t value = 0)
+    {
+        resize(size, value);
+    }
+
+    SmallDims(std::initializer_list<size_t> values)
+    {
+        assign(values.begin(), values.end());
+    }
+
+    SmallDims(const Dims &dimensions)
+    {
+        assign(dimensions.data(), dimensions.data() + dimensions.size());
+    }
+
+    SmallDims(const SmallDims &other) { assign(other.begin(), other.end()); }
+
+    SmallDims &operator=(const SmallDims &other)
+    {
+        if (this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    operator Dims() const { return Dims(begin(), end()); }
+
+    size_t size() const noexcept { return m_Size; }
+    bool empty() const noexcept { return m_Size == 0; }
+
+    size_t *data() noexcept
+    {
+        return m_Size > InlineCapacity ? m_Heap.data() : m_Inline;
+    }
+    const size_t *data() const noexcept
+    {
+        return m_Size > InlineCapacity ? m_Heap.data() : m_Inline;
+    }
+
+    size_t &operator[](const size_t index) noexcept { return data()[index]; }
+    const size_t &operator[](const size_t index) const noexcept
+    {
+        return data()[index];
+    }
+
+    size_t &front() noexcept { return data()[0]; }
+    const size_t &front() const noexcept { return data()[0]; }
+    size_t &back() noexcept { return data()[m_Size - 1]; }
+    const size_t &back() const noexcept { return data()[m_Size - 1]; }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + m_Size; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + m_Size; }
+
+    /** no-op, kept for drop-in use where Dims were reserved */
+    void reserve(const size_t /*size*/) noexcept {}
+
+    void clear() noexcept { m_Size = 0; }
+
+    void resize(const size_t size, const size_t value = 0)
+    {
+        if (size > InlineCapacity)
+        {
+            if (m_Size <= InlineCapacity)
+            {
+                m_Heap.assign(m_Inline, m_Inline + m_Size);
+            }
+            m_Heap.resize(size, value);
+        }
+        else
+        {
+            if (m_Size > InlineCapacity)
+            {
+                std::copy(m_Heap.begin(), m_Heap.begin() + size, m_Inline);
+            }
+            else if (size > m_Size)
+            {
+                std::fill(m_Inline + m_Size, m_Inline + size, value);
+            }
+        }
+        m_Size = size;
+    }
+
+    void push_back(const size_t value)
+    {
+        resize(m_Size + 1, value);
+    }
+
+    void assign(const size_t *first, const size_t *last)
+    {
+        const size_t size = static_cast<size_t>(last - first);
+        if (size > InlineCapacity)
+        {
+            m_Heap.assign(first, last);
+        }
+        else
+        {
+            std::copy(first, last, m_Inline);
+        }
+        m_Size = size;
+    }
+
+private:
+    size_t m_Size = 0;
+    size_t m_Inline[InlineCapacity];
+    /** only used above InlineCapacity dimensions */
+    std::vector<size_t> m_Heap;
+};
+
+inline bool operator==(const SmallDims &lhs, const SmallDims &rhs) noexcept
+{
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+inline bool operator!=(const SmallDims &lhs, const SmallDims &rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+} // end namespace helper
+} // end namespace adios2
+
+#endif /* ADIOS2_HELPER_ADIOSSMALLDIMS_H_ */
@@ -20,6 +20,7 @@
 /// \endcond
 
 #include "adios2/ADIOSTypes.h"
+#include "adios2/helper/adiosSmallDims.h"
 
 namespace adios2
 {
@@ -81,11 +82,11 @@ struct SubStreamBoxInfo
 
     /**  from characteristics, first = Start point, second =
      End point of block of data */
-    Box<Dims> BlockBox;
+    Box<SmallDims> BlockBox;
 
     /** Intersection box between BlockBox and variable block
      *  first = Start point, second = End point */
-    Box<Dims> IntersectionBox;
+    Box<SmallDims> IntersectionBox;
 
     /** Seeks (offsets) in serialized stream for intersection box */
     Box<size_t> Seeks;
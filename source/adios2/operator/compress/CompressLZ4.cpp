@@ -0,0 +1,173 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressLZ4.cpp
+ */
+
+#include "CompressLZ4.h"
+
+#include <algorithm> //std::min
+#include <cstdint>   //uint64_t
+#include <cstring>   //std::memcpy
+#include <ios>       //std::ios_base::failure
+#include <stdexcept> //std::invalid_argument
+
+extern "C" {
+#include <lz4.h>
+#include <lz4hc.h>
+}
+
+#include "adios2/helper/adiosFunctions.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+CompressLZ4::CompressLZ4(const Params &parameters, const bool debugMode)
+: CompressShuffle("lz4", parameters, debugMode)
+{
+}
+
+// PRIVATE
+size_t CompressLZ4::CompressBound(const size_t sizeIn) const
+{
+    const size_t chunkSize = static_cast<size_t>(LZ4_MAX_INPUT_SIZE);
+    const size_t chunks = sizeIn / chunkSize;
+    const size_t remainder = sizeIn % chunkSize;
+
+    size_t bound = chunks * (sizeof(uint64_t) +
+                             static_cast<size_t>(LZ4_compressBound(
+                                 static_cast<int>(chunkSize))));
+    if (remainder > 0)
+    {
+        bound += sizeof(uint64_t) + static_cast<size_t>(LZ4_compressBound(
+                                        static_cast<int>(remainder)));
+    }
+    return bound;
+}
+
+size_t CompressLZ4::CompressBytes(const char *dataIn, const size_t sizeIn,
+                                  char *bufferOut, const size_t maxSizeOut,
+                                  const Params &parameters) const
+{
+    // defaults
+    int level = 0;
+    int acceleration = 1;
+
+    const std::string hint(" in call to CompressLZ4 Compress\n");
+    helper::SetParameterValueInt("Level", parameters, level, m_DebugMode,
+                                 hint);
+    helper::SetParameterValueInt("Acceleration", parameters, acceleration,
+                                 m_DebugMode, hint);
+
+    if (m_DebugMode)
+    {
+        if (level < 0 || level > LZ4HC_CLEVEL_MAX)
+        {
+            throw std::invalid_argument(
+                "ERROR: Level must be an integer between 0 (fast LZ4) and " +
+                std::to_string(LZ4HC_CLEVEL_MAX) + " (LZ4 HC)," + hint);
+        }
+        if (acceleration < 1)
+        {
+            throw std::invalid_argument(
+                "ERROR: Acceleration must be an integer >= 1," + hint);
+        }
+    }
+
+    // LZ4 blocks are limited to LZ4_MAX_INPUT_SIZE, each chunk is stored
+    // after its compressed size
+    const size_t chunkSize = static_cast<size_t>(LZ4_MAX_INPUT_SIZE);
+    size_t positionIn = 0;
+    size_t positionOut = 0;
+
+    while (positionIn < sizeIn)
+    {
+        const size_t chunkIn = std::min(chunkSize, sizeIn - positionIn);
+        char *chunkOut = bufferOut + positionOut + sizeof(uint64_t);
+        const int maxChunkOut = static_cast<int>(std::min(
+            maxSizeOut - positionOut - sizeof(uint64_t),
+            static_cast<size_t>(
+                LZ4_compressBound(static_cast<int>(chunkIn)))));
+
+        const int sizeOut =
+            level == 0
+                ? LZ4_compress_fast(dataIn + positionIn, chunkOut,
+                                    static_cast<int>(chunkIn), maxChunkOut,
+                                    acceleration)
+                : LZ4_compress_HC(dataIn + positionIn, chunkOut,
+                                  static_cast<int>(chunkIn), maxChunkOut,
+                                  level);
+
+        if (sizeOut <= 0)
+        {
+            throw std::ios_base::failure(
+                "ERROR: LZ4 compression failed for " +
+                std::to_string(chunkIn) + " bytes at offset " +
+                std::to_string(positionIn) + "," + hint);
+        }
+
+        const uint64_t chunkSizeOut = static_cast<uint64_t>(sizeOut);
+        std::memcpy(bufferOut + positionOut, &chunkSizeOut,
+                    sizeof(uint64_t));
+        positionOut += sizeof(uint64_t) + chunkSizeOut;
+        positionIn += chunkIn;
+    }
+
+    return positionOut;
+}
+
+size_t CompressLZ4::DecompressBytes(const char *bufferIn, const size_t sizeIn,
+                                    char *dataOut, const size_t sizeOut) const
+{
+    const size_t chunkSize = static_cast<size_t>(LZ4_MAX_INPUT_SIZE);
+    size_t positionIn = 0;
+    size_t positionOut = 0;
+
+    while (positionIn < sizeIn)
+    {
+        uint64_t chunkSizeIn = 0;
+        if (sizeIn - positionIn >= sizeof(uint64_t))
+        {
+            std::memcpy(&chunkSizeIn, bufferIn + positionIn,
+                        sizeof(uint64_t));
+            positionIn += sizeof(uint64_t);
+        }
+
+        if (chunkSizeIn == 0 || chunkSizeIn > sizeIn - positionIn ||
+            chunkSizeIn > static_cast<uint64_t>(
+                              LZ4_compressBound(LZ4_MAX_INPUT_SIZE)))
+        {
+            throw std::invalid_argument(
+                "ERROR: LZ4 detected corrupted or truncated compressed data "
+                "at offset " +
+                std::to_string(positionIn) +
+                ", in call to CompressLZ4 Decompress\n");
+        }
+
+        const size_t chunkOut = std::min(chunkSize, sizeOut - positionOut);
+        const int size = LZ4_decompress_safe(
+            bufferIn + positionIn, dataOut + positionOut,
+            static_cast<int>(chunkSizeIn), static_cast<int>(chunkOut));
+
+        if (size < 0)
+        {
+            throw std::invalid_argument(
+                "ERROR: LZ4 detected corrupted or truncated compressed data, "
+                "in call to CompressLZ4 Decompress\n");
+        }
+
+        positionIn += static_cast<size_t>(chunkSizeIn);
+        positionOut += static_cast<size_t>(size);
+    }
+
+    return positionOut;
+}
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
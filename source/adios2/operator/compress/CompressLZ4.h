@@ -0,0 +1,56 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressLZ4.h : wrapper to LZ4 compression library, with a byte or bit
+ * shuffle pre-filter from CompressShuffle
+ */
+
+#ifndef ADIOS2_OPERATOR_COMPRESS_COMPRESSLZ4_H_
+#define ADIOS2_OPERATOR_COMPRESS_COMPRESSLZ4_H_
+
+#include "adios2/operator/compress/CompressShuffle.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+/**
+ * LZ4 blocks hold at most LZ4_MAX_INPUT_SIZE (~2GB) bytes, larger inputs
+ * are split: the compressed bytes are a sequence of chunks, each one a
+ * uint64_t compressed size followed by an LZ4 block.
+ * Parameters (besides Shuffle):
+ * Level: 0 (default) fast LZ4, 1 to 12 use LZ4 HC (slower, smaller)
+ * Acceleration: >= 1 (default 1), fast LZ4 only, higher is faster
+ */
+class CompressLZ4 : public CompressShuffle
+{
+
+public:
+    /**
+     * Unique constructor
+     * @param debugMode
+     */
+    CompressLZ4(const Params &parameters, const bool debugMode);
+
+    ~CompressLZ4() = default;
+
+private:
+    size_t CompressBound(const size_t sizeIn) const final;
+
+    size_t CompressBytes(const char *dataIn, const size_t sizeIn,
+                         char *bufferOut, const size_t maxSizeOut,
+                         const Params &parameters) const final;
+
+    size_t DecompressBytes(const char *bufferIn, const size_t sizeIn,
+                           char *dataOut, const size_t sizeOut) const final;
+};
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_COMPRESS_COMPRESSLZ4_H_ */
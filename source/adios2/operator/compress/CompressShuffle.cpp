@@ -0,0 +1,169 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressShuffle.cpp
+ */
+
+#include "CompressShuffle.h"
+
+#include <algorithm> //std::transform
+#include <memory>    //std::unique_ptr
+#include <stdexcept> //std::invalid_argument
+
+#include "adios2/helper/adiosFunctions.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+constexpr size_t CompressShuffle::m_HeaderSize;
+
+CompressShuffle::CompressShuffle(const std::string type,
+                                 const Params &parameters, const bool debugMode)
+: Operator(type, parameters, debugMode)
+{
+}
+
+size_t CompressShuffle::BufferMaxSize(const size_t sizeIn) const
+{
+    return m_HeaderSize + CompressBound(sizeIn);
+}
+
+size_t CompressShuffle::Compress(const void *dataIn, const Dims &dimensions,
+                                 const size_t elementSize,
+                                 const std::string type, void *bufferOut,
+                                 const Params &parameters) const
+{
+    const Params mergedParameters = MergeParameters(parameters);
+    const ShuffleMode mode =
+        GetShuffleMode(mergedParameters, elementSize, m_DebugMode);
+
+    const size_t sizeIn = helper::GetTotalSize(dimensions) * elementSize;
+    const char *input = reinterpret_cast<const char *>(dataIn);
+    char *output = reinterpret_cast<char *>(bufferOut);
+
+    output[0] = static_cast<char>(mode);
+    output[1] = static_cast<char>(mode == shuffle_none ? 1 : elementSize);
+
+    // not a vector, no need to zero the scratch memory
+    std::unique_ptr<char[]> shuffled;
+    if (mode != shuffle_none)
+    {
+        shuffled.reset(new char[sizeIn]);
+        if (mode == shuffle_byte)
+        {
+            helper::ByteShuffle(input, shuffled.get(), sizeIn, elementSize);
+        }
+        else
+        {
+            helper::BitShuffle(input, shuffled.get(), sizeIn, elementSize);
+        }
+        input = shuffled.get();
+    }
+
+    return m_HeaderSize + CompressBytes(input, sizeIn, output + m_HeaderSize,
+                                        CompressBound(sizeIn),
+                                        mergedParameters);
+}
+
+size_t CompressShuffle::Decompress(const void *bufferIn, const size_t sizeIn,
+                                   void *dataOut, const size_t sizeOut) const
+{
+    const char *input = reinterpret_cast<const char *>(bufferIn);
+    char *output = reinterpret_cast<char *>(dataOut);
+
+    if (sizeIn < m_HeaderSize)
+    {
+        throw std::invalid_argument("ERROR: " + m_Type +
+                                    " compressed buffer of " +
+                                    std::to_string(sizeIn) +
+                                    " bytes is too small, in call to "
+                                    "Decompress\n");
+    }
+
+    const ShuffleMode mode =
+        static_cast<ShuffleMode>(static_cast<uint8_t>(input[0]));
+    const size_t elementSize = static_cast<uint8_t>(input[1]);
+
+    if (mode != shuffle_none && mode != shuffle_byte && mode != shuffle_bit)
+    {
+        throw std::invalid_argument("ERROR: unknown shuffle mode " +
+                                    std::to_string(static_cast<int>(mode)) +
+                                    " in " + m_Type +
+                                    " compressed buffer, in call to "
+                                    "Decompress\n");
+    }
+
+    if (mode == shuffle_none)
+    {
+        return DecompressBytes(input + m_HeaderSize, sizeIn - m_HeaderSize,
+                               output, sizeOut);
+    }
+
+    std::unique_ptr<char[]> shuffled(new char[sizeOut]);
+    const size_t size = DecompressBytes(
+        input + m_HeaderSize, sizeIn - m_HeaderSize, shuffled.get(), sizeOut);
+
+    if (mode == shuffle_byte)
+    {
+        helper::ByteUnshuffle(shuffled.get(), output, size, elementSize);
+    }
+    else
+    {
+        helper::BitUnshuffle(shuffled.get(), output, size, elementSize);
+    }
+    return size;
+}
+
+CompressShuffle::ShuffleMode
+CompressShuffle::GetShuffleMode(const Params &parameters,
+                                const size_t elementSize, const bool debugMode)
+{
+    // the header stores the element size in one byte
+    if (elementSize <= 1 || elementSize > 255)
+    {
+        return shuffle_none;
+    }
+
+    auto itShuffle = parameters.find("Shuffle");
+    if (itShuffle == parameters.end())
+    {
+        return shuffle_byte;
+    }
+
+    std::string value(itShuffle->second);
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+    if (value == "byte")
+    {
+        return shuffle_byte;
+    }
+    if (value == "bit")
+    {
+        return shuffle_bit;
+    }
+    if (debugMode && value != "none")
+    {
+        throw std::invalid_argument(
+            "ERROR: Shuffle parameter must be byte, bit or none, found " +
+            itShuffle->second + ", in call to Compress\n");
+    }
+    return shuffle_none;
+}
+
+Params CompressShuffle::MergeParameters(const Params &parameters) const
+{
+    Params mergedParameters = m_Parameters;
+    for (const auto &parameter : parameters)
+    {
+        mergedParameters[parameter.first] = parameter.second;
+    }
+    return mergedParameters;
+}
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,98 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressShuffle.h : common base of the fast lossless compressors (LZ4,
+ * Zstd), applies a byte or bit shuffle pre-filter to typed data before the
+ * compression library is called
+ */
+
+#ifndef ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLE_H_
+#define ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLE_H_
+
+#include "adios2/core/Operator.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+/**
+ * Compressed buffers start with a 2 byte header: shuffle mode and element
+ * size used by the pre-filter, so they can be decompressed without the
+ * original parameters.
+ * Parameters (from DefineOperator, overridden by AddOperation):
+ * Shuffle: byte (default for elements larger than 1 byte), bit or none
+ */
+class CompressShuffle : public Operator
+{
+
+public:
+    CompressShuffle(const std::string type, const Params &parameters,
+                    const bool debugMode);
+
+    virtual ~CompressShuffle() = default;
+
+    size_t BufferMaxSize(const size_t sizeIn) const final;
+
+    size_t Compress(const void *dataIn, const Dims &dimensions,
+                    const size_t elementSize, const std::string type,
+                    void *bufferOut,
+                    const Params &parameters = Params()) const final;
+
+    using Operator::Decompress;
+
+    size_t Decompress(const void *bufferIn, const size_t sizeIn, void *dataOut,
+                      const size_t sizeOut) const final;
+
+    enum ShuffleMode
+    {
+        shuffle_none = 0,
+        shuffle_byte = 1,
+        shuffle_bit = 2
+    };
+
+    /**
+     * Shuffle mode from the Shuffle parameter
+     * @param parameters merged operator parameters
+     * @param elementSize bytes per element, no shuffle if 1
+     * @param debugMode true: throws on unknown values
+     */
+    static ShuffleMode GetShuffleMode(const Params &parameters,
+                                      const size_t elementSize,
+                                      const bool debugMode);
+
+protected:
+    /** header with shuffle mode and element size */
+    static constexpr size_t m_HeaderSize = 2;
+
+    /** Library bound on the compressed size of sizeIn bytes */
+    virtual size_t CompressBound(const size_t sizeIn) const = 0;
+
+    /**
+     * Library compression of the (shuffled) input
+     * @return compressed size in bytes
+     */
+    virtual size_t CompressBytes(const char *dataIn, const size_t sizeIn,
+                                 char *bufferOut, const size_t maxSizeOut,
+                                 const Params &parameters) const = 0;
+
+    /**
+     * Library decompression into the (shuffled) output
+     * @return decompressed size in bytes
+     */
+    virtual size_t DecompressBytes(const char *bufferIn, const size_t sizeIn,
+                                   char *dataOut,
+                                   const size_t sizeOut) const = 0;
+
+    /** Operator parameters overridden by parameters passed to Compress */
+    Params MergeParameters(const Params &parameters) const;
+};
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLE_H_ */
@@ -10,6 +10,8 @@
 
 #include "CompressZfp.h"
 
+#include <algorithm> //std::min
+
 #include "adios2/helper/adiosFunctions.h"
 
 namespace adios2
@@ -70,20 +72,6 @@ size_t CompressZfp::Decompress(const void *bufferIn, const size_t sizeIn,
                                const std::string type,
                                const Params &parameters) const
 {
-    auto lf_GetTypeSize = [](const zfp_type zfpType) -> size_t {
-
-        size_t size = 0;
-        if (zfpType == zfp_type_int32 || zfpType == zfp_type_float)
-        {
-            size = 4;
-        }
-        else if (zfpType == zfp_type_int64 || zfpType == zfp_type_double)
-        {
-            size = 8;
-        }
-        return size;
-    };
-
     zfp_field *field = GetZFPField(dataOut, dimensions, type);
     zfp_stream *stream = GetZFPStream(dimensions, type, parameters);
 
@@ -108,14 +96,133 @@ size_t CompressZfp::Decompress(const void *bufferIn, const size_t sizeIn,
     zfp_stream_close(stream);
     stream_close(bitstream);
 
-    const size_t typeSizeBytes = lf_GetTypeSize(GetZfpType(type));
+    const size_t typeSizeBytes = GetTypeSize(GetZfpType(type));
     const size_t dataSizeBytes =
         helper::GetTotalSize(dimensions) * typeSizeBytes;
 
     return dataSizeBytes;
 }
 
+void CompressZfp::DecompressRange(const void *bufferIn, const size_t sizeIn,
+                                  void *dataOut, const Dims &dimensions,
+                                  const std::string type,
+                                  const Params &parameters, const size_t start,
+                                  const size_t end) const
+{
+    BlockRange range;
+    if (!GetBlockRange(dimensions, type, parameters, start, end, range))
+    {
+        Decompress(bufferIn, sizeIn, dataOut, dimensions, type, parameters);
+        return;
+    }
+
+    char *rangeData = reinterpret_cast<char *>(dataOut) + range.DataStart;
+    zfp_field *field = GetZFPField(rangeData, range.Dimensions, type);
+    zfp_stream *stream = GetZFPStream(dimensions, type, parameters);
+
+    // blocks are stored with the fastest dimension first, the sub-field is
+    // a contiguous run of blocks starting at BitStart
+    bitstream *bitstream = stream_open(const_cast<void *>(bufferIn), sizeIn);
+    zfp_stream_set_bit_stream(stream, bitstream);
+    stream_rseek(bitstream, range.BitStart);
+
+    int status = zfp_decompress(stream, field);
+
+    if (m_DebugMode)
+    {
+        if (!status)
+        {
+            throw std::invalid_argument(
+                "ERROR: zfp failed with status " + std::to_string(status) +
+                ", in call to CompressZfp DecompressRange\n");
+        }
+    }
+
+    zfp_field_free(field);
+    zfp_stream_close(stream);
+    stream_close(bitstream);
+}
+
+bool CompressZfp::GetPayloadRange(const Dims &dimensions,
+                                  const std::string type,
+                                  const Params &parameters, const size_t start,
+                                  const size_t end, size_t &payloadStart,
+                                  size_t &payloadEnd) const
+{
+    BlockRange range;
+    if (!GetBlockRange(dimensions, type, parameters, start, end, range))
+    {
+        return false;
+    }
+
+    // the bitstream reads whole words
+    const size_t wordBits = static_cast<size_t>(stream_word_bits);
+    payloadStart = range.BitStart / wordBits * wordBits / 8;
+    payloadEnd = (range.BitEnd + wordBits - 1) / wordBits * wordBits / 8;
+    return true;
+}
+
 // PRIVATE
+bool CompressZfp::GetBlockRange(const Dims &dimensions, const std::string type,
+                                const Params &parameters, const size_t start,
+                                const size_t end, BlockRange &range) const
+{
+    if (parameters.count("rate") == 0 || dimensions.empty() ||
+        dimensions.size() > 3)
+    {
+        return false;
+    }
+
+    const size_t elementSize = GetTypeSize(GetZfpType(type));
+    const size_t last = dimensions.size() - 1;
+
+    // zfp uses dimensions[0] as the fastest, blocks are 4 elements wide
+    size_t planeElements = 1;
+    size_t planeBlocks = 1;
+    for (size_t d = 0; d < last; ++d)
+    {
+        planeElements *= dimensions[d];
+        planeBlocks *= (dimensions[d] + 3) / 4;
+    }
+
+    if (elementSize == 0 || planeElements == 0 || end <= start)
+    {
+        return false;
+    }
+
+    const size_t elementStart = start / elementSize;
+    const size_t elementEnd = (end + elementSize - 1) / elementSize;
+    // rows of blocks along the last dimension, [rowStart, rowEnd)
+    const size_t rowStart = elementStart / planeElements / 4;
+    const size_t rowEnd = (elementEnd - 1) / planeElements / 4 + 1;
+
+    zfp_stream *stream = GetZFPStream(dimensions, type, parameters);
+    const size_t blockBits = static_cast<size_t>(stream->maxbits);
+    zfp_stream_close(stream);
+
+    range.Dimensions = dimensions;
+    range.Dimensions[last] =
+        std::min(dimensions[last], 4 * rowEnd) - 4 * rowStart;
+    range.DataStart = 4 * rowStart * planeElements * elementSize;
+    range.BitStart = rowStart * planeBlocks * blockBits;
+    range.BitEnd = rowEnd * planeBlocks * blockBits;
+    return true;
+}
+
+size_t CompressZfp::GetTypeSize(const zfp_type zfpType) noexcept
+{
+    size_t size = 0;
+    if (zfpType == zfp_type_int32 || zfpType == zfp_type_float)
+    {
+        size = 4;
+    }
+    else if (zfpType == zfp_type_int64 || zfpType == zfp_type_double)
+    {
+        size = 8;
+    }
+    return size;
+}
+
 zfp_type CompressZfp::GetZfpType(const std::string type) const
 {
     zfp_type zfpType = zfp_type_none;
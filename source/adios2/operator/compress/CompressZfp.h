@@ -60,7 +60,63 @@ public:
                       const Dims &dimensions, const std::string type,
                       const Params &parameters) const final;
 
+    /**
+     * Decompresses at least the bytes [start, end) of the original data. In
+     * fixed rate mode (rate parameter) every zfp block has the same number
+     * of bits, only the blocks along the slowest zfp dimension covering the
+     * range are decoded. Other modes decompress all data.
+     * @param bufferIn
+     * @param sizeIn
+     * @param dataOut sized for all data, bytes outside the decoded blocks
+     * are not modified
+     * @param dimensions
+     * @param type
+     * @param parameters
+     * @param start first byte needed in dataOut
+     * @param end byte past the last needed in dataOut
+     */
+    void DecompressRange(const void *bufferIn, const size_t sizeIn,
+                         void *dataOut, const Dims &dimensions,
+                         const std::string type, const Params &parameters,
+                         const size_t start, const size_t end) const;
+
+    /**
+     * Bytes of bufferIn read by DecompressRange for the same range
+     * @param payloadStart output, first byte read
+     * @param payloadEnd output, byte past the last read, might exceed the
+     * compressed size
+     * @return false: not fixed rate, DecompressRange reads all bytes
+     */
+    bool GetPayloadRange(const Dims &dimensions, const std::string type,
+                         const Params &parameters, const size_t start,
+                         const size_t end, size_t &payloadStart,
+                         size_t &payloadEnd) const;
+
 private:
+    /** zfp blocks covering a range of the data in a fixed rate stream */
+    struct BlockRange
+    {
+        /** decoded sub-field, only the last dimension is shorter */
+        Dims Dimensions;
+        /** bytes in the data before the sub-field */
+        size_t DataStart = 0;
+        /** first bit of the sub-field in the stream */
+        size_t BitStart = 0;
+        /** bit past the last of the sub-field in the stream */
+        size_t BitEnd = 0;
+    };
+
+    /**
+     * Finds the zfp blocks covering bytes [start, end) of the data
+     * @return false: not fixed rate, range is not set
+     */
+    bool GetBlockRange(const Dims &dimensions, const std::string type,
+                       const Params &parameters, const size_t start,
+                       const size_t end, BlockRange &range) const;
+
+    /** @return bytes per element of zfpType, 0 if not supported */
+    static size_t GetTypeSize(const zfp_type zfpType) noexcept;
+
     /**
      * Returns Zfp supported zfp_type based on adios string type
      * @param type adios type as string, see GetType<T> in
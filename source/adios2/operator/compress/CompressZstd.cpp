@@ -0,0 +1,89 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressZstd.cpp
+ */
+
+#include "CompressZstd.h"
+
+#include <ios>       //std::ios_base::failure
+#include <stdexcept> //std::invalid_argument
+
+extern "C" {
+#include <zstd.h>
+}
+
+#include "adios2/helper/adiosFunctions.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+CompressZstd::CompressZstd(const Params &parameters, const bool debugMode)
+: CompressShuffle("zstd", parameters, debugMode)
+{
+}
+
+// PRIVATE
+size_t CompressZstd::CompressBound(const size_t sizeIn) const
+{
+    return ZSTD_compressBound(sizeIn);
+}
+
+size_t CompressZstd::CompressBytes(const char *dataIn, const size_t sizeIn,
+                                   char *bufferOut, const size_t maxSizeOut,
+                                   const Params &parameters) const
+{
+    // defaults
+    int level = 3;
+
+    const std::string hint(" in call to CompressZstd Compress\n");
+    helper::SetParameterValueInt("Level", parameters, level, m_DebugMode,
+                                 hint);
+
+    if (m_DebugMode)
+    {
+        if (level > ZSTD_maxCLevel())
+        {
+            throw std::invalid_argument(
+                "ERROR: Level must be an integer up to " +
+                std::to_string(ZSTD_maxCLevel()) + "," + hint);
+        }
+    }
+
+    const size_t sizeOut =
+        ZSTD_compress(bufferOut, maxSizeOut, dataIn, sizeIn, level);
+
+    if (ZSTD_isError(sizeOut))
+    {
+        throw std::ios_base::failure("ERROR: Zstd compression failed, " +
+                                     std::string(ZSTD_getErrorName(sizeOut)) +
+                                     "," + hint);
+    }
+
+    return sizeOut;
+}
+
+size_t CompressZstd::DecompressBytes(const char *bufferIn, const size_t sizeIn,
+                                     char *dataOut, const size_t sizeOut) const
+{
+    const size_t size = ZSTD_decompress(dataOut, sizeOut, bufferIn, sizeIn);
+
+    if (ZSTD_isError(size))
+    {
+        throw std::invalid_argument(
+            "ERROR: Zstd decompression failed, " +
+            std::string(ZSTD_getErrorName(size)) +
+            ", in call to CompressZstd Decompress\n");
+    }
+
+    return size;
+}
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,52 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressZstd.h : wrapper to Zstd compression library, with a byte or bit
+ * shuffle pre-filter from CompressShuffle
+ */
+
+#ifndef ADIOS2_OPERATOR_COMPRESS_COMPRESSZSTD_H_
+#define ADIOS2_OPERATOR_COMPRESS_COMPRESSZSTD_H_
+
+#include "adios2/operator/compress/CompressShuffle.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+/**
+ * Parameters (besides Shuffle):
+ * Level: up to 19 or 22 (ultra), default 3, negative levels are faster
+ */
+class CompressZstd : public CompressShuffle
+{
+
+public:
+    /**
+     * Unique constructor
+     * @param debugMode
+     */
+    CompressZstd(const Params &parameters, const bool debugMode);
+
+    ~CompressZstd() = default;
+
+private:
+    size_t CompressBound(const size_t sizeIn) const final;
+
+    size_t CompressBytes(const char *dataIn, const size_t sizeIn,
+                         char *bufferOut, const size_t maxSizeOut,
+                         const Params &parameters) const final;
+
+    size_t DecompressBytes(const char *bufferIn, const size_t sizeIn,
+                           char *dataOut, const size_t sizeOut) const final;
+};
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_COMPRESS_COMPRESSZSTD_H_ */
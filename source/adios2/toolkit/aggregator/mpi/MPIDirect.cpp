@@ -0,0 +1,131 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPIDirect.cpp
+ */
+
+#include "MPIDirect.h"
+
+#include <algorithm> //std::min
+
+#include "adios2/ADIOSMPI.h"
+#include "adios2/helper/adiosFunctions.h" //helper::CheckMPIReturn
+
+namespace adios2
+{
+namespace aggregator
+{
+
+MPIDirect::MPIDirect() : MPIAggregator() {}
+
+void MPIDirect::Init(const size_t subStreams, MPI_Comm parentComm)
+{
+    InitComm(subStreams, parentComm);
+    HandshakeRank(0);
+
+    // consumer receives into one buffer while writing the other
+    if (m_Rank == 0)
+    {
+        m_Buffers.resize(2);
+    }
+}
+
+std::vector<MPI_Request> MPIDirect::IExchange(BufferSTL &bufferSTL,
+                                              const int step)
+{
+    std::vector<MPI_Request> requests;
+
+    const int producer = step + 1;
+    if (m_Size == 1 || producer >= m_Size)
+    {
+        return requests;
+    }
+
+    if (m_Rank == producer)
+    {
+        const size_t size = bufferSTL.m_Position;
+        requests.reserve(size / m_ChunkSize + 2);
+
+        requests.emplace_back();
+        helper::CheckMPIReturn(MPI_Isend(&bufferSTL.m_Position, 1,
+                                         ADIOS2_MPI_SIZE_T, 0, 0, m_Comm,
+                                         &requests.back()),
+                               ", aggregation Isend size at iteration " +
+                                   std::to_string(step) + "\n");
+
+        // same source and tag, chunks arrive in order
+        for (size_t position = 0; position < size; position += m_ChunkSize)
+        {
+            const size_t chunkSize = std::min(m_ChunkSize, size - position);
+            requests.emplace_back();
+            helper::CheckMPIReturn(
+                MPI_Isend(bufferSTL.m_Buffer.data() + position,
+                          static_cast<int>(chunkSize), MPI_CHAR, 0, 1, m_Comm,
+                          &requests.back()),
+                ", aggregation Isend data at iteration " +
+                    std::to_string(step) + "\n");
+        }
+    }
+    else if (m_Rank == 0)
+    {
+        size_t size = 0;
+        MPI_Status status;
+        helper::CheckMPIReturn(MPI_Recv(&size, 1, ADIOS2_MPI_SIZE_T, producer,
+                                        0, m_Comm, &status),
+                               ", aggregation Recv size at iteration " +
+                                   std::to_string(step) + "\n");
+
+        BufferSTL &receiveBuffer = m_Buffers[producer % 2];
+        receiveBuffer.Resize(size,
+                             "in aggregation, when resizing receiving buffer "
+                             "to size " +
+                                 std::to_string(size));
+        receiveBuffer.m_Position = size;
+
+        requests.reserve(size / m_ChunkSize + 1);
+        for (size_t position = 0; position < size; position += m_ChunkSize)
+        {
+            const size_t chunkSize = std::min(m_ChunkSize, size - position);
+            requests.emplace_back();
+            helper::CheckMPIReturn(
+                MPI_Irecv(receiveBuffer.m_Buffer.data() + position,
+                          static_cast<int>(chunkSize), MPI_CHAR, producer, 1,
+                          m_Comm, &requests.back()),
+                ", aggregation Irecv data at iteration " +
+                    std::to_string(step) + "\n");
+        }
+    }
+
+    return requests;
+}
+
+void MPIDirect::Wait(std::vector<MPI_Request> &requests, const int step)
+{
+    MPI_Status status;
+    for (MPI_Request &request : requests)
+    {
+        helper::CheckMPIReturn(MPI_Wait(&request, &status),
+                               ", aggregation waiting for data at iteration " +
+                                   std::to_string(step) + "\n");
+    }
+}
+
+void MPIDirect::SwapBuffers(const int step) noexcept
+{
+    m_ConsumerStep = step + 1;
+}
+
+void MPIDirect::ResetBuffers() noexcept { m_ConsumerStep = 0; }
+
+BufferSTL &MPIDirect::GetConsumerBuffer(BufferSTL &bufferSTL)
+{
+    if (m_ConsumerStep == 0)
+    {
+        return bufferSTL;
+    }
+    return m_Buffers[m_ConsumerStep % 2];
+}
+
+} // end namespace aggregator
+} // end namespace adios2
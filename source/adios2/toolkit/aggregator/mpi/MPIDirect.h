@@ -0,0 +1,56 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPIDirect.h aggregation where every producer sends its buffer straight to
+ * the consumer in fixed size chunks
+ */
+
+#ifndef ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPIDIRECT_H_
+#define ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPIDIRECT_H_
+
+#include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
+
+namespace adios2
+{
+namespace aggregator
+{
+
+/**
+ * Unlike MPIChain, data crosses a single hop: at iteration step the producer
+ * step + 1 sends to the consumer, which receives into one of two buffers
+ * while the other one, holding the data of producer step, is written.
+ */
+class MPIDirect : public MPIAggregator
+{
+
+public:
+    MPIDirect();
+
+    ~MPIDirect() = default;
+
+    void Init(const size_t subStreams, MPI_Comm parentComm) final;
+
+    std::vector<MPI_Request> IExchange(BufferSTL &bufferSTL,
+                                       const int step) final;
+
+    void Wait(std::vector<MPI_Request> &requests, const int step) final;
+
+    void SwapBuffers(const int step) noexcept final;
+
+    void ResetBuffers() noexcept final;
+
+    BufferSTL &GetConsumerBuffer(BufferSTL &bufferSTL) final;
+
+private:
+    /** max bytes per message, also keeps counts within int range */
+    const size_t m_ChunkSize = 16777216;
+
+    /** iteration (producer rank) whose data GetConsumerBuffer returns */
+    int m_ConsumerStep = 0;
+};
+
+} // end namespace aggregator
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPIDIRECT_H_ */
@@ -0,0 +1,87 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BlockCache.cpp
+ */
+
+#include "BlockCache.h"
+
+namespace adios2
+{
+
+void BlockCache::SetCapacity(const size_t capacity)
+{
+    m_Capacity = capacity;
+    Evict(0);
+}
+
+bool BlockCache::IsActive() const noexcept { return m_Capacity > 0; }
+
+bool BlockCache::Fits(const size_t size) const noexcept
+{
+    return m_Capacity > 0 && size <= m_Capacity;
+}
+
+size_t BlockCache::GetSize() const noexcept { return m_Size; }
+
+const std::vector<char> *BlockCache::Find(const size_t subStreamID,
+                                          const size_t payloadOffset,
+                                          const bool isDecompressed)
+{
+    auto itIndex =
+        m_Index.find(Key(subStreamID, payloadOffset, isDecompressed));
+    if (itIndex == m_Index.end())
+    {
+        ++m_Misses;
+        return nullptr;
+    }
+
+    ++m_Hits;
+    // list iterators stay valid when splicing
+    m_Entries.splice(m_Entries.begin(), m_Entries, itIndex->second);
+    return &itIndex->second->Payload;
+}
+
+bool BlockCache::Contains(const size_t subStreamID, const size_t payloadOffset,
+                          const bool isDecompressed) const
+{
+    return m_Index.count(Key(subStreamID, payloadOffset, isDecompressed)) ==
+           1;
+}
+
+void BlockCache::Insert(const size_t subStreamID, const size_t payloadOffset,
+                        const bool isDecompressed, std::vector<char> &&payload)
+{
+    const Key key(subStreamID, payloadOffset, isDecompressed);
+    if (!Fits(payload.size()) || m_Index.count(key) == 1)
+    {
+        return;
+    }
+
+    Evict(payload.size());
+    m_Size += payload.size();
+    m_Entries.push_front(Entry{key, std::move(payload)});
+    m_Index.emplace(key, m_Entries.begin());
+}
+
+void BlockCache::Clear() noexcept
+{
+    m_Index.clear();
+    m_Entries.clear();
+    m_Size = 0;
+}
+
+// PRIVATE
+void BlockCache::Evict(const size_t size)
+{
+    while (!m_Entries.empty() && m_Size + size > m_Capacity)
+    {
+        const Entry &entry = m_Entries.back();
+        m_Size -= entry.Payload.size();
+        m_Index.erase(entry.CacheKey);
+        m_Entries.pop_back();
+    }
+}
+
+} // end namespace adios2
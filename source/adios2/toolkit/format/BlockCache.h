@@ -0,0 +1,98 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BlockCache.h : size bounded least recently used cache of block payloads,
+ * keyed by subfile and payload offset
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BLOCKCACHE_H_
+#define ADIOS2_TOOLKIT_FORMAT_BLOCKCACHE_H_
+
+#include <list>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "adios2/ADIOSTypes.h"
+
+namespace adios2
+{
+
+class BlockCache
+{
+public:
+    /** Find calls that returned a cached payload */
+    size_t m_Hits = 0;
+
+    /** Find calls that returned nullptr */
+    size_t m_Misses = 0;
+
+    BlockCache() = default;
+    ~BlockCache() = default;
+
+    /**
+     * Sets the bytes budget for cached payloads, evicts least recently used
+     * payloads that no longer fit
+     * @param capacity 0: cache is disabled
+     */
+    void SetCapacity(const size_t capacity);
+
+    /** @return true: capacity is not zero */
+    bool IsActive() const noexcept;
+
+    /** @return true: a payload of size bytes can be cached */
+    bool Fits(const size_t size) const noexcept;
+
+    /** @return bytes held by cached payloads */
+    size_t GetSize() const noexcept;
+
+    /**
+     * Looks for a payload and marks it as most recently used, counts a hit
+     * or a miss
+     * @param subStreamID subfile holding the payload
+     * @param payloadOffset payload position in subfile
+     * @param isDecompressed true: operator output, false: bytes as stored
+     * @return cached payload, valid until the next Insert, or nullptr
+     */
+    const std::vector<char> *Find(const size_t subStreamID,
+                                  const size_t payloadOffset,
+                                  const bool isDecompressed);
+
+    /** @return true: payload is cached, doesn't count as hit or miss */
+    bool Contains(const size_t subStreamID, const size_t payloadOffset,
+                  const bool isDecompressed) const;
+
+    /**
+     * Adds payload as most recently used, evicting least recently used
+     * payloads until it fits. Ignored if it doesn't Fit or is cached.
+     */
+    void Insert(const size_t subStreamID, const size_t payloadOffset,
+                const bool isDecompressed, std::vector<char> &&payload);
+
+    /** Frees all payloads, keeps capacity and counters */
+    void Clear() noexcept;
+
+private:
+    using Key = std::tuple<size_t, size_t, bool>;
+
+    struct Entry
+    {
+        Key CacheKey;
+        std::vector<char> Payload;
+    };
+
+    /** front is most recently used */
+    std::list<Entry> m_Entries;
+    std::map<Key, std::list<Entry>::iterator> m_Index;
+
+    size_t m_Capacity = 0;
+    size_t m_Size = 0;
+
+    /** Removes least recently used payloads until size bytes are free */
+    void Evict(const size_t size);
+};
+
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BLOCKCACHE_H_ */
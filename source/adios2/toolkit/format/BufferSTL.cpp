@@ -10,9 +10,26 @@
 
 #include "BufferSTL.h"
 
+#include <algorithm> //std::min_element, std::max
+#include <cstdint>   //uintptr_t
+#include <mutex>
+
+#ifdef __linux__
+#include <sys/mman.h> //madvise
+#include <unistd.h>   //sysconf
+#endif
+
 namespace adios2
 {
 
+namespace
+{
+
+std::mutex PoolMutex;
+std::vector<std::vector<char>> Pool;
+
+} // end anonymous namespace
+
 void BufferSTL::Resize(const size_t size, const std::string hint)
 {
     try
@@ -20,6 +37,7 @@ void BufferSTL::Resize(const size_t size, const std::string hint)
         // doing this will effectively replace the STL GNU default power of 2
         // reallocation.
         m_Buffer.reserve(size);
+        AdviseHugePages();
         // must initialize memory (secure)
         m_Buffer.resize(size, '\0');
     }
@@ -29,6 +47,7 @@ void BufferSTL::Resize(const size_t size, const std::string hint)
             "ERROR: buffer overflow when resizing to " + std::to_string(size) +
             " bytes, " + hint + "\n"));
     }
+    m_PeakSize = std::max(m_PeakSize, m_SegmentsSize + m_Buffer.size());
 }
 
 size_t BufferSTL::GetAvailableSize() const
@@ -36,4 +55,158 @@ size_t BufferSTL::GetAvailableSize() const
     return m_Buffer.size() - m_Position;
 }
 
+void BufferSTL::AddSegment(const size_t size, const std::string hint)
+{
+    m_Buffer.resize(m_Position);
+    m_SegmentsSize += m_Position;
+    m_Segments.push_back(std::vector<char>());
+    m_Segments.back().swap(m_Buffer);
+    m_Position = 0;
+    Resize(size, hint);
+}
+
+size_t BufferSTL::GetSegmentedPosition() const noexcept
+{
+    return m_SegmentsSize + m_Position;
+}
+
+std::vector<char> &BufferSTL::GetSegment(size_t &position)
+{
+    for (auto &segment : m_Segments)
+    {
+        if (position < segment.size())
+        {
+            return segment;
+        }
+        position -= segment.size();
+    }
+    return m_Buffer;
+}
+
+void BufferSTL::JoinSegments(const std::string hint)
+{
+    if (m_Segments.empty())
+    {
+        return;
+    }
+
+    std::vector<char> joined;
+    try
+    {
+        joined.reserve(m_SegmentsSize + m_Buffer.size());
+    }
+    catch (...)
+    {
+        std::throw_with_nested(std::runtime_error(
+            "ERROR: buffer overflow when joining segments into " +
+            std::to_string(m_SegmentsSize + m_Buffer.size()) + " bytes, " +
+            hint + "\n"));
+    }
+
+    for (const auto &segment : m_Segments)
+    {
+        joined.insert(joined.end(), segment.begin(), segment.end());
+    }
+    joined.insert(joined.end(), m_Buffer.begin(), m_Buffer.end());
+
+    m_Buffer.swap(joined);
+    m_Position += m_SegmentsSize;
+    ClearSegments();
+    m_PeakSize = std::max(m_PeakSize, m_Buffer.size());
+}
+
+void BufferSTL::ClearSegments() noexcept
+{
+    m_Segments.clear();
+    m_SegmentsSize = 0;
+}
+
+bool BufferSTL::ResizeFromPool(const size_t size)
+{
+    std::vector<char> pooled;
+    {
+        std::lock_guard<std::mutex> lock(PoolMutex);
+        // smallest pooled buffer that fits
+        auto itBest = Pool.end();
+        for (auto it = Pool.begin(); it != Pool.end(); ++it)
+        {
+            if (it->size() >= size &&
+                (itBest == Pool.end() || it->size() < itBest->size()))
+            {
+                itBest = it;
+            }
+        }
+
+        if (itBest == Pool.end())
+        {
+            return false;
+        }
+        pooled.swap(*itBest);
+        Pool.erase(itBest);
+    }
+
+    // pooled buffers keep size == capacity, writes rely on it
+    m_Buffer.swap(pooled);
+    m_PeakSize = std::max(m_PeakSize, m_Buffer.size());
+    return true;
+}
+
+void BufferSTL::ReleaseToPool()
+{
+    if (m_Buffer.empty())
+    {
+        return;
+    }
+
+    // must not be resized again, make size and capacity match
+    m_Buffer.resize(m_Buffer.capacity());
+
+    std::vector<char> released;
+    released.swap(m_Buffer);
+    m_Position = 0;
+    m_AbsolutePosition = 0;
+
+    std::lock_guard<std::mutex> lock(PoolMutex);
+    if (Pool.size() < MaxPoolBuffers)
+    {
+        Pool.push_back(std::move(released));
+        return;
+    }
+
+    auto itSmallest = std::min_element(
+        Pool.begin(), Pool.end(),
+        [](const std::vector<char> &a, const std::vector<char> &b) {
+            return a.size() < b.size();
+        });
+    if (itSmallest->size() < released.size())
+    {
+        itSmallest->swap(released);
+    }
+    // released (the smallest) is freed here, outside the pool
+}
+
+size_t BufferSTL::GetPeakSize() const noexcept { return m_PeakSize; }
+
+void BufferSTL::AdviseHugePages() noexcept
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // huge pages are 2MB, smaller buffers gain nothing
+    const size_t hugePageSize = 2097152;
+    if (m_Buffer.capacity() < 2 * hugePageSize)
+    {
+        return;
+    }
+
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(m_Buffer.data());
+    const uintptr_t alignedBegin = (begin + pageSize - 1) / pageSize * pageSize;
+    const uintptr_t end = begin + m_Buffer.capacity();
+    const uintptr_t alignedEnd = end / pageSize * pageSize;
+
+    // only a hint, the buffer works the same if it fails
+    madvise(reinterpret_cast<void *>(alignedBegin), alignedEnd - alignedBegin,
+            MADV_HUGEPAGE);
+#endif
+}
+
 } // end namespace adios2
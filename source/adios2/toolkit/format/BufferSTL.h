@@ -26,6 +26,13 @@ public:
     size_t m_Position = 0;
     size_t m_AbsolutePosition = 0;
 
+    /** buffers filled before m_Buffer when growing by segments, they come
+     * before m_Buffer in the output, see AddSegment */
+    std::vector<std::vector<char>> m_Segments;
+
+    /** total bytes in m_Segments */
+    size_t m_SegmentsSize = 0;
+
     BufferSTL() = default;
     ~BufferSTL() = default;
 
@@ -33,8 +40,61 @@ public:
 
     size_t GetAvailableSize() const;
 
+    /**
+     * Moves m_Buffer, up to m_Position, to m_Segments and continues in a new
+     * m_Buffer starting at m_Position = 0. Unlike Resize, previous bytes are
+     * not copied.
+     * @param size new m_Buffer size
+     * @param hint added to exception message
+     */
+    void AddSegment(const size_t size, const std::string hint);
+
+    /** @return m_Position counting the bytes in m_Segments */
+    size_t GetSegmentedPosition() const noexcept;
+
+    /**
+     * Finds the buffer holding a position counted from the first segment
+     * @param position input: segmented position, output: position inside
+     * the returned buffer
+     * @return segment or m_Buffer
+     */
+    std::vector<char> &GetSegment(size_t &position);
+
+    /** Copies m_Segments and m_Buffer into a single m_Buffer, for consumers
+     * that require contiguous memory */
+    void JoinSegments(const std::string hint);
+
+    /** Frees m_Segments, m_Buffer is kept */
+    void ClearSegments() noexcept;
+
+    /**
+     * Takes a buffer of at least size bytes released by another BufferSTL
+     * instead of allocating a new one, contents are not initialized
+     * @param size minimum buffer size
+     * @return true: pooled buffer was taken, false: pool has none that fits
+     */
+    bool ResizeFromPool(const size_t size);
+
+    /**
+     * Moves m_Buffer to a process-wide pool for reuse by ResizeFromPool,
+     * leaves this buffer empty. The pool keeps the largest buffers up to
+     * MaxPoolBuffers, smaller ones are freed.
+     */
+    void ReleaseToPool();
+
+    /** @return largest size, segments included, reached since construction */
+    size_t GetPeakSize() const noexcept;
+
+    /** max buffers retained by the process-wide pool */
+    static constexpr size_t MaxPoolBuffers = 4;
+
 private:
     const bool m_DebugMode = false;
+
+    size_t m_PeakSize = 0;
+
+    /** hints the OS to back large buffers with huge pages */
+    void AdviseHugePages() noexcept;
 };
 
 } // end namespace adios2
@@ -16,6 +16,7 @@
 #include "adios2/ADIOSTypes.h"            //PathSeparator
 #include "adios2/helper/adiosFunctions.h" //CreateDirectory, StringToTimeUnit,
 
+#include "adios2/toolkit/format/bp3/operation/BP3Lossless.h"
 #include "adios2/toolkit/format/bp3/operation/BP3MGARD.h"
 #include "adios2/toolkit/format/bp3/operation/BP3SZ.h"
 #include "adios2/toolkit/format/bp3/operation/BP3Zfp.h"
@@ -26,12 +27,13 @@ namespace format
 {
 
 const std::set<std::string> BP3Base::m_TransformTypes = {
-    {"unknown", "none", "identity", "sz", "zfp", "mgard"}};
+    {"unknown", "none", "identity", "sz", "zfp", "mgard", "lz4", "zstd"}};
 
 const std::map<int, std::string> BP3Base::m_TransformTypesToNames = {
     {transform_unknown, "unknown"},   {transform_none, "none"},
     {transform_identity, "identity"}, {transform_sz, "sz"},
     {transform_zfp, "zfp"},           {transform_mgard, "mgard"},
+    {transform_lz4, "lz4"},           {transform_zstd, "zstd"},
     // {transform_zlib, "zlib"},
     //    {transform_bzip2, "bzip2"},
     //    {transform_szip, "szip"},
@@ -40,7 +42,6 @@ const std::map<int, std::string> BP3Base::m_TransformTypesToNames = {
     //    {transform_alacrity, "alacrity"},
 
     //    {transform_sz, "sz"},
-    //    {transform_lz4, "lz4"},
     //    {transform_blosc, "blosc"},
 };
 
@@ -836,6 +837,10 @@ BP3Base::SetBP3Operation(const std::string type) const noexcept
     {
         bp3Op = std::make_shared<BP3MGARD>();
     }
+    else if (type == "lz4" || type == "zstd")
+    {
+        bp3Op = std::make_shared<BP3Lossless>();
+    }
     else if (type == "bzip2")
     {
         // TODO
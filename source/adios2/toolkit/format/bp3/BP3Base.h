@@ -411,7 +411,8 @@ protected:
         transform_sz = 9,
         transform_lz4 = 10,
         transform_blosc = 11,
-        transform_mgard = 12
+        transform_mgard = 12,
+        transform_zstd = 13
     };
 
     static const std::set<std::string> m_TransformTypes;
@@ -462,6 +463,8 @@ protected:
         T Min;
         T Max;
         T Value;
+        /** false if the writer didn't store min and max, read side only */
+        bool HasMinMax = false;
         std::vector<T> Values;
         uint32_t Step = 0;
         uint32_t FileIndex = 0;
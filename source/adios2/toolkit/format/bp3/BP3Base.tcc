@@ -271,6 +271,7 @@ inline void BP3Base::ParseCharacteristics(const std::vector<char> &buffer,
         {
             characteristics.Statistics.Min =
                 helper::ReadValue<T>(buffer, position, isLittleEndian);
+            characteristics.Statistics.HasMinMax = true;
             break;
         }
 
@@ -278,6 +279,7 @@ inline void BP3Base::ParseCharacteristics(const std::vector<char> &buffer,
         {
             characteristics.Statistics.Max =
                 helper::ReadValue<T>(buffer, position, isLittleEndian);
+            characteristics.Statistics.HasMinMax = true;
             break;
         }
 
@@ -394,12 +396,14 @@ inline void BP3Base::ParseCharacteristics(const std::vector<char> &buffer,
                 {
                     characteristics.Statistics.Min =
                         helper::ReadValue<T>(buffer, position, isLittleEndian);
+                    characteristics.Statistics.HasMinMax = true;
                     break;
                 }
                 case (statistic_max):
                 {
                     characteristics.Statistics.Max =
                         helper::ReadValue<T>(buffer, position, isLittleEndian);
+                    characteristics.Statistics.HasMinMax = true;
                     break;
                 }
                 case (statistic_sum):
@@ -335,10 +335,11 @@ BP3Deserializer::PerformGetsVariablesSubFileInfo(core::IO &io)
     return m_DeferredVariablesMap;
 }
 
-void BP3Deserializer::ClipMemory(const std::string &variableName, core::IO &io,
-                                 const std::vector<char> &contiguousMemory,
-                                 const Box<Dims> &blockBox,
-                                 const Box<Dims> &intersectionBox) const
+void BP3Deserializer::ClipMemory(
+    const std::string &variableName, core::IO &io,
+    const std::vector<char> &contiguousMemory,
+    const Box<helper::SmallDims> &blockBox,
+    const Box<helper::SmallDims> &intersectionBox) const
 {
     const std::string type(io.InquireVariableType(variableName));
 
@@ -373,7 +374,8 @@ void BP3Deserializer::ClipMemory(const std::string &variableName, core::IO &io,
                                                                                \
     template void BP3Deserializer::ClipContiguousMemory<T>(                    \
         typename core::Variable<T>::Info &, const std::vector<char> &,         \
-        const Box<Dims> &, const Box<Dims> &) const;                           \
+        const Box<helper::SmallDims> &,                                        \
+        const Box<helper::SmallDims> &) const;                                 \
                                                                                \
     template void BP3Deserializer::GetValueFromMetadata(                       \
         core::Variable<T> &variable, T *) const;
@@ -411,7 +413,11 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
                                                                                \
     template void BP3Deserializer::PostDataRead(                               \
         core::Variable<T> &, typename core::Variable<T>::Info &,               \
-        const helper::SubStreamBoxInfo &, const bool, const size_t);
+        const helper::SubStreamBoxInfo &, const bool, const size_t);           \
+                                                                               \
+    template void BP3Deserializer::ClipPayload(                                \
+        const core::Variable<T> &, typename core::Variable<T>::Info &,         \
+        const helper::SubStreamBoxInfo &, const char *) const;
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
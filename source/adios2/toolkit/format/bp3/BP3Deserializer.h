@@ -104,6 +104,21 @@ public:
                       const bool isRowMajorDestination,
                       const size_t threadID = 0);
 
+    /**
+     * Clips a raw (not operated) payload into blockInfo.Data, the part of
+     * PostDataRead after the payload is available in memory. Used directly
+     * on memory mapped files to skip the thread buffer copy.
+     * @param variable input Variable
+     * @param blockInfo input blockInfo with the destination Data
+     * @param subStreamBoxInfo box (block) the payload belongs to
+     * @param payload contiguous memory starting at subStreamBoxInfo.Seeks.first
+     */
+    template <class T>
+    void ClipPayload(const core::Variable<T> &variable,
+                     typename core::Variable<T>::Info &blockInfo,
+                     const helper::SubStreamBoxInfo &subStreamBoxInfo,
+                     const char *payload) const;
+
     /**
      * Clips and assigns memory to blockInfo.Data from a contiguous memory
      * input
@@ -113,10 +128,11 @@ public:
      * @param intersectionBox
      */
     template <class T>
-    void ClipContiguousMemory(typename core::Variable<T>::Info &blockInfo,
-                              const std::vector<char> &contiguousMemory,
-                              const Box<Dims> &blockBox,
-                              const Box<Dims> &intersectionBox) const;
+    void
+    ClipContiguousMemory(typename core::Variable<T>::Info &blockInfo,
+                         const std::vector<char> &contiguousMemory,
+                         const Box<helper::SmallDims> &blockBox,
+                         const Box<helper::SmallDims> &intersectionBox) const;
 
     /**
      * Gets a value directly from metadata (if Variable is single value)
@@ -159,8 +175,8 @@ public:
     // TODO : will deprecate
     void ClipMemory(const std::string &variableName, core::IO &io,
                     const std::vector<char> &contiguousMemory,
-                    const Box<Dims> &blockBox,
-                    const Box<Dims> &intersectionBox) const;
+                    const Box<helper::SmallDims> &blockBox,
+                    const Box<helper::SmallDims> &intersectionBox) const;
 
     // TODO: will deprecate
     bool m_PerformedGets = false;
@@ -227,7 +243,8 @@ private:
                                                                                \
     extern template void BP3Deserializer::ClipContiguousMemory<T>(             \
         typename core::Variable<T>::Info &, const std::vector<char> &,         \
-        const Box<Dims> &, const Box<Dims> &intersectionBox) const;            \
+        const Box<helper::SmallDims> &,                                        \
+        const Box<helper::SmallDims> &intersectionBox) const;                  \
                                                                                \
     extern template void BP3Deserializer::GetValueFromMetadata(                \
         core::Variable<T> &variable, T *) const;
@@ -266,7 +283,11 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
                                                                                \
     extern template void BP3Deserializer::PostDataRead(                        \
         core::Variable<T> &, typename core::Variable<T>::Info &,               \
-        const helper::SubStreamBoxInfo &, const bool, const size_t);
+        const helper::SubStreamBoxInfo &, const bool, const size_t);           \
+                                                                               \
+    extern template void BP3Deserializer::ClipPayload(                         \
+        const core::Variable<T> &, typename core::Variable<T>::Info &,         \
+        const helper::SubStreamBoxInfo &, const char *) const;
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
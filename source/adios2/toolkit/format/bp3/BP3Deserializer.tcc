@@ -154,7 +154,8 @@ void BP3Deserializer::SetVariableBlockInfo(
     };
 
     auto lf_SetSubStreamInfoLocalArray =
-        [&](const std::string &variableName, const Box<Dims> &selectionBox,
+        [&](const std::string &variableName,
+            const Box<helper::SmallDims> &selectionBox,
             typename core::Variable<T>::Info &blockInfo, const size_t step,
             const size_t blockIndexOffset, const BufferSTL &bufferSTL,
             const bool isRowMajor)
@@ -178,8 +179,9 @@ void BP3Deserializer::SetVariableBlockInfo(
 
         // if selection box start is not empty = local selection
         subStreamInfo.BlockBox =
-            helper::StartEndBox(Dims(blockCharacteristics.Count.size(), 0),
-                                blockCharacteristics.Count);
+            helper::StartEndBox(
+                helper::SmallDims(blockCharacteristics.Count.size(), 0),
+                blockCharacteristics.Count);
 
         if (!selectionBox.first.empty()) // selection start count was defined
         {
@@ -272,7 +274,8 @@ void BP3Deserializer::SetVariableBlockInfo(
     };
 
     auto lf_SetSubStreamInfoGlobalArray =
-        [&](const std::string &variableName, const Box<Dims> &selectionBox,
+        [&](const std::string &variableName,
+            const Box<helper::SmallDims> &selectionBox,
             typename core::Variable<T>::Info &blockInfo, const size_t step,
             const size_t blockIndexOffset, const BufferSTL &bufferSTL,
             const bool isRowMajor)
@@ -381,7 +384,7 @@ void BP3Deserializer::SetVariableBlockInfo(
     const std::map<size_t, std::vector<size_t>> &indices =
         variable.m_AvailableStepBlockIndexOffsets;
 
-    const Box<Dims> selectionBox = helper::StartEndBox(
+    const Box<helper::SmallDims> selectionBox = helper::StartEndBox(
         blockInfo.Start, blockInfo.Count, m_ReverseDimensions);
 
     auto itStep = std::next(indices.begin(), blockInfo.StepsStart);
@@ -541,6 +544,16 @@ void BP3Deserializer::PostDataRead(
                            subStreamBoxInfo.Seeks.second);
     }
 
+    ClipPayload(variable, blockInfo, subStreamBoxInfo,
+                m_ThreadBuffers[threadID][0].data());
+}
+
+template <class T>
+void BP3Deserializer::ClipPayload(const core::Variable<T> &variable,
+                                  typename core::Variable<T>::Info &blockInfo,
+                                  const helper::SubStreamBoxInfo &subStreamBoxInfo,
+                                  const char *payload) const
+{
 #ifdef ADIOS2_HAVE_ENDIAN_REVERSE
     const bool endianReverse =
         (helper::IsLittleEndian() != m_Minifooter.IsLittleEndian) ? true
@@ -556,7 +569,7 @@ void BP3Deserializer::PostDataRead(
 
     helper::ClipContiguousMemory(
         blockInfo.Data, blockInfoStart, blockInfo.Count,
-        m_ThreadBuffers[threadID][0].data(), subStreamBoxInfo.BlockBox,
+        payload, subStreamBoxInfo.BlockBox,
         subStreamBoxInfo.IntersectionBox, m_IsRowMajor, m_ReverseDimensions,
         endianReverse);
 }
@@ -616,8 +629,9 @@ BP3Deserializer::BlocksInfo(const core::Variable<T> &variable,
 template <class T>
 void BP3Deserializer::ClipContiguousMemory(
     typename core::Variable<T>::Info &blockInfo,
-    const std::vector<char> &contiguousMemory, const Box<Dims> &blockBox,
-    const Box<Dims> &intersectionBox) const
+    const std::vector<char> &contiguousMemory,
+    const Box<helper::SmallDims> &blockBox,
+    const Box<helper::SmallDims> &intersectionBox) const
 {
     helper::ClipContiguousMemory(
         blockInfo.Data, blockInfo.Start, blockInfo.Count, contiguousMemory,
@@ -965,7 +979,7 @@ BP3Deserializer::GetSubFileInfo(const core::Variable<T> &variable) const
     const size_t stepStart = variable.m_StepsStart + 1;
     const size_t stepEnd = stepStart + variable.m_StepsCount; // exclusive
 
-    const Box<Dims> selectionBox = helper::StartEndBox(
+    const Box<helper::SmallDims> selectionBox = helper::StartEndBox(
         variable.m_Start, variable.m_Count, m_ReverseDimensions);
 
     for (size_t step = stepStart; step < stepEnd; ++step)
@@ -1066,6 +1080,7 @@ std::vector<typename core::Variable<T>::Info> BP3Deserializer::BlocksInfoCommon(
             blockInfo.IsValue = false;
             blockInfo.Min = blockCharacteristics.Statistics.Min;
             blockInfo.Max = blockCharacteristics.Statistics.Max;
+            blockInfo.HasMinMax = blockCharacteristics.Statistics.HasMinMax;
         }
         if (blockInfo.Shape.size() == 1 &&
             blockInfo.Shape.front() == LocalValueDim)
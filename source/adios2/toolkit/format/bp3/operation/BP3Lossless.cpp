@@ -0,0 +1,117 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP3Lossless.cpp
+ */
+
+#include "BP3Lossless.h"
+#include "BP3Lossless.tcc"
+
+#include "adios2/helper/adiosFunctions.h"
+
+#ifdef ADIOS2_HAVE_LZ4
+#include "adios2/operator/compress/CompressLZ4.h"
+#endif
+
+#ifdef ADIOS2_HAVE_ZSTD
+#include "adios2/operator/compress/CompressZstd.h"
+#endif
+
+namespace adios2
+{
+namespace format
+{
+
+#define declare_type(T)                                                        \
+    void BP3Lossless::SetData(                                                 \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        BufferSTL &bufferSTL) const noexcept                                   \
+    {                                                                          \
+        SetDataCommon(variable, blockInfo, operation, bufferSTL);              \
+    }                                                                          \
+                                                                               \
+    void BP3Lossless::SetMetadata(                                             \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept                              \
+    {                                                                          \
+        SetMetadataCommon(variable, blockInfo, operation, buffer);             \
+    }                                                                          \
+                                                                               \
+    void BP3Lossless::UpdateMetadata(                                          \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept                              \
+    {                                                                          \
+        UpdateMetadataCommon(variable, blockInfo, operation, buffer);          \
+    }
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+void BP3Lossless::GetMetadata(const std::vector<char> &buffer,
+                              Params &info) const noexcept
+{
+    size_t position = 0;
+    info["InputSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+    info["OutputSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+
+    switch (helper::ReadValue<uint8_t>(buffer, position))
+    {
+    case 1:
+        info["Shuffle"] = "byte";
+        break;
+    case 2:
+        info["Shuffle"] = "bit";
+        break;
+    default:
+        info["Shuffle"] = "none";
+        break;
+    }
+}
+
+void BP3Lossless::GetData(const char *input,
+                          const helper::BlockOperationInfo &blockOperationInfo,
+                          char *dataOutput) const
+{
+    const std::string type = blockOperationInfo.Info.at("Type");
+    const size_t sizeOut = helper::GetTotalSize(blockOperationInfo.PreCount) *
+                           blockOperationInfo.PreSizeOf;
+
+    if (type == "lz4")
+    {
+#ifdef ADIOS2_HAVE_LZ4
+        core::compress::CompressLZ4 op(Params(), true);
+        op.Decompress(input, blockOperationInfo.PayloadSize, dataOutput,
+                      sizeOut);
+#else
+        throw std::runtime_error(
+            "ERROR: current ADIOS2 library didn't compile "
+            "with LZ4, can't read LZ4 compressed data, in call "
+            "to Get\n");
+#endif
+    }
+    else if (type == "zstd")
+    {
+#ifdef ADIOS2_HAVE_ZSTD
+        core::compress::CompressZstd op(Params(), true);
+        op.Decompress(input, blockOperationInfo.PayloadSize, dataOutput,
+                      sizeOut);
+#else
+        throw std::runtime_error(
+            "ERROR: current ADIOS2 library didn't compile "
+            "with Zstd, can't read Zstd compressed data, in call "
+            "to Get\n");
+#endif
+    }
+}
+
+} // end namespace format
+} // end namespace adios2
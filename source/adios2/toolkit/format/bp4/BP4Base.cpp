@@ -15,7 +15,11 @@
 
 #include "adios2/ADIOSTypes.h"            //PathSeparator
 #include "adios2/helper/adiosFunctions.h" //CreateDirectory, StringToTimeUnit,
+#include "adios2/toolkit/aggregator/mpi/MPIChain.h"
+#include "adios2/toolkit/aggregator/mpi/MPIDirect.h"
 
+#include "adios2/toolkit/format/bp4/operation/BP4BZip2.h"
+#include "adios2/toolkit/format/bp4/operation/BP4Lossless.h"
 #include "adios2/toolkit/format/bp4/operation/BP4MGARD.h"
 #include "adios2/toolkit/format/bp4/operation/BP4SZ.h"
 #include "adios2/toolkit/format/bp4/operation/BP4Zfp.h"
@@ -25,28 +29,34 @@ namespace adios2
 namespace format
 {
 
+constexpr size_t BP4Base::m_ActiveFlagPosition;
+constexpr size_t BP4Base::m_IndexHeaderSize;
+constexpr size_t BP4Base::m_IndexRecordSize;
+
 const std::set<std::string> BP4Base::m_TransformTypes = {
-    {"unknown", "none", "identity", "sz", "zfp", "mgard"}};
+    {"unknown", "none", "identity", "bzip2", "sz", "zfp", "mgard", "lz4",
+     "zstd"}};
 
 const std::map<int, std::string> BP4Base::m_TransformTypesToNames = {
     {transform_unknown, "unknown"},   {transform_none, "none"},
     {transform_identity, "identity"}, {transform_sz, "sz"},
     {transform_zfp, "zfp"},           {transform_mgard, "mgard"},
+    {transform_bzip2, "bzip2"},       {transform_lz4, "lz4"},
+    {transform_zstd, "zstd"},
     //{transform_mgard, "mgard"},
     // {transform_zlib, "zlib"},
-    //    {transform_bzip2, "bzip2"},
     //    {transform_szip, "szip"},
     //    {transform_isobar, "isobar"},
     //    {transform_aplod, "aplod"},
     //    {transform_alacrity, "alacrity"},
 
     //    {transform_sz, "sz"},
-    //    {transform_lz4, "lz4"},
     //    {transform_blosc, "blosc"},
 };
 
 BP4Base::BP4Base(MPI_Comm mpiComm, const bool debugMode)
-: m_MPIComm(mpiComm), m_DebugMode(debugMode)
+: m_MPIComm(mpiComm), m_Aggregator(std::make_shared<aggregator::MPIChain>()),
+  m_DebugMode(debugMode)
 {
     MPI_Comm_rank(m_MPIComm, &m_RankMPI);
     MPI_Comm_size(m_MPIComm, &m_SizeMPI);
@@ -91,6 +101,10 @@ void BP4Base::InitParameters(const Params &parameters)
         {
             InitParameterMaxBufferSize(value);
         }
+        else if (key == "bufferchunksize")
+        {
+            InitParameterBufferChunkSize(value);
+        }
         else if (key == "threads")
         {
             InitParameterThreads(value);
@@ -115,6 +129,68 @@ void BP4Base::InitParameters(const Params &parameters)
         {
             InitParameterNodeLocal(value);
         }
+        else if (key == "asyncwrite")
+        {
+            InitParameterAsyncWrite(value);
+        }
+        else if (key == "asyncqueuedepth")
+        {
+            InitParameterAsyncQueueDepth(value);
+        }
+        else if (key == "lazymetadata")
+        {
+            InitParameterLazyMetadata(value);
+        }
+        else if (key == "maxparsedsteps")
+        {
+            InitParameterMaxParsedSteps(value);
+        }
+        else if (key == "metadatabroadcast")
+        {
+            InitParameterMetadataBroadcast(value);
+        }
+        else if (key == "streamreader")
+        {
+            InitParameterStreamReader(value);
+        }
+        else if (key == "readgapthreshold")
+        {
+            InitParameterReadGapThreshold(value);
+        }
+        else if (key == "readmaxextentsize")
+        {
+            InitParameterReadMaxExtentSize(value);
+        }
+        else if (key == "aggregator")
+        {
+            InitParameterAggregator(value);
+        }
+        else if (key == "zerobuffers")
+        {
+            InitParameterZeroBuffers(value);
+        }
+        else if (key == "bufferpool")
+        {
+            InitParameterBufferPool(value);
+        }
+        else if (key == "metadataaggregation")
+        {
+            InitParameterMetadataAggregation(value);
+        }
+        else if (key == "blockcachesize")
+        {
+            InitParameterBlockCacheSize(value);
+        }
+        else if (key == "tracing")
+        {
+            InitParameterTracing(value);
+        }
+    }
+
+    // parameters come in any order, the aggregator type must be set first
+    if (m_SubStreams > 0 && m_SubStreams < m_SizeMPI)
+    {
+        m_Aggregator->Init(static_cast<size_t>(m_SubStreams), m_MPIComm);
     }
 
     // default timer for buffering
@@ -136,12 +212,23 @@ void BP4Base::InitParameters(const Params &parameters)
         m_Profiler.Bytes.emplace("buffering", 0);
     }
 
-    ProfilerStart("buffering");
-    if (useDefaultInitialBufferSize)
+    for (size_t e = 0; e < profiling::TraceEventCount; ++e)
+    {
+        auto itTimer = m_Profiler.Timers.find(
+            profiling::Tracer::GetName(static_cast<uint16_t>(e)));
+        m_ProfilerTimers[e] =
+            (m_Profiler.IsActive && itTimer != m_Profiler.Timers.end())
+                ? &itTimer->second
+                : nullptr;
+    }
+
+    ProfilerStart(profiling::TraceEvent::Buffering);
+    if (useDefaultInitialBufferSize &&
+        !(m_BufferPool && m_Data.ResizeFromPool(DefaultInitialBufferSize)))
     {
         m_Data.Resize(DefaultInitialBufferSize, "in call to Open");
     }
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 std::vector<std::string>
@@ -195,7 +282,7 @@ std::string BP4Base::GetBPMetadataFileName(const std::string &name) const
     }
 
     // const size_t index =
-    //    m_Aggregator.m_IsActive ? m_Aggregator.m_SubStreamIndex : rank;
+    //    m_Aggregator->m_IsActive ? m_Aggregator->m_SubStreamIndex : rank;
 
     const size_t index = 0; // global metadata file is generated by rank 0
 
@@ -236,7 +323,7 @@ std::string BP4Base::GetBPMetadataIndexFileName(const std::string &name) const
     }
 
     // const size_t index =
-    //    m_Aggregator.m_IsActive ? m_Aggregator.m_SubStreamIndex : rank;
+    //    m_Aggregator->m_IsActive ? m_Aggregator->m_SubStreamIndex : rank;
 
     // const size_t index = 0; // global metadata index file is generated by
     // rank 0
@@ -305,29 +392,50 @@ size_t BP4Base::GetBPIndexSizeInData(const std::string &variableName,
     return indexSize + 12; // extra 12 bytes in case of attributes
 }
 
+size_t BP4Base::GetOperationPayloadMaxSize(
+    const std::vector<core::VariableBase::Operation> &operations,
+    const size_t payloadSize, const size_t elementSize) const
+{
+    // only the first supported operation is applied
+    for (const core::VariableBase::Operation &operation : operations)
+    {
+        const std::shared_ptr<BP4Operation> bp4Operation =
+            SetBP4Operation(operation.Op->m_Type);
+        if (bp4Operation)
+        {
+            return bp4Operation->GetPayloadMaxSize(
+                *operation.Op, operation.Parameters, payloadSize, elementSize);
+        }
+    }
+    return payloadSize;
+}
+
 void BP4Base::ResetBuffer(BufferSTL &bufferSTL,
                           const bool resetAbsolutePosition,
                           const bool zeroInitialize)
 {
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
     bufferSTL.m_Position = 0;
+    bufferSTL.ClearSegments();
     if (resetAbsolutePosition)
     {
         bufferSTL.m_AbsolutePosition = 0;
     }
-    if (zeroInitialize)
+    if (zeroInitialize && m_ZeroBuffers)
     {
         bufferSTL.m_Buffer.assign(bufferSTL.m_Buffer.size(), '\0');
     }
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 BP4Base::ResizeResult BP4Base::ResizeBuffer(const size_t dataIn,
                                             const std::string hint)
 {
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
     const size_t currentCapacity = m_Data.m_Buffer.capacity();
     const size_t requiredCapacity = dataIn + m_Data.m_Position;
+    // segments count towards the max buffer size
+    const size_t requiredSize = requiredCapacity + m_Data.m_SegmentsSize;
 
     ResizeResult result = ResizeResult::Unchanged;
 
@@ -347,9 +455,10 @@ BP4Base::ResizeResult BP4Base::ResizeBuffer(const size_t dataIn,
     {
         // do nothing, unchanged is default
     }
-    else if (requiredCapacity > m_MaxBufferSize)
+    else if (requiredSize > m_MaxBufferSize)
     {
-        if (currentCapacity < m_MaxBufferSize)
+        // segmented buffers get a segment after the flush
+        if (m_BufferChunkSize == 0 && currentCapacity < m_MaxBufferSize)
         {
             m_Data.Resize(m_MaxBufferSize, " when resizing buffer to " +
                                                std::to_string(m_MaxBufferSize) +
@@ -357,6 +466,17 @@ BP4Base::ResizeResult BP4Base::ResizeBuffer(const size_t dataIn,
         }
         result = ResizeResult::Flush;
     }
+    else if (m_BufferChunkSize > 0)
+    {
+        // new segment, serialized bytes stay in place
+        const size_t nextSize = std::min(
+            m_MaxBufferSize - m_Data.m_SegmentsSize - m_Data.m_Position,
+            std::max(m_BufferChunkSize, dataIn));
+        m_Data.AddSegment(nextSize, " when adding buffer segment of " +
+                                        std::to_string(nextSize) + "bytes, " +
+                                        hint);
+        result = ResizeResult::Success;
+    }
     else // buffer must grow
     {
         if (currentCapacity < m_MaxBufferSize)
@@ -372,7 +492,7 @@ BP4Base::ResizeResult BP4Base::ResizeBuffer(const size_t dataIn,
         }
     }
 
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
     return result;
 }
 
@@ -431,6 +551,21 @@ void BP4Base::InitParameterProfileUnits(const std::string value)
     m_Profiler.Bytes.emplace("buffering", 0);
 }
 
+void BP4Base::InitParameterTracing(const std::string value)
+{
+    bool tracing = false;
+    InitOnOffParameter(value, tracing, "valid: Tracing On or Off");
+
+    if (tracing)
+    {
+        m_Tracer.Activate();
+    }
+    else
+    {
+        m_Tracer.IsActive = false;
+    }
+}
+
 void BP4Base::InitParameterBufferGrowth(const std::string value)
 {
     if (m_DebugMode)
@@ -684,6 +819,328 @@ void BP4Base::InitParameterNodeLocal(const std::string value)
     InitOnOffParameter(value, m_NodeLocal, "valid: node-local On or Off");
 }
 
+void BP4Base::InitParameterAsyncWrite(const std::string value)
+{
+    InitOnOffParameter(value, m_AsyncWrite, "valid: AsyncWrite On or Off");
+}
+
+void BP4Base::InitParameterAsyncQueueDepth(const std::string value)
+{
+    long long int queueDepth = -1;
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            queueDepth = std::stoll(value);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success || queueDepth < 1)
+        {
+            throw std::invalid_argument(
+                "ERROR: value in AsyncQueueDepth=value in IO SetParameters "
+                "must be an integer >= 1 (default 2) \nadditional "
+                "description: " +
+                description + "\n, in call to Open\n");
+        }
+    }
+    else
+    {
+        queueDepth = std::stoll(value);
+    }
+
+    m_AsyncQueueDepth = static_cast<size_t>(queueDepth);
+}
+
+void BP4Base::InitParameterLazyMetadata(const std::string value)
+{
+    InitOnOffParameter(value, m_LazyMetadata,
+                       "valid: LazyMetadata On or Off");
+}
+
+void BP4Base::InitParameterMaxParsedSteps(const std::string value)
+{
+    long long int maxParsedSteps = -1;
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            maxParsedSteps = std::stoll(value);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success || maxParsedSteps < 0)
+        {
+            throw std::invalid_argument(
+                "ERROR: value in MaxParsedSteps=value in IO SetParameters "
+                "must be an integer >= 0 (default 0, no limit) \nadditional "
+                "description: " +
+                description + "\n, in call to Open\n");
+        }
+    }
+    else
+    {
+        maxParsedSteps = std::stoll(value);
+    }
+
+    m_MaxParsedSteps = static_cast<size_t>(maxParsedSteps);
+}
+
+void BP4Base::InitParameterMetadataBroadcast(const std::string value)
+{
+    if (value == "flat")
+    {
+        m_NodeMetadataBroadcast = false;
+    }
+    else if (value == "node")
+    {
+        m_NodeMetadataBroadcast = true;
+    }
+    else
+    {
+        if (m_DebugMode)
+        {
+            throw std::invalid_argument(
+                "ERROR: value " + value +
+                " in MetadataBroadcast=value in IO SetParameters is not "
+                "valid, use Flat (default) or Node, in call to Open\n");
+        }
+    }
+}
+
+void BP4Base::InitParameterStreamReader(const std::string value)
+{
+    InitOnOffParameter(value, m_StreamReader, "valid: StreamReader On or Off");
+}
+
+void BP4Base::InitParameterBufferChunkSize(const std::string value)
+{
+    const std::string hint(
+        "ERROR: couldn't convert value of BufferChunkSize IO SetParameter, "
+        "valid syntax: BufferChunkSize=64Mb, BufferChunkSize=16Kb (minimum), "
+        "BufferChunkSize=0Kb (contiguous growth)");
+
+    if (m_DebugMode)
+    {
+        if (value.size() < 2)
+        {
+            throw std::invalid_argument(hint + ", in call to Open\n");
+        }
+    }
+
+    const std::string number(value.substr(0, value.size() - 2));
+    const std::string units(value.substr(value.size() - 2));
+    const size_t factor = helper::BytesFactor(units, m_DebugMode);
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            m_BufferChunkSize =
+                static_cast<size_t>(std::stoul(number) * factor);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success ||
+            (m_BufferChunkSize > 0 && m_BufferChunkSize < 16 * 1024))
+        {
+            throw std::invalid_argument(hint + "\nadditional description: " +
+                                        description + ", in call to Open\n");
+        }
+    }
+    else
+    {
+        m_BufferChunkSize = static_cast<size_t>(std::stoul(number) * factor);
+    }
+}
+
+void BP4Base::InitParameterZeroBuffers(const std::string value)
+{
+    InitOnOffParameter(value, m_ZeroBuffers, "valid: ZeroBuffers On or Off");
+}
+
+void BP4Base::InitParameterBufferPool(const std::string value)
+{
+    InitOnOffParameter(value, m_BufferPool, "valid: BufferPool On or Off");
+}
+
+void BP4Base::InitParameterReadGapThreshold(const std::string value)
+{
+    long long int readGapThreshold = -1;
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            readGapThreshold = std::stoll(value);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success || readGapThreshold < 0)
+        {
+            throw std::invalid_argument(
+                "ERROR: value in ReadGapThreshold=value in IO SetParameters "
+                "must be an integer >= 0 bytes (default 65536) \nadditional "
+                "description: " +
+                description + "\n, in call to Open\n");
+        }
+    }
+    else
+    {
+        readGapThreshold = std::stoll(value);
+    }
+
+    m_ReadGapThreshold = static_cast<size_t>(readGapThreshold);
+}
+
+void BP4Base::InitParameterReadMaxExtentSize(const std::string value)
+{
+    long long int readMaxExtentSize = -1;
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            readMaxExtentSize = std::stoll(value);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success || readMaxExtentSize <= 0)
+        {
+            throw std::invalid_argument(
+                "ERROR: value in ReadMaxExtentSize=value in IO SetParameters "
+                "must be an integer > 0 bytes (default 16777216) \nadditional "
+                "description: " +
+                description + "\n, in call to Open\n");
+        }
+    }
+    else
+    {
+        readMaxExtentSize = std::stoll(value);
+    }
+
+    m_ReadMaxExtentSize = static_cast<size_t>(readMaxExtentSize);
+}
+
+void BP4Base::InitParameterAggregator(const std::string value)
+{
+    if (value == "chain")
+    {
+        m_Aggregator = std::make_shared<aggregator::MPIChain>();
+    }
+    else if (value == "direct")
+    {
+        m_Aggregator = std::make_shared<aggregator::MPIDirect>();
+    }
+    else
+    {
+        if (m_DebugMode)
+        {
+            throw std::invalid_argument(
+                "ERROR: value " + value +
+                " in Aggregator=value in IO SetParameters is not valid, use "
+                "Chain (default) or Direct, in call to Open\n");
+        }
+    }
+}
+
+void BP4Base::InitParameterMetadataAggregation(const std::string value)
+{
+    if (value == "flat")
+    {
+        m_HierarchicalMetadata = false;
+    }
+    else if (value == "hierarchical")
+    {
+        m_HierarchicalMetadata = true;
+    }
+    else
+    {
+        if (m_DebugMode)
+        {
+            throw std::invalid_argument(
+                "ERROR: value " + value +
+                " in MetadataAggregation=value in IO SetParameters is not "
+                "valid, use Flat (default) or Hierarchical, in call to "
+                "Open\n");
+        }
+    }
+}
+
+void BP4Base::InitParameterBlockCacheSize(const std::string value)
+{
+    const std::string hint(
+        "ERROR: couldn't convert value of BlockCacheSize IO SetParameter, "
+        "valid syntax: BlockCacheSize=256Mb, BlockCacheSize=0Kb (off)");
+
+    if (m_DebugMode)
+    {
+        if (value.size() < 2)
+        {
+            throw std::invalid_argument(hint + ", in call to Open\n");
+        }
+    }
+
+    const std::string number(value.substr(0, value.size() - 2));
+    const std::string units(value.substr(value.size() - 2));
+    const size_t factor = helper::BytesFactor(units, m_DebugMode);
+
+    if (m_DebugMode)
+    {
+        try
+        {
+            m_BlockCacheSize = static_cast<size_t>(std::stoul(number) * factor);
+        }
+        catch (std::exception &e)
+        {
+            throw std::invalid_argument(hint + "\nadditional description: " +
+                                        std::string(e.what()) +
+                                        ", in call to Open\n");
+        }
+    }
+    else
+    {
+        m_BlockCacheSize = static_cast<size_t>(std::stoul(number) * factor);
+    }
+}
+
 std::vector<uint8_t>
 BP4Base::GetTransportIDs(const std::vector<std::string> &transportsTypes) const
     noexcept
@@ -795,20 +1252,25 @@ std::string BP4Base::ReadBP4String(const std::vector<char> &buffer,
     return values;
 }
 
-void BP4Base::ProfilerStart(const std::string process) noexcept
+void BP4Base::ProfilerStart(const profiling::TraceEvent event) noexcept
 {
-    if (m_Profiler.IsActive)
+    const size_t index = static_cast<size_t>(event);
+    if (m_ProfilerTimers[index] != nullptr)
     {
-        m_Profiler.Timers.at(process).Resume();
+        m_ProfilerTimers[index]->Resume();
     }
+    m_TraceStarts[index] = m_Tracer.Now();
 }
 
-void BP4Base::ProfilerStop(const std::string process) noexcept
+void BP4Base::ProfilerStop(const profiling::TraceEvent event,
+                           const size_t bytes) noexcept
 {
-    if (m_Profiler.IsActive)
+    const size_t index = static_cast<size_t>(event);
+    if (m_ProfilerTimers[index] != nullptr)
     {
-        m_Profiler.Timers.at(process).Pause();
+        m_ProfilerTimers[index]->Pause();
     }
+    m_Tracer.Record(event, m_TraceStarts[index], bytes);
 }
 
 BP4Base::TransformTypes
@@ -878,10 +1340,8 @@ void BP4Base::InitParameterSubStreams(const std::string value)
         subStreams = std::stoi(value);
     }
 
-    if (subStreams < m_SizeMPI)
-    {
-        m_Aggregator.Init(subStreams, m_MPIComm);
-    }
+    // aggregation starts once the Aggregator parameter is known
+    m_SubStreams = subStreams;
 }
 
 std::shared_ptr<BP4Operation>
@@ -900,9 +1360,13 @@ BP4Base::SetBP4Operation(const std::string type) const noexcept
     {
         bp4Op = std::make_shared<BP4MGARD>();
     }
+    else if (type == "lz4" || type == "zstd")
+    {
+        bp4Op = std::make_shared<BP4Lossless>();
+    }
     else if (type == "bzip2")
     {
-        // TODO
+        bp4Op = std::make_shared<BP4BZip2>();
     }
     return bp4Op;
 }
@@ -929,7 +1393,7 @@ std::string BP4Base::GetBPSubStreamName(const std::string &name,
     // }
 
     const size_t index =
-        m_Aggregator.m_IsActive ? m_Aggregator.m_SubStreamIndex : rank;
+        m_Aggregator->m_IsActive ? m_Aggregator->m_SubStreamIndex : rank;
 
     // const std::string bpRankName(bpName + ".dir" + PathSeparator + bpRoot +
     //                             "." + std::to_string(index));
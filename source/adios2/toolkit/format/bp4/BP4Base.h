@@ -12,6 +12,7 @@
 #define ADIOS2_TOOLKIT_FORMAT_BP4_BP4BASE_H_
 
 /// \cond EXCLUDE_FROM_DOXYGEN
+#include <array>
 #include <bitset>
 #include <map>
 #include <memory> //std::shared_ptr
@@ -28,10 +29,11 @@
 #include "adios2/ADIOSTypes.h"
 #include "adios2/core/Engine.h"
 #include "adios2/core/VariableBase.h"
-#include "adios2/toolkit/aggregator/mpi/MPIChain.h"
+#include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
 #include "adios2/toolkit/format/BufferSTL.h"
 #include "adios2/toolkit/format/bp4/operation/BP4Operation.h"
 #include "adios2/toolkit/profiling/iochrono/IOChrono.h"
+#include "adios2/toolkit/profiling/tracer/Tracer.h"
 
 namespace adios2
 {
@@ -102,11 +104,13 @@ public:
 
         /** number of current PGs */
         uint64_t DataPGCount = 0;
-        /** current PG initial ( relative ) position in data buffer */
+        /** current PG initial ( relative ) position in data buffer, counts
+         * previous segments */
         size_t DataPGLengthPosition = 0;
         /** number of variables in current PG */
         uint32_t DataPGVarsCount = 0;
-        /** current PG variable count ( relative ) position */
+        /** current PG variable count ( relative ) position, counts previous
+         * segments */
         size_t DataPGVarsCountPosition = 0;
         /** true: currently writing to a pg, false: no current pg */
         bool DataPGIsOpen = false;
@@ -166,6 +170,10 @@ public:
     /** max buffer size, set by the user */
     size_t m_MaxBufferSize = DefaultMaxBufferSize;
 
+    /** > 0: data buffer grows by adding segments of at least this size
+     * instead of reallocating, 0: contiguous growth (default) */
+    size_t m_BufferChunkSize = 0;
+
     /** contains bp1 format metadata indices*/
     MetadataSet m_MetadataSet;
 
@@ -176,6 +184,10 @@ public:
     /** buffering and MPI aggregation profiling info, set by user */
     profiling::IOChrono m_Profiler;
 
+    /** spans with bytes and step, set by user with Tracing=On, the writer
+     * exports them to trace.json in Chrome trace format */
+    profiling::Tracer m_Tracer;
+
     /** Default: write collective metadata in Capsule metadata. */
     bool m_CollectiveMetadata = true;
 
@@ -189,8 +201,12 @@ public:
     /** if reader and writer have different ordering (column vs row major) */
     bool m_ReverseDimensions = false;
 
-    /** manages all communication tasks in aggregation */
-    aggregator::MPIChain m_Aggregator;
+    /** manages all communication tasks in aggregation, MPIChain or
+     * MPIDirect from the Aggregator parameter */
+    std::shared_ptr<aggregator::MPIAggregator> m_Aggregator;
+
+    /** from the SubStreams parameter, aggregation is on if < MPI size */
+    int m_SubStreams = -1;
 
     /** tracks Put and Get variables in deferred mode */
     std::set<std::string> m_DeferredVariables;
@@ -214,6 +230,69 @@ public:
     /** true: NVMex each rank creates its own directory */
     bool m_NodeLocal = false;
 
+    /** true: flushed data buffers are written by a background thread, a
+     * step shows up in md.idx once all ranks wrote its data */
+    bool m_AsyncWrite = false;
+
+    /** max number of buffers pending in the background write queue, callers
+     * block when the queue is full */
+    size_t m_AsyncQueueDepth = 2;
+
+    /** true: reader Open only scans the variables index headers of each
+     * step, which defines all variables and counts their steps. The blocks
+     * of a step are parsed on demand by BeginStep, Get or BlocksInfo, Min,
+     * Max and changing shapes only cover the parsed steps */
+    bool m_LazyMetadata = false;
+
+    /** lazy metadata streaming: max steps with a parsed variables index
+     * kept in memory, older steps are dropped at BeginStep, 0: no limit */
+    size_t m_MaxParsedSteps = 0;
+
+    /** true: reader Open distributes metadata once per shared memory node,
+     * false: rank 0 broadcasts it to every rank */
+    bool m_NodeMetadataBroadcast = false;
+
+    /** true: writer indices are merged first inside groups of contiguous
+     * ranks (substreams or nodes), rank 0 only merges the group results,
+     * false: rank 0 gathers and merges the indices of every rank */
+    bool m_HierarchicalMetadata = false;
+
+    /** > 0: reader keeps up to this many bytes of operated (compressed)
+     * blocks in memory for repeated reads, 0: off (default) */
+    size_t m_BlockCacheSize = 0;
+
+    /** true: reader follows a file while it is being written, BeginStep
+     * waits for new steps until the writer closes it */
+    bool m_StreamReader = false;
+
+    /** threads parsing metadata and clipping read payloads, might be used in
+     * large payload copies to buffer */
+    unsigned int m_Threads = 1;
+
+    /** reader: max bytes between two payloads of a subfile read with a
+     * single call, payloads further apart are read separately */
+    size_t m_ReadGapThreshold = 65536;
+
+    /** reader: max bytes of a single merged read, merging starts a new read
+     * past it, a larger payload is still read at once */
+    size_t m_ReadMaxExtentSize = 16777216;
+
+    /** false: ResetBuffer doesn't zero buffers between steps, leftover bytes
+     * past m_Position are never written to file */
+    bool m_ZeroBuffers = true;
+
+    /** true: writer data buffer is returned to a process-wide pool at Close
+     * and the next engine Open takes it instead of allocating */
+    bool m_BufferPool = false;
+
+    /** metadata index header byte set to 1 while the writer has the file
+     * open, cleared at Close */
+    static constexpr size_t m_ActiveFlagPosition = 32;
+
+    /** metadata index header and entry sizes in bytes */
+    static constexpr size_t m_IndexHeaderSize = 48;
+    static constexpr size_t m_IndexRecordSize = 48;
+
     /**
      * Unique constructor
      * @param mpiComm for m_BP1Aggregator
@@ -271,7 +350,19 @@ public:
                                 const Dims &count) const noexcept;
 
     /**
-     * Sets buffer's positions to zero and fill buffer with zero char
+     * Returns the largest payload the block operations can write, used to
+     * resize the buffer before an operation writes into it
+     * @param operations block operations
+     * @param payloadSize block payload size before operations
+     * @param elementSize variable element size
+     */
+    size_t GetOperationPayloadMaxSize(
+        const std::vector<core::VariableBase::Operation> &operations,
+        const size_t payloadSize, const size_t elementSize) const;
+
+    /**
+     * Sets buffer's positions to zero and fill buffer with zero char if
+     * m_ZeroBuffers is true
      * @param bufferSTL buffer to be reset
      * @param resetAbsolutePosition true: both bufferSTL.m_Position and
      * bufferSTL.m_AbsolutePosition set to 0,   false(default): only
@@ -303,13 +394,19 @@ public:
      */
     ResizeResult ResizeBuffer(const size_t dataIn, const std::string hint);
 
-    void ProfilerStart(const std::string process) noexcept;
+    /** Resumes the m_Profiler timer of event and starts its m_Tracer span,
+     * application thread only */
+    void ProfilerStart(const profiling::TraceEvent event) noexcept;
 
-    void ProfilerStop(const std::string process) noexcept;
+    /**
+     * Pauses the m_Profiler timer of event and records its m_Tracer span
+     * @param event same as ProfilerStart
+     * @param bytes processed during the span, only traced
+     */
+    void ProfilerStop(const profiling::TraceEvent event,
+                      const size_t bytes = 0) noexcept;
 
 protected:
-    /** might be used in large payload copies to buffer */
-    unsigned int m_Threads = 1;
     const bool m_DebugMode = false;
 
     /** method type for file I/O */
@@ -438,7 +535,8 @@ protected:
         transform_sz = 9,
         transform_lz4 = 10,
         transform_blosc = 11,
-        transform_mgard = 12
+        transform_mgard = 12,
+        transform_zstd = 13
     };
 
     static const std::set<std::string> m_TransformTypes;
@@ -489,6 +587,8 @@ protected:
         T Min;
         T Max;
         T Value;
+        /** false if the writer didn't store min and max, read side only */
+        bool HasMinMax = false;
         std::vector<T> Values;
         uint32_t Step = 0;
         uint32_t FileIndex = 0;
@@ -541,6 +641,9 @@ protected:
     /** profile_units=s (default) (mus, ms, s,m,h) from ADIOSTypes.h TimeUnit */
     void InitParameterProfileUnits(const std::string value);
 
+    /** Sets if m_Tracer records spans */
+    void InitParameterTracing(const std::string value);
+
     /** growth_factor=1.5 (default), must be > 1.0 */
     void InitParameterBufferGrowth(const std::string value);
 
@@ -552,6 +655,9 @@ protected:
      *  max_buffer_size=100Mb or  max_buffer_size=1Gb */
     void InitParameterMaxBufferSize(const std::string value);
 
+    /** set min size of data buffer segments, enables segmented growth */
+    void InitParameterBufferChunkSize(const std::string value);
+
     /** Set available number of threads for vector operations */
     void InitParameterThreads(const std::string value);
 
@@ -571,6 +677,47 @@ protected:
      * stream */
     void InitParameterNodeLocal(const std::string value);
 
+    /** Sets if flushed buffers are written by a background thread */
+    void InitParameterAsyncWrite(const std::string value);
+
+    /** set max number of buffers pending in the background write queue */
+    void InitParameterAsyncQueueDepth(const std::string value);
+
+    /** Sets if the reader parses variables metadata per step on demand */
+    void InitParameterLazyMetadata(const std::string value);
+
+    /** set max number of steps with parsed variables metadata kept by a lazy
+     * streaming reader */
+    void InitParameterMaxParsedSteps(const std::string value);
+
+    /** Sets how the reader distributes metadata at Open, Flat or Node */
+    void InitParameterMetadataBroadcast(const std::string value);
+
+    /** Sets if the reader follows a file being written */
+    void InitParameterStreamReader(const std::string value);
+
+    /** set max gap in bytes between payloads merged into one read */
+    void InitParameterReadGapThreshold(const std::string value);
+
+    /** set max bytes of a read merging several payloads */
+    void InitParameterReadMaxExtentSize(const std::string value);
+
+    /** Sets the aggregation strategy, Chain or Direct */
+    void InitParameterAggregator(const std::string value);
+
+    /** Sets if buffers are zeroed at every reset */
+    void InitParameterZeroBuffers(const std::string value);
+
+    /** Sets if the data buffer is reused across engines */
+    void InitParameterBufferPool(const std::string value);
+
+    /** Sets how the writer merges collective metadata, Flat or Hierarchical
+     */
+    void InitParameterMetadataAggregation(const std::string value);
+
+    /** set bytes budget of the reader operated blocks cache */
+    void InitParameterBlockCacheSize(const std::string value);
+
     std::vector<uint8_t>
     GetTransportIDs(const std::vector<std::string> &transportsTypes) const
         noexcept;
@@ -629,6 +776,14 @@ protected:
         noexcept;
 
 private:
+    /** m_Profiler timers by TraceEvent, nullptr: not profiled. Found once
+     * so ProfilerStart and ProfilerStop don't look up names. */
+    std::array<profiling::Timer *, profiling::TraceEventCount>
+        m_ProfilerTimers{};
+
+    /** m_Tracer start of the current span by TraceEvent */
+    std::array<int64_t, profiling::TraceEventCount> m_TraceStarts{};
+
     std::string GetBPSubStreamName(const std::string &name, const size_t rank,
                                    const bool hasSubFiles = true) const
         noexcept;
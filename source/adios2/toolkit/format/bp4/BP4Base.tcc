@@ -270,6 +270,7 @@ inline void BP4Base::ParseCharacteristics(const std::vector<char> &buffer,
         {
             characteristics.Statistics.Min =
                 helper::ReadValue<T>(buffer, position, isLittleEndian);
+            characteristics.Statistics.HasMinMax = true;
             break;
         }
 
@@ -277,6 +278,7 @@ inline void BP4Base::ParseCharacteristics(const std::vector<char> &buffer,
         {
             characteristics.Statistics.Max =
                 helper::ReadValue<T>(buffer, position, isLittleEndian);
+            characteristics.Statistics.HasMinMax = true;
             break;
         }
 
@@ -392,12 +394,14 @@ inline void BP4Base::ParseCharacteristics(const std::vector<char> &buffer,
                 {
                     characteristics.Statistics.Min =
                         helper::ReadValue<T>(buffer, position, isLittleEndian);
+                    characteristics.Statistics.HasMinMax = true;
                     break;
                 }
                 case (statistic_max):
                 {
                     characteristics.Statistics.Max =
                         helper::ReadValue<T>(buffer, position, isLittleEndian);
+                    characteristics.Statistics.HasMinMax = true;
                     break;
                 }
                 case (statistic_sum):
@@ -11,7 +11,9 @@
 #include "BP4Deserializer.h"
 #include "BP4Deserializer.tcc"
 
+#include <algorithm> //std::min
 #include <future>
+#include <iterator> //std::distance
 #include <unordered_set>
 #include <vector>
 
@@ -42,25 +44,137 @@ void BP4Deserializer::ParseMetadata(const BufferSTL &bufferSTL,
     // ParsePGIndex(bufferSTL, io);
     // ParseVariablesIndex(bufferSTL, io);
     // ParseAttributesIndex(bufferSTL, io);
-    size_t steps;
-    steps = m_MetadataIndexTable[0].size();
+    const size_t steps = m_MetadataIndexTable[0].size();
     m_MetadataSet.StepsCount = steps;
     m_MetadataSet.CurrentStep = steps - 1;
+
+    // variables already in IO must be found while parsing the new steps
+    const bool readStreaming = engine.m_IO.m_ReadStreaming;
+    engine.m_IO.m_ReadStreaming = false;
+
+    if (m_LazyMetadata)
+    {
+        m_LazyEngine = &engine;
+    }
+
     /* parse the metadata step by step using the pointers saved in the metadata
-    index table */
-    for (int i = 0; i < steps; i++)
+    index table, a stream reader only parses steps added since the last call */
+    for (size_t i = m_ParsedMetadataSteps; i < steps; ++i)
     {
         ParsePGIndexPerStep(bufferSTL, engine.m_IO.m_HostLanguage, 0, i + 1);
-        ParseVariablesIndexPerStep(bufferSTL, engine, 0, i + 1);
+        if (m_LazyMetadata)
+        {
+            ScanVariablesIndexPerStep(bufferSTL, engine, i + 1);
+        }
+        else
+        {
+            ParseVariablesIndexPerStep(bufferSTL, engine, 0, i + 1);
+        }
         ParseAttributesIndexPerStep(bufferSTL, engine, 0, i + 1);
     }
+    m_ParsedMetadataSteps = steps;
+    engine.m_IO.m_ReadStreaming = readStreaming;
+
+    if (!m_LazyMetadata)
+    {
+        m_ParsedVariablesStep = steps;
+    }
+}
+
+void BP4Deserializer::ParseVariablesIndexUpToStep(const size_t step) const
+{
+    const size_t lastStep = std::min(step, m_MetadataSet.StepsCount);
+    if (m_ParsedVariablesStep >= lastStep)
+    {
+        return;
+    }
+
+    // streaming InquireVariable hides variables not in the current step,
+    // parsing must find every variable already defined
+    core::Engine &engine = *m_LazyEngine;
+    const bool readStreaming = engine.m_IO.m_ReadStreaming;
+    engine.m_IO.m_ReadStreaming = false;
+
+    for (size_t s = m_ParsedVariablesStep + 1; s <= lastStep; ++s)
+    {
+        ParseVariablesIndexPerStep(m_Metadata, engine, 0, s);
+        m_ParsedVariablesStep = s;
+    }
+
+    engine.m_IO.m_ReadStreaming = readStreaming;
 }
 
-void BP4Deserializer::ParseMetadataIndex(const BufferSTL &bufferSTL)
+void BP4Deserializer::ParseVariablesIndexForSelection(
+    const core::VariableBase &variable) const
+{
+    // steps selection is relative to the variable's available steps
+    const size_t stepsEnd = variable.m_StepsStart + variable.m_StepsCount;
+
+    while (variable.m_AvailableStepBlockIndexOffsets.size() < stepsEnd &&
+           m_ParsedVariablesStep < m_MetadataSet.StepsCount)
+    {
+        ParseVariablesIndexUpToStep(m_ParsedVariablesStep + 1);
+    }
+}
+
+void BP4Deserializer::SetVariablesStreamingStep(core::IO &io,
+                                                const size_t step)
+{
+    const size_t oldestStep = (m_MaxParsedSteps > 0 && step > m_MaxParsedSteps)
+                                  ? step - m_MaxParsedSteps + 1
+                                  : 1;
+
+    auto lf_SetStep = [&](core::VariableBase &variable) {
+        auto &indices = variable.m_AvailableStepBlockIndexOffsets;
+        indices.erase(indices.begin(), indices.lower_bound(oldestStep));
+
+        auto itBlocksIndex = m_BlocksIndices.find(variable.m_Name);
+        if (itBlocksIndex != m_BlocksIndices.end())
+        {
+            auto &blocksIndices = itBlocksIndex->second;
+            blocksIndices.erase(blocksIndices.begin(),
+                                blocksIndices.lower_bound(oldestStep));
+        }
+
+        // Get uses the position of the step in the remaining index
+        variable.m_StepsStart = static_cast<size_t>(
+            std::distance(indices.begin(), indices.lower_bound(step)));
+    };
+
+    const bool readStreaming = io.m_ReadStreaming;
+    io.m_ReadStreaming = false;
+
+    for (const auto &variableData : io.GetVariablesDataMap())
+    {
+        const std::string &name = variableData.first;
+        const std::string type = io.InquireVariableType(name);
+
+        if (type == "compound")
+        {
+        }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetType<T>())                                     \
+    {                                                                          \
+        lf_SetStep(*io.InquireVariable<T>(name));                              \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+
+    io.m_ReadStreaming = readStreaming;
+}
+
+void BP4Deserializer::ParseMetadataIndex(const BufferSTL &bufferSTL,
+                                         const size_t startPosition)
 {
     const auto &buffer = bufferSTL.m_Buffer;
-    const size_t bufferSize = buffer.size();
-    size_t position = 0;
+    size_t position = startPosition;
+    if (startPosition > 0)
+    {
+        ParseMetadataIndexEntries(buffer, position);
+        return;
+    }
+
     position += 28;
     const uint8_t endianness = helper::ReadValue<uint8_t>(buffer, position);
     m_Minifooter.IsLittleEndian = (endianness == 0) ? true : false;
@@ -105,6 +219,13 @@ void BP4Deserializer::ParseMetadataIndex(const BufferSTL &bufferSTL)
     m_Minifooter.VersionTag.assign(&buffer[position], 28);
 
     position += 48;
+    ParseMetadataIndexEntries(buffer, position);
+}
+
+void BP4Deserializer::ParseMetadataIndexEntries(const std::vector<char> &buffer,
+                                                size_t &position)
+{
+    const size_t bufferSize = buffer.size();
     while (position < bufferSize)
     {
         std::vector<uint64_t> ptrs;
@@ -277,7 +398,7 @@ void BP4Deserializer::ParsePGIndexPerStep(const BufferSTL &bufferSTL,
 void BP4Deserializer::ParseVariablesIndexPerStep(const BufferSTL &bufferSTL,
                                                  core::Engine &engine,
                                                  size_t submetadatafileId,
-                                                 size_t step)
+                                                 size_t step) const
 {
     auto lf_ReadElementIndexPerStep = [&](core::Engine &engine,
                                           const std::vector<char> &buffer,
@@ -302,7 +423,7 @@ void BP4Deserializer::ParseVariablesIndexPerStep(const BufferSTL &bufferSTL,
     };
 
     const auto &buffer = bufferSTL.m_Buffer;
-    size_t position = m_MetadataIndexTable[submetadatafileId][step][1];
+    size_t position = m_MetadataIndexTable.at(submetadatafileId).at(step)[1];
 
     const uint32_t count = helper::ReadValue<uint32_t>(
         buffer, position, m_Minifooter.IsLittleEndian);
@@ -370,6 +491,62 @@ void BP4Deserializer::ParseVariablesIndexPerStep(const BufferSTL &bufferSTL,
     }
 }
 
+void BP4Deserializer::ScanVariablesIndexPerStep(const BufferSTL &bufferSTL,
+                                                core::Engine &engine,
+                                                size_t step) const
+{
+    const auto &buffer = bufferSTL.m_Buffer;
+    size_t position = m_MetadataIndexTable.at(0).at(step)[1];
+
+    // variables count, unused
+    helper::ReadValue<uint32_t>(buffer, position, m_Minifooter.IsLittleEndian);
+    const uint64_t length = helper::ReadValue<uint64_t>(
+        buffer, position, m_Minifooter.IsLittleEndian);
+
+    const size_t startPosition = position;
+
+    while (position - startPosition < length)
+    {
+        size_t headerPosition = position;
+        const ElementIndexHeader header = ReadElementIndexHeader(
+            buffer, headerPosition, m_Minifooter.IsLittleEndian);
+
+        const std::string variableName =
+            header.Path.empty() ? header.Name
+                                : header.Path + PathSeparator + header.Name;
+
+        // characteristics are only read for variables first found in step
+        switch (header.DataType)
+        {
+
+#define make_case(T)                                                           \
+    case (TypeTraits<T>::type_enum):                                           \
+    {                                                                          \
+        core::Variable<T> *variable =                                          \
+            engine.m_IO.InquireVariable<T>(variableName);                      \
+        if (variable == nullptr)                                               \
+        {                                                                      \
+            DefineVariableInEngineIOPerStep<T>(header, engine, buffer,         \
+                                               headerPosition, step);          \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            ++variable->m_AvailableStepsCount;                                 \
+        }                                                                      \
+        break;                                                                 \
+    }
+            ADIOS2_FOREACH_STDTYPE_1ARG(make_case)
+#undef make_case
+
+        } // end switch
+
+        const size_t elementIndexSize =
+            static_cast<size_t>(helper::ReadValue<uint32_t>(
+                buffer, position, m_Minifooter.IsLittleEndian));
+        position += elementIndexSize;
+    }
+}
+
 /* void BP4Deserializer::ParseVariablesIndex(const BufferSTL &bufferSTL,
                                           core::IO &io)
 {
@@ -590,10 +767,11 @@ BP4Deserializer::PerformGetsVariablesSubFileInfo(core::IO &io)
     return m_DeferredVariablesMap;
 }
 
-void BP4Deserializer::ClipMemory(const std::string &variableName, core::IO &io,
-                                 const std::vector<char> &contiguousMemory,
-                                 const Box<Dims> &blockBox,
-                                 const Box<Dims> &intersectionBox) const
+void BP4Deserializer::ClipMemory(
+    const std::string &variableName, core::IO &io,
+    const std::vector<char> &contiguousMemory,
+    const Box<helper::SmallDims> &blockBox,
+    const Box<helper::SmallDims> &intersectionBox) const
 {
     const std::string type(io.InquireVariableType(variableName));
 
@@ -628,7 +806,8 @@ void BP4Deserializer::ClipMemory(const std::string &variableName, core::IO &io,
                                                                                \
     template void BP4Deserializer::ClipContiguousMemory<T>(                    \
         typename core::Variable<T>::Info &, const std::vector<char> &,         \
-        const Box<Dims> &, const Box<Dims> &) const;                           \
+        const Box<helper::SmallDims> &,                                        \
+        const Box<helper::SmallDims> &) const;                                 \
                                                                                \
     template void BP4Deserializer::GetValueFromMetadata(                       \
         core::Variable<T> &variable, T *) const;
@@ -660,9 +839,17 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
         const helper::SubStreamBoxInfo &, char *&, size_t &, size_t &,         \
         const size_t);                                                         \
                                                                                \
+    template bool BP4Deserializer::CachedDataRead(                             \
+        core::Variable<T> &, typename core::Variable<T>::Info &,               \
+        const helper::SubStreamBoxInfo &, const bool, const size_t);           \
+                                                                               \
     template void BP4Deserializer::PostDataRead(                               \
         core::Variable<T> &, typename core::Variable<T>::Info &,               \
-        const helper::SubStreamBoxInfo &, const bool, const size_t);
+        const helper::SubStreamBoxInfo &, const bool, const size_t);           \
+                                                                               \
+    template void BP4Deserializer::ClipPayload(                                \
+        const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
+        T *, const helper::SubStreamBoxInfo &, const char *) const;
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -11,14 +11,18 @@
 #ifndef ADIOS2_TOOLKIT_FORMAT_BP4_BP4DESERIALIZER_H_
 #define ADIOS2_TOOLKIT_FORMAT_BP4_BP4DESERIALIZER_H_
 
+#include <map>
 #include <mutex>
 #include <set>
+#include <string>
+#include <unordered_map>
 #include <utility> //std::pair
 #include <vector>
 
 #include "adios2/core/IO.h"
 #include "adios2/core/Variable.h"
 #include "adios2/helper/adiosFunctions.h" //VariablesSubFileInfo, BlockOperation
+#include "adios2/toolkit/format/BlockCache.h"
 #include "adios2/toolkit/format/bp4/BP4Base.h"
 
 namespace adios2
@@ -40,6 +44,9 @@ public:
 
     BufferSTL m_MetadataIndex;
 
+    /** operated blocks kept across Get calls, capacity is m_BlockCacheSize */
+    BlockCache m_BlockCache;
+
     /**
      * Unique constructor
      * @param mpiComm
@@ -49,10 +56,51 @@ public:
 
     ~BP4Deserializer() = default;
 
-    void ParseMetadataIndex(const BufferSTL &bufferSTL);
+    /**
+     * Parses the metadata index table
+     * @param bufferSTL metadata index
+     * @param startPosition 0: header and all entries, otherwise position of
+     * the first new entry appended by a stream reader
+     */
+    void ParseMetadataIndex(const BufferSTL &bufferSTL,
+                            const size_t startPosition = 0);
 
+    /**
+     * Parses process groups and attributes of all steps not parsed by a
+     * previous call. Variables are parsed for all steps. If m_LazyMetadata is
+     * true only their index headers are scanned: variables are defined from
+     * their first step and count all their steps, the blocks of other steps
+     * are parsed on demand.
+     * @param bufferSTL metadata
+     * @param engine reader engine, variables are defined in its IO
+     */
     void ParseMetadata(const BufferSTL &bufferSTL, core::Engine &engine);
 
+    /**
+     * Lazy metadata: parses the variables index of m_Metadata for all steps
+     * up to step that are not parsed yet. Const so BlocksInfo queries can
+     * call it, it only fills the lazily parsed state.
+     * @param step last step to parse, bp4 steps start at 1
+     */
+    void ParseVariablesIndexUpToStep(const size_t step) const;
+
+    /**
+     * Lazy metadata: parses the variables index of steps until variable has
+     * the steps in its current steps selection, or all steps are parsed
+     * @param variable with steps selection from SetStepSelection or BeginStep
+     */
+    void ParseVariablesIndexForSelection(
+        const core::VariableBase &variable) const;
+
+    /**
+     * Lazy metadata streaming: drops the parsed variables index of steps
+     * older than m_MaxParsedSteps and points every variable steps selection
+     * to step within its remaining steps
+     * @param io reader IO
+     * @param step current step, bp4 steps start at 1
+     */
+    void SetVariablesStreamingStep(core::IO &io, const size_t step);
+
     /**
      * Used to get the variable payload data for the current selection (dims and
      * steps), used in single buffer for streaming
@@ -107,6 +155,25 @@ public:
                      char *&buffer, size_t &payloadSize, size_t &payloadOffset,
                      const size_t threadID = 0);
 
+    /**
+     * Serves an operated block from m_BlockCache without reading its subfile:
+     * clips a cached decompressed block, or decompresses a cached payload
+     * with PostDataRead
+     * @param variable input Variable
+     * @param blockInfo input blockInfo with the selection
+     * @param subStreamBoxInfo box (block) to be read
+     * @param isRowMajorDestination passed to PostDataRead
+     * @param threadID thread buffers used by PostDataRead
+     * @return true: blockInfo.Data is filled, false: not cached, use
+     * PreDataRead, read the payload, then PostDataRead
+     */
+    template <class T>
+    bool CachedDataRead(core::Variable<T> &variable,
+                        typename core::Variable<T>::Info &blockInfo,
+                        const helper::SubStreamBoxInfo &subStreamBoxInfo,
+                        const bool isRowMajorDestination,
+                        const size_t threadID = 0);
+
     template <class T>
     void PostDataRead(core::Variable<T> &variable,
                       typename core::Variable<T>::Info &blockInfo,
@@ -114,6 +181,24 @@ public:
                       const bool isRowMajorDestination,
                       const size_t threadID = 0);
 
+    /**
+     * Clips a raw (not operated) payload into blockData, the part of
+     * PostDataRead after the payload is available in memory. Used directly
+     * on memory mapped files to skip the thread buffer copy and on coalesced
+     * reads, it can run in parallel for different blocks.
+     * @param variable input Variable
+     * @param blockInfo input blockInfo with the selection
+     * @param blockData destination, blockInfo.Data of the payload's step
+     * @param subStreamBoxInfo box (block) the payload belongs to
+     * @param payload contiguous memory starting at subStreamBoxInfo.Seeks.first
+     */
+    template <class T>
+    void ClipPayload(const core::Variable<T> &variable,
+                     const typename core::Variable<T>::Info &blockInfo,
+                     T *blockData,
+                     const helper::SubStreamBoxInfo &subStreamBoxInfo,
+                     const char *payload) const;
+
     /**
      * Clips and assigns memory to blockInfo.Data from a contiguous memory
      * input
@@ -123,10 +208,11 @@ public:
      * @param intersectionBox
      */
     template <class T>
-    void ClipContiguousMemory(typename core::Variable<T>::Info &blockInfo,
-                              const std::vector<char> &contiguousMemory,
-                              const Box<Dims> &blockBox,
-                              const Box<Dims> &intersectionBox) const;
+    void
+    ClipContiguousMemory(typename core::Variable<T>::Info &blockInfo,
+                         const std::vector<char> &contiguousMemory,
+                         const Box<helper::SmallDims> &blockBox,
+                         const Box<helper::SmallDims> &intersectionBox) const;
 
     /**
      * Gets a value directly from metadata (if Variable is single value)
@@ -165,8 +251,8 @@ public:
     // TODO : will deprecate
     void ClipMemory(const std::string &variableName, core::IO &io,
                     const std::vector<char> &contiguousMemory,
-                    const Box<Dims> &blockBox,
-                    const Box<Dims> &intersectionBox) const;
+                    const Box<helper::SmallDims> &blockBox,
+                    const Box<helper::SmallDims> &intersectionBox) const;
 
     // TODO: will deprecate
     bool m_PerformedGets = false;
@@ -176,6 +262,68 @@ private:
 
     static std::mutex m_Mutex;
 
+    /**
+     * lazy metadata: last step with a parsed variables index, bp4 steps
+     * start at 1
+     */
+    mutable size_t m_ParsedVariablesStep = 0;
+
+    /** lazy metadata: reader engine passed to ParseMetadata */
+    core::Engine *m_LazyEngine = nullptr;
+
+    /** steps with parsed process groups and attributes */
+    size_t m_ParsedMetadataSteps = 0;
+
+    /**
+     * Global array blocks of a variable step sorted by start in the first
+     * dimension (file order), with the block characteristics used by
+     * SetVariableBlockInfo. A selection only checks the blocks that overlap
+     * it in the first dimension instead of parsing the metadata of all blocks.
+     */
+    struct BlocksIndex
+    {
+        struct Block
+        {
+            /** start and end in file order */
+            Box<helper::SmallDims> BlockBox;
+            Dims Shape;
+            size_t PayloadOffset = 0;
+            size_t SubStreamID = 0;
+            /** block index offset in metadata, operations are read from it */
+            size_t IndexOffset = 0;
+            /** block position in the step, requests keep the metadata order */
+            size_t Position = 0;
+            bool IsOperated = false;
+        };
+
+        /** zero count blocks are left out */
+        std::vector<Block> Blocks;
+        /** MaxEnds[i]: largest end in the first dimension of Blocks[0..i] */
+        std::vector<size_t> MaxEnds;
+        /** blocks in the step when the index was built */
+        size_t StepBlocksCount = 0;
+    };
+
+    /** built lazily by GetBlocksIndex, key: variable name, value: steps */
+    mutable std::unordered_map<std::string, std::map<size_t, BlocksIndex>>
+        m_BlocksIndices;
+
+    /**
+     * Returns the blocks index of a global array variable step, built from
+     * the metadata on first use
+     * @param variable
+     * @param step key in variable.m_AvailableStepBlockIndexOffsets
+     * @param blockOffsets block index offsets of step in m_Metadata
+     */
+    template <class T>
+    const BlocksIndex &
+    GetBlocksIndex(const core::Variable<T> &variable, const size_t step,
+                   const std::vector<size_t> &blockOffsets) const;
+
+    /** Parses 48-byte metadata index entries from position to the end */
+    void ParseMetadataIndexEntries(const std::vector<char> &buffer,
+                                   size_t &position);
+
     void ParseMinifooter(const BufferSTL &bufferSTL);
 
     // void ParsePGIndex(const BufferSTL &bufferSTL, const core::IO &io);
@@ -186,7 +334,18 @@ private:
     // void ParseVariablesIndex(const BufferSTL &bufferSTL, core::IO &io);
     void ParseVariablesIndexPerStep(const BufferSTL &bufferSTL,
                                     core::Engine &engine,
-                                    size_t submetadatafileId, size_t step);
+                                    size_t submetadatafileId,
+                                    size_t step) const;
+
+    /**
+     * Lazy metadata: reads only the variables index headers of a step, counts
+     * the step for each variable and defines the variables first found in it
+     * @param bufferSTL metadata
+     * @param engine reader engine, variables are defined in its IO
+     * @param step bp4 steps start at 1
+     */
+    void ScanVariablesIndexPerStep(const BufferSTL &bufferSTL,
+                                   core::Engine &engine, size_t step) const;
 
     // void ParseAttributesIndex(const BufferSTL &bufferSTL, core::IO &io);
     void ParseAttributesIndexPerStep(const BufferSTL &bufferSTL,
@@ -242,7 +401,8 @@ private:
                                                                                \
     extern template void BP4Deserializer::ClipContiguousMemory<T>(             \
         typename core::Variable<T>::Info &, const std::vector<char> &,         \
-        const Box<Dims> &, const Box<Dims> &intersectionBox) const;            \
+        const Box<helper::SmallDims> &,                                        \
+        const Box<helper::SmallDims> &intersectionBox) const;                  \
                                                                                \
     extern template void BP4Deserializer::GetValueFromMetadata(                \
         core::Variable<T> &variable, T *) const;
@@ -275,9 +435,17 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
         const helper::SubStreamBoxInfo &, char *&, size_t &, size_t &,         \
         const size_t);                                                         \
                                                                                \
+    extern template bool BP4Deserializer::CachedDataRead(                      \
+        core::Variable<T> &, typename core::Variable<T>::Info &,               \
+        const helper::SubStreamBoxInfo &, const bool, const size_t);           \
+                                                                               \
     extern template void BP4Deserializer::PostDataRead(                        \
         core::Variable<T> &, typename core::Variable<T>::Info &,               \
-        const helper::SubStreamBoxInfo &, const bool, const size_t);
+        const helper::SubStreamBoxInfo &, const bool, const size_t);           \
+                                                                               \
+    extern template void BP4Deserializer::ClipPayload(                         \
+        const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
+        T *, const helper::SubStreamBoxInfo &, const char *) const;
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -60,6 +60,13 @@ BP4Deserializer::InitVariableBlockInfo(core::Variable<T> &variable,
     if (m_DebugMode)
     {
         const auto &indices = variable.m_AvailableStepBlockIndexOffsets;
+        if (indices.empty())
+        {
+            throw std::invalid_argument(
+                "ERROR: no available steps for variable " + variable.m_Name +
+                ", in call to Get\n");
+        }
+
         const size_t maxStep = indices.rbegin()->first;
         if (stepsStart + 1 > maxStep)
         {
@@ -155,7 +162,8 @@ void BP4Deserializer::SetVariableBlockInfo(
     };
 
     auto lf_SetSubStreamInfoLocalArray =
-        [&](const std::string &variableName, const Box<Dims> &selectionBox,
+        [&](const std::string &variableName,
+            const Box<helper::SmallDims> &selectionBox,
             typename core::Variable<T>::Info &blockInfo, const size_t step,
             const size_t blockIndexOffset, const BufferSTL &bufferSTL,
             const bool isRowMajor)
@@ -179,8 +187,9 @@ void BP4Deserializer::SetVariableBlockInfo(
 
         // if selection box start is not empty = local selection
         subStreamInfo.BlockBox =
-            helper::StartEndBox(Dims(blockCharacteristics.Count.size(), 0),
-                                blockCharacteristics.Count);
+            helper::StartEndBox(
+                helper::SmallDims(blockCharacteristics.Count.size(), 0),
+                blockCharacteristics.Count);
 
         if (!selectionBox.first.empty()) // selection start count was defined
         {
@@ -273,43 +282,20 @@ void BP4Deserializer::SetVariableBlockInfo(
     };
 
     auto lf_SetSubStreamInfoGlobalArray =
-        [&](const std::string &variableName, const Box<Dims> &selectionBox,
+        [&](const std::string &variableName,
             typename core::Variable<T>::Info &blockInfo, const size_t step,
-            const size_t blockIndexOffset, const BufferSTL &bufferSTL,
-            const bool isRowMajor)
+            const BlocksIndex::Block &block,
+            const Box<helper::SmallDims> &intersectionBox,
+            const BufferSTL &bufferSTL, const bool isRowMajor)
 
     {
-        const std::vector<char> &buffer = bufferSTL.m_Buffer;
-
-        size_t position = blockIndexOffset;
-
-        const Characteristics<T> blockCharacteristics =
-            ReadElementIndexCharacteristics<T>(buffer, position,
-                                               TypeTraits<T>::type_enum, false,
-                                               m_Minifooter.IsLittleEndian);
-
-        // check if they intersect
         helper::SubStreamBoxInfo subStreamInfo;
-
-        if (helper::GetTotalSize(blockCharacteristics.Count) == 0)
-        {
-            subStreamInfo.ZeroBlock = true;
-        }
-
-        subStreamInfo.BlockBox = helper::StartEndBox(
-            blockCharacteristics.Start, blockCharacteristics.Count);
-        subStreamInfo.IntersectionBox =
-            helper::IntersectionBox(selectionBox, subStreamInfo.BlockBox);
-
-        if (subStreamInfo.IntersectionBox.first.empty() ||
-            subStreamInfo.IntersectionBox.second.empty())
-        {
-            return;
-        }
+        subStreamInfo.BlockBox = block.BlockBox;
+        subStreamInfo.IntersectionBox = intersectionBox;
 
         if (m_DebugMode)
         {
-            const size_t dimensions = blockCharacteristics.Shape.size();
+            const size_t dimensions = block.Shape.size();
             if (dimensions != blockInfo.Shape.size())
             {
                 throw std::invalid_argument(
@@ -320,7 +306,7 @@ void BP4Deserializer::SetVariableBlockInfo(
                     variableName + ", in call to Get");
             }
 
-            Dims readInShape = blockCharacteristics.Shape;
+            Dims readInShape = block.Shape;
             if (m_ReverseDimensions)
             {
                 std::reverse(readInShape.begin(), readInShape.end());
@@ -336,7 +322,7 @@ void BP4Deserializer::SetVariableBlockInfo(
                         helper::DimsToString(blockInfo.Count) +
                         " (requested) is out of bounds of (available) "
                         "Shape " +
-                        helper::DimsToString(blockCharacteristics.Shape) +
+                        helper::DimsToString(block.Shape) +
                         " , when reading global array variable " +
                         variableName + ", in call to Get");
                 }
@@ -355,24 +341,28 @@ void BP4Deserializer::SetVariableBlockInfo(
                              subStreamInfo.IntersectionBox.second, isRowMajor) +
                          1);
 
-        const size_t payloadOffset =
-            blockCharacteristics.Statistics.PayloadOffset;
-        const auto &bp4Op = blockCharacteristics.Statistics.Op;
         // if they intersect get info Seeks (first: start, second:
         // count) depending on operation info
-        if (bp4Op.IsActive)
+        if (block.IsOperated)
         {
-            lf_SetSubStreamInfoOperations(bp4Op, payloadOffset, subStreamInfo,
+            // operation metadata is not kept in the index
+            size_t position = block.IndexOffset;
+            const Characteristics<T> blockCharacteristics =
+                ReadElementIndexCharacteristics<T>(
+                    bufferSTL.m_Buffer, position, TypeTraits<T>::type_enum,
+                    false, m_Minifooter.IsLittleEndian);
+
+            lf_SetSubStreamInfoOperations(blockCharacteristics.Statistics.Op,
+                                          block.PayloadOffset, subStreamInfo,
                                           m_IsRowMajor);
         }
         else
         {
             // make it absolute if no operations
-            subStreamInfo.Seeks.first += payloadOffset;
-            subStreamInfo.Seeks.second += payloadOffset;
+            subStreamInfo.Seeks.first += block.PayloadOffset;
+            subStreamInfo.Seeks.second += block.PayloadOffset;
         }
-        subStreamInfo.SubStreamID =
-            static_cast<size_t>(blockCharacteristics.Statistics.FileIndex);
+        subStreamInfo.SubStreamID = block.SubStreamID;
 
         blockInfo.StepBlockSubStreamsInfo[step].push_back(
             std::move(subStreamInfo));
@@ -382,7 +372,7 @@ void BP4Deserializer::SetVariableBlockInfo(
     const std::map<size_t, std::vector<size_t>> &indices =
         variable.m_AvailableStepBlockIndexOffsets;
 
-    const Box<Dims> selectionBox = helper::StartEndBox(
+    const Box<helper::SmallDims> selectionBox = helper::StartEndBox(
         blockInfo.Start, blockInfo.Count, m_ReverseDimensions);
 
     auto itStep = std::next(indices.begin(), blockInfo.StepsStart);
@@ -394,11 +384,60 @@ void BP4Deserializer::SetVariableBlockInfo(
 
         if (variable.m_ShapeID == ShapeID::GlobalArray)
         {
-            for (const size_t blockOffset : blockOffsets)
+            const BlocksIndex &blocksIndex =
+                GetBlocksIndex(variable, step, blockOffsets);
+            const std::vector<BlocksIndex::Block> &blocks = blocksIndex.Blocks;
+
+            // candidates overlap the selection in the first dimension
+            size_t candidatesStart = 0;
+            size_t candidatesEnd = blocks.size();
+            if (!selectionBox.first.empty())
             {
-                lf_SetSubStreamInfoGlobalArray(variable.m_Name, selectionBox,
-                                               blockInfo, step, blockOffset,
-                                               m_Metadata, m_IsRowMajor);
+                candidatesStart = static_cast<size_t>(std::distance(
+                    blocksIndex.MaxEnds.begin(),
+                    std::lower_bound(blocksIndex.MaxEnds.begin(),
+                                     blocksIndex.MaxEnds.end(),
+                                     selectionBox.first.front())));
+
+                candidatesEnd = static_cast<size_t>(std::distance(
+                    blocks.begin(),
+                    std::upper_bound(
+                        blocks.begin(), blocks.end(),
+                        selectionBox.second.front(),
+                        [](const size_t end, const BlocksIndex::Block &block) {
+                            return end < block.BlockBox.first.front();
+                        })));
+            }
+
+            std::vector<
+                std::pair<const BlocksIndex::Block *, Box<helper::SmallDims>>>
+                intersections;
+            for (size_t b = candidatesStart; b < candidatesEnd; ++b)
+            {
+                Box<helper::SmallDims> intersectionBox =
+                    helper::IntersectionBox(selectionBox, blocks[b].BlockBox);
+
+                if (!intersectionBox.first.empty() &&
+                    !intersectionBox.second.empty())
+                {
+                    intersections.emplace_back(&blocks[b],
+                                               std::move(intersectionBox));
+                }
+            }
+
+            std::sort(intersections.begin(), intersections.end(),
+                      [](const std::pair<const BlocksIndex::Block *,
+                                         Box<helper::SmallDims>> &a,
+                         const std::pair<const BlocksIndex::Block *,
+                                         Box<helper::SmallDims>> &b) {
+                          return a.first->Position < b.first->Position;
+                      });
+
+            for (const auto &intersection : intersections)
+            {
+                lf_SetSubStreamInfoGlobalArray(
+                    variable.m_Name, blockInfo, step, *intersection.first,
+                    intersection.second, m_Metadata, m_IsRowMajor);
             }
         }
         else if (variable.m_ShapeID == ShapeID::LocalArray)
@@ -412,6 +451,76 @@ void BP4Deserializer::SetVariableBlockInfo(
     }
 }
 
+template <class T>
+const BP4Deserializer::BlocksIndex &
+BP4Deserializer::GetBlocksIndex(const core::Variable<T> &variable,
+                                const size_t step,
+                                const std::vector<size_t> &blockOffsets) const
+{
+    BlocksIndex &blocksIndex = m_BlocksIndices[variable.m_Name][step];
+    if (!blocksIndex.Blocks.empty() &&
+        blocksIndex.StepBlocksCount == blockOffsets.size())
+    {
+        return blocksIndex;
+    }
+
+    blocksIndex = BlocksIndex();
+    blocksIndex.StepBlocksCount = blockOffsets.size();
+    blocksIndex.Blocks.reserve(blockOffsets.size());
+
+    for (size_t b = 0; b < blockOffsets.size(); ++b)
+    {
+        size_t position = blockOffsets[b];
+        const Characteristics<T> blockCharacteristics =
+            ReadElementIndexCharacteristics<T>(m_Metadata.m_Buffer, position,
+                                               TypeTraits<T>::type_enum, false,
+                                               m_Minifooter.IsLittleEndian);
+
+        // zero blocks never intersect a selection
+        if (helper::GetTotalSize(blockCharacteristics.Count) == 0)
+        {
+            continue;
+        }
+
+        BlocksIndex::Block block;
+        block.BlockBox = helper::StartEndBox(blockCharacteristics.Start,
+                                             blockCharacteristics.Count);
+        block.Shape = blockCharacteristics.Shape;
+        block.PayloadOffset = blockCharacteristics.Statistics.PayloadOffset;
+        block.SubStreamID =
+            static_cast<size_t>(blockCharacteristics.Statistics.FileIndex);
+        block.IndexOffset = blockOffsets[b];
+        block.Position = b;
+        block.IsOperated = blockCharacteristics.Statistics.Op.IsActive;
+        blocksIndex.Blocks.push_back(std::move(block));
+    }
+
+    auto lf_Start = [](const BlocksIndex::Block &block) -> size_t {
+        return block.BlockBox.first.empty() ? 0 : block.BlockBox.first.front();
+    };
+
+    auto lf_End = [](const BlocksIndex::Block &block) -> size_t {
+        return block.BlockBox.second.empty() ? MaxSizeT
+                                             : block.BlockBox.second.front();
+    };
+
+    std::stable_sort(
+        blocksIndex.Blocks.begin(), blocksIndex.Blocks.end(),
+        [&](const BlocksIndex::Block &a, const BlocksIndex::Block &b) {
+            return lf_Start(a) < lf_Start(b);
+        });
+
+    blocksIndex.MaxEnds.reserve(blocksIndex.Blocks.size());
+    size_t maxEnd = 0;
+    for (const BlocksIndex::Block &block : blocksIndex.Blocks)
+    {
+        maxEnd = std::max(maxEnd, lf_End(block));
+        blocksIndex.MaxEnds.push_back(maxEnd);
+    }
+
+    return blocksIndex;
+}
+
 template <class T>
 void BP4Deserializer::GetValueFromMetadata(core::Variable<T> &variable,
                                            T *data) const
@@ -499,6 +608,25 @@ void BP4Deserializer::PreDataRead(
 
         payloadSize = blockOperationInfo.PayloadSize;
         payloadOffset = blockOperationInfo.PayloadOffset;
+
+        // some operations only need part of the payload for the selection,
+        // cached payloads must be complete
+        const std::shared_ptr<BP4Operation> bp4Op =
+            identity ? nullptr
+                     : SetBP4Operation(blockOperationInfo.Info.at("Type"));
+        if (bp4Op && !m_BlockCache.IsActive())
+        {
+            size_t payloadStart = 0;
+            size_t payloadEnd = payloadSize;
+            bp4Op->GetPayloadRange(blockOperationInfo,
+                                   subStreamBoxInfo.Seeks.first,
+                                   subStreamBoxInfo.Seeks.second, payloadStart,
+                                   payloadEnd);
+
+            buffer += payloadStart;
+            payloadSize = payloadEnd - payloadStart;
+            payloadOffset += payloadStart;
+        }
     }
     else
     {
@@ -510,6 +638,48 @@ void BP4Deserializer::PreDataRead(
     }
 }
 
+template <class T>
+bool BP4Deserializer::CachedDataRead(
+    core::Variable<T> &variable, typename core::Variable<T>::Info &blockInfo,
+    const helper::SubStreamBoxInfo &subStreamBoxInfo,
+    const bool isRowMajorDestination, const size_t threadID)
+{
+    if (!m_BlockCache.IsActive() || subStreamBoxInfo.OperationsInfo.empty() ||
+        IdentityOperation<T>(blockInfo.Operations))
+    {
+        return false;
+    }
+
+    const helper::BlockOperationInfo &blockOperationInfo =
+        InitPostOperatorBlockData(subStreamBoxInfo.OperationsInfo);
+
+    // probe first so each lookup counts a single hit or miss
+    if (m_BlockCache.Contains(subStreamBoxInfo.SubStreamID,
+                              blockOperationInfo.PayloadOffset, true))
+    {
+        const std::vector<char> *preOpData =
+            m_BlockCache.Find(subStreamBoxInfo.SubStreamID,
+                              blockOperationInfo.PayloadOffset, true);
+        ClipPayload(variable, blockInfo, blockInfo.Data, subStreamBoxInfo,
+                    preOpData->data() + subStreamBoxInfo.Seeks.first);
+        return true;
+    }
+
+    const std::vector<char> *postOpData =
+        m_BlockCache.Find(subStreamBoxInfo.SubStreamID,
+                          blockOperationInfo.PayloadOffset, false);
+    if (postOpData != nullptr)
+    {
+        m_ThreadBuffers[threadID][1].assign(postOpData->begin(),
+                                            postOpData->end());
+        PostDataRead(variable, blockInfo, subStreamBoxInfo,
+                     isRowMajorDestination, threadID);
+        return true;
+    }
+
+    return false;
+}
+
 template <class T>
 void BP4Deserializer::PostDataRead(
     core::Variable<T> &variable, typename core::Variable<T>::Info &blockInfo,
@@ -525,16 +695,44 @@ void BP4Deserializer::PostDataRead(
         const size_t preOpPayloadSize =
             helper::GetTotalSize(blockOperationInfo.PreCount) *
             blockOperationInfo.PreSizeOf;
-        m_ThreadBuffers[threadID][0].resize(preOpPayloadSize);
 
         // get the right bp4Op
         std::shared_ptr<BP4Operation> bp4Op =
             SetBP4Operation(blockOperationInfo.Info.at("Type"));
 
-        // get original block back
-        char *preOpData = m_ThreadBuffers[threadID][0].data();
         const char *postOpData = m_ThreadBuffers[threadID][1].data();
-        bp4Op->GetData(postOpData, blockOperationInfo, preOpData);
+
+        // decompress the whole block once, later selections are clipped
+        // from the cache
+        if (m_BlockCache.Fits(preOpPayloadSize))
+        {
+            std::vector<char> block(preOpPayloadSize);
+            bp4Op->GetDataRange(postOpData, blockOperationInfo, block.data(),
+                                0, preOpPayloadSize, m_Threads);
+            ClipPayload(variable, blockInfo, blockInfo.Data, subStreamBoxInfo,
+                        block.data() + subStreamBoxInfo.Seeks.first);
+            m_BlockCache.Insert(subStreamBoxInfo.SubStreamID,
+                                blockOperationInfo.PayloadOffset, true,
+                                std::move(block));
+            return;
+        }
+
+        // too large decompressed, keeping the payload still saves the read
+        if (m_BlockCache.Fits(blockOperationInfo.PayloadSize) &&
+            !m_BlockCache.Contains(subStreamBoxInfo.SubStreamID,
+                                   blockOperationInfo.PayloadOffset, false))
+        {
+            m_BlockCache.Insert(
+                subStreamBoxInfo.SubStreamID, blockOperationInfo.PayloadOffset,
+                false, std::vector<char>(m_ThreadBuffers[threadID][1]));
+        }
+
+        // get original block back, at least the part that is clipped below
+        m_ThreadBuffers[threadID][0].resize(preOpPayloadSize);
+        char *preOpData = m_ThreadBuffers[threadID][0].data();
+        bp4Op->GetDataRange(postOpData, blockOperationInfo, preOpData,
+                            subStreamBoxInfo.Seeks.first,
+                            subStreamBoxInfo.Seeks.second, m_Threads);
 
         // clip block to match selection
         helper::ClipVector(m_ThreadBuffers[threadID][0],
@@ -542,6 +740,16 @@ void BP4Deserializer::PostDataRead(
                            subStreamBoxInfo.Seeks.second);
     }
 
+    ClipPayload(variable, blockInfo, blockInfo.Data, subStreamBoxInfo,
+                m_ThreadBuffers[threadID][0].data());
+}
+
+template <class T>
+void BP4Deserializer::ClipPayload(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo, T *blockData,
+    const helper::SubStreamBoxInfo &subStreamBoxInfo, const char *payload) const
+{
 #ifdef ADIOS2_HAVE_ENDIAN_REVERSE
     const bool endianReverse =
         (helper::IsLittleEndian() != m_Minifooter.IsLittleEndian) ? true
@@ -556,10 +764,9 @@ void BP4Deserializer::PostDataRead(
             : blockInfo.Start;
 
     helper::ClipContiguousMemory(
-        blockInfo.Data, blockInfoStart, blockInfo.Count,
-        m_ThreadBuffers[threadID][0].data(), subStreamBoxInfo.BlockBox,
-        subStreamBoxInfo.IntersectionBox, m_IsRowMajor, m_ReverseDimensions,
-        endianReverse);
+        blockData, blockInfoStart, blockInfo.Count, payload,
+        subStreamBoxInfo.BlockBox, subStreamBoxInfo.IntersectionBox,
+        m_IsRowMajor, m_ReverseDimensions, endianReverse);
 }
 
 template <class T>
@@ -597,8 +804,9 @@ BP4Deserializer::BlocksInfo(const core::Variable<T> &variable,
 template <class T>
 void BP4Deserializer::ClipContiguousMemory(
     typename core::Variable<T>::Info &blockInfo,
-    const std::vector<char> &contiguousMemory, const Box<Dims> &blockBox,
-    const Box<Dims> &intersectionBox) const
+    const std::vector<char> &contiguousMemory,
+    const Box<helper::SmallDims> &blockBox,
+    const Box<helper::SmallDims> &intersectionBox) const
 {
     helper::ClipContiguousMemory(
         blockInfo.Data, blockInfo.Start, blockInfo.Count, contiguousMemory,
@@ -627,6 +835,14 @@ inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
     variable = engine.m_IO.InquireVariable<std::string>(variableName);
     if (variable)
     {
+        // lazy metadata: already counted by ScanVariablesIndexPerStep, and
+        // parsed if the variable was defined from this step
+        if (m_LazyMetadata &&
+            variable->m_AvailableStepBlockIndexOffsets.count(step) == 1)
+        {
+            return;
+        }
+
         size_t endPositionCurrentStep =
             initialPosition -
             (header.Name.size() + header.GroupName.size() + header.Path.size() +
@@ -634,7 +850,10 @@ inline void BP4Deserializer::DefineVariableInEngineIOPerStep<std::string>(
             static_cast<size_t>(header.Length) + 4;
         position = initialPosition;
         // variable->m_AvailableStepsCount = step;
-        ++variable->m_AvailableStepsCount;
+        if (!m_LazyMetadata)
+        {
+            ++variable->m_AvailableStepsCount;
+        }
         // std::cout << variable->m_Name << ", " <<
         // variable->m_AvailableStepsCount << std::endl;
         while (position < endPositionCurrentStep)
@@ -778,6 +997,14 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
     variable = engine.m_IO.InquireVariable<T>(variableName);
     if (variable)
     {
+        // lazy metadata: already counted by ScanVariablesIndexPerStep, and
+        // parsed if the variable was defined from this step
+        if (m_LazyMetadata &&
+            variable->m_AvailableStepBlockIndexOffsets.count(step) == 1)
+        {
+            return;
+        }
+
         size_t endPositionCurrentStep =
             initialPosition -
             (header.Name.size() + header.GroupName.size() + header.Path.size() +
@@ -785,7 +1012,10 @@ void BP4Deserializer::DefineVariableInEngineIOPerStep(
             static_cast<size_t>(header.Length) + 4;
         position = initialPosition;
         // variable->m_AvailableStepsCount = step;
-        ++variable->m_AvailableStepsCount;
+        if (!m_LazyMetadata)
+        {
+            ++variable->m_AvailableStepsCount;
+        }
         while (position < endPositionCurrentStep)
         {
             const size_t subsetPosition = position;
@@ -1061,7 +1291,7 @@ BP4Deserializer::GetSubFileInfo(const core::Variable<T> &variable) const
     const size_t stepStart = variable.m_StepsStart + 1;
     const size_t stepEnd = stepStart + variable.m_StepsCount; // exclusive
 
-    const Box<Dims> selectionBox = helper::StartEndBox(
+    const Box<helper::SmallDims> selectionBox = helper::StartEndBox(
         variable.m_Start, variable.m_Count, m_ReverseDimensions);
 
     for (size_t step = stepStart; step < stepEnd; ++step)
@@ -1160,6 +1390,7 @@ std::vector<typename core::Variable<T>::Info> BP4Deserializer::BlocksInfoCommon(
             blockInfo.IsValue = false;
             blockInfo.Min = blockCharacteristics.Statistics.Min;
             blockInfo.Max = blockCharacteristics.Statistics.Max;
+            blockInfo.HasMinMax = blockCharacteristics.Statistics.HasMinMax;
         }
         blocksInfo.push_back(blockInfo);
     }
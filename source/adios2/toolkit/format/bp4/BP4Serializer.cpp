@@ -39,13 +39,14 @@ void BP4Serializer::PutProcessGroupIndex(
     const std::string &ioName, const std::string hostLanguage,
     const std::vector<std::string> &transportsTypes) noexcept
 {
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
     std::vector<char> &metadataBuffer = m_MetadataSet.PGIndex.Buffer;
 
     std::vector<char> &dataBuffer = m_Data.m_Buffer;
     size_t &dataPosition = m_Data.m_Position;
 
-    m_MetadataSet.DataPGLengthPosition = dataPosition;
+    const size_t pgStartPosition = dataPosition;
+    m_MetadataSet.DataPGLengthPosition = m_Data.GetSegmentedPosition();
     dataPosition += 8; // skip pg length (8)
 
     const std::size_t metadataPGLengthPosition = metadataBuffer.size();
@@ -105,11 +106,10 @@ void BP4Serializer::PutProcessGroupIndex(
     }
 
     // update absolute position
-    m_Data.m_AbsolutePosition +=
-        dataPosition - m_MetadataSet.DataPGLengthPosition;
+    m_Data.m_AbsolutePosition += dataPosition - pgStartPosition;
     // pg vars count and position
     m_MetadataSet.DataPGVarsCount = 0;
-    m_MetadataSet.DataPGVarsCountPosition = dataPosition;
+    m_MetadataSet.DataPGVarsCountPosition = m_Data.GetSegmentedPosition();
     // add vars count and length
     dataPosition += 12;
     m_Data.m_AbsolutePosition += 12; // add vars count and length
@@ -117,24 +117,24 @@ void BP4Serializer::PutProcessGroupIndex(
     ++m_MetadataSet.DataPGCount;
     m_MetadataSet.DataPGIsOpen = true;
 
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 void BP4Serializer::SerializeData(core::IO &io, const bool advanceStep)
 {
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
     SerializeDataBuffer(io);
     if (advanceStep)
     {
         ++m_MetadataSet.TimeStep;
         ++m_MetadataSet.CurrentStep;
     }
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 void BP4Serializer::CloseData(core::IO &io)
 {
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
 
     if (!m_IsClosed)
     {
@@ -150,16 +150,16 @@ void BP4Serializer::CloseData(core::IO &io)
             m_Profiler.Bytes.at("buffering") = m_Data.m_AbsolutePosition;
         }
 
-        m_Aggregator.Close();
+        m_Aggregator->Close();
         m_IsClosed = true;
     }
 
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 void BP4Serializer::CloseStream(core::IO &io, const bool addMetadata)
 {
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
     if (m_MetadataSet.DataPGIsOpen)
     {
         SerializeDataBuffer(io);
@@ -169,16 +169,16 @@ void BP4Serializer::CloseStream(core::IO &io, const bool addMetadata)
 
     if (m_Profiler.IsActive)
     {
-        m_Profiler.Bytes.at("buffering") += m_Data.m_Position;
+        m_Profiler.Bytes.at("buffering") += m_Data.GetSegmentedPosition();
     }
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 void BP4Serializer::CloseStream(core::IO &io, size_t &metadataStart,
                                 size_t &metadataCount, const bool addMetadata)
 {
 
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
     if (m_MetadataSet.DataPGIsOpen)
     {
         SerializeDataBuffer(io);
@@ -192,9 +192,9 @@ void BP4Serializer::CloseStream(core::IO &io, size_t &metadataStart,
 
     if (m_Profiler.IsActive)
     {
-        m_Profiler.Bytes.at("buffering") += m_Data.m_Position;
+        m_Profiler.Bytes.at("buffering") += m_Data.GetSegmentedPosition();
     }
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 void BP4Serializer::ResetIndices()
@@ -261,6 +261,8 @@ std::string BP4Serializer::GetRankProfilingJSON(
     rankLog += "\"threads\": " + std::to_string(m_Threads) + ", ";
     rankLog +=
         "\"bytes\": " + std::to_string(profiler.Bytes.at("buffering")) + ", ";
+    rankLog +=
+        "\"buffer_peak\": " + std::to_string(m_Data.GetPeakSize()) + ", ";
     lf_WriterTimer(rankLog, profiler.Timers.at("buffering"));
     lf_WriterTimer(rankLog, profiler.Timers.at("memcpy"));
     lf_WriterTimer(rankLog, profiler.Timers.at("minmax"));
@@ -307,8 +309,14 @@ void BP4Serializer::AggregateCollectiveMetadata(MPI_Comm comm,
                                                 BufferSTL &bufferSTL,
                                                 const bool inMetadataBuffer)
 {
-    ProfilerStart("buffering");
-    ProfilerStart("meta_sort_merge");
+    ProfilerStart(profiling::TraceEvent::Buffering);
+    ProfilerStart(profiling::TraceEvent::MetaSortMerge);
+
+    if (m_HierarchicalMetadata && comm == m_MPIComm && m_SizeMPI > 1 &&
+        m_MetadataGroupComm == MPI_COMM_NULL)
+    {
+        InitMetadataGroupComm(comm);
+    }
 
     auto &position = bufferSTL.m_Position;
 
@@ -354,8 +362,8 @@ void BP4Serializer::AggregateCollectiveMetadata(MPI_Comm comm,
         }
     }
 
-    ProfilerStop("meta_sort_merge");
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::MetaSortMerge);
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 void BP4Serializer::UpdateOffsetsInMetadata()
@@ -421,7 +429,7 @@ void BP4Serializer::UpdateOffsetsInMetadata()
     };
 
     // BODY OF FUNCTION STARTS HERE
-    if (m_Aggregator.m_IsConsumer)
+    if (m_Aggregator->m_IsConsumer)
     {
         return;
     }
@@ -614,18 +622,20 @@ BP4Serializer::SerialElementIndex &BP4Serializer::GetSerialElementIndex(
 
 void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
 {
-    auto &buffer = m_Data.m_Buffer;
     auto &position = m_Data.m_Position;
     auto &absolutePosition = m_Data.m_AbsolutePosition;
 
+    // PG records might be in a previous segment
+    size_t varsCountPosition = m_MetadataSet.DataPGVarsCountPosition;
+    std::vector<char> &varsCountBuffer = m_Data.GetSegment(varsCountPosition);
+
     // vars count and Length (only for PG)
-    helper::CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition,
+    helper::CopyToBuffer(varsCountBuffer, varsCountPosition,
                          &m_MetadataSet.DataPGVarsCount);
     // without record itself and vars count
-    const uint64_t varsLength =
-        position - m_MetadataSet.DataPGVarsCountPosition - 8 - 4;
-    helper::CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition,
-                         &varsLength);
+    const uint64_t varsLength = m_Data.GetSegmentedPosition() -
+                                m_MetadataSet.DataPGVarsCountPosition - 8 - 4;
+    helper::CopyToBuffer(varsCountBuffer, varsCountPosition, &varsLength);
 
     // each attribute is only written to output once
     size_t attributesSizeInData = GetAttributesSizeInData(io);
@@ -647,9 +657,10 @@ void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
     }
 
     // Finish writing pg group length without record itself
-    const uint64_t dataPGLength =
-        position - m_MetadataSet.DataPGLengthPosition - 8;
-    helper::CopyToBuffer(buffer, m_MetadataSet.DataPGLengthPosition,
+    const uint64_t dataPGLength = m_Data.GetSegmentedPosition() -
+                                  m_MetadataSet.DataPGLengthPosition - 8;
+    size_t pgLengthPosition = m_MetadataSet.DataPGLengthPosition;
+    helper::CopyToBuffer(m_Data.GetSegment(pgLengthPosition), pgLengthPosition,
                          &dataPGLength);
 
     m_MetadataSet.DataPGIsOpen = false;
@@ -851,8 +862,11 @@ void BP4Serializer::AggregateMergeIndex(
     const std::unordered_map<std::string, SerialElementIndex> &indices,
     MPI_Comm comm, BufferSTL &bufferSTL, const bool isRankConstant)
 {
-    // first serialize index
-    std::vector<char> serializedIndices = SerializeIndices(indices, comm);
+    // first serialize index, already merged per group if hierarchical
+    std::vector<char> serializedIndices =
+        (comm == m_MPIComm && m_MetadataGroupComm != MPI_COMM_NULL)
+            ? MergeGroupIndices(indices, comm, isRankConstant)
+            : SerializeIndices(indices, comm);
     // gather in rank 0
     std::vector<char> gatheredSerialIndices;
     size_t gatheredSerialIndicesPosition = 0;
@@ -901,6 +915,130 @@ void BP4Serializer::AggregateMergeIndex(
     }
 }
 
+void BP4Serializer::InitMetadataGroupComm(MPI_Comm comm)
+{
+#ifdef ADIOS2_HAVE_MPI
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    if (m_SubStreams > 0 && m_SubStreams < m_SizeMPI)
+    {
+        // substreams hold contiguous ranks, the consumer is the group rank 0
+        helper::CheckMPIReturn(
+            MPI_Comm_split(comm, m_Aggregator->m_ConsumerRank, rank,
+                           &m_MetadataGroupComm),
+            "creating metadata group comm with split, in call to "
+            "AggregateCollectiveMetadata\n");
+        return;
+    }
+
+#if MPI_VERSION >= 3
+    MPI_Comm nodeComm;
+    helper::CheckMPIReturn(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED,
+                                               rank, MPI_INFO_NULL, &nodeComm),
+                           "creating node comm with split type, in call to "
+                           "AggregateCollectiveMetadata\n");
+    int nodeRank, nodeSize;
+    MPI_Comm_rank(nodeComm, &nodeRank);
+    MPI_Comm_size(nodeComm, &nodeSize);
+
+    // indices are merged in rank order, groups can't interleave ranks
+    const size_t nodeFirstRank =
+        helper::BroadcastValue(static_cast<size_t>(rank), nodeComm);
+    int isContiguous =
+        (static_cast<size_t>(rank) == nodeFirstRank + nodeRank) ? 1 : 0;
+    int allContiguous = 0;
+    MPI_Allreduce(&isContiguous, &allContiguous, 1, MPI_INT, MPI_LAND, comm);
+
+    if (allContiguous == 1)
+    {
+        m_MetadataGroupComm = nodeComm;
+        return;
+    }
+
+    int groupSize = 1;
+    MPI_Allreduce(&nodeSize, &groupSize, 1, MPI_INT, MPI_MAX, comm);
+    MPI_Comm_free(&nodeComm);
+
+    helper::CheckMPIReturn(MPI_Comm_split(comm, rank / groupSize, rank,
+                                          &m_MetadataGroupComm),
+                           "creating metadata group comm with split, in call "
+                           "to AggregateCollectiveMetadata\n");
+#endif
+#endif
+}
+
+void BP4Serializer::FreeMetadataGroupComm()
+{
+    if (m_MetadataGroupComm != MPI_COMM_NULL)
+    {
+        helper::CheckMPIReturn(MPI_Comm_free(&m_MetadataGroupComm),
+                               "freeing metadata group comm at Close\n");
+        m_MetadataGroupComm = MPI_COMM_NULL;
+    }
+}
+
+std::vector<char> BP4Serializer::MergeGroupIndices(
+    const std::unordered_map<std::string, SerialElementIndex> &indices,
+    MPI_Comm comm, const bool isRankConstant)
+{
+    std::vector<char> serializedIndices =
+        SerializeIndices(indices, m_MetadataGroupComm);
+    // gather in group rank 0
+    std::vector<char> gatheredSerialIndices;
+    size_t gatheredSerialIndicesPosition = 0;
+
+    helper::GathervVectors(serializedIndices, gatheredSerialIndices,
+                           gatheredSerialIndicesPosition, m_MetadataGroupComm);
+
+    std::vector<char>().swap(serializedIndices);
+
+    const std::unordered_map<std::string, std::vector<SerialElementIndex>>
+        nameRankIndices = DeserializeIndicesPerRankThreads(
+            gatheredSerialIndices, m_MetadataGroupComm, isRankConstant);
+
+    std::vector<char>().swap(gatheredSerialIndices);
+
+    int groupRank;
+    MPI_Comm_rank(m_MetadataGroupComm, &groupRank);
+
+    if (groupRank != 0)
+    {
+        return serializedIndices;
+    }
+
+    // merged indices are never larger than the gathered ones
+    BufferSTL groupBufferSTL;
+    groupBufferSTL.Resize(gatheredSerialIndicesPosition,
+                          ", in call to MergeGroupIndices BP4 metadata");
+    MergeSerializeIndicesPerStep(nameRankIndices, m_MetadataGroupComm,
+                                 groupBufferSTL);
+
+    // each merged index has the format of a single rank index
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    const uint32_t rankSource = static_cast<uint32_t>(rank);
+
+    const std::vector<char> &groupBuffer = groupBufferSTL.m_Buffer;
+    serializedIndices.reserve(groupBufferSTL.m_Position +
+                              4 * nameRankIndices.size());
+
+    size_t position = 0;
+    while (position < groupBufferSTL.m_Position)
+    {
+        size_t lengthPosition = position;
+        const size_t bufferSize = static_cast<size_t>(
+            helper::ReadValue<uint32_t>(groupBuffer, lengthPosition) + 4);
+
+        helper::InsertToBuffer(serializedIndices, &rankSource);
+        helper::InsertToBuffer(serializedIndices, &groupBuffer[position],
+                               bufferSize);
+        position += bufferSize;
+    }
+
+    return serializedIndices;
+}
+
 std::vector<char> BP4Serializer::SerializeIndices(
     const std::unordered_map<std::string, SerialElementIndex> &indices,
     MPI_Comm comm) const noexcept
@@ -954,6 +1092,10 @@ BP4Serializer::DeserializeIndicesPerRankThreads(
     std::unordered_map<std::string, std::vector<SerialElementIndex>>
         deserialized;
 
+    // comm might be a group of the engine communicator
+    int size;
+    MPI_Comm_size(comm, &size);
+
     auto lf_Deserialize_no_mutex = [&](const int rankSource,
                                        const size_t serializedPosition,
                                        const bool isRankConstant) {
@@ -988,7 +1130,7 @@ BP4Serializer::DeserializeIndicesPerRankThreads(
                       .emplace(std::piecewise_construct,
                                std::forward_as_tuple(header.Name),
                                std::forward_as_tuple(
-                                   m_SizeMPI,
+                                   size,
                                    SerialElementIndex(header.MemberID, 0)))
                       .first->second);
             // std::cout << "rank " << rankSource << ": did not find " <<
@@ -1031,7 +1173,7 @@ BP4Serializer::DeserializeIndicesPerRankThreads(
                       .emplace(std::piecewise_construct,
                                std::forward_as_tuple(header.Name),
                                std::forward_as_tuple(
-                                   m_SizeMPI,
+                                   size,
                                    SerialElementIndex(header.MemberID, 0)))
                       .first->second);
         }
@@ -1849,9 +1991,9 @@ BP4Serializer::SetCollectiveProfilingJSON(const std::string &rankLog) const
 
 uint32_t BP4Serializer::GetFileIndex() const noexcept
 {
-    if (m_Aggregator.m_IsActive)
+    if (m_Aggregator->m_IsActive)
     {
-        return static_cast<uint32_t>(m_Aggregator.m_SubStreamIndex);
+        return static_cast<uint32_t>(m_Aggregator->m_SubStreamIndex);
     }
 
     return static_cast<uint32_t>(m_RankMPI);
@@ -1898,7 +2040,7 @@ size_t BP4Serializer::GetAttributesSizeInData(core::IO &io) const noexcept
 #define declare_template_instantiation(T)                                      \
     template void BP4Serializer::PutVariablePayload(                           \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
-        const bool) noexcept;                                                  \
+        const bool);                                                           \
                                                                                \
     template void BP4Serializer::PutVariableMetadata(                          \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
@@ -1907,6 +2049,17 @@ size_t BP4Serializer::GetAttributesSizeInData(core::IO &io) const noexcept
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+#define declare_template_instantiation(T)                                      \
+    template void BP4Serializer::PutSpanPayload(                               \
+        const core::Variable<T> &, typename core::Variable<T>::Span &,         \
+        const T &) noexcept;                                                   \
+                                                                               \
+    template void BP4Serializer::PutSpanBounds(                                \
+        const core::Variable<T> &, const typename core::Variable<T>::Span &);
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 //------------------------------------------------------------------------------
 
 } // end namespace format
@@ -12,6 +12,7 @@
 #define ADIOS2_TOOLKIT_FORMAT_BP4_BP4SERIALIZER_H_
 
 #include <mutex>
+#include <unordered_map>
 
 #include "adios2/core/Attribute.h"
 #include "adios2/core/IO.h"
@@ -62,7 +63,30 @@ public:
     template <class T>
     void PutVariablePayload(const core::Variable<T> &variable,
                             const typename core::Variable<T>::Info &blockInfo,
-                            const bool sourceRowMajor = true) noexcept;
+                            const bool sourceRowMajor = true);
+
+    /**
+     * Reserves in buffer the payload of a block put with a span, filled with
+     * value. Must follow PutVariableMetadata, min and max are set by
+     * PutSpanBounds once the application filled the span.
+     * @param variable
+     * @param span its payload position is set to the segmented position
+     * @param value initial value of all elements
+     */
+    template <class T>
+    void PutSpanPayload(const core::Variable<T> &variable,
+                        typename core::Variable<T>::Span &span,
+                        const T &value) noexcept;
+
+    /**
+     * Computes min and max of a span payload and writes them in data and
+     * metadata index, before SerializeData
+     * @param variable
+     * @param span reserved by PutSpanPayload in the current step
+     */
+    template <class T>
+    void PutSpanBounds(const core::Variable<T> &variable,
+                       const typename core::Variable<T>::Span &span);
 
     /**
      *  Serializes data buffer and close current process group
@@ -140,12 +164,43 @@ public:
      */
     void UpdateOffsetsInMetadata();
 
+    /**
+     * Frees the group communicator created for MetadataAggregation =
+     * Hierarchical, called at Close before the application finalizes MPI
+     */
+    void FreeMetadataGroupComm();
+
 private:
     /** BP format version */
     const uint8_t m_Version = 4;
 
     static std::mutex m_Mutex;
 
+    /** contiguous ranks merging their indices in the group rank 0 before
+     * rank 0 merges all groups, created at the first collective metadata
+     * aggregation with MetadataAggregation = Hierarchical */
+    MPI_Comm m_MetadataGroupComm = MPI_COMM_NULL;
+
+    /**
+     * Block min and max computed by PutPayloadInBuffer while copying the
+     * payload, written as placeholders by PutVariableMetadata and patched
+     * at the positions of the min values, each followed by max
+     */
+    struct DeferredBounds
+    {
+        bool IsActive = false;
+        /** segmented position in m_Data, see BufferSTL::GetSegment */
+        size_t DataPosition = 0;
+        /** variable index buffer in m_MetadataSet.VarsIndices */
+        std::vector<char> *IndexBuffer = nullptr;
+        size_t IndexPosition = 0;
+    };
+
+    DeferredBounds m_DeferredBounds;
+
+    /** bounds waiting for PutSpanBounds, key: span payload position */
+    std::unordered_map<size_t, DeferredBounds> m_SpanBounds;
+
     /**
      * Put in BP buffer all attributes defined in an IO object.
      * Called by SerializeData function
@@ -209,7 +264,17 @@ private:
                              const Stats<T> &stats) noexcept;
 
     /**
-     * Get variable statistics
+     * Write min and max at the data and index positions recorded in
+     * m_DeferredBounds, then reset it
+     * @param min
+     * @param max
+     */
+    template <class T>
+    void PatchDeferredBounds(const T &min, const T &max) noexcept;
+
+    /**
+     * Get variable statistics, min and max of arrays without operations are
+     * left to PutPayloadInBuffer (see m_DeferredBounds)
      * @param variable
      * @param isRowMajor
      * @return stats BP4 Stats
@@ -378,6 +443,27 @@ private:
         const std::unordered_map<std::string, SerialElementIndex> &indices,
         MPI_Comm comm, BufferSTL &bufferSTL, const bool isRankConstant = false);
 
+    /**
+     * Creates m_MetadataGroupComm from comm: ranks of the same substream if
+     * aggregating, else ranks of the same shared memory node if nodes hold
+     * contiguous ranks, else contiguous groups of the largest node size
+     * @param comm engine communicator
+     */
+    void InitMetadataGroupComm(MPI_Comm comm);
+
+    /**
+     * First level of hierarchical aggregation, merges indices in the group
+     * rank 0 of m_MetadataGroupComm
+     * @param indices input of all indices to be merged
+     * @param comm engine communicator, its rank identifies merged indices
+     * @param isRankConstant see AggregateMergeIndex
+     * @return merged indices serialized as a single rank of comm in the
+     * group rank 0, empty in other ranks
+     */
+    std::vector<char> MergeGroupIndices(
+        const std::unordered_map<std::string, SerialElementIndex> &indices,
+        MPI_Comm comm, const bool isRankConstant);
+
     /**
      * Returns a serialized buffer with all indices with format:
      * Rank (4 bytes), Buffer
@@ -462,7 +548,7 @@ private:
 #define declare_template_instantiation(T)                                      \
     extern template void BP4Serializer::PutVariablePayload(                    \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
-        const bool) noexcept;                                                  \
+        const bool);                                                           \
                                                                                \
     extern template void BP4Serializer::PutVariableMetadata(                   \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
@@ -471,6 +557,17 @@ private:
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+#define declare_template_instantiation(T)                                      \
+    extern template void BP4Serializer::PutSpanPayload(                        \
+        const core::Variable<T> &, typename core::Variable<T>::Span &,         \
+        const T &) noexcept;                                                   \
+                                                                               \
+    extern template void BP4Serializer::PutSpanBounds(                         \
+        const core::Variable<T> &, const typename core::Variable<T>::Span &);
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 } // end namespace format
 } // end namespace adios2
 
@@ -29,9 +29,9 @@ inline void BP4Serializer::PutVariableMetadata(
     const bool sourceRowMajor) noexcept
 {
     auto lf_SetOffset = [&](uint64_t &offset) {
-        if (m_Aggregator.m_IsActive && !m_Aggregator.m_IsConsumer)
+        if (m_Aggregator->m_IsActive && !m_Aggregator->m_IsConsumer)
         {
-            offset = static_cast<uint64_t>(m_Data.m_Position);
+            offset = static_cast<uint64_t>(m_Data.GetSegmentedPosition());
         }
         else
         {
@@ -39,7 +39,7 @@ inline void BP4Serializer::PutVariableMetadata(
         }
     };
 
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
 
     Stats<T> stats =
         GetBPStats<T>(variable.m_SingleValue, blockInfo, sourceRowMajor);
@@ -61,16 +61,16 @@ inline void BP4Serializer::PutVariableMetadata(
                                variableIndex);
     ++m_MetadataSet.DataPGVarsCount;
 
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 template <class T>
 inline void BP4Serializer::PutVariablePayload(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo,
-    const bool sourceRowMajor) noexcept
+    const bool sourceRowMajor)
 {
-    ProfilerStart("buffering");
+    ProfilerStart(profiling::TraceEvent::Buffering);
     if (blockInfo.Operations.empty())
     {
         PutPayloadInBuffer(variable, blockInfo, sourceRowMajor);
@@ -80,7 +80,7 @@ inline void BP4Serializer::PutVariablePayload(
         PutOperationPayloadInBuffer(variable, blockInfo);
     }
 
-    ProfilerStop("buffering");
+    ProfilerStop(profiling::TraceEvent::Buffering);
 }
 
 // PRIVATE
@@ -375,9 +375,17 @@ BP4Serializer::GetBPStats(const bool singleValue,
         return stats;
     }
 
-    if (m_StatsLevel == 0)
+    if (m_StatsLevel == 0 && blockInfo.Data != nullptr &&
+        blockInfo.Operations.empty() &&
+        helper::GetTotalSize(blockInfo.Count) > 0)
+    {
+        // single pass over the data: min and max are computed while copying
+        // the payload
+        m_DeferredBounds.IsActive = true;
+    }
+    else if (m_StatsLevel == 0)
     {
-        ProfilerStart("minmax");
+        ProfilerStart(profiling::TraceEvent::MinMax);
         if (blockInfo.MemoryStart.empty())
         {
             const std::size_t valuesSize =
@@ -391,7 +399,8 @@ BP4Serializer::GetBPStats(const bool singleValue,
                                        blockInfo.MemoryStart, blockInfo.Count,
                                        isRowMajor, stats.Min, stats.Max);
         }
-        ProfilerStop("minmax");
+        ProfilerStop(profiling::TraceEvent::MinMax,
+                     helper::GetTotalSize(blockInfo.Count) * sizeof(T));
     }
 
     return stats;
@@ -551,6 +560,11 @@ void BP4Serializer::PutBoundsRecord(const bool singleValue,
     {
         if (m_StatsLevel == 0) // default verbose
         {
+            if (m_DeferredBounds.IsActive)
+            {
+                m_DeferredBounds.IndexBuffer = &buffer;
+                m_DeferredBounds.IndexPosition = buffer.size() + 1; // skip id
+            }
             PutCharacteristicRecord(characteristic_min, characteristicsCounter,
                                     stats.Min, buffer);
 
@@ -581,6 +595,12 @@ void BP4Serializer::PutBoundsRecord(const bool singleValue,
     {
         if (m_StatsLevel == 0) // default min and max only
         {
+            if (m_DeferredBounds.IsActive)
+            {
+                // skip id
+                m_DeferredBounds.DataPosition =
+                    m_Data.m_SegmentsSize + position + 1;
+            }
             PutCharacteristicRecord(characteristic_min, characteristicsCounter,
                                     stats.Min, buffer, position);
 
@@ -801,26 +821,107 @@ void BP4Serializer::PutPayloadInBuffer(
     const bool sourceRowMajor) noexcept
 {
     const size_t blockSize = helper::GetTotalSize(blockInfo.Count);
-    ProfilerStart("memcpy");
+    ProfilerStart(profiling::TraceEvent::Memcpy);
     if (!blockInfo.MemoryStart.empty())
     {
+        T *payload =
+            reinterpret_cast<T *>(m_Data.m_Buffer.data() + m_Data.m_Position);
         // TODO make it a BP4Serializer function
-        helper::CopyMemory(
-            reinterpret_cast<T *>(m_Data.m_Buffer.data() + m_Data.m_Position),
-            blockInfo.Start, blockInfo.Count, sourceRowMajor, blockInfo.Data,
-            blockInfo.Start, blockInfo.Count, sourceRowMajor, false, Dims(),
-            Dims(), blockInfo.MemoryStart, blockInfo.MemoryCount);
+        helper::CopyMemory(payload, blockInfo.Start, blockInfo.Count,
+                           sourceRowMajor, blockInfo.Data, blockInfo.Start,
+                           blockInfo.Count, sourceRowMajor, false, Dims(),
+                           Dims(), blockInfo.MemoryStart,
+                           blockInfo.MemoryCount);
         m_Data.m_Position += blockSize * sizeof(T);
+
+        if (m_DeferredBounds.IsActive)
+        {
+            // packed payload is contiguous, unlike the memory selection
+            T min, max;
+            helper::GetMinMaxThreads(payload, blockSize, min, max, m_Threads);
+            PatchDeferredBounds(min, max);
+        }
+    }
+    else if (m_DeferredBounds.IsActive)
+    {
+        T min, max;
+        helper::CopyToBufferMinMaxThreads(m_Data.m_Buffer, m_Data.m_Position,
+                                          blockInfo.Data, blockSize, min, max,
+                                          m_Threads);
+        PatchDeferredBounds(min, max);
     }
     else
     {
         helper::CopyToBufferThreads(m_Data.m_Buffer, m_Data.m_Position,
                                     blockInfo.Data, blockSize, m_Threads);
     }
-    ProfilerStop("memcpy");
+    ProfilerStop(profiling::TraceEvent::Memcpy, blockSize * sizeof(T));
     m_Data.m_AbsolutePosition += blockSize * sizeof(T); // payload size
 }
 
+template <class T>
+void BP4Serializer::PutSpanPayload(const core::Variable<T> &variable,
+                                   typename core::Variable<T>::Span &span,
+                                   const T &value) noexcept
+{
+    ProfilerStart(profiling::TraceEvent::Buffering);
+    const size_t blockSize = span.Size();
+    span.m_PayloadPosition = m_Data.GetSegmentedPosition();
+
+    T *payload =
+        reinterpret_cast<T *>(m_Data.m_Buffer.data() + m_Data.m_Position);
+    std::fill_n(payload, blockSize, value);
+    m_Data.m_Position += blockSize * sizeof(T);
+    m_Data.m_AbsolutePosition += blockSize * sizeof(T);
+
+    if (m_DeferredBounds.IsActive)
+    {
+        m_SpanBounds[span.m_PayloadPosition] = m_DeferredBounds;
+        m_DeferredBounds = DeferredBounds();
+    }
+    ProfilerStop(profiling::TraceEvent::Buffering);
+}
+
+template <class T>
+void BP4Serializer::PutSpanBounds(const core::Variable<T> &variable,
+                                  const typename core::Variable<T>::Span &span)
+{
+    auto itBounds = m_SpanBounds.find(span.m_PayloadPosition);
+    if (itBounds == m_SpanBounds.end())
+    {
+        return;
+    }
+
+    ProfilerStart(profiling::TraceEvent::MinMax);
+    size_t payloadPosition = span.m_PayloadPosition;
+    const std::vector<char> &segment = m_Data.GetSegment(payloadPosition);
+    T min, max;
+    helper::GetMinMaxThreads(
+        reinterpret_cast<const T *>(segment.data() + payloadPosition),
+        span.Size(), min, max, m_Threads);
+    ProfilerStop(profiling::TraceEvent::MinMax, span.Size() * sizeof(T));
+
+    m_DeferredBounds = itBounds->second;
+    PatchDeferredBounds(min, max);
+    m_SpanBounds.erase(itBounds);
+}
+
+template <class T>
+void BP4Serializer::PatchDeferredBounds(const T &min, const T &max) noexcept
+{
+    auto lf_Patch = [&](std::vector<char> &buffer, size_t position) {
+        helper::CopyToBuffer(buffer, position, &min);
+        position += 1; // skip max id
+        helper::CopyToBuffer(buffer, position, &max);
+    };
+
+    size_t dataPosition = m_DeferredBounds.DataPosition;
+    std::vector<char> &dataBuffer = m_Data.GetSegment(dataPosition);
+    lf_Patch(dataBuffer, dataPosition);
+    lf_Patch(*m_DeferredBounds.IndexBuffer, m_DeferredBounds.IndexPosition);
+    m_DeferredBounds = DeferredBounds();
+}
+
 template <class T>
 void BP4Serializer::UpdateIndexOffsetsCharacteristics(size_t &currentPosition,
                                                       const DataTypes dataType,
@@ -0,0 +1,211 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP4BZip2.cpp
+ */
+
+#include "BP4BZip2.h"
+#include "BP4BZip2.tcc"
+
+#include <cstdlib> //std::strtoull
+
+#include "adios2/helper/adiosFunctions.h"
+
+#ifdef ADIOS2_HAVE_BZIP2
+#include "adios2/operator/compress/CompressBZip2.h"
+#endif
+
+namespace adios2
+{
+namespace format
+{
+
+constexpr size_t BP4BZip2::m_MaxChunks;
+constexpr size_t BP4BZip2::m_MaxChunkSize;
+
+#define declare_type(T)                                                        \
+    void BP4BZip2::SetData(                                                    \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        BufferSTL &bufferSTL) const                                            \
+    {                                                                          \
+        SetDataCommon(variable, blockInfo, operation, bufferSTL);              \
+    }                                                                          \
+                                                                               \
+    void BP4BZip2::SetMetadata(                                                \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept                              \
+    {                                                                          \
+        SetMetadataCommon(variable, blockInfo, operation, buffer);             \
+    }                                                                          \
+                                                                               \
+    void BP4BZip2::UpdateMetadata(                                             \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept                              \
+    {                                                                          \
+        UpdateMetadataCommon(variable, blockInfo, operation, buffer);          \
+    }
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+void BP4BZip2::GetMetadata(const std::vector<char> &buffer, Params &info) const
+    noexcept
+{
+    size_t position = 0;
+    info["InputSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+    info["OutputSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+    info["ChunkSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+    const uint32_t chunkCount = helper::ReadValue<uint32_t>(buffer, position);
+    info["ChunkCount"] = std::to_string(chunkCount);
+
+    std::string chunkOutputSizes;
+    for (uint32_t c = 0; c < chunkCount; ++c)
+    {
+        chunkOutputSizes +=
+            std::to_string(helper::ReadValue<uint64_t>(buffer, position)) +
+            " ";
+    }
+    info["ChunkOutputSizes"] = chunkOutputSizes;
+}
+
+void BP4BZip2::GetData(const char *input,
+                       const helper::BlockOperationInfo &blockOperationInfo,
+                       char *dataOutput) const
+{
+    const size_t inputSize = static_cast<size_t>(
+        std::stoull(blockOperationInfo.Info.at("InputSize")));
+    GetDataRange(input, blockOperationInfo, dataOutput, 0, inputSize, 1);
+}
+
+void BP4BZip2::GetDataRange(
+    const char *input, const helper::BlockOperationInfo &blockOperationInfo,
+    char *dataOutput, const size_t outputStart, const size_t outputEnd,
+    const unsigned int threads) const
+{
+#ifdef ADIOS2_HAVE_BZIP2
+    const Params &info = blockOperationInfo.Info;
+    const size_t inputSize =
+        static_cast<size_t>(std::stoull(info.at("InputSize")));
+    const size_t chunkSize =
+        static_cast<size_t>(std::stoull(info.at("ChunkSize")));
+    const size_t chunkCount =
+        static_cast<size_t>(std::stoull(info.at("ChunkCount")));
+
+    if (chunkCount == 0 || outputStart >= outputEnd)
+    {
+        return;
+    }
+
+    // payload offset of each chunk from the chunk table
+    std::vector<size_t> chunkOffsets(chunkCount + 1, 0);
+    std::istringstream chunkOutputSizes(info.at("ChunkOutputSizes"));
+    for (size_t c = 0; c < chunkCount; ++c)
+    {
+        size_t chunkOutputSize = 0;
+        chunkOutputSizes >> chunkOutputSize;
+        chunkOffsets[c + 1] = chunkOffsets[c] + chunkOutputSize;
+    }
+
+    // only chunks intersecting [outputStart, outputEnd)
+    const size_t first = outputStart / chunkSize;
+    const size_t last = std::min((outputEnd - 1) / chunkSize + 1, chunkCount);
+    const unsigned int chunkThreads = static_cast<unsigned int>(
+        std::max(std::min(static_cast<size_t>(threads), last - first),
+                 static_cast<size_t>(1)));
+
+    core::compress::CompressBZip2 op(Params(), true);
+
+    auto lf_DecompressChunks = [&](const size_t start) {
+        for (size_t c = start; c < last; c += chunkThreads)
+        {
+            const size_t chunkInputSize =
+                std::min(chunkSize, inputSize - c * chunkSize);
+            op.Decompress(input + chunkOffsets[c],
+                          chunkOffsets[c + 1] - chunkOffsets[c],
+                          dataOutput + c * chunkSize, chunkInputSize);
+        }
+    };
+
+    std::vector<std::future<void>> asyncs(chunkThreads - 1);
+    for (unsigned int t = 1; t < chunkThreads; ++t)
+    {
+        asyncs[t - 1] =
+            std::async(std::launch::async, lf_DecompressChunks, first + t);
+    }
+    lf_DecompressChunks(first);
+    for (auto &async : asyncs)
+    {
+        async.get();
+    }
+#else
+    throw std::runtime_error(
+        "ERROR: current ADIOS2 library didn't compile "
+        "with BZip2, can't read BZip2 compressed data, in call "
+        "to Get\n");
+#endif
+}
+
+size_t BP4BZip2::GetPayloadMaxSize(const core::Operator &op,
+                                   const Params &parameters,
+                                   const size_t inputSize,
+                                   const size_t elementSize) const
+{
+    const size_t chunkSize = ChunkSize(parameters, inputSize, elementSize);
+
+    size_t maxSize = 0;
+    for (size_t position = 0; position < inputSize; position += chunkSize)
+    {
+        maxSize += op.BufferMaxSize(std::min(chunkSize, inputSize - position));
+    }
+    return maxSize;
+}
+
+// PRIVATE
+size_t BP4BZip2::ChunkSize(const Params &parameters, const size_t inputSize,
+                           const size_t elementSize) const noexcept
+{
+    size_t chunkSize = 0;
+    auto itChunkSize = parameters.find("ChunkSize");
+    if (itChunkSize != parameters.end())
+    {
+        chunkSize = static_cast<size_t>(
+            std::strtoull(itChunkSize->second.c_str(), nullptr, 10));
+    }
+
+    if (chunkSize == 0 || chunkSize > inputSize)
+    {
+        chunkSize = inputSize;
+    }
+    chunkSize = std::min(chunkSize, m_MaxChunkSize);
+    chunkSize =
+        std::max(chunkSize, (inputSize + m_MaxChunks - 1) / m_MaxChunks);
+
+    // round up to whole elements, at least one
+    const size_t elements = (chunkSize + elementSize - 1) / elementSize;
+    return std::max(elements, static_cast<size_t>(1)) * elementSize;
+}
+
+unsigned int BP4BZip2::Threads(const Params &parameters) const noexcept
+{
+    unsigned int threads = 1;
+    auto itThreads = parameters.find("Threads");
+    if (itThreads != parameters.end())
+    {
+        threads = static_cast<unsigned int>(
+            std::strtoul(itThreads->second.c_str(), nullptr, 10));
+    }
+    return std::max(threads, 1u);
+}
+
+} // end namespace format
+} // end namespace adios2
@@ -0,0 +1,107 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP4BZip2.h : bzip2 operation, blocks are split into chunks compressed
+ * independently, possibly by several threads, the chunk table is stored in
+ * the operation metadata
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4BZIP2_H_
+#define ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4BZIP2_H_
+
+#include "adios2/toolkit/format/bp4/operation/BP4Operation.h"
+
+namespace adios2
+{
+namespace format
+{
+
+class BP4BZip2 : public BP4Operation
+{
+public:
+    BP4BZip2() = default;
+
+    ~BP4BZip2() = default;
+
+#define declare_type(T)                                                        \
+    void SetData(const core::Variable<T> &variable,                            \
+                 const typename core::Variable<T>::Info &blockInfo,            \
+                 const typename core::Variable<T>::Operation &operation,       \
+                 BufferSTL &bufferSTL) const final;                            \
+                                                                               \
+    void SetMetadata(const core::Variable<T> &variable,                        \
+                     const typename core::Variable<T>::Info &blockInfo,        \
+                     const typename core::Variable<T>::Operation &operation,   \
+                     std::vector<char> &buffer) const noexcept final;          \
+                                                                               \
+    void UpdateMetadata(                                                       \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept final;
+
+    ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+    void GetMetadata(const std::vector<char> &buffer, Params &info) const
+        noexcept final;
+
+    void GetData(const char *input,
+                 const helper::BlockOperationInfo &blockOperationInfo,
+                 char *dataOutput) const final;
+
+    void GetDataRange(const char *input,
+                      const helper::BlockOperationInfo &blockOperationInfo,
+                      char *dataOutput, const size_t outputStart,
+                      const size_t outputEnd,
+                      const unsigned int threads) const final;
+
+    /** sum of the bzip2 bound of each chunk */
+    size_t GetPayloadMaxSize(const core::Operator &op, const Params &parameters,
+                             const size_t inputSize,
+                             const size_t elementSize) const final;
+
+private:
+    /** chunk table entries that fit the uint16_t metadata length */
+    static constexpr size_t m_MaxChunks = 8188;
+
+    /** bzip2 sizes are unsigned int, keep chunks well below that */
+    static constexpr size_t m_MaxChunkSize = 1073741824;
+
+    template <class T>
+    void SetDataCommon(const core::Variable<T> &variable,
+                       const typename core::Variable<T>::Info &blockInfo,
+                       const typename core::Variable<T>::Operation &operation,
+                       BufferSTL &bufferSTL) const;
+
+    template <class T>
+    void
+    SetMetadataCommon(const core::Variable<T> &variable,
+                      const typename core::Variable<T>::Info &blockInfo,
+                      const typename core::Variable<T>::Operation &operation,
+                      std::vector<char> &buffer) const noexcept;
+
+    template <class T>
+    void
+    UpdateMetadataCommon(const core::Variable<T> &variable,
+                         const typename core::Variable<T>::Info &blockInfo,
+                         const typename core::Variable<T>::Operation &operation,
+                         std::vector<char> &buffer) const noexcept;
+
+    /**
+     * Chunk size in bytes from the ChunkSize operation parameter, rounded
+     * down to whole elements and bounded by m_MaxChunkSize and m_MaxChunks.
+     * 0 (default) uses a single chunk if the block allows it.
+     */
+    size_t ChunkSize(const Params &parameters, const size_t inputSize,
+                     const size_t elementSize) const noexcept;
+
+    /** Threads operation parameter, 1 (default) compresses in place */
+    unsigned int Threads(const Params &parameters) const noexcept;
+};
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4BZIP2_H_ */
@@ -0,0 +1,216 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP4BZip2.tcc
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4BZIP2_TCC_
+#define ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4BZIP2_TCC_
+
+#include "BP4BZip2.h"
+
+#include <algorithm> //std::min
+#include <cstring>   //std::memmove
+#include <future>    //std::async
+#include <sstream>   //std::istringstream
+#include <stdexcept> //std::runtime_error
+
+#include "adios2/helper/adiosFunctions.h"
+
+namespace adios2
+{
+namespace format
+{
+
+template <class T>
+void BP4BZip2::SetDataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    BufferSTL &bufferSTL) const
+{
+    const core::Operator &op = *operation.Op;
+    const Params &parameters = operation.Parameters;
+
+    const size_t inputSize = static_cast<size_t>(
+        std::stoull(operation.Info.at("InputSize")));
+    const size_t chunkSize = static_cast<size_t>(
+        std::stoull(operation.Info.at("ChunkSize")));
+    const size_t chunkCount = static_cast<size_t>(
+        std::stoull(operation.Info.at("ChunkCount")));
+
+    const char *input = reinterpret_cast<const char *>(blockInfo.Data);
+    const unsigned int threads = static_cast<unsigned int>(
+        std::min(static_cast<size_t>(Threads(parameters)), chunkCount));
+
+    auto lf_ChunkInputSize = [&](const size_t c) -> size_t {
+        return std::min(chunkSize, inputSize - c * chunkSize);
+    };
+
+    auto lf_CompressChunk = [&](const size_t c, char *output) -> size_t {
+        const size_t chunkInputSize = lf_ChunkInputSize(c);
+        return op.Compress(input + c * chunkSize,
+                           Dims{chunkInputSize / sizeof(T)}, sizeof(T),
+                           variable.m_Type, output, parameters);
+    };
+
+    // bounds of each chunk, GetPayloadMaxSize in total
+    std::vector<size_t> maxSizes(chunkCount);
+    size_t maxSize = 0;
+    for (size_t c = 0; c < chunkCount; ++c)
+    {
+        maxSizes[c] = op.BufferMaxSize(lf_ChunkInputSize(c));
+        maxSize += maxSizes[c];
+    }
+
+    // BP4Base::ResizeBuffer reserved the capacity, the size is extended
+    // without reallocation so that later resizes don't zero the chunks
+    const size_t maxEnd = bufferSTL.m_Position + maxSize;
+    if (bufferSTL.m_Buffer.capacity() < maxEnd)
+    {
+        throw std::runtime_error(
+            "ERROR: buffer too small for BZip2 compression of variable " +
+            variable.m_Name + ", in call to Put\n");
+    }
+    if (bufferSTL.m_Buffer.size() < maxEnd)
+    {
+        bufferSTL.m_Buffer.resize(maxEnd);
+    }
+
+    char *output = bufferSTL.m_Buffer.data() + bufferSTL.m_Position;
+    std::vector<size_t> outputSizes(chunkCount);
+    size_t outputSize = 0;
+
+    if (threads <= 1)
+    {
+        // compress in place, chunk after chunk
+        for (size_t c = 0; c < chunkCount; ++c)
+        {
+            outputSizes[c] = lf_CompressChunk(c, output + outputSize);
+            outputSize += outputSizes[c];
+        }
+    }
+    else
+    {
+        // each thread takes every threads-th chunk and compresses it at its
+        // worst case offset in the buffer, chunks are packed in order once
+        // all are done, so no memory is used outside the buffer
+        std::vector<size_t> maxOffsets(chunkCount, 0);
+        for (size_t c = 1; c < chunkCount; ++c)
+        {
+            maxOffsets[c] = maxOffsets[c - 1] + maxSizes[c - 1];
+        }
+
+        auto lf_CompressChunks = [&](const size_t first) {
+            for (size_t c = first; c < chunkCount; c += threads)
+            {
+                outputSizes[c] = lf_CompressChunk(c, output + maxOffsets[c]);
+            }
+        };
+
+        std::vector<std::future<void>> asyncs(threads - 1);
+        for (unsigned int t = 1; t < threads; ++t)
+        {
+            asyncs[t - 1] =
+                std::async(std::launch::async, lf_CompressChunks, t);
+        }
+        lf_CompressChunks(0);
+        for (auto &async : asyncs)
+        {
+            async.get();
+        }
+
+        // packed offsets never pass the worst case ones, moving left in
+        // order doesn't overwrite chunks not yet moved
+        for (size_t c = 0; c < chunkCount; ++c)
+        {
+            std::memmove(output + outputSize, output + maxOffsets[c],
+                         outputSizes[c]);
+            outputSize += outputSizes[c];
+        }
+    }
+
+    bufferSTL.m_Position += outputSize;
+    bufferSTL.m_AbsolutePosition += outputSize;
+
+    std::string chunkOutputSizes;
+    for (size_t c = 0; c < chunkCount; ++c)
+    {
+        chunkOutputSizes += std::to_string(outputSizes[c]) + " ";
+    }
+
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+    info["OutputSize"] = std::to_string(outputSize);
+    info["ChunkOutputSizes"] = chunkOutputSizes;
+}
+
+template <class T>
+void BP4BZip2::SetMetadataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    std::vector<char> &buffer) const noexcept
+{
+    const uint64_t inputSize =
+        helper::GetTotalSize(blockInfo.Count) * sizeof(T);
+    const uint64_t chunkSize = static_cast<uint64_t>(ChunkSize(
+        operation.Parameters, static_cast<size_t>(inputSize), sizeof(T)));
+    const uint32_t chunkCount =
+        static_cast<uint32_t>((inputSize + chunkSize - 1) / chunkSize);
+
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+    info["InputSize"] = std::to_string(inputSize);
+    info["ChunkSize"] = std::to_string(chunkSize);
+    info["ChunkCount"] = std::to_string(chunkCount);
+
+    const uint64_t outputSize = 0; // not known yet
+
+    const uint16_t metadataSize = static_cast<uint16_t>(28 + 8 * chunkCount);
+    helper::InsertToBuffer(buffer, &metadataSize);
+    helper::InsertToBuffer(buffer, &inputSize);
+    // total and chunk output sizes filled out after operation is applied on
+    // data
+    info["OutputSizeMetadataPosition"] = std::to_string(buffer.size());
+    helper::InsertToBuffer(buffer, &outputSize);
+    helper::InsertToBuffer(buffer, &chunkSize);
+    helper::InsertToBuffer(buffer, &chunkCount);
+    buffer.resize(buffer.size() + 8 * chunkCount, '\0');
+}
+
+template <class T>
+void BP4BZip2::UpdateMetadataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    std::vector<char> &buffer) const noexcept
+{
+    const uint64_t outputSize =
+        static_cast<uint64_t>(std::stoull(operation.Info.at("OutputSize")));
+
+    size_t backPosition = static_cast<size_t>(
+        std::stoull(operation.Info.at("OutputSizeMetadataPosition")));
+
+    helper::CopyToBuffer(buffer, backPosition, &outputSize);
+    // skip chunk size and count
+    backPosition += 12;
+
+    std::istringstream chunkOutputSizes(operation.Info.at("ChunkOutputSizes"));
+    uint64_t chunkOutputSize = 0;
+    while (chunkOutputSizes >> chunkOutputSize)
+    {
+        helper::CopyToBuffer(buffer, backPosition, &chunkOutputSize);
+    }
+
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+    info.erase("OutputSizeMetadataPosition");
+    info.erase("ChunkOutputSizes");
+}
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4BZIP2_TCC_ */
@@ -0,0 +1,96 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP4Lossless.tcc
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4LOSSLESS_TCC_
+#define ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4LOSSLESS_TCC_
+
+#include "BP4Lossless.h"
+
+#include "adios2/helper/adiosFunctions.h"
+
+namespace adios2
+{
+namespace format
+{
+
+template <class T>
+void BP4Lossless::SetDataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    BufferSTL &bufferSTL) const
+{
+    const core::Operator &op = *operation.Op;
+    const Params &parameters = operation.Parameters;
+
+    char *output = bufferSTL.m_Buffer.data() + bufferSTL.m_Position;
+    const size_t outputSize =
+        op.Compress(blockInfo.Data, blockInfo.Count, variable.m_ElementSize,
+                    variable.m_Type, output, parameters);
+
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+    info["OutputSize"] = std::to_string(outputSize);
+    // first byte of the operator output
+    info["Shuffle"] = std::to_string(static_cast<uint8_t>(output[0]));
+
+    bufferSTL.m_Position += outputSize;
+    bufferSTL.m_AbsolutePosition += outputSize;
+}
+
+template <class T>
+void BP4Lossless::SetMetadataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    std::vector<char> &buffer) const noexcept
+{
+    const uint64_t inputSize =
+        helper::GetTotalSize(blockInfo.Count) * sizeof(T);
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+    info["InputSize"] = std::to_string(inputSize);
+
+    const uint64_t outputSize = 0; // not known yet
+    const uint8_t shuffle = 0;     // not known yet
+
+    constexpr uint16_t metadataSize = 17;
+    helper::InsertToBuffer(buffer, &metadataSize);
+    helper::InsertToBuffer(buffer, &inputSize);
+    // to be filled out after operation is applied on data
+    info["OutputSizeMetadataPosition"] = std::to_string(buffer.size());
+    helper::InsertToBuffer(buffer, &outputSize);
+    helper::InsertToBuffer(buffer, &shuffle);
+}
+
+template <class T>
+void BP4Lossless::UpdateMetadataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    std::vector<char> &buffer) const noexcept
+{
+    const uint64_t outputSize =
+        static_cast<uint64_t>(std::stoull(operation.Info.at("OutputSize")));
+    const uint8_t shuffle =
+        static_cast<uint8_t>(std::stoul(operation.Info.at("Shuffle")));
+
+    size_t backPosition = static_cast<size_t>(
+        std::stoll(operation.Info.at("OutputSizeMetadataPosition")));
+
+    helper::CopyToBuffer(buffer, backPosition, &outputSize);
+    helper::CopyToBuffer(buffer, backPosition, &shuffle);
+
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+    info.erase("OutputSizeMetadataPosition");
+}
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4LOSSLESS_TCC_ */
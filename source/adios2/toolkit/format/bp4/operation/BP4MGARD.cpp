@@ -27,7 +27,7 @@ namespace format
         const core::Variable<T> &variable,                                     \
         const typename core::Variable<T>::Info &blockInfo,                     \
         const typename core::Variable<T>::Operation &operation,                \
-        BufferSTL &bufferSTL) const noexcept                                   \
+        BufferSTL &bufferSTL) const                                            \
     {                                                                          \
         SetDataCommon(variable, blockInfo, operation, bufferSTL);              \
     }                                                                          \
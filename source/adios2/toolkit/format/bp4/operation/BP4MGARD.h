@@ -32,7 +32,7 @@ public:
     void SetData(const core::Variable<T> &variable,                            \
                  const typename core::Variable<T>::Info &blockInfo,            \
                  const typename core::Variable<T>::Operation &operation,       \
-                 BufferSTL &bufferSTL) const noexcept override;                \
+                 BufferSTL &bufferSTL) const override;                         \
                                                                                \
     void SetMetadata(const core::Variable<T> &variable,                        \
                      const typename core::Variable<T>::Info &blockInfo,        \
@@ -60,7 +60,7 @@ private:
     void SetDataCommon(const core::Variable<T> &variable,
                        const typename core::Variable<T>::Info &blockInfo,
                        const typename core::Variable<T>::Operation &operation,
-                       BufferSTL &bufferSTL) const noexcept;
+                       BufferSTL &bufferSTL) const;
 
     template <class T>
     void GetDataCommon(const char *input,
@@ -25,7 +25,7 @@ void BP4MGARD::SetDataCommon(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo,
     const typename core::Variable<T>::Operation &operation,
-    BufferSTL &bufferSTL) const noexcept
+    BufferSTL &bufferSTL) const
 {
     const core::Operator &op = *operation.Op;
     const Params &parameters = operation.Parameters;
@@ -20,7 +20,7 @@ namespace format
         const core::Variable<T> &variable,                                     \
         const typename core::Variable<T>::Info &blockInfo,                     \
         const typename core::Variable<T>::Operation &operation,                \
-        BufferSTL &bufferSTL) const noexcept                                   \
+        BufferSTL &bufferSTL) const                                            \
     {                                                                          \
     }                                                                          \
                                                                                \
@@ -43,5 +43,30 @@ namespace format
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
+void BP4Operation::GetDataRange(
+    const char *input, const helper::BlockOperationInfo &blockOperationInfo,
+    char *dataOutput, const size_t /*outputStart*/, const size_t /*outputEnd*/,
+    const unsigned int /*threads*/) const
+{
+    GetData(input, blockOperationInfo, dataOutput);
+}
+
+void BP4Operation::GetPayloadRange(
+    const helper::BlockOperationInfo &blockOperationInfo,
+    const size_t /*outputStart*/, const size_t /*outputEnd*/,
+    size_t &payloadStart, size_t &payloadEnd) const
+{
+    payloadStart = 0;
+    payloadEnd = blockOperationInfo.PayloadSize;
+}
+
+size_t BP4Operation::GetPayloadMaxSize(const core::Operator & /*op*/,
+                                       const Params & /*parameters*/,
+                                       const size_t inputSize,
+                                       const size_t /*elementSize*/) const
+{
+    return inputSize;
+}
+
 } // end namespace format
 } // end namespace adios2
@@ -35,7 +35,7 @@ public:
         const core::Variable<T> &variable,                                     \
         const typename core::Variable<T>::Info &blockInfo,                     \
         const typename core::Variable<T>::Operation &operation,                \
-        BufferSTL &bufferSTL) const noexcept;                                  \
+        BufferSTL &bufferSTL) const;                                           \
                                                                                \
     virtual void SetMetadata(                                                  \
         const core::Variable<T> &variable,                                     \
@@ -63,6 +63,41 @@ public:
     virtual void GetData(const char *input,
                          const helper::BlockOperationInfo &blockOperationInfo,
                          char *dataOutput) const = 0;
+
+    /**
+     * Recovers at least the bytes [outputStart, outputEnd) of the original
+     * block into dataOutput (sized for the whole block). Operations that
+     * store independent chunks only decompress the intersecting ones,
+     * default decompresses the entire block with GetData.
+     * @param threads maximum number of threads used to decompress
+     */
+    virtual void GetDataRange(
+        const char *input, const helper::BlockOperationInfo &blockOperationInfo,
+        char *dataOutput, const size_t outputStart, const size_t outputEnd,
+        const unsigned int threads) const;
+
+    /**
+     * Bytes [payloadStart, payloadEnd) of the operated payload read by
+     * GetDataRange for the same output range, the rest of input can be left
+     * unread. Default is the entire payload.
+     */
+    virtual void
+    GetPayloadRange(const helper::BlockOperationInfo &blockOperationInfo,
+                    const size_t outputStart, const size_t outputEnd,
+                    size_t &payloadStart, size_t &payloadEnd) const;
+
+    /**
+     * Upper bound of the operated payload of a block, the serializer sizes
+     * its buffer with it before SetData. Default is the input size.
+     * @param op operator applied to the block
+     * @param parameters operation parameters
+     * @param inputSize block payload bytes before the operation
+     * @param elementSize bytes per element
+     */
+    virtual size_t GetPayloadMaxSize(const core::Operator &op,
+                                     const Params &parameters,
+                                     const size_t inputSize,
+                                     const size_t elementSize) const;
 };
 
 } // end namespace format
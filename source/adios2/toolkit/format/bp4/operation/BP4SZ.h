@@ -29,7 +29,7 @@ public:
     void SetData(const core::Variable<T> &variable,                            \
                  const typename core::Variable<T>::Info &blockInfo,            \
                  const typename core::Variable<T>::Operation &operation,       \
-                 BufferSTL &bufferSTL) const noexcept final;                   \
+                 BufferSTL &bufferSTL) const final;                            \
                                                                                \
     void SetMetadata(const core::Variable<T> &variable,                        \
                      const typename core::Variable<T>::Info &blockInfo,        \
@@ -57,7 +57,7 @@ private:
     void SetDataCommon(const core::Variable<T> &variable,
                        const typename core::Variable<T>::Info &blockInfo,
                        const typename core::Variable<T>::Operation &operation,
-                       BufferSTL &bufferSTL) const noexcept;
+                       BufferSTL &bufferSTL) const;
 
     template <class T>
     void GetDataCommon(const char *input,
@@ -11,6 +11,8 @@
 #include "BP4Zfp.h"
 #include "BP4Zfp.tcc"
 
+#include <algorithm> //std::min
+
 #include "adios2/helper/adiosFunctions.h"
 
 #ifdef ADIOS2_HAVE_ZFP
@@ -27,7 +29,7 @@ namespace format
         const core::Variable<T> &variable,                                     \
         const typename core::Variable<T>::Info &blockInfo,                     \
         const typename core::Variable<T>::Operation &operation,                \
-        BufferSTL &bufferSTL) const noexcept                                   \
+        BufferSTL &bufferSTL) const                                            \
     {                                                                          \
         SetDataCommon(variable, blockInfo, operation, bufferSTL);              \
     }                                                                          \
@@ -100,5 +102,44 @@ void BP4Zfp::GetData(const char *input,
 #endif
 }
 
+void BP4Zfp::GetDataRange(const char *input,
+                          const helper::BlockOperationInfo &blockOperationInfo,
+                          char *dataOutput, const size_t outputStart,
+                          const size_t outputEnd,
+                          const unsigned int /*threads*/) const
+{
+#ifdef ADIOS2_HAVE_ZFP
+    core::compress::CompressZfp op(Params(), true);
+    op.DecompressRange(input, blockOperationInfo.PayloadSize, dataOutput,
+                       blockOperationInfo.PreCount,
+                       blockOperationInfo.Info.at("PreDataType"),
+                       blockOperationInfo.Info, outputStart, outputEnd);
+#else
+    throw std::runtime_error(
+        "ERROR: current ADIOS2 library didn't compile "
+        "with Zfp, can't read Zfp compressed data, in call "
+        "to Get\n");
+#endif
+}
+
+void BP4Zfp::GetPayloadRange(
+    const helper::BlockOperationInfo &blockOperationInfo,
+    const size_t outputStart, const size_t outputEnd, size_t &payloadStart,
+    size_t &payloadEnd) const
+{
+    payloadStart = 0;
+    payloadEnd = blockOperationInfo.PayloadSize;
+#ifdef ADIOS2_HAVE_ZFP
+    core::compress::CompressZfp op(Params(), true);
+    if (op.GetPayloadRange(blockOperationInfo.PreCount,
+                           blockOperationInfo.Info.at("PreDataType"),
+                           blockOperationInfo.Info, outputStart, outputEnd,
+                           payloadStart, payloadEnd))
+    {
+        payloadEnd = std::min(payloadEnd, blockOperationInfo.PayloadSize);
+    }
+#endif
+}
+
 } // end namespace format
 } // end namespace adios2
@@ -29,7 +29,7 @@ public:
     void SetData(const core::Variable<T> &variable,                            \
                  const typename core::Variable<T>::Info &blockInfo,            \
                  const typename core::Variable<T>::Operation &operation,       \
-                 BufferSTL &bufferSTL) const noexcept final;                   \
+                 BufferSTL &bufferSTL) const final;                            \
                                                                                \
     void SetMetadata(const core::Variable<T> &variable,                        \
                      const typename core::Variable<T>::Info &blockInfo,        \
@@ -52,6 +52,19 @@ public:
                  const helper::BlockOperationInfo &blockOperationInfo,
                  char *dataOutput) const final;
 
+    /** fixed rate streams only decompress the zfp blocks covering the
+     * range, other modes the entire block */
+    void GetDataRange(const char *input,
+                      const helper::BlockOperationInfo &blockOperationInfo,
+                      char *dataOutput, const size_t outputStart,
+                      const size_t outputEnd,
+                      const unsigned int threads) const final;
+
+    void GetPayloadRange(const helper::BlockOperationInfo &blockOperationInfo,
+                         const size_t outputStart, const size_t outputEnd,
+                         size_t &payloadStart,
+                         size_t &payloadEnd) const final;
+
 private:
     enum Mode
     {
@@ -64,7 +77,7 @@ private:
     void SetDataCommon(const core::Variable<T> &variable,
                        const typename core::Variable<T>::Info &blockInfo,
                        const typename core::Variable<T>::Operation &operation,
-                       BufferSTL &bufferSTL) const noexcept;
+                       BufferSTL &bufferSTL) const;
 
     template <class T>
     void
@@ -14,21 +14,153 @@
 
 #include <cstring>
 #include <iostream>
+#include <random>
 
 namespace adios2
 {
 namespace format
 {
 
+namespace
+{
+
+const char BinaryMagic[] = {'D', 'M', 'B', 1};
+
+void PutVarUInt(std::vector<char> &buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+void PutVarInt(std::vector<char> &buffer, int64_t value)
+{
+    // zigzag, so that small negative differences stay short
+    PutVarUInt(buffer, (static_cast<uint64_t>(value) << 1) ^
+                           static_cast<uint64_t>(value >> 63));
+}
+
+void PutString(std::vector<char> &buffer, const std::string &value)
+{
+    PutVarUInt(buffer, value.size());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+// encodes dims as the difference to previous, which is empty at the first
+// block of a variable in a pack
+void PutDimsDelta(std::vector<char> &buffer, const Dims &dims,
+                  const Dims &previous)
+{
+    PutVarUInt(buffer, dims.size());
+    for (size_t i = 0; i < dims.size(); ++i)
+    {
+        const size_t base = i < previous.size() ? previous[i] : 0;
+        PutVarInt(buffer, static_cast<int64_t>(dims[i] - base));
+    }
+}
+
+// reads binary metadata, throws std::runtime_error past its end
+class BinaryReader
+{
+public:
+    BinaryReader(const char *start, size_t size)
+    : m_Position(start), m_End(start + size)
+    {
+    }
+
+    uint64_t GetVarUInt()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            const uint8_t byte = static_cast<uint8_t>(*Get(1));
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw std::runtime_error("ERROR: invalid varint in DataMan binary "
+                                 "metadata\n");
+    }
+
+    int64_t GetVarInt()
+    {
+        const uint64_t value = GetVarUInt();
+        return static_cast<int64_t>(value >> 1) ^
+               -static_cast<int64_t>(value & 1);
+    }
+
+    std::string GetString()
+    {
+        const size_t size = GetVarUInt();
+        return std::string(Get(size), size);
+    }
+
+    void GetDimsDelta(Dims &dims, const Dims &previous)
+    {
+        dims.resize(GetVarUInt());
+        for (size_t i = 0; i < dims.size(); ++i)
+        {
+            const size_t base = i < previous.size() ? previous[i] : 0;
+            dims[i] = base + GetVarInt();
+        }
+    }
+
+    const char *Get(const size_t size)
+    {
+        if (size > static_cast<size_t>(m_End - m_Position))
+        {
+            throw std::runtime_error("ERROR: DataMan binary metadata ends "
+                                     "unexpectedly\n");
+        }
+        const char *position = m_Position;
+        m_Position += size;
+        return position;
+    }
+
+private:
+    const char *m_Position;
+    const char *m_End;
+};
+
+} // end anonymous namespace
+
 DataManSerializer::DataManSerializer(bool isRowMajor,
                                      const bool contiguousMajor,
-                                     bool isLittleEndian)
+                                     bool isLittleEndian,
+                                     const std::string &metadataFormat)
 : m_IsRowMajor(isRowMajor), m_IsLittleEndian(isLittleEndian),
   m_ContiguousMajor(contiguousMajor),
   m_DeferredRequestsToSend(
       std::make_shared<std::unordered_map<std::string, std::vector<char>>>())
 
 {
+    if (metadataFormat == "binary" || metadataFormat == "binary-schema-once")
+    {
+        // requests, replies and attributes stay JSON strings
+        m_UseBinaryMetadata = true;
+        m_BinarySchemaOnce = metadataFormat == "binary-schema-once";
+        // tells this writer's definitions apart from other writers' on the
+        // reader side
+        std::random_device random;
+        m_BinaryStreamID = (static_cast<uint64_t>(random()) << 32) ^ random();
+    }
+    else if (metadataFormat == "string" || metadataFormat == "msgpack" ||
+             metadataFormat == "cbor" || metadataFormat == "ubjson")
+    {
+        m_UseJsonSerialization = metadataFormat;
+    }
+    else
+    {
+        throw(std::invalid_argument(
+            metadataFormat + " is not a valid method. DataManSerializer "
+                             "only uses string, msgpack, cbor, ubjson, "
+                             "binary or binary-schema-once"));
+    }
     New(1024);
 }
 
@@ -38,15 +170,43 @@ void DataManSerializer::New(size_t size)
     // still be alive and needed somewhere in the workflow, for example the
     // queue in transport manager. It will be automatically released when the
     // entire workflow finishes using it.
+    auto buffer = std::make_shared<std::vector<char>>();
+    buffer->reserve(size);
+    New(buffer);
+}
+
+void DataManSerializer::New(std::shared_ptr<std::vector<char>> buffer)
+{
     m_MetadataJson = nullptr;
-    m_LocalBuffer = std::make_shared<std::vector<char>>();
-    m_LocalBuffer->reserve(size);
+    m_LocalBuffer = buffer;
     m_LocalBuffer->resize(sizeof(uint64_t) * 2);
+
+    if (m_UseBinaryMetadata)
+    {
+        if (!m_BinarySchemaOnce)
+        {
+            m_BinarySchemas.clear();
+            m_BinarySchemaIndex.clear();
+            m_BinarySchemasSent = 0;
+        }
+        for (auto &schema : m_BinarySchemas)
+        {
+            schema.lastStart.clear();
+            schema.lastCount.clear();
+        }
+        m_BinaryBlocks.clear();
+        m_BinaryBlockCount = 0;
+        m_BinaryLastStep = 0;
+        m_BinaryLastRank = 0;
+        m_BinaryLastEnd = 0;
+    }
 }
 
 const std::shared_ptr<std::vector<char>> DataManSerializer::GetLocalPack()
 {
-    std::vector<char> metapack = SerializeJson(m_MetadataJson);
+    std::vector<char> metapack = m_UseBinaryMetadata
+                                     ? SerializeBinaryMetadata()
+                                     : SerializeJson(m_MetadataJson);
     size_t metasize = metapack.size();
     (reinterpret_cast<uint64_t *>(m_LocalBuffer->data()))[0] =
         m_LocalBuffer->size();
@@ -355,6 +515,24 @@ int DataManSerializer::PutPack(const std::shared_ptr<std::vector<char>> data)
     uint64_t metaPosition =
         (reinterpret_cast<const uint64_t *>(data->data()))[0];
     uint64_t metaSize = (reinterpret_cast<const uint64_t *>(data->data()))[1];
+
+    if (metaSize >= sizeof(BinaryMagic) &&
+        metaPosition + metaSize <= data->size() &&
+        std::memcmp(data->data() + metaPosition, BinaryMagic,
+                    sizeof(BinaryMagic)) == 0)
+    {
+        try
+        {
+            BinaryToDataManVarMap(data->data() + metaPosition, metaSize, data);
+        }
+        catch (std::exception &e)
+        {
+            std::cout << e.what() << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+
     nlohmann::json j = DeserializeJson(data->data() + metaPosition, metaSize);
 
     JsonToDataManVarMap(j, data);
@@ -362,6 +540,216 @@ int DataManSerializer::PutPack(const std::shared_ptr<std::vector<char>> data)
     return 0;
 }
 
+void DataManSerializer::PutBinaryBlock(
+    const std::string &varName, const std::string &type, const Dims &varShape,
+    const Dims &varStart, const Dims &varCount, const std::string &doid,
+    const size_t step, const int rank, const std::string &address,
+    const size_t position, const size_t datasize,
+    const std::string &compression, const Params &compressionParams)
+{
+    size_t index = m_BinarySchemas.size();
+    std::vector<size_t> &candidates = m_BinarySchemaIndex[varName];
+    for (const size_t i : candidates)
+    {
+        const BinaryVarSchema &schema = m_BinarySchemas[i];
+        if (schema.type == type && schema.shape == varShape &&
+            schema.doid == doid && schema.address == address)
+        {
+            index = i;
+            break;
+        }
+    }
+    if (index == m_BinarySchemas.size())
+    {
+        candidates.push_back(index);
+        m_BinarySchemas.push_back({varName, type, doid, address, m_IsRowMajor,
+                                   m_IsLittleEndian, varShape, Dims(),
+                                   Dims()});
+    }
+    BinaryVarSchema &schema = m_BinarySchemas[index];
+
+    PutVarUInt(m_BinaryBlocks, index);
+    PutVarInt(m_BinaryBlocks, static_cast<int64_t>(step - m_BinaryLastStep));
+    PutVarInt(m_BinaryBlocks, static_cast<int64_t>(rank) - m_BinaryLastRank);
+    PutDimsDelta(m_BinaryBlocks, varStart, schema.lastStart);
+    PutDimsDelta(m_BinaryBlocks, varCount, schema.lastCount);
+    PutVarInt(m_BinaryBlocks, static_cast<int64_t>(position - m_BinaryLastEnd));
+    PutVarUInt(m_BinaryBlocks, datasize);
+    PutString(m_BinaryBlocks, compression);
+    PutVarUInt(m_BinaryBlocks, compressionParams.size());
+    for (const auto &p : compressionParams)
+    {
+        PutString(m_BinaryBlocks, p.first);
+        PutString(m_BinaryBlocks, p.second);
+    }
+
+    schema.lastStart = varStart;
+    schema.lastCount = varCount;
+    m_BinaryLastStep = step;
+    m_BinaryLastRank = rank;
+    m_BinaryLastEnd = position + datasize;
+    ++m_BinaryBlockCount;
+}
+
+std::vector<char> DataManSerializer::SerializeBinaryMetadata()
+{
+    std::vector<char> pack(BinaryMagic, BinaryMagic + sizeof(BinaryMagic));
+    pack.reserve(m_BinaryBlocks.size() + 64);
+    PutVarUInt(pack, m_BinaryStreamID);
+
+    PutVarUInt(pack, m_BinarySchemasSent);
+    PutVarUInt(pack, m_BinarySchemas.size() - m_BinarySchemasSent);
+    for (size_t i = m_BinarySchemasSent; i < m_BinarySchemas.size(); ++i)
+    {
+        const BinaryVarSchema &schema = m_BinarySchemas[i];
+        PutString(pack, schema.name);
+        PutString(pack, schema.type);
+        PutString(pack, schema.doid);
+        PutString(pack, schema.address);
+        pack.push_back(static_cast<char>((schema.isRowMajor ? 1 : 0) |
+                                         (schema.isLittleEndian ? 2 : 0)));
+        PutDimsDelta(pack, schema.shape, Dims());
+    }
+    m_BinarySchemasSent = m_BinarySchemas.size();
+
+    PutVarUInt(pack, m_BinaryBlockCount);
+    pack.insert(pack.end(), m_BinaryBlocks.begin(), m_BinaryBlocks.end());
+
+    if (m_MetadataJson.is_null())
+    {
+        PutVarUInt(pack, 0);
+    }
+    else
+    {
+        const std::string attributes = m_MetadataJson.dump();
+        PutString(pack, attributes);
+    }
+    return pack;
+}
+
+void DataManSerializer::BinaryToDataManVarMap(
+    const char *start, size_t size, std::shared_ptr<std::vector<char>> pack)
+{
+    BinaryReader reader(start, size);
+    reader.Get(sizeof(BinaryMagic));
+    const uint64_t streamID = reader.GetVarUInt();
+
+    std::vector<DataManVar> vars;
+    {
+        std::lock_guard<std::mutex> l(m_RemoteBinarySchemasMutex);
+        std::vector<BinaryVarSchema> &schemas =
+            m_RemoteBinarySchemas[streamID];
+
+        const size_t firstSchema = reader.GetVarUInt();
+        if (firstSchema > schemas.size())
+        {
+            throw std::runtime_error(
+                "ERROR: DataMan binary metadata uses variable definitions "
+                "sent in packs this reader did not receive, in call to "
+                "PutPack\n");
+        }
+        schemas.resize(firstSchema);
+        const size_t newSchemas = reader.GetVarUInt();
+        for (size_t i = 0; i < newSchemas; ++i)
+        {
+            BinaryVarSchema schema;
+            schema.name = reader.GetString();
+            schema.type = reader.GetString();
+            schema.doid = reader.GetString();
+            schema.address = reader.GetString();
+            const char flags = *reader.Get(1);
+            schema.isRowMajor = (flags & 1) != 0;
+            schema.isLittleEndian = (flags & 2) != 0;
+            reader.GetDimsDelta(schema.shape, Dims());
+            schemas.push_back(std::move(schema));
+        }
+
+        for (auto &schema : schemas)
+        {
+            schema.lastStart.clear();
+            schema.lastCount.clear();
+        }
+
+        const size_t blocks = reader.GetVarUInt();
+        vars.reserve(blocks);
+        size_t lastStep = 0;
+        int lastRank = 0;
+        size_t lastEnd = 0;
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            const size_t index = reader.GetVarUInt();
+            if (index >= schemas.size())
+            {
+                throw std::runtime_error(
+                    "ERROR: DataMan binary metadata uses an undefined "
+                    "variable definition, in call to PutPack\n");
+            }
+            BinaryVarSchema &schema = schemas[index];
+
+            DataManVar var;
+            var.name = schema.name;
+            var.type = schema.type;
+            var.doid = schema.doid;
+            var.address = schema.address;
+            var.isRowMajor = schema.isRowMajor;
+            var.isLittleEndian = schema.isLittleEndian;
+            var.shape = schema.shape;
+            var.step = lastStep + reader.GetVarInt();
+            var.rank = static_cast<int>(lastRank + reader.GetVarInt());
+            reader.GetDimsDelta(var.start, schema.lastStart);
+            reader.GetDimsDelta(var.count, schema.lastCount);
+            var.position = lastEnd + reader.GetVarInt();
+            var.size = reader.GetVarUInt();
+            var.compression = reader.GetString();
+            const size_t params = reader.GetVarUInt();
+            for (size_t i = 0; i < params; ++i)
+            {
+                const std::string key = reader.GetString();
+                const std::string value = reader.GetString();
+                auto pos = key.find(":");
+                if (pos != std::string::npos)
+                {
+                    var.params[key.substr(pos + 1)] = value;
+                }
+            }
+            if (var.position + var.size > pack->size())
+            {
+                throw std::runtime_error(
+                    "ERROR: DataMan binary metadata points past the end of "
+                    "the pack, in call to PutPack\n");
+            }
+            var.buffer = pack;
+
+            schema.lastStart = var.start;
+            schema.lastCount = var.count;
+            lastStep = var.step;
+            lastRank = var.rank;
+            lastEnd = var.position + var.size;
+            vars.push_back(std::move(var));
+        }
+    }
+
+    const size_t attributesSize = reader.GetVarUInt();
+    if (attributesSize > 0)
+    {
+        const char *attributes = reader.Get(attributesSize);
+        nlohmann::json metaJ =
+            nlohmann::json::parse(attributes, attributes + attributesSize);
+        JsonToDataManVarMap(metaJ, nullptr);
+    }
+
+    std::lock_guard<std::mutex> l(m_DataManVarMapMutex);
+    for (auto &var : vars)
+    {
+        auto &stepVars = m_DataManVarMap[var.step];
+        if (stepVars == nullptr)
+        {
+            stepVars = std::make_shared<std::vector<DataManVar>>();
+        }
+        stepVars->emplace_back(std::move(var));
+    }
+}
+
 void DataManSerializer::Erase(const size_t step, const bool allPreviousSteps)
 {
     std::lock_guard<std::mutex> l1(m_DataManVarMapMutex);
@@ -37,6 +37,18 @@
 // Y - Data Type
 // Z - Compression Method
 // ZP - Compression Parameters
+//
+// With the binary metadata formats the local pack metadata is instead
+//   "DMB" version, stream ID,
+//   variable definitions (name, type, doid, address, major, endian, shape),
+//   blocks (definition index, step, rank, start, count, position, size,
+//           compression, compression parameters),
+//   attributes as a JSON string.
+// Integers are varints, step, rank, start and count are stored as the
+// difference to the previous block (of the same variable for start and
+// count) and position as the gap after the previous block. binary sends all
+// definitions used in a pack with it, binary-schema-once sends each
+// definition only in the first pack that uses it.
 
 namespace adios2
 {
@@ -47,7 +59,8 @@ class DataManSerializer
 {
 public:
     DataManSerializer(bool isRowMajor, const bool contiguousMajor,
-                      bool isLittleEndian);
+                      bool isLittleEndian,
+                      const std::string &metadataFormat = "string");
 
     struct DataManVar
     {
@@ -72,6 +85,10 @@ public:
     // clear and allocate new buffer for writer
     void New(size_t size);
 
+    // clear and use buffer, for example one recycled by the transport
+    // manager, for writer
+    void New(std::shared_ptr<std::vector<char>> buffer);
+
     // put a variable for writer
     template <class T>
     void
@@ -137,17 +154,46 @@ public:
     size_t Steps();
 
 private:
+    // variable definition shared by the blocks of binary metadata
+    struct BinaryVarSchema
+    {
+        std::string name;
+        std::string type;
+        std::string doid;
+        std::string address;
+        bool isRowMajor;
+        bool isLittleEndian;
+        Dims shape;
+        // start and count of the last block put in the current pack
+        Dims lastStart;
+        Dims lastCount;
+    };
+
     template <class T>
-    bool PutZfp(nlohmann::json &metaj, size_t &datasize, const T *inputData,
-                const Dims &varCount, const Params &params);
+    bool PutZfp(Params &compressionParams, size_t &datasize,
+                const T *inputData, const Dims &varCount, const Params &params);
 
     template <class T>
-    bool PutSz(nlohmann::json &metaj, size_t &datasize, const T *inputData,
+    bool PutSz(Params &compressionParams, size_t &datasize, const T *inputData,
                const Dims &varCount, const Params &params);
 
     template <class T>
-    bool PutBZip2(nlohmann::json &metaj, size_t &datasize, const T *inputData,
-                  const Dims &varCount, const Params &params);
+    bool PutBZip2(Params &compressionParams, size_t &datasize,
+                  const T *inputData, const Dims &varCount,
+                  const Params &params);
+
+    void PutBinaryBlock(const std::string &varName, const std::string &type,
+                        const Dims &varShape, const Dims &varStart,
+                        const Dims &varCount, const std::string &doid,
+                        const size_t step, const int rank,
+                        const std::string &address, const size_t position,
+                        const size_t datasize, const std::string &compression,
+                        const Params &compressionParams);
+
+    std::vector<char> SerializeBinaryMetadata();
+
+    void BinaryToDataManVarMap(const char *start, size_t size,
+                               std::shared_ptr<std::vector<char>> pack);
 
     template <class T>
     void PutAttribute(const core::Attribute<T> &attribute, const int rank);
@@ -198,6 +244,27 @@ private:
     // string, msgpack, cbor, ubjson
     std::string m_UseJsonSerialization = "string";
 
+    // binary metadata for the local pack, used in writer instead of
+    // m_MetadataJson when m_UseBinaryMetadata, only accessed from writer app
+    // API thread, does not need mutex
+    bool m_UseBinaryMetadata = false;
+    bool m_BinarySchemaOnce = false;
+    uint64_t m_BinaryStreamID;
+    std::vector<BinaryVarSchema> m_BinarySchemas;
+    std::unordered_map<std::string, std::vector<size_t>> m_BinarySchemaIndex;
+    size_t m_BinarySchemasSent = 0;
+    std::vector<char> m_BinaryBlocks;
+    size_t m_BinaryBlockCount = 0;
+    size_t m_BinaryLastStep = 0;
+    int m_BinaryLastRank = 0;
+    size_t m_BinaryLastEnd = 0;
+
+    // binary metadata definitions received from each writer stream, used in
+    // reader, needs mutex
+    std::unordered_map<uint64_t, std::vector<BinaryVarSchema>>
+        m_RemoteBinarySchemas;
+    std::mutex m_RemoteBinarySchemasMutex;
+
     bool m_IsRowMajor;
     bool m_IsLittleEndian;
     bool m_ContiguousMajor;
@@ -65,21 +65,11 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
         localBuffer = m_LocalBuffer;
     }
 
-    nlohmann::json metaj;
-
-    metaj["A"] = address;
-    metaj["N"] = varName;
-    metaj["O"] = varStart;
-    metaj["C"] = varCount;
-    metaj["S"] = varShape;
-    metaj["D"] = doid;
-    metaj["M"] = m_IsRowMajor;
-    metaj["E"] = m_IsLittleEndian;
-    metaj["Y"] = helper::GetType<T>();
-    metaj["P"] = localBuffer->size();
-
+    const size_t position = localBuffer->size();
     size_t datasize = 0;
     bool compressed = false;
+    std::string compression;
+    Params compressionParams;
     if (params.empty() == false)
     {
         const auto i = params.find("CompressionMethod");
@@ -93,11 +83,11 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
                 if (IsCompressionAvailable(compressionMethod, helper::GetType<T>(),
                                            varCount))
                 {
-                    compressed =
-                        PutZfp<T>(metaj, datasize, inputData, varCount, params);
+                    compressed = PutZfp<T>(compressionParams, datasize,
+                                           inputData, varCount, params);
                     if (compressed)
                     {
-                        metaj["Z"] = "zfp";
+                        compression = "zfp";
                     }
                 }
             }
@@ -106,11 +96,11 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
                 if (IsCompressionAvailable(compressionMethod, helper::GetType<T>(),
                                            varCount))
                 {
-                    compressed =
-                        PutSz<T>(metaj, datasize, inputData, varCount, params);
+                    compressed = PutSz<T>(compressionParams, datasize,
+                                          inputData, varCount, params);
                     if (compressed)
                     {
-                        metaj["Z"] = "sz";
+                        compression = "sz";
                     }
                 }
             }
@@ -119,11 +109,11 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
                 if (IsCompressionAvailable(compressionMethod, helper::GetType<T>(),
                                            varCount))
                 {
-                    compressed = PutBZip2<T>(metaj, datasize, inputData,
-                                             varCount, params);
+                    compressed = PutBZip2<T>(compressionParams, datasize,
+                                             inputData, varCount, params);
                     if (compressed)
                     {
-                        metaj["Z"] = "bzip2";
+                        compression = "bzip2";
                     }
                 }
             }
@@ -140,7 +130,6 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
         datasize = std::accumulate(varCount.begin(), varCount.end(), sizeof(T),
                                    std::multiplies<size_t>());
     }
-    metaj["I"] = datasize;
 
     if (localBuffer->capacity() < localBuffer->size() + datasize)
     {
@@ -160,15 +149,46 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
                     inputData, datasize);
     }
 
-    if (metadataJson == nullptr)
+    if (m_UseBinaryMetadata && metadataJson == nullptr)
     {
-        m_MetadataJson[std::to_string(step)][std::to_string(rank)].emplace_back(
-            metaj);
+        PutBinaryBlock(varName, helper::GetType<T>(), varShape, varStart,
+                       varCount, doid, step, rank, address, position, datasize,
+                       compression, compressionParams);
     }
     else
     {
-        (*metadataJson)[std::to_string(step)][std::to_string(rank)]
-            .emplace_back(metaj);
+        nlohmann::json metaj;
+
+        metaj["A"] = address;
+        metaj["N"] = varName;
+        metaj["O"] = varStart;
+        metaj["C"] = varCount;
+        metaj["S"] = varShape;
+        metaj["D"] = doid;
+        metaj["M"] = m_IsRowMajor;
+        metaj["E"] = m_IsLittleEndian;
+        metaj["Y"] = helper::GetType<T>();
+        metaj["P"] = position;
+        metaj["I"] = datasize;
+        if (compressed)
+        {
+            metaj["Z"] = compression;
+            for (const auto &p : compressionParams)
+            {
+                metaj[p.first] = p.second;
+            }
+        }
+
+        if (metadataJson == nullptr)
+        {
+            m_MetadataJson[std::to_string(step)][std::to_string(rank)]
+                .emplace_back(metaj);
+        }
+        else
+        {
+            (*metadataJson)[std::to_string(step)][std::to_string(rank)]
+                .emplace_back(metaj);
+        }
     }
 
     if (m_Verbosity >= 100)
@@ -187,7 +207,7 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
 }
 
 template <class T>
-bool DataManSerializer::PutZfp(nlohmann::json &metaj, size_t &datasize,
+bool DataManSerializer::PutZfp(Params &compressionParams, size_t &datasize,
                                const T *inputData, const Dims &varCount,
                                const Params &params)
 {
@@ -199,7 +219,7 @@ bool DataManSerializer::PutZfp(nlohmann::json &metaj, size_t &datasize,
         if (prefix == "zfp:" || prefix == "Zfp:" || prefix == "ZFP:")
         {
             std::string key = i.first.substr(4);
-            metaj[i.first] = i.second;
+            compressionParams[i.first] = i.second;
             p[key] = i.second;
         }
     }
@@ -226,7 +246,7 @@ bool DataManSerializer::PutZfp(nlohmann::json &metaj, size_t &datasize,
 }
 
 template <class T>
-bool DataManSerializer::PutSz(nlohmann::json &metaj, size_t &datasize,
+bool DataManSerializer::PutSz(Params &compressionParams, size_t &datasize,
                               const T *inputData, const Dims &varCount,
                               const Params &params)
 {
@@ -238,7 +258,7 @@ bool DataManSerializer::PutSz(nlohmann::json &metaj, size_t &datasize,
         if (prefix == "sz:" || prefix == "Sz:" || prefix == "SZ:")
         {
             std::string key = i.first.substr(3);
-            metaj[i.first] = i.second;
+            compressionParams[i.first] = i.second;
             p[key] = i.second;
         }
     }
@@ -265,9 +285,9 @@ bool DataManSerializer::PutSz(nlohmann::json &metaj, size_t &datasize,
 }
 
 template <class T>
-bool DataManSerializer::PutBZip2(nlohmann::json &metaj, size_t &datasize,
-                                 const T *inputData, const Dims &varCount,
-                                 const Params &params)
+bool DataManSerializer::PutBZip2(Params &compressionParams,
+                                 size_t &datasize, const T *inputData,
+                                 const Dims &varCount, const Params &params)
 {
 #ifdef ADIOS2_HAVE_BZIP2
     Params p;
@@ -278,7 +298,7 @@ bool DataManSerializer::PutBZip2(nlohmann::json &metaj, size_t &datasize,
             prefix == "BZIP2:")
         {
             std::string key = i.first.substr(6);
-            metaj[i.first] = i.second;
+            compressionParams[i.first] = i.second;
             p[key] = i.second;
         }
     }
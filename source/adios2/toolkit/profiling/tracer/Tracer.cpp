@@ -0,0 +1,262 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Tracer.cpp
+ */
+
+#include "Tracer.h"
+
+#include <algorithm> //std::find
+#include <cstdint>   //UINT16_MAX
+#include <stdexcept> //std::out_of_range
+
+namespace adios2
+{
+namespace profiling
+{
+
+namespace
+{
+
+std::atomic<uint64_t> TracerCount(0);
+
+std::mutex NamesMutex;
+
+/** interned names, index is the ID, starts with TraceEvent */
+std::vector<std::string> &Names()
+{
+    static std::vector<std::string> names{
+        "buffering",       "memcpy",          "minmax",
+        "meta_sort_merge", "aggregation",     "mkdir",
+        "serialize",       "write",           "metadata",
+        "transport_open",  "transport_write", "transport_read",
+        "transport_close"};
+    return names;
+}
+
+/** last buffers used by this thread, most threads use a single tracer */
+struct ThreadCache
+{
+    uint64_t TracerID = 0;
+    TraceBuffer *Buffer = nullptr;
+};
+
+constexpr size_t ThreadCacheSize = 4;
+thread_local ThreadCache ThreadCaches[ThreadCacheSize];
+thread_local size_t ThreadCacheNext = 0;
+
+/** nanoseconds as microseconds with 3 decimals */
+std::string ToMicroseconds(const int64_t nanoseconds)
+{
+    std::string fraction(std::to_string(nanoseconds % 1000));
+    fraction.insert(0, 3 - fraction.size(), '0');
+    return std::to_string(nanoseconds / 1000) + "." + fraction;
+}
+
+} // end anonymous namespace
+
+Tracer::Tracer()
+: m_TracerID(++TracerCount), m_Epoch(std::chrono::steady_clock::now()),
+  m_EpochNanoseconds(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count())
+{
+}
+
+uint16_t Tracer::Intern(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(NamesMutex);
+    std::vector<std::string> &names = Names();
+
+    auto itName = std::find(names.begin(), names.end(), name);
+    if (itName != names.end())
+    {
+        return static_cast<uint16_t>(itName - names.begin());
+    }
+
+    if (names.size() > UINT16_MAX)
+    {
+        throw std::out_of_range("ERROR: too many trace event names, can't "
+                                "intern " +
+                                name + ", in call to Tracer Intern\n");
+    }
+
+    names.push_back(name);
+    return static_cast<uint16_t>(names.size() - 1);
+}
+
+std::string Tracer::GetName(const uint16_t id)
+{
+    std::lock_guard<std::mutex> lock(NamesMutex);
+    return Names().at(id);
+}
+
+void Tracer::Activate(const size_t capacity)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_BuffersMutex);
+        // registered buffers keep their size
+        if (m_Buffers.empty())
+        {
+            m_Capacity = 1;
+            while (m_Capacity < capacity)
+            {
+                m_Capacity <<= 1;
+            }
+        }
+        IsActive = true;
+    }
+    // spans are recorded from noexcept functions, allocate now
+    RegisterThread();
+}
+
+void Tracer::RegisterThread(const std::thread::id threadID)
+{
+    if (!IsActive)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_BuffersMutex);
+    FindOrAddBuffer(threadID);
+}
+
+int64_t Tracer::Now() const noexcept
+{
+    if (!IsActive)
+    {
+        return 0;
+    }
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - m_Epoch)
+        .count();
+}
+
+void Tracer::SetStep(const size_t step) noexcept
+{
+    m_Step.store(step, std::memory_order_relaxed);
+}
+
+void Tracer::Record(const uint16_t id, const int64_t start, const size_t bytes)
+{
+    if (!IsActive)
+    {
+        return;
+    }
+
+    const int64_t end = Now();
+    TraceBuffer &buffer = GetThreadBuffer();
+
+    // single writer, the release store publishes the record to exporters
+    const size_t head = buffer.Head.load(std::memory_order_relaxed);
+    TraceRecord &record = buffer.Records[head & (m_Capacity - 1)];
+    record.Start = start;
+    record.Duration = end - start;
+    record.Bytes = static_cast<uint64_t>(bytes);
+    record.Step =
+        static_cast<uint64_t>(m_Step.load(std::memory_order_relaxed));
+    record.ID = id;
+    buffer.Head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::Record(const TraceEvent event, const int64_t start,
+                    const size_t bytes)
+{
+    Record(static_cast<uint16_t>(event), start, bytes);
+}
+
+std::string Tracer::GetChromeTraceEvents(const int pid) const
+{
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(NamesMutex);
+        names = Names();
+    }
+
+    const std::string pidStr(std::to_string(pid));
+    std::string events("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" +
+                       pidStr + ",\"args\":{\"name\":\"rank " + pidStr +
+                       "\"}},\n");
+
+    std::lock_guard<std::mutex> lock(m_BuffersMutex);
+    for (const auto &buffer : m_Buffers)
+    {
+        const std::string tidStr(std::to_string(buffer->ThreadIndex));
+        const size_t head = buffer->Head.load(std::memory_order_acquire);
+        const size_t first = head > m_Capacity ? head - m_Capacity : 0;
+
+        for (size_t r = first; r < head; ++r)
+        {
+            const TraceRecord &record =
+                buffer->Records[r & (m_Capacity - 1)];
+
+            events += "{\"name\":\"" + names[record.ID] +
+                      "\",\"cat\":\"adios2\",\"ph\":\"X\",\"pid\":" + pidStr +
+                      ",\"tid\":" + tidStr + ",\"ts\":" +
+                      ToMicroseconds(m_EpochNanoseconds + record.Start) +
+                      ",\"dur\":" + ToMicroseconds(record.Duration) +
+                      ",\"args\":{\"step\":" + std::to_string(record.Step) +
+                      ",\"bytes\":" + std::to_string(record.Bytes) + "}},\n";
+        }
+    }
+    return events;
+}
+
+size_t Tracer::GetDroppedCount() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_BuffersMutex);
+    size_t dropped = 0;
+    for (const auto &buffer : m_Buffers)
+    {
+        const size_t head = buffer->Head.load(std::memory_order_acquire);
+        dropped += head > m_Capacity ? head - m_Capacity : 0;
+    }
+    return dropped;
+}
+
+// PRIVATE
+TraceBuffer &Tracer::GetThreadBuffer()
+{
+    for (const ThreadCache &cache : ThreadCaches)
+    {
+        if (cache.TracerID == m_TracerID)
+        {
+            return *cache.Buffer;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_BuffersMutex);
+
+    // the thread might have been evicted from its cache, be registered
+    // before its first record, or reuse the ID of a finished thread, either
+    // way it is the only writer
+    TraceBuffer &buffer = FindOrAddBuffer(std::this_thread::get_id());
+
+    ThreadCache &cache = ThreadCaches[ThreadCacheNext++ % ThreadCacheSize];
+    cache.TracerID = m_TracerID;
+    cache.Buffer = &buffer;
+    return buffer;
+}
+
+TraceBuffer &Tracer::FindOrAddBuffer(const std::thread::id threadID)
+{
+    for (const auto &registered : m_Buffers)
+    {
+        if (registered->ThreadID == threadID)
+        {
+            return *registered;
+        }
+    }
+
+    m_Buffers.emplace_back(new TraceBuffer());
+    TraceBuffer &buffer = *m_Buffers.back();
+    buffer.Records.resize(m_Capacity);
+    buffer.ThreadIndex = m_Buffers.size() - 1;
+    buffer.ThreadID = threadID;
+    return buffer;
+}
+
+} // end namespace profiling
+} // end namespace adios2
@@ -0,0 +1,176 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Tracer.h : timed spans recorded in per-thread ring buffers, identified by
+ * interned event IDs, exported as Chrome trace (Perfetto) JSON events
+ */
+
+#ifndef ADIOS2_TOOLKIT_PROFILING_TRACER_TRACER_H_
+#define ADIOS2_TOOLKIT_PROFILING_TRACER_TRACER_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <atomic>
+#include <chrono>
+#include <memory> //std::unique_ptr
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+/// \endcond
+
+#include "adios2/ADIOSConfig.h"
+#include "adios2/ADIOSTypes.h"
+
+namespace adios2
+{
+namespace profiling
+{
+
+/** built-in spans, interned first so their IDs are the enum values */
+enum class TraceEvent : uint16_t
+{
+    Buffering,      ///< "buffering"
+    Memcpy,         ///< "memcpy"
+    MinMax,         ///< "minmax"
+    MetaSortMerge,  ///< "meta_sort_merge"
+    Aggregation,    ///< "aggregation", exchange with the aggregator
+    Mkdir,          ///< "mkdir"
+    Serialize,      ///< "serialize", one block Put into the data buffer
+    Write,          ///< "write", data buffer to transports
+    Metadata,       ///< "metadata", collective metadata and index files
+    TransportOpen,  ///< "transport_open"
+    TransportWrite, ///< "transport_write", one write call to the medium
+    TransportRead,  ///< "transport_read", one read call from the medium
+    TransportClose  ///< "transport_close"
+};
+
+/** number of TraceEvent values */
+constexpr size_t TraceEventCount = 13;
+
+/** default records kept per thread, oldest are overwritten */
+constexpr size_t DefaultTraceCapacity = 65536;
+
+/** one complete span */
+struct TraceRecord
+{
+    /** nanoseconds since Tracer creation */
+    int64_t Start = 0;
+    int64_t Duration = 0;
+    uint64_t Bytes = 0;
+    uint64_t Step = 0;
+    uint16_t ID = 0;
+};
+
+/**
+ * Ring of records written by a single thread without locks, read when
+ * exporting after the thread is done recording
+ */
+struct TraceBuffer
+{
+    std::vector<TraceRecord> Records;
+    /** records ever written, next one goes to Head % Records.size() */
+    std::atomic<size_t> Head{0};
+    /** "tid" in exported events */
+    size_t ThreadIndex = 0;
+    std::thread::id ThreadID;
+};
+
+class Tracer
+{
+public:
+    /** flag to determine if Tracer object is recording */
+    bool IsActive = false;
+
+    Tracer();
+    ~Tracer() = default;
+
+    Tracer(const Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+
+    /**
+     * Interns a span name, IDs are shared by all tracers. Intended for
+     * setup, not for hot paths.
+     * @param name span name
+     * @return existing or new ID
+     */
+    static uint16_t Intern(const std::string &name);
+
+    /** @return name interned as id */
+    static std::string GetName(const uint16_t id);
+
+    /**
+     * Starts recording, the calling thread's buffer is allocated here
+     * @param capacity records kept per thread, rounded up to a power of 2
+     */
+    void Activate(const size_t capacity = DefaultTraceCapacity);
+
+    /**
+     * Allocates the buffer of a thread if active, its Record calls then
+     * don't allocate and can be made from noexcept functions
+     * @param threadID thread that will record, e.g. before it starts
+     */
+    void RegisterThread(
+        const std::thread::id threadID = std::this_thread::get_id());
+
+    /** @return nanoseconds since creation, 0 if not active */
+    int64_t Now() const noexcept;
+
+    /** step attached to following records from any thread */
+    void SetStep(const size_t step) noexcept;
+
+    /**
+     * Records a span ending now in the calling thread's buffer, ignored if
+     * not active. The first record of a thread not registered by Activate or
+     * RegisterThread allocates its buffer.
+     * @param id interned span name
+     * @param start from Now() at the beginning of the span
+     * @param bytes processed by the span
+     */
+    void Record(const uint16_t id, const int64_t start,
+                const size_t bytes = 0);
+
+    void Record(const TraceEvent event, const int64_t start,
+                const size_t bytes = 0);
+
+    /**
+     * Chrome trace complete ("ph":"X") events of all threads, each followed
+     * by ",\n". Call after recording threads are done.
+     * @param pid process ID of the events, e.g. MPI rank
+     */
+    std::string GetChromeTraceEvents(const int pid) const;
+
+    /** @return records overwritten in full ring buffers */
+    size_t GetDroppedCount() const noexcept;
+
+private:
+    /** unique for the process lifetime, keys thread-local buffer caches */
+    const uint64_t m_TracerID;
+
+    const std::chrono::steady_clock::time_point m_Epoch;
+
+    /** system clock at m_Epoch, aligns events of different processes */
+    const int64_t m_EpochNanoseconds;
+
+    size_t m_Capacity = 0;
+
+    std::atomic<size_t> m_Step{0};
+
+    /** guards m_Buffers when threads register and on export */
+    mutable std::mutex m_BuffersMutex;
+    std::vector<std::unique_ptr<TraceBuffer>> m_Buffers;
+
+    /** @return calling thread's buffer, registered on first use */
+    TraceBuffer &GetThreadBuffer();
+
+    /**
+     * Call with m_BuffersMutex locked
+     * @return registered buffer of threadID, a new one if none
+     */
+    TraceBuffer &FindOrAddBuffer(const std::thread::id threadID);
+};
+
+} // end namespace profiling
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_PROFILING_TRACER_TRACER_H_ */
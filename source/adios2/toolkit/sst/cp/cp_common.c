@@ -64,6 +64,11 @@ void CP_validateParams(SstStream Stream, SstParams Params, int Writer)
         {
             Params->DataTransport = strdup("rdma");
         }
+        else if ((strcmp(SelectedTransport, "shm") == 0) ||
+                 (strcmp(SelectedTransport, "sharedmemory") == 0))
+        {
+            Params->DataTransport = strdup("shm");
+        }
         free(SelectedTransport);
     }
     if (Params->ControlTransport == NULL)
@@ -152,6 +157,7 @@ extern void CP_dumpParams(SstStream Stream, struct _SstParams *Params)
             Params->NetworkInterface ? Params->NetworkInterface : "");
     fprintf(stderr, "Param -   CompressionMethod:%s\n",
             SstCompressStr[Params->CompressionMethod]);
+    fprintf(stderr, "Param -   ReadCoalesceGap:%d\n", Params->ReadCoalesceGap);
 }
 
 static FMField CP_SstParamsList_RAW[] = {
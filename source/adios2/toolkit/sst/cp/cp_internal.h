@@ -165,6 +165,8 @@ struct _SstStream
     void *ParamsBlock;
     long DiscardPriorTimestep; /* timesteps numerically less than this will be
                                   discarded with prejudice */
+    size_t StepReadRequests; /* remote reads issued for the current timestep */
+    size_t StepBytesRead;
 
     /* reader side marshal info */
     FFSContext ReaderFFSContext;
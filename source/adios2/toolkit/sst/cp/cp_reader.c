@@ -867,7 +867,12 @@ extern void *SstReadRemoteMemory(SstStream Stream, int Rank, long Timestep,
                                  void *DP_TimestepInfo)
 {
     if (Stream->Stats)
+    {
         Stream->Stats->BytesTransferred += Length;
+        Stream->Stats->ReadRequests++;
+    }
+    Stream->StepReadRequests++;
+    Stream->StepBytesRead += Length;
     return Stream->DP_Interface->readRemoteMemory(
         &Svcs, Stream->DP_Stream, Rank, Timestep, Offset, Length, Buffer,
         DP_TimestepInfo);
@@ -899,6 +904,11 @@ extern void SstReleaseStep(SstStream Stream)
     long Timestep = Stream->ReaderTimestep;
     struct _ReleaseTimestepMsg Msg;
 
+    CP_verbose(Stream, "Timestep %ld used %zu remote reads for %zu bytes\n",
+               Timestep, Stream->StepReadRequests, Stream->StepBytesRead);
+    Stream->StepReadRequests = 0;
+    Stream->StepBytesRead = 0;
+
     /*
      * remove local metadata for that timestep
      */
@@ -0,0 +1,629 @@
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <unistd.h>
+
+#include <atl.h>
+#include <evpath.h>
+
+#include "sst_data.h"
+
+#include "dp_interface.h"
+
+/*
+ *  This "shm" data plane is for readers that run on the same node as the
+ *  writer.  In ProvideTimestep the writer copies its data block for the
+ *  timestep into a SysV shared memory segment and publishes the segment ID
+ *  in the per-timestep info that the control plane delivers to readers with
+ *  the metadata.  ReadRemoteMemory attaches the segment and copies the
+ *  requested range out of it, so no data goes through the network stack and
+ *  no request message is sent to the writer.
+ *
+ *  Segment lifetime follows the timestep reference counting in the writer
+ *  control plane: when the count of a timestep reaches zero, ReleaseTimestep
+ *  detaches the segment.  The kernel frees the memory when the last process
+ *  detaches, so a reader still attached to an old segment keeps valid
+ *  memory.  Readers keep the last segment of each writer rank attached and
+ *  switch when a later timestep is read.
+ *
+ *  On Linux a segment is marked for removal (IPC_RMID) as soon as the writer
+ *  attached it, Linux still lets readers attach it by ID.  Segments then go
+ *  away with their last process, even if the writer crashes.  Elsewhere
+ *  segments are only marked at ReleaseTimestep, the segments of a crashed
+ *  writer stay until removed with ipcrm.
+ *
+ *  Reads are synchronous, the completion handle only carries the result.
+ *  Readers compare their host with each writer rank's host when they get
+ *  the writer contact info, reads from a writer rank on another host fail
+ *  without attaching anything: the same segment ID there names another
+ *  segment.
+ */
+
+#ifdef __linux__
+#define SHM_RMID_AT_ATTACH 1
+#else
+#define SHM_RMID_AT_ATTACH 0
+#endif
+
+typedef struct _ShmAttachedSegment
+{
+    int ShmID;
+    char *Address;
+    /* 0 if the writer rank is on another host */
+    int SameHost;
+} * ShmAttachedSegment;
+
+typedef struct _Shm_RS_Stream
+{
+    void *CP_Stream;
+    int Rank;
+    char *Hostname;
+
+    /* writer info */
+    int WriterCohortSize;
+    struct _ShmWriterContactInfo *WriterContactInfo;
+    /* last segment attached for each writer rank */
+    struct _ShmAttachedSegment *Segments;
+} * Shm_RS_Stream;
+
+typedef struct _Shm_WSR_Stream
+{
+    struct _Shm_WS_Stream *WS_Stream;
+    struct _ShmWriterContactInfo
+        *WriterContactInfo; /* included so we can free on destroy */
+} * Shm_WSR_Stream;
+
+typedef struct _TimestepEntry
+{
+    long Timestep;
+    char *Address;
+    struct _ShmPerTimestepInfo *DP_TimestepInfo;
+    struct _TimestepEntry *Next;
+} * TimestepList;
+
+typedef struct _Shm_WS_Stream
+{
+    void *CP_Stream;
+    int Rank;
+    char *Hostname;
+
+    TimestepList Timesteps;
+
+    int ReaderCount;
+    Shm_WSR_Stream *Readers;
+} * Shm_WS_Stream;
+
+typedef struct _ShmReaderContactInfo
+{
+    char *Hostname;
+    void *RS_Stream;
+} * ShmReaderContactInfo;
+
+typedef struct _ShmWriterContactInfo
+{
+    char *Hostname;
+    void *WS_Stream;
+} * ShmWriterContactInfo;
+
+typedef struct _ShmPerTimestepInfo
+{
+    int ShmID;
+    size_t Size;
+} * ShmPerTimestepInfo;
+
+typedef struct _ShmCompletionHandle
+{
+    void *CPStream;
+    int Rank;
+    int Failed;
+} * ShmCompletionHandle;
+
+static char *ShmGetHostname()
+{
+    char Hostname[256];
+    memset(Hostname, 0, sizeof(Hostname));
+    gethostname(Hostname, sizeof(Hostname) - 1);
+    return strdup(Hostname);
+}
+
+static DP_RS_Stream ShmInitReader(CP_Services Svcs, void *CP_Stream,
+                                  void **ReaderContactInfoPtr,
+                                  struct _SstParams *Params)
+{
+    Shm_RS_Stream Stream = malloc(sizeof(struct _Shm_RS_Stream));
+    ShmReaderContactInfo Contact =
+        malloc(sizeof(struct _ShmReaderContactInfo));
+    MPI_Comm comm = Svcs->getMPIComm(CP_Stream);
+
+    memset(Stream, 0, sizeof(*Stream));
+    memset(Contact, 0, sizeof(*Contact));
+
+    /*
+     * save the CP_stream value of later use
+     */
+    Stream->CP_Stream = CP_Stream;
+
+    MPI_Comm_rank(comm, &Stream->Rank);
+    Stream->Hostname = ShmGetHostname();
+
+    Contact->Hostname = strdup(Stream->Hostname);
+    Contact->RS_Stream = Stream;
+
+    *ReaderContactInfoPtr = Contact;
+
+    return Stream;
+}
+
+static void ShmDestroyReader(CP_Services Svcs, DP_RS_Stream RS_Stream_v)
+{
+    Shm_RS_Stream RS_Stream = (Shm_RS_Stream)RS_Stream_v;
+    for (int i = 0; i < RS_Stream->WriterCohortSize; i++)
+    {
+        if (RS_Stream->Segments[i].Address)
+        {
+            shmdt(RS_Stream->Segments[i].Address);
+        }
+        free(RS_Stream->WriterContactInfo[i].Hostname);
+    }
+    free(RS_Stream->Segments);
+    free(RS_Stream->WriterContactInfo);
+    free(RS_Stream->Hostname);
+    free(RS_Stream);
+}
+
+static DP_WS_Stream ShmInitWriter(CP_Services Svcs, void *CP_Stream,
+                                  struct _SstParams *Params)
+{
+    Shm_WS_Stream Stream = malloc(sizeof(struct _Shm_WS_Stream));
+    MPI_Comm comm = Svcs->getMPIComm(CP_Stream);
+
+    memset(Stream, 0, sizeof(struct _Shm_WS_Stream));
+
+    MPI_Comm_rank(comm, &Stream->Rank);
+    Stream->Hostname = ShmGetHostname();
+
+    /*
+     * save the CP_stream value of later use
+     */
+    Stream->CP_Stream = CP_Stream;
+
+    return (void *)Stream;
+}
+
+static void ShmFreeTimestepEntry(TimestepList Entry)
+{
+    if (Entry->Address)
+    {
+        shmdt(Entry->Address);
+    }
+    if (!SHM_RMID_AT_ATTACH && Entry->DP_TimestepInfo->ShmID != -1)
+    {
+        /* removed once every reader has detached */
+        shmctl(Entry->DP_TimestepInfo->ShmID, IPC_RMID, NULL);
+    }
+    free(Entry->DP_TimestepInfo);
+    free(Entry);
+}
+
+static void ShmDestroyWriter(CP_Services Svcs, DP_WS_Stream WS_Stream_v)
+{
+    Shm_WS_Stream WS_Stream = (Shm_WS_Stream)WS_Stream_v;
+    while (WS_Stream->Timesteps)
+    {
+        TimestepList Next = WS_Stream->Timesteps->Next;
+        ShmFreeTimestepEntry(WS_Stream->Timesteps);
+        WS_Stream->Timesteps = Next;
+    }
+    for (int i = 0; i < WS_Stream->ReaderCount; i++)
+    {
+        if (WS_Stream->Readers[i])
+        {
+            free(WS_Stream->Readers[i]->WriterContactInfo->Hostname);
+            free(WS_Stream->Readers[i]->WriterContactInfo);
+            free(WS_Stream->Readers[i]);
+        }
+    }
+    free(WS_Stream->Readers);
+    free(WS_Stream->Hostname);
+    free(WS_Stream);
+}
+
+static DP_WSR_Stream ShmInitWriterPerReader(CP_Services Svcs,
+                                            DP_WS_Stream WS_Stream_v,
+                                            int readerCohortSize,
+                                            CP_PeerCohort PeerCohort,
+                                            void **providedReaderInfo_v,
+                                            void **WriterContactInfoPtr)
+{
+    Shm_WS_Stream WS_Stream = (Shm_WS_Stream)WS_Stream_v;
+    Shm_WSR_Stream WSR_Stream = malloc(sizeof(*WSR_Stream));
+    ShmWriterContactInfo ContactInfo;
+    ShmReaderContactInfo *providedReaderInfo =
+        (ShmReaderContactInfo *)providedReaderInfo_v;
+
+    WSR_Stream->WS_Stream = WS_Stream; /* pointer to writer struct */
+
+    for (int i = 0; i < readerCohortSize; i++)
+    {
+        if (strcmp(providedReaderInfo[i]->Hostname, WS_Stream->Hostname) != 0)
+        {
+            fprintf(stderr, "Warning:  SST shm DataPlane reader rank %d is on "
+                            "host \"%s\", not on writer host \"%s\", it "
+                            "refuses to read from this rank\n",
+                    i, providedReaderInfo[i]->Hostname, WS_Stream->Hostname);
+        }
+    }
+
+    /*
+     * add this writer-side reader-specific stream to the parent writer stream
+     * structure
+     */
+    WS_Stream->Readers = realloc(
+        WS_Stream->Readers, sizeof(*WSR_Stream) * (WS_Stream->ReaderCount + 1));
+    WS_Stream->Readers[WS_Stream->ReaderCount] = WSR_Stream;
+    WS_Stream->ReaderCount++;
+
+    ContactInfo = malloc(sizeof(struct _ShmWriterContactInfo));
+    memset(ContactInfo, 0, sizeof(struct _ShmWriterContactInfo));
+    ContactInfo->Hostname = strdup(WS_Stream->Hostname);
+    ContactInfo->WS_Stream = WSR_Stream;
+    *WriterContactInfoPtr = ContactInfo;
+    WSR_Stream->WriterContactInfo = ContactInfo;
+
+    return WSR_Stream;
+}
+
+static void ShmDestroyWriterPerReader(CP_Services Svcs,
+                                      DP_WSR_Stream WSR_Stream_v)
+{
+    Shm_WSR_Stream WSR_Stream = (Shm_WSR_Stream)WSR_Stream_v;
+    Shm_WS_Stream WS_Stream = WSR_Stream->WS_Stream;
+    for (int i = 0; i < WS_Stream->ReaderCount; i++)
+    {
+        if (WS_Stream->Readers[i] == WSR_Stream)
+        {
+            WS_Stream->Readers[i] = NULL;
+        }
+    }
+    free(WSR_Stream->WriterContactInfo->Hostname);
+    free(WSR_Stream->WriterContactInfo);
+    free(WSR_Stream);
+}
+
+static void ShmProvideWriterDataToReader(CP_Services Svcs,
+                                         DP_RS_Stream RS_Stream_v,
+                                         int writerCohortSize,
+                                         CP_PeerCohort PeerCohort,
+                                         void **providedWriterInfo_v)
+{
+    Shm_RS_Stream RS_Stream = (Shm_RS_Stream)RS_Stream_v;
+    ShmWriterContactInfo *providedWriterInfo =
+        (ShmWriterContactInfo *)providedWriterInfo_v;
+
+    RS_Stream->WriterCohortSize = writerCohortSize;
+
+    /*
+     * make a copy of writer contact information (original will not be
+     * preserved)
+     */
+    RS_Stream->WriterContactInfo =
+        malloc(sizeof(struct _ShmWriterContactInfo) * writerCohortSize);
+    RS_Stream->Segments =
+        malloc(sizeof(struct _ShmAttachedSegment) * writerCohortSize);
+    for (int i = 0; i < writerCohortSize; i++)
+    {
+        RS_Stream->WriterContactInfo[i].Hostname =
+            strdup(providedWriterInfo[i]->Hostname);
+        RS_Stream->WriterContactInfo[i].WS_Stream =
+            providedWriterInfo[i]->WS_Stream;
+        RS_Stream->Segments[i].ShmID = -1;
+        RS_Stream->Segments[i].Address = NULL;
+        RS_Stream->Segments[i].SameHost =
+            (strcmp(providedWriterInfo[i]->Hostname, RS_Stream->Hostname) ==
+             0);
+        if (!RS_Stream->Segments[i].SameHost)
+        {
+            fprintf(stderr, "Warning:  SST shm DataPlane writer rank %d is on "
+                            "host \"%s\", not on reader host \"%s\", reads "
+                            "from it will fail\n",
+                    i, providedWriterInfo[i]->Hostname, RS_Stream->Hostname);
+        }
+        Svcs->verbose(
+            RS_Stream->CP_Stream,
+            "Received contact info for host \"%s\", WS_stream %p for WSR "
+            "Rank %d\n",
+            RS_Stream->WriterContactInfo[i].Hostname,
+            RS_Stream->WriterContactInfo[i].WS_Stream, i);
+    }
+}
+
+/*
+ * Returns the address of the segment of writer Rank, attached on first use,
+ * NULL if it can't be attached
+ */
+static char *ShmAttachSegment(CP_Services Svcs, Shm_RS_Stream Stream, int Rank,
+                              int ShmID)
+{
+    ShmAttachedSegment Segment = &Stream->Segments[Rank];
+    void *Address;
+
+    if (Segment->ShmID == ShmID)
+    {
+        return Segment->Address;
+    }
+
+    if (Segment->Address)
+    {
+        shmdt(Segment->Address);
+        Segment->Address = NULL;
+        Segment->ShmID = -1;
+    }
+
+    Address = shmat(ShmID, NULL, SHM_RDONLY);
+    if (Address == (void *)-1)
+    {
+        fprintf(stderr, "SST shm DataPlane failed to attach segment %d of "
+                        "writer rank %d on host \"%s\": %s\n",
+                ShmID, Rank, Stream->WriterContactInfo[Rank].Hostname,
+                strerror(errno));
+        return NULL;
+    }
+    Svcs->verbose(Stream->CP_Stream,
+                  "Attached segment %d of writer rank %d at %p\n", ShmID, Rank,
+                  Address);
+
+    Segment->ShmID = ShmID;
+    Segment->Address = Address;
+    return Segment->Address;
+}
+
+static void *ShmReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
+                                 int Rank, long Timestep, size_t Offset,
+                                 size_t Length, void *Buffer,
+                                 void *DP_TimestepInfo)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)
+        Stream_v; /* DP_RS_Stream is the return from InitReader */
+    ShmCompletionHandle ret = malloc(sizeof(struct _ShmCompletionHandle));
+    ShmPerTimestepInfo TimestepInfo = (ShmPerTimestepInfo)DP_TimestepInfo;
+    char *Address = NULL;
+
+    ret->CPStream = Stream->CP_Stream;
+    ret->Rank = Rank;
+    ret->Failed = 0;
+
+    Svcs->verbose(Stream->CP_Stream,
+                  "Adios requesting to read shared memory for Timestep %ld "
+                  "from Rank %d, offset %zu, length %zu\n",
+                  Timestep, Rank, Offset, Length);
+
+    if (Length == 0)
+    {
+        return ret;
+    }
+
+    if (!Stream->Segments[Rank].SameHost)
+    {
+        fprintf(stderr, "SST shm DataPlane can't read from writer rank %d on "
+                        "host \"%s\", reader is on host \"%s\"\n",
+                Rank, Stream->WriterContactInfo[Rank].Hostname,
+                Stream->Hostname);
+        ret->Failed = 1;
+        return ret;
+    }
+
+    if (TimestepInfo == NULL || TimestepInfo->ShmID == -1 ||
+        Offset + Length > TimestepInfo->Size)
+    {
+        fprintf(stderr, "SST shm DataPlane has no data for Timestep %ld, "
+                        "offset %zu, length %zu from writer rank %d\n",
+                Timestep, Offset, Length, Rank);
+        ret->Failed = 1;
+        return ret;
+    }
+
+    Address = ShmAttachSegment(Svcs, Stream, Rank, TimestepInfo->ShmID);
+    if (Address == NULL)
+    {
+        ret->Failed = 1;
+        return ret;
+    }
+
+    memcpy(Buffer, Address + Offset, Length);
+    return ret;
+}
+
+static int ShmWaitForCompletion(CP_Services Svcs, void *Handle_v)
+{
+    ShmCompletionHandle Handle = (ShmCompletionHandle)Handle_v;
+    int Ret = 1;
+    if (Handle->Failed)
+    {
+        Svcs->verbose(Handle->CPStream,
+                      "Shared memory read to rank %d has FAILED\n",
+                      Handle->Rank);
+        Ret = 0;
+    }
+    free(Handle);
+    return Ret;
+}
+
+static void ShmNotifyConnFailure(CP_Services Svcs, DP_RS_Stream Stream_v,
+                                 int FailedPeerRank)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)
+        Stream_v; /* DP_RS_Stream is the return from InitReader */
+    /*
+     * reads complete immediately, nothing is pending.  Attached segments
+     * remain valid after the writer is gone.
+     */
+    Svcs->verbose(Stream->CP_Stream, "received notification that writer peer "
+                                     "%d has failed\n",
+                  FailedPeerRank);
+}
+
+static void ShmProvideTimestep(CP_Services Svcs, DP_WS_Stream Stream_v,
+                               struct _SstData *Data,
+                               struct _SstData *LocalMetadata, long Timestep,
+                               void **TimestepInfoPtr)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)Stream_v;
+    TimestepList Entry = malloc(sizeof(struct _TimestepEntry));
+    ShmPerTimestepInfo Info = malloc(sizeof(struct _ShmPerTimestepInfo));
+
+    memset(Entry, 0, sizeof(*Entry));
+    Info->ShmID = -1;
+    Info->Size = Data->DataSize;
+
+    if (Data->DataSize > 0)
+    {
+        Info->ShmID = shmget(IPC_PRIVATE, Data->DataSize, IPC_CREAT | 0600);
+        if (Info->ShmID == -1)
+        {
+            fprintf(stderr, "SST shm DataPlane failed to create a segment of "
+                            "%zu bytes for Timestep %ld: %s\n",
+                    Data->DataSize, Timestep, strerror(errno));
+        }
+        else
+        {
+            void *Address = shmat(Info->ShmID, NULL, 0);
+            if (Address == (void *)-1)
+            {
+                fprintf(stderr, "SST shm DataPlane failed to attach segment "
+                                "for Timestep %ld: %s\n",
+                        Timestep, strerror(errno));
+                shmctl(Info->ShmID, IPC_RMID, NULL);
+                Info->ShmID = -1;
+            }
+            else
+            {
+                Entry->Address = Address;
+                memcpy(Entry->Address, Data->block, Data->DataSize);
+                if (SHM_RMID_AT_ATTACH)
+                {
+                    /* freed with its last process, readers can still attach */
+                    shmctl(Info->ShmID, IPC_RMID, NULL);
+                }
+            }
+        }
+    }
+
+    Svcs->verbose(Stream->CP_Stream,
+                  "Providing timestep %ld in segment %d of %zu bytes\n",
+                  Timestep, Info->ShmID, Info->Size);
+
+    Entry->Timestep = Timestep;
+    Entry->DP_TimestepInfo = Info;
+
+    Entry->Next = Stream->Timesteps;
+    Stream->Timesteps = Entry;
+    *TimestepInfoPtr = Info;
+}
+
+static void ShmReleaseTimestep(CP_Services Svcs, DP_WS_Stream Stream_v,
+                               long Timestep)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)Stream_v;
+    TimestepList List = Stream->Timesteps;
+    TimestepList Last = NULL;
+
+    Svcs->verbose(Stream->CP_Stream, "Releasing timestep %ld\n", Timestep);
+    while (List != NULL)
+    {
+        if (List->Timestep == Timestep)
+        {
+            if (Last == NULL)
+            {
+                Stream->Timesteps = List->Next;
+            }
+            else
+            {
+                Last->Next = List->Next;
+            }
+            ShmFreeTimestepEntry(List);
+            return;
+        }
+        Last = List;
+        List = List->Next;
+    }
+    /*
+     * Shouldn't ever get here because we should never release a
+     * timestep that we don't have.
+     */
+    fprintf(stderr, "Failed to release Timestep %ld, not found\n", Timestep);
+    assert(0);
+}
+
+static FMField ShmReaderContactList[] = {
+    {"Hostname", "string", sizeof(char *),
+     FMOffset(ShmReaderContactInfo, Hostname)},
+    {"reader_ID", "integer", sizeof(void *),
+     FMOffset(ShmReaderContactInfo, RS_Stream)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmReaderContactStructs[] = {
+    {"ShmReaderContactInfo", ShmReaderContactList,
+     sizeof(struct _ShmReaderContactInfo), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static FMField ShmWriterContactList[] = {
+    {"Hostname", "string", sizeof(char *),
+     FMOffset(ShmWriterContactInfo, Hostname)},
+    {"writer_ID", "integer", sizeof(void *),
+     FMOffset(ShmWriterContactInfo, WS_Stream)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmWriterContactStructs[] = {
+    {"ShmWriterContactInfo", ShmWriterContactList,
+     sizeof(struct _ShmWriterContactInfo), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static FMField ShmTimestepInfoList[] = {
+    {"ShmID", "integer", sizeof(int), FMOffset(ShmPerTimestepInfo, ShmID)},
+    {"Size", "integer", sizeof(size_t), FMOffset(ShmPerTimestepInfo, Size)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmTimestepInfoStructs[] = {
+    {"ShmTimestepInfo", ShmTimestepInfoList,
+     sizeof(struct _ShmPerTimestepInfo), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static struct _CP_DP_Interface shmDPInterface;
+
+static int ShmGetPriority(CP_Services Svcs, void *CP_Stream,
+                          struct _SstParams *Params)
+{
+    /*
+     * Only usable when writer and readers share a node, which isn't known
+     * here.  Return 0, lower than evpath, so it is only selected with
+     * DataTransport=shm.
+     */
+    return 0;
+}
+
+extern CP_DP_Interface LoadShmDP()
+{
+    memset(&shmDPInterface, 0, sizeof(shmDPInterface));
+    shmDPInterface.ReaderContactFormats = ShmReaderContactStructs;
+    shmDPInterface.WriterContactFormats = ShmWriterContactStructs;
+    shmDPInterface.TimestepInfoFormats = ShmTimestepInfoStructs;
+    shmDPInterface.initReader = ShmInitReader;
+    shmDPInterface.initWriter = ShmInitWriter;
+    shmDPInterface.initWriterPerReader = ShmInitWriterPerReader;
+    shmDPInterface.provideWriterDataToReader = ShmProvideWriterDataToReader;
+    shmDPInterface.readRemoteMemory = ShmReadRemoteMemory;
+    shmDPInterface.waitForCompletion = ShmWaitForCompletion;
+    shmDPInterface.notifyConnFailure = ShmNotifyConnFailure;
+    shmDPInterface.provideTimestep = ShmProvideTimestep;
+    shmDPInterface.releaseTimestep = ShmReleaseTimestep;
+    shmDPInterface.destroyReader = ShmDestroyReader;
+    shmDPInterface.destroyWriter = ShmDestroyWriter;
+    shmDPInterface.destroyWriterPerReader = ShmDestroyWriterPerReader;
+    shmDPInterface.getPriority = ShmGetPriority;
+    shmDPInterface.unGetPriority = NULL;
+    return &shmDPInterface;
+}
@@ -52,6 +52,7 @@ typedef struct _SstStats
     double CloseTimeSecs;
     double ValidTimeSecs;
     size_t BytesTransferred;
+    size_t ReadRequests;
 } * SstStats;
 
 typedef struct _SstParams *SstParams;
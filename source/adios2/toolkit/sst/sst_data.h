@@ -34,7 +34,8 @@ struct _SstBlock
     MACRO(IsRowMajor, IsRowMajor, int, 0)                                      \
     MACRO(ControlTransport, String, char *, NULL)                              \
     MACRO(NetworkInterface, String, char *, NULL)                              \
-    MACRO(CompressionMethod, CompressionMethod, size_t, 0)
+    MACRO(CompressionMethod, CompressionMethod, size_t, 0)                     \
+    MACRO(ReadCoalesceGap, Int, int, 4096)
 
 typedef enum {
     SstRegisterFile,
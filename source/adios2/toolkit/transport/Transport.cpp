@@ -30,6 +30,18 @@ void Transport::IWrite(const char *buffer, size_t size, Status &status,
     throw std::invalid_argument("ERROR: this class doesn't implement IWrite\n");
 }
 
+void Transport::WriteV(const std::vector<Segment> &segments, size_t start)
+{
+    for (const Segment &segment : segments)
+    {
+        Write(segment.Buffer, segment.Size, start);
+        if (start != MaxSizeT)
+        {
+            start += segment.Size;
+        }
+    }
+}
+
 void Transport::IRead(char *buffer, size_t size, Status &status, size_t start)
 {
     throw std::invalid_argument("ERROR: this class doesn't implement IRead\n");
@@ -71,8 +83,26 @@ void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
     m_Profiler.Timers.emplace(
         "close",
         profiling::Timer("close", TimeUnit::Microseconds, m_DebugMode));
+
+    auto lf_SetTimer = [&](const profiling::TraceEvent event,
+                           const std::string &name) {
+        auto itTimer = m_Profiler.Timers.find(name);
+        m_ProfilerTimers[static_cast<size_t>(event)] =
+            (itTimer != m_Profiler.Timers.end()) ? &itTimer->second : nullptr;
+    };
+
+    lf_SetTimer(profiling::TraceEvent::TransportOpen, "open");
+    lf_SetTimer(profiling::TraceEvent::TransportWrite, "write");
+    lf_SetTimer(profiling::TraceEvent::TransportRead, "read");
+    lf_SetTimer(profiling::TraceEvent::TransportClose, "close");
 }
 
+void Transport::SetParameters(const Params & /*parameters*/) {}
+
+const char *Transport::GetMappedData() const noexcept { return nullptr; }
+
+size_t Transport::GetMappedSize() const noexcept { return 0; }
+
 void Transport::SetBuffer(char * /*buffer*/, size_t /*size*/)
 {
     if (m_DebugMode)
@@ -95,19 +125,30 @@ void Transport::Flush()
 
 size_t Transport::GetSize() { return 0; }
 
-void Transport::ProfilerStart(const std::string process) noexcept
+void Transport::ProfilerStart(const profiling::TraceEvent event) noexcept
 {
-    if (m_Profiler.IsActive)
+    const size_t index = static_cast<size_t>(event);
+    if (m_ProfilerTimers[index] != nullptr)
+    {
+        m_ProfilerTimers[index]->Resume();
+    }
+    if (m_Tracer != nullptr)
     {
-        m_Profiler.Timers.at(process).Resume();
+        m_TraceStarts[index] = m_Tracer->Now();
     }
 }
 
-void Transport::ProfilerStop(const std::string process) noexcept
+void Transport::ProfilerStop(const profiling::TraceEvent event,
+                             const size_t bytes) noexcept
 {
-    if (m_Profiler.IsActive)
+    const size_t index = static_cast<size_t>(event);
+    if (m_ProfilerTimers[index] != nullptr)
+    {
+        m_ProfilerTimers[index]->Pause();
+    }
+    if (m_Tracer != nullptr)
     {
-        m_Profiler.Timers.at(process).Pause();
+        m_Tracer->Record(event, m_TraceStarts[index], bytes);
     }
 }
 
@@ -12,6 +12,7 @@
 #define ADIOS2_TOOLKIT_TRANSPORT_TRANSPORT_H_
 
 /// \cond EXCLUDE_FROM_DOXYGEN
+#include <array>
 #include <string>
 #include <vector>
 /// \endcond
@@ -20,6 +21,7 @@
 #include "adios2/ADIOSMPICommOnly.h"
 #include "adios2/ADIOSTypes.h"
 #include "adios2/toolkit/profiling/iochrono/IOChrono.h"
+#include "adios2/toolkit/profiling/tracer/Tracer.h"
 
 namespace adios2
 {
@@ -38,6 +40,9 @@ public:
     int m_SizeMPI = 1;     ///< from MPI_Comm_Size
     profiling::IOChrono m_Profiler; ///< profiles Open, Write/Read, Close
 
+    /** records Open, Write/Read, Close spans if active, not owned */
+    profiling::Tracer *m_Tracer = nullptr;
+
     struct Status
     {
         size_t Bytes;
@@ -46,6 +51,13 @@ public:
         // TODO add more thing...time?
     };
 
+    /** contiguous piece of memory in a gathered write */
+    struct Segment
+    {
+        const char *Buffer;
+        size_t Size;
+    };
+
     /**
      * Base constructor that all derived classes pass
      * @param type from derived class
@@ -59,6 +71,13 @@ public:
 
     void InitProfiler(const Mode openMode, const TimeUnit timeUnit);
 
+    /**
+     * Sets library specific parameters from IO AddTransport, called before
+     * Open. Default ignores all parameters.
+     * @param parameters
+     */
+    virtual void SetParameters(const Params &parameters);
+
     /**
      * Opens transport, required before SetBuffer, Write, Read, Flush, Close
      * @param name
@@ -87,6 +106,16 @@ public:
     virtual void IWrite(const char *buffer, size_t size, Status &status,
                         size_t start = MaxSizeT);
 
+    /**
+     * Writes segments one after the other as if they were a single buffer.
+     * Default calls Write for each segment.
+     * @param segments memory pieces in file order
+     * @param start starting position for writing, if not passed then start
+     * at current stream position
+     */
+    virtual void WriteV(const std::vector<Segment> &segments,
+                        size_t start = MaxSizeT);
+
     /**
      * Reads from transport "size" bytes from a certain position. Note that size
      * and position and non-const due to the nature of underlying transport
@@ -108,6 +137,19 @@ public:
      */
     virtual size_t GetSize();
 
+    /**
+     * Returns the start of the file contents if the transport maps them in
+     * memory (e.g. mmap), valid from Open to Close
+     * @return mapped contents, nullptr if not mapped (default)
+     */
+    virtual const char *GetMappedData() const noexcept;
+
+    /**
+     * Returns the length of the contents returned by GetMappedData
+     * @return mapped length in bytes, 0 if not mapped (default)
+     */
+    virtual size_t GetMappedSize() const noexcept;
+
     /** flushes current contents to physical medium without closing */
     virtual void Flush();
 
@@ -120,11 +162,29 @@ protected:
 
     void MkDir(const std::string &fileName);
 
-    void ProfilerStart(const std::string process) noexcept;
+    /** Resumes the m_Profiler timer of event and starts its m_Tracer span,
+     * event is one of the Transport* TraceEvents */
+    void ProfilerStart(const profiling::TraceEvent event) noexcept;
 
-    void ProfilerStop(const std::string process) noexcept;
+    /**
+     * Pauses the m_Profiler timer of event and records its m_Tracer span
+     * @param event same as ProfilerStart
+     * @param bytes requested by the span
+     */
+    void ProfilerStop(const profiling::TraceEvent event,
+                      const size_t bytes = 0) noexcept;
 
     void CheckName() const;
+
+private:
+    /** m_Profiler timers by TraceEvent, nullptr: not profiled. Found once
+     * by InitProfiler so ProfilerStart and ProfilerStop don't look up
+     * names. */
+    std::array<profiling::Timer *, profiling::TraceEventCount>
+        m_ProfilerTimers{};
+
+    /** m_Tracer start of the current span by TraceEvent */
+    std::array<int64_t, profiling::TraceEventCount> m_TraceStarts{};
 };
 
 } // end namespace adios2
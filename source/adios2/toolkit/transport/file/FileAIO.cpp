@@ -0,0 +1,648 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileAIO.cpp file I/O using Linux native asynchronous I/O (io_submit)
+ */
+#include "FileAIO.h"
+
+#include <fcntl.h>       // open, O_DIRECT
+#include <sys/stat.h>    // open, fstat
+#include <sys/syscall.h> // SYS_io_setup, ...
+#include <sys/types.h>   // open
+#include <unistd.h>      // pwrite, pread, close, syscall
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::min
+#include <cerrno>
+#include <cstring> //std::memcpy, std::memset
+#include <exception>
+#include <ios>    //std::ios_base::failure
+#include <string> //std::to_string
+/// \endcond
+
+#include "adios2/helper/adiosFunctions.h" //StringToUInt
+
+namespace adios2
+{
+namespace transport
+{
+
+namespace
+{
+// glibc doesn't wrap the native AIO system calls
+int IOSetup(unsigned int nrEvents, aio_context_t *context)
+{
+    return static_cast<int>(syscall(SYS_io_setup, nrEvents, context));
+}
+
+int IODestroy(aio_context_t context)
+{
+    return static_cast<int>(syscall(SYS_io_destroy, context));
+}
+
+int IOSubmit(aio_context_t context, long nr, struct iocb **iocbs)
+{
+    return static_cast<int>(syscall(SYS_io_submit, context, nr, iocbs));
+}
+
+int IOGetEvents(aio_context_t context, long minNr, long nr,
+                struct io_event *events)
+{
+    return static_cast<int>(
+        syscall(SYS_io_getevents, context, minNr, nr, events, nullptr));
+}
+
+char *AlignedData(std::vector<char> &staging, const size_t alignment)
+{
+    const size_t address = reinterpret_cast<size_t>(staging.data());
+    const size_t padding = (alignment - address % alignment) % alignment;
+    return staging.data() + padding;
+}
+} // end empty namespace
+
+constexpr size_t FileAIO::m_Alignment;
+
+FileAIO::FileAIO(MPI_Comm mpiComm, const bool debugMode)
+: Transport("File", "AIO", mpiComm, debugMode)
+{
+}
+
+FileAIO::~FileAIO()
+{
+    if (m_IsOpen)
+    {
+        // io_destroy waits for requests in flight
+        IODestroy(m_Context);
+        close(m_FileDescriptor);
+        if (m_DirectFileDescriptor != -1)
+        {
+            close(m_DirectFileDescriptor);
+        }
+    }
+}
+
+void FileAIO::SetParameters(const Params &parameters)
+{
+    for (const auto &pair : parameters)
+    {
+        std::string key(pair.first);
+        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+
+        std::string value(pair.second);
+        std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+
+        if (key == "queuedepth")
+        {
+            m_QueueDepth = static_cast<size_t>(helper::StringToUInt(
+                value, m_DebugMode, "in QueueDepth AIO transport parameter"));
+        }
+        else if (key == "chunksize")
+        {
+            m_ChunkSize = static_cast<size_t>(helper::StringToUInt(
+                value, m_DebugMode, "in ChunkSize AIO transport parameter"));
+        }
+        else if (key == "directio")
+        {
+            if (value == "on")
+            {
+                m_DirectIO = true;
+            }
+            else if (value == "off")
+            {
+                m_DirectIO = false;
+            }
+            else if (m_DebugMode)
+            {
+                throw std::invalid_argument(
+                    "ERROR: AIO transport DirectIO=" + value +
+                    " invalid value, valid: DirectIO On or Off, in call to "
+                    "Open\n");
+            }
+        }
+    }
+
+    if (m_DebugMode && (m_QueueDepth == 0 || m_ChunkSize == 0))
+    {
+        throw std::invalid_argument("ERROR: AIO transport QueueDepth and "
+                                    "ChunkSize must be > 0, in call to Open\n");
+    }
+
+    m_ChunkSize = (m_ChunkSize + m_Alignment - 1) / m_Alignment * m_Alignment;
+}
+
+void FileAIO::Open(const std::string &name, const Mode openMode)
+{
+    m_Name = name;
+    CheckName();
+    m_OpenMode = openMode;
+    m_Position = 0;
+
+    ProfilerStart(profiling::TraceEvent::TransportOpen);
+    switch (m_OpenMode)
+    {
+
+    case (Mode::Write):
+        m_FileDescriptor =
+            open(m_Name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (m_DirectIO && m_FileDescriptor != -1)
+        {
+            m_DirectFileDescriptor = open(m_Name.c_str(), O_WRONLY | O_DIRECT);
+        }
+        break;
+
+    case (Mode::Append):
+        // no O_APPEND, it would ignore the offsets passed to pwrite
+        m_FileDescriptor = open(m_Name.c_str(), O_RDWR | O_CREAT, 0777);
+        if (m_DirectIO && m_FileDescriptor != -1)
+        {
+            m_DirectFileDescriptor = open(m_Name.c_str(), O_WRONLY | O_DIRECT);
+        }
+        break;
+
+    case (Mode::Read):
+        m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
+        break;
+
+    default:
+        CheckFile("unknown open mode for file " + m_Name +
+                  ", in call to AIO open");
+    }
+    ProfilerStop(profiling::TraceEvent::TransportOpen);
+
+    CheckFile("couldn't open file " + m_Name +
+              ", check permissions or path existence, in call to AIO open");
+
+    // O_DIRECT is not supported by all file systems (e.g. tmpfs), fall back
+    // to asynchronous requests on the buffered descriptor
+    m_DirectIO = (m_DirectFileDescriptor != -1);
+
+    if (m_OpenMode == Mode::Append)
+    {
+        m_Position = GetSize();
+    }
+
+    m_Context = 0;
+    if (IOSetup(static_cast<unsigned int>(m_QueueDepth), &m_Context) != 0)
+    {
+        const int setupErrno = errno;
+        close(m_FileDescriptor);
+        if (m_DirectIO)
+        {
+            close(m_DirectFileDescriptor);
+            m_DirectFileDescriptor = -1;
+        }
+        throw std::ios_base::failure(
+            "ERROR: couldn't create AIO context for file " + m_Name +
+            ", errno " + std::to_string(setupErrno) +
+            ", in call to AIO open\n");
+    }
+
+    m_Requests.clear();
+    m_Requests.resize(m_QueueDepth);
+    if (m_DirectIO)
+    {
+        for (Request &request : m_Requests)
+        {
+            request.Staging.resize(m_ChunkSize + m_Alignment);
+        }
+    }
+    m_Events.resize(m_QueueDepth);
+    m_InFlight = 0;
+
+    m_IsOpen = true;
+}
+
+void FileAIO::Write(const char *buffer, size_t size, size_t start)
+{
+    WriteCommon(buffer, size, start, nullptr);
+
+    if (!m_DirectIO)
+    {
+        // requests point to buffer, owned by the caller after returning
+        WaitAll();
+    }
+}
+
+void FileAIO::IWrite(const char *buffer, size_t size, Status &status,
+                     size_t start)
+{
+    status.Bytes = 0;
+    status.Running = true;
+    status.Successful = true;
+
+    WriteCommon(buffer, size, start, &status);
+
+    if (m_StatusRequests.count(&status) == 0)
+    {
+        status.Running = false;
+    }
+}
+
+void FileAIO::Read(char *buffer, size_t size, size_t start)
+{
+    ReadCommon(buffer, size, start, nullptr);
+    WaitAll();
+}
+
+void FileAIO::IRead(char *buffer, size_t size, Status &status, size_t start)
+{
+    status.Bytes = 0;
+    status.Running = true;
+    status.Successful = true;
+
+    ReadCommon(buffer, size, start, &status);
+
+    if (m_StatusRequests.count(&status) == 0)
+    {
+        status.Running = false;
+    }
+}
+
+size_t FileAIO::GetSize()
+{
+    WaitAll();
+
+    struct stat fileStat;
+    if (fstat(m_FileDescriptor, &fileStat) == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't get size of file " +
+                                     m_Name + "\n");
+    }
+    return static_cast<size_t>(fileStat.st_size);
+}
+
+void FileAIO::Flush() { WaitAll(); }
+
+void FileAIO::Close()
+{
+    WaitAll();
+
+    ProfilerStart(profiling::TraceEvent::TransportClose);
+    IODestroy(m_Context);
+    m_Context = 0;
+
+    int status = 0;
+    if (m_DirectFileDescriptor != -1)
+    {
+        status = close(m_DirectFileDescriptor);
+        m_DirectFileDescriptor = -1;
+    }
+    if (close(m_FileDescriptor) == -1)
+    {
+        status = -1;
+    }
+    ProfilerStop(profiling::TraceEvent::TransportClose);
+
+    m_Requests.clear();
+    m_IsOpen = false;
+
+    if (status == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't close file " + m_Name +
+                                     ", in call to AIO close\n");
+    }
+}
+
+// PRIVATE
+FileAIO::Request &FileAIO::GetFreeRequest()
+{
+    if (m_InFlight == m_Requests.size())
+    {
+        Reap(1);
+    }
+
+    for (Request &request : m_Requests)
+    {
+        if (!request.InFlight)
+        {
+            return request;
+        }
+    }
+    // unreachable, Reap(1) frees at least one request
+    return m_Requests.front();
+}
+
+void FileAIO::Submit(Request &request, const uint16_t opcode,
+                     const int descriptor, const char *buffer,
+                     const size_t size, const size_t offset, Status *status)
+{
+    struct iocb &controlBlock = request.ControlBlock;
+    std::memset(&controlBlock, 0, sizeof(controlBlock));
+    controlBlock.aio_data = reinterpret_cast<uint64_t>(&request);
+    controlBlock.aio_lio_opcode = opcode;
+    controlBlock.aio_fildes = static_cast<uint32_t>(descriptor);
+    controlBlock.aio_buf = reinterpret_cast<uint64_t>(buffer);
+    controlBlock.aio_nbytes = size;
+    controlBlock.aio_offset = static_cast<int64_t>(offset);
+
+    struct iocb *controlBlocks[1] = {&controlBlock};
+
+    int submitted = -1;
+    do
+    {
+        submitted = IOSubmit(m_Context, 1, controlBlocks);
+        if (submitted == -1 && errno == EAGAIN && m_InFlight > 0)
+        {
+            // kernel queue is full, make room
+            Reap(1);
+            continue;
+        }
+    } while (submitted == -1 && (errno == EINTR || errno == EAGAIN));
+
+    if (submitted != 1)
+    {
+        throw std::ios_base::failure(
+            "ERROR: couldn't submit request to file " + m_Name + ", errno " +
+            std::to_string(errno) + ", in call to AIO io_submit\n");
+    }
+
+    request.InFlight = true;
+    request.RequestStatus = status;
+    ++m_InFlight;
+
+    if (status != nullptr)
+    {
+        status->Running = true;
+        ++m_StatusRequests[status];
+    }
+}
+
+void FileAIO::SubmitChunks(const uint16_t opcode, const int descriptor,
+                           const char *buffer, const size_t size,
+                           size_t offset, Status *status)
+{
+    const bool stage = (descriptor == m_DirectFileDescriptor);
+
+    size_t position = 0;
+    while (position < size)
+    {
+        const size_t chunkSize = std::min(m_ChunkSize, size - position);
+        Request &request = GetFreeRequest();
+
+        const char *chunk = buffer + position;
+        if (stage)
+        {
+            char *staging = AlignedData(request.Staging, m_Alignment);
+            std::memcpy(staging, chunk, chunkSize);
+            chunk = staging;
+        }
+
+        Submit(request, opcode, descriptor, chunk, chunkSize, offset, status);
+        position += chunkSize;
+        offset += chunkSize;
+    }
+}
+
+void FileAIO::Reap(const size_t minRequests)
+{
+    size_t minEvents = std::min(minRequests, m_InFlight);
+
+    while (minEvents > 0)
+    {
+        const int events =
+            IOGetEvents(m_Context, static_cast<long>(minEvents),
+                        static_cast<long>(m_Events.size()), m_Events.data());
+
+        if (events == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::ios_base::failure(
+                "ERROR: couldn't get completed requests for file " + m_Name +
+                ", errno " + std::to_string(errno) +
+                ", in call to AIO io_getevents\n");
+        }
+
+        // every reaped event is accounted for before reporting a failure,
+        // otherwise requests and statuses would stay in flight forever
+        std::string error;
+        for (int e = 0; e < events; ++e)
+        {
+            const struct io_event &event = m_Events[e];
+            Request &request = *reinterpret_cast<Request *>(event.data);
+            const struct iocb &controlBlock = request.ControlBlock;
+
+            request.InFlight = false;
+            --m_InFlight;
+
+            Status *status = request.RequestStatus;
+            request.RequestStatus = nullptr;
+
+            bool successful = true;
+            const size_t requested =
+                static_cast<size_t>(controlBlock.aio_nbytes);
+            if (event.res < 0)
+            {
+                successful = false;
+                if (error.empty())
+                {
+                    error = "ERROR: request failed for file " + m_Name +
+                            ", errno " + std::to_string(-event.res) +
+                            ", in call to AIO\n";
+                }
+            }
+            else if (static_cast<size_t>(event.res) < requested)
+            {
+                // short transfers are completed synchronously
+                const size_t done = static_cast<size_t>(event.res);
+                char *buffer = reinterpret_cast<char *>(controlBlock.aio_buf);
+                const size_t offset =
+                    static_cast<size_t>(controlBlock.aio_offset);
+                try
+                {
+                    if (controlBlock.aio_lio_opcode == IOCB_CMD_PWRITE)
+                    {
+                        PWrite(buffer + done, requested - done, offset + done);
+                    }
+                    else
+                    {
+                        PRead(buffer + done, requested - done, offset + done);
+                    }
+                }
+                catch (std::exception &failure)
+                {
+                    successful = false;
+                    if (error.empty())
+                    {
+                        error = failure.what();
+                    }
+                }
+            }
+
+            if (status == nullptr)
+            {
+                continue;
+            }
+
+            if (successful)
+            {
+                status->Bytes += requested;
+            }
+            else
+            {
+                status->Successful = false;
+            }
+
+            // the entry is kept until the last chunk of the status completes
+            auto itStatus = m_StatusRequests.find(status);
+            if (itStatus != m_StatusRequests.end() && --itStatus->second == 0)
+            {
+                status->Running = false;
+                m_StatusRequests.erase(itStatus);
+            }
+        }
+
+        if (!error.empty())
+        {
+            throw std::ios_base::failure(error);
+        }
+
+        minEvents -= std::min(minEvents, static_cast<size_t>(events));
+    }
+}
+
+void FileAIO::WaitAll()
+{
+    if (m_InFlight > 0)
+    {
+        Reap(m_InFlight);
+    }
+}
+
+void FileAIO::WriteCommon(const char *buffer, size_t size, size_t start,
+                          Status *status)
+{
+    ProfilerStart(profiling::TraceEvent::TransportWrite);
+
+    size_t offset = m_Position;
+    if (start != MaxSizeT)
+    {
+        // rewinds may overlap regions still in flight
+        WaitAll();
+        offset = start;
+    }
+    m_Position = offset + size;
+
+    if (!m_DirectIO)
+    {
+        SubmitChunks(IOCB_CMD_PWRITE, m_FileDescriptor, buffer, size, offset,
+                     status);
+        ProfilerStop(profiling::TraceEvent::TransportWrite, size);
+        return;
+    }
+
+    // unaligned head and tail go through the page cache
+    const size_t alignedStart =
+        (offset + m_Alignment - 1) / m_Alignment * m_Alignment;
+    const size_t headSize = std::min(size, alignedStart - offset);
+    const size_t alignedSize =
+        (size - headSize) / m_Alignment * m_Alignment;
+    const size_t tailSize = size - headSize - alignedSize;
+
+    if (headSize > 0)
+    {
+        PWrite(buffer, headSize, offset);
+    }
+
+    SubmitChunks(IOCB_CMD_PWRITE, m_DirectFileDescriptor, buffer + headSize,
+                 alignedSize, offset + headSize, status);
+
+    if (tailSize > 0)
+    {
+        PWrite(buffer + headSize + alignedSize, tailSize,
+               offset + headSize + alignedSize);
+    }
+
+    if (status != nullptr)
+    {
+        status->Bytes += headSize + tailSize;
+    }
+
+    ProfilerStop(profiling::TraceEvent::TransportWrite, size);
+}
+
+void FileAIO::ReadCommon(char *buffer, size_t size, size_t start,
+                         Status *status)
+{
+    ProfilerStart(profiling::TraceEvent::TransportRead);
+
+    const size_t offset = (start != MaxSizeT) ? start : m_Position;
+    m_Position = offset + size;
+
+    SubmitChunks(IOCB_CMD_PREAD, m_FileDescriptor, buffer, size, offset,
+                 status);
+
+    ProfilerStop(profiling::TraceEvent::TransportRead, size);
+}
+
+void FileAIO::PWrite(const char *buffer, size_t size, size_t offset)
+{
+    while (size > 0)
+    {
+        const size_t batchSize = std::min(size, DefaultMaxFileBatchSize);
+        const auto writtenSize =
+            pwrite(m_FileDescriptor, buffer, batchSize, offset);
+
+        if (writtenSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::ios_base::failure("ERROR: couldn't write to file " +
+                                         m_Name + ", in call to AIO pwrite\n");
+        }
+
+        buffer += writtenSize;
+        size -= writtenSize;
+        offset += writtenSize;
+    }
+}
+
+void FileAIO::PRead(char *buffer, size_t size, size_t offset)
+{
+    while (size > 0)
+    {
+        const size_t batchSize = std::min(size, DefaultMaxFileBatchSize);
+        const auto readSize =
+            pread(m_FileDescriptor, buffer, batchSize, offset);
+
+        if (readSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::ios_base::failure("ERROR: couldn't read from file " +
+                                         m_Name + ", in call to AIO pread\n");
+        }
+
+        if (readSize == 0)
+        {
+            throw std::ios_base::failure(
+                "ERROR: couldn't read " + std::to_string(size) +
+                " bytes past the end of file " + m_Name +
+                ", in call to AIO pread\n");
+        }
+
+        buffer += readSize;
+        size -= readSize;
+        offset += readSize;
+    }
+}
+
+void FileAIO::CheckFile(const std::string hint) const
+{
+    if (m_FileDescriptor == -1)
+    {
+        throw std::ios_base::failure("ERROR: " + hint + "\n");
+    }
+}
+
+} // end namespace transport
+} // end namespace adios2
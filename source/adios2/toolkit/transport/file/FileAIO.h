@@ -0,0 +1,150 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileAIO.h file I/O using Linux native asynchronous I/O (io_submit)
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEAIO_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEAIO_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <linux/aio_abi.h> //aio_context_t, iocb, io_event
+
+#include <unordered_map>
+#include <vector>
+/// \endcond
+
+#include "adios2/ADIOSConfig.h"
+#include "adios2/toolkit/transport/Transport.h"
+
+namespace adios2
+{
+namespace transport
+{
+
+/**
+ * File transport keeping up to QueueDepth chunk requests in flight with the
+ * Linux native AIO interface. With DirectIO writes are staged in aligned
+ * buffers and submitted to an O_DIRECT descriptor, so Write returns once the
+ * data is copied and the device works in the background.
+ */
+class FileAIO : public Transport
+{
+
+public:
+    FileAIO(MPI_Comm mpiComm, const bool debugMode);
+
+    ~FileAIO();
+
+    /**
+     * Supported parameters:
+     * QueueDepth=8 max requests in flight
+     * ChunkSize=4194304 bytes per request, rounded up to the alignment
+     * DirectIO=On use O_DIRECT for aligned write regions
+     */
+    void SetParameters(const Params &parameters) final;
+
+    void Open(const std::string &name, const Mode openMode) final;
+
+    /** Returns after all chunks are submitted (DirectIO) or written */
+    void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    /** buffer must remain valid until status.Running is false or Flush */
+    void IWrite(const char *buffer, size_t size, Status &status,
+                size_t start = MaxSizeT) final;
+
+    void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    /** buffer is complete after status.Running is false or Flush */
+    void IRead(char *buffer, size_t size, Status &status,
+               size_t start = MaxSizeT) final;
+
+    size_t GetSize() final;
+
+    /** Waits for all requests in flight */
+    void Flush() final;
+
+    void Close() final;
+
+private:
+    /** O_DIRECT offset, size and memory alignment */
+    static constexpr size_t m_Alignment = 4096;
+
+    struct Request
+    {
+        struct iocb ControlBlock;
+        /** aligned staging memory for DirectIO writes */
+        std::vector<char> Staging;
+        /** IWrite/IRead status to update at completion, can be nullptr */
+        Status *RequestStatus = nullptr;
+        bool InFlight = false;
+    };
+
+    /** buffered descriptor, used for reads and unaligned write regions */
+    int m_FileDescriptor = -1;
+
+    /** O_DIRECT descriptor for aligned write regions, -1 if not used */
+    int m_DirectFileDescriptor = -1;
+
+    aio_context_t m_Context = 0;
+
+    size_t m_QueueDepth = 8;
+    size_t m_ChunkSize = 4194304;
+    bool m_DirectIO = true;
+
+    /** size m_QueueDepth, allocated at Open */
+    std::vector<Request> m_Requests;
+    std::vector<struct io_event> m_Events;
+    size_t m_InFlight = 0;
+
+    /** requests still in flight for each IWrite/IRead status */
+    std::unordered_map<Status *, size_t> m_StatusRequests;
+
+    /** current stream position, Write/Read without start continue here */
+    size_t m_Position = 0;
+
+    /**
+     * Returns a request slot, waits for a completion if all are in flight
+     */
+    Request &GetFreeRequest();
+
+    void Submit(Request &request, const uint16_t opcode, const int descriptor,
+                const char *buffer, const size_t size, const size_t offset,
+                Status *status);
+
+    /** Submits chunked requests for [buffer, buffer + size) */
+    void SubmitChunks(const uint16_t opcode, const int descriptor,
+                      const char *buffer, const size_t size, size_t offset,
+                      Status *status);
+
+    /**
+     * Reaps completions, completes short transfers synchronously. Failures
+     * mark their Status unsuccessful and are thrown once all reaped events
+     * are accounted for.
+     * @param minRequests blocks until at least this many complete
+     */
+    void Reap(const size_t minRequests);
+
+    void WaitAll();
+
+    void WriteCommon(const char *buffer, size_t size, size_t start,
+                     Status *status);
+
+    void ReadCommon(char *buffer, size_t size, size_t start, Status *status);
+
+    /** synchronous pwrite/pread loops on m_FileDescriptor */
+    void PWrite(const char *buffer, size_t size, size_t offset);
+    void PRead(char *buffer, size_t size, size_t offset);
+
+    /**
+     * Check if m_FileDescriptor is -1 after an operation
+     * @param hint exception message
+     */
+    void CheckFile(const std::string hint) const;
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEAIO_H_ */
@@ -32,25 +32,25 @@ void FileFStream::Open(const std::string &name, const Mode openMode)
     switch (m_OpenMode)
     {
     case (Mode::Write):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         m_FileStream.open(name, std::fstream::out | std::fstream::binary |
                                     std::fstream::trunc);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     case (Mode::Append):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         // m_FileStream.open(name, std::fstream::in | std::fstream::out |
         //                            std::fstream::binary);
         m_FileStream.open(name, std::fstream::in | std::fstream::out |
                                     std::fstream::app | std::fstream::binary);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     case (Mode::Read):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         m_FileStream.open(name, std::fstream::in | std::fstream::binary);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     default:
@@ -73,9 +73,9 @@ void FileFStream::SetBuffer(char *buffer, size_t size)
 void FileFStream::Write(const char *buffer, size_t size, size_t start)
 {
     auto lf_Write = [&](const char *buffer, size_t size) {
-        ProfilerStart("write");
+        ProfilerStart(profiling::TraceEvent::TransportWrite);
         m_FileStream.write(buffer, static_cast<std::streamsize>(size));
-        ProfilerStop("write");
+        ProfilerStop(profiling::TraceEvent::TransportWrite, size);
         CheckFile("couldn't write from file " + m_Name +
                   ", in call to fstream write");
     };
@@ -109,9 +109,9 @@ void FileFStream::Write(const char *buffer, size_t size, size_t start)
 void FileFStream::Read(char *buffer, size_t size, size_t start)
 {
     auto lf_Read = [&](char *buffer, size_t size) {
-        ProfilerStart("read");
+        ProfilerStart(profiling::TraceEvent::TransportRead);
         m_FileStream.read(buffer, static_cast<std::streamsize>(size));
-        ProfilerStop("read");
+        ProfilerStop(profiling::TraceEvent::TransportRead, size);
         CheckFile("couldn't read from file " + m_Name +
                   ", in call to fstream read");
     };
@@ -158,18 +158,18 @@ size_t FileFStream::GetSize()
 
 void FileFStream::Flush()
 {
-    ProfilerStart("write");
+    ProfilerStart(profiling::TraceEvent::TransportWrite);
     m_FileStream.flush();
-    ProfilerStart("write");
+    ProfilerStop(profiling::TraceEvent::TransportWrite);
     CheckFile("couldn't flush to file " + m_Name +
               ", in call to fstream flush");
 }
 
 void FileFStream::Close()
 {
-    ProfilerStart("close");
+    ProfilerStart(profiling::TraceEvent::TransportClose);
     m_FileStream.close();
-    ProfilerStop("close");
+    ProfilerStop(profiling::TraceEvent::TransportClose);
 
     CheckFile("couldn't close file " + m_Name + ", in call to fstream close");
     m_IsOpen = false;
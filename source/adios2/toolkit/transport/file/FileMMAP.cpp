@@ -0,0 +1,252 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileMMAP.cpp file I/O mapping files in read mode with POSIX mmap
+ */
+#include "FileMMAP.h"
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // open, fstat
+#include <sys/types.h> // open
+#include <unistd.h>    // write, close
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::min
+#include <cstring>   //std::memcpy
+#include <ios>       //std::ios_base::failure
+/// \endcond
+
+namespace adios2
+{
+namespace transport
+{
+
+FileMMAP::FileMMAP(MPI_Comm mpiComm, const bool debugMode)
+: Transport("File", "mmap", mpiComm, debugMode)
+{
+}
+
+FileMMAP::~FileMMAP()
+{
+    if (m_IsOpen)
+    {
+        Unmap();
+        close(m_FileDescriptor);
+    }
+}
+
+void FileMMAP::Open(const std::string &name, const Mode openMode)
+{
+    m_Name = name;
+    CheckName();
+    m_OpenMode = openMode;
+    m_Position = 0;
+
+    switch (m_OpenMode)
+    {
+
+    case (Mode::Write):
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
+        m_FileDescriptor =
+            open(m_Name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
+        break;
+
+    case (Mode::Append):
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
+        m_FileDescriptor =
+            open(m_Name.c_str(), O_RDWR | O_APPEND | O_CREAT, 0777);
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
+        break;
+
+    case (Mode::Read):
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
+        m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
+        break;
+
+    default:
+        CheckFile("unknown open mode for file " + m_Name +
+                  ", in call to mmap open");
+    }
+
+    CheckFile("couldn't open file " + m_Name +
+              ", check permissions or path existence, in call to mmap open");
+
+    if (m_OpenMode == Mode::Read)
+    {
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
+        Remap(GetSize());
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
+    }
+
+    m_IsOpen = true;
+}
+
+void FileMMAP::Write(const char *buffer, size_t size, size_t start)
+{
+    if (m_OpenMode == Mode::Read)
+    {
+        throw std::invalid_argument("ERROR: file " + m_Name +
+                                    " is mapped read-only, in call to mmap "
+                                    "Write\n");
+    }
+
+    if (start != MaxSizeT)
+    {
+        const auto newPosition = lseek(m_FileDescriptor, start, SEEK_SET);
+
+        if (static_cast<size_t>(newPosition) != start)
+        {
+            throw std::ios_base::failure(
+                "ERROR: couldn't move to start position " +
+                std::to_string(start) + " in file " + m_Name +
+                ", in call to mmap lseek\n");
+        }
+    }
+
+    while (size > 0)
+    {
+        const size_t batchSize = std::min(size, DefaultMaxFileBatchSize);
+        ProfilerStart(profiling::TraceEvent::TransportWrite);
+        const auto writtenSize = write(m_FileDescriptor, buffer, batchSize);
+        ProfilerStop(profiling::TraceEvent::TransportWrite, batchSize);
+
+        if (writtenSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::ios_base::failure("ERROR: couldn't write to file " +
+                                         m_Name + ", in call to mmap Write\n");
+        }
+
+        buffer += writtenSize;
+        size -= writtenSize;
+    }
+}
+
+void FileMMAP::Read(char *buffer, size_t size, size_t start)
+{
+    if (start == MaxSizeT)
+    {
+        start = m_Position;
+    }
+
+    // file grew since it was mapped (e.g. followed while being written)
+    if (m_OpenMode == Mode::Read && (start > m_Size || size > m_Size - start))
+    {
+        GetSize();
+    }
+
+    if (m_OpenMode != Mode::Read || start > m_Size || size > m_Size - start)
+    {
+        throw std::ios_base::failure(
+            "ERROR: couldn't read " + std::to_string(size) +
+            " bytes at position " + std::to_string(start) + " from file " +
+            m_Name + " of mapped size " + std::to_string(m_Size) +
+            ", in call to mmap Read\n");
+    }
+
+    if (size > 0)
+    {
+        ProfilerStart(profiling::TraceEvent::TransportRead);
+        std::memcpy(buffer, m_Data + start, size);
+        ProfilerStop(profiling::TraceEvent::TransportRead, size);
+    }
+    m_Position = start + size;
+}
+
+size_t FileMMAP::GetSize()
+{
+    struct stat fileStat;
+    if (fstat(m_FileDescriptor, &fileStat) == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't get size of file " +
+                                     m_Name + "\n");
+    }
+    const size_t size = static_cast<size_t>(fileStat.st_size);
+
+    // keep the mapping in sync with a file that is still being written
+    if (m_IsOpen && m_OpenMode == Mode::Read)
+    {
+        Remap(size);
+    }
+    return size;
+}
+
+const char *FileMMAP::GetMappedData() const noexcept { return m_Data; }
+
+size_t FileMMAP::GetMappedSize() const noexcept { return m_Size; }
+
+void FileMMAP::Flush() {}
+
+void FileMMAP::Close()
+{
+    ProfilerStart(profiling::TraceEvent::TransportClose);
+    Unmap();
+    const int status = close(m_FileDescriptor);
+    ProfilerStop(profiling::TraceEvent::TransportClose);
+
+    if (status == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't close file " + m_Name +
+                                     ", in call to mmap close\n");
+    }
+
+    m_FileDescriptor = -1;
+    m_IsOpen = false;
+}
+
+void FileMMAP::Remap(const size_t size)
+{
+    if (m_Data != nullptr && size == m_Size)
+    {
+        return;
+    }
+
+    Unmap();
+
+    // mmap rejects zero length, empty files have nothing to map
+    if (size == 0)
+    {
+        return;
+    }
+
+    void *data =
+        mmap(nullptr, size, PROT_READ, MAP_SHARED, m_FileDescriptor, 0);
+
+    if (data == MAP_FAILED)
+    {
+        throw std::ios_base::failure("ERROR: couldn't map file " + m_Name +
+                                     ", in call to mmap errno " +
+                                     std::to_string(errno) + "\n");
+    }
+    m_Data = static_cast<char *>(data);
+    m_Size = size;
+}
+
+void FileMMAP::Unmap()
+{
+    if (m_Data != nullptr)
+    {
+        munmap(m_Data, m_Size);
+        m_Data = nullptr;
+    }
+    m_Size = 0;
+}
+
+void FileMMAP::CheckFile(const std::string hint) const
+{
+    if (m_FileDescriptor == -1)
+    {
+        throw std::ios_base::failure("ERROR: " + hint + "\n");
+    }
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,81 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileMMAP.h file I/O mapping files in read mode with POSIX mmap
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+
+#include "adios2/ADIOSConfig.h"
+#include "adios2/toolkit/transport/Transport.h"
+
+namespace adios2
+{
+namespace transport
+{
+
+/**
+ * File transport that maps the whole file read-only in Mode::Read, Read
+ * copies from the mapped pages and GetMappedData exposes them for zero-copy
+ * access. Write and Append modes use plain POSIX writes.
+ */
+class FileMMAP : public Transport
+{
+
+public:
+    FileMMAP(MPI_Comm mpiComm, const bool debugMode);
+
+    ~FileMMAP();
+
+    void Open(const std::string &name, const Mode openMode) final;
+
+    void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    /** In Mode::Read the mapping is extended if the file grew */
+    size_t GetSize() final;
+
+    /** nullptr in write modes or for empty files, can change after Read or
+     * GetSize */
+    const char *GetMappedData() const noexcept final;
+
+    /** length of GetMappedData, can change after Read or GetSize */
+    size_t GetMappedSize() const noexcept final;
+
+    /** Does nothing, each write is supposed to flush */
+    void Flush() final;
+
+    void Close() final;
+
+private:
+    /** POSIX file handle returned by Open */
+    int m_FileDescriptor = -1;
+
+    /** read-only mapping of the whole file, Mode::Read only */
+    char *m_Data = nullptr;
+
+    /** file size at Open, mapped length */
+    size_t m_Size = 0;
+
+    /** current stream position, Read without start continues here */
+    size_t m_Position = 0;
+
+    /** (Re)maps the whole file if it is not mapped or its size changed */
+    void Remap(const size_t size);
+
+    void Unmap();
+
+    /**
+     * Check if m_FileDescriptor is -1 after an operation
+     * @param hint exception message
+     */
+    void CheckFile(const std::string hint) const;
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_ */
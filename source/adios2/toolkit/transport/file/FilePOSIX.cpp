@@ -10,11 +10,15 @@
 #include "FilePOSIX.h"
 
 #include <fcntl.h>     // open
+#include <limits.h>    // IOV_MAX
 #include <stddef.h>    // write output
 #include <sys/stat.h>  // open, fstat
 #include <sys/types.h> // open
+#include <sys/uio.h>   // writev
 #include <unistd.h>    // write, close
 
+#include <algorithm> //std::min
+
 /// \cond EXCLUDE_FROM_DOXYGEN
 #include <ios> //std::ios_base::failure
 /// \endcond
@@ -47,24 +51,24 @@ void FilePOSIX::Open(const std::string &name, const Mode openMode)
     {
 
     case (Mode::Write):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         m_FileDescriptor =
             open(m_Name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     case (Mode::Append):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         // m_FileDescriptor = open(m_Name.c_str(), O_RDWR);
         m_FileDescriptor =
             open(m_Name.c_str(), O_RDWR | O_APPEND | O_CREAT, 0777);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     case (Mode::Read):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     default:
@@ -83,9 +87,9 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     auto lf_Write = [&](const char *buffer, size_t size) {
         while (size > 0)
         {
-            ProfilerStart("write");
+            ProfilerStart(profiling::TraceEvent::TransportWrite);
             const auto writtenSize = write(m_FileDescriptor, buffer, size);
-            ProfilerStop("write");
+            ProfilerStop(profiling::TraceEvent::TransportWrite, size);
 
             if (writtenSize == -1)
             {
@@ -136,14 +140,85 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     }
 }
 
+void FilePOSIX::WriteV(const std::vector<Segment> &segments, size_t start)
+{
+    if (start != MaxSizeT)
+    {
+        const auto newPosition = lseek(m_FileDescriptor, start, SEEK_SET);
+
+        if (static_cast<size_t>(newPosition) != start)
+        {
+            throw std::ios_base::failure(
+                "ERROR: couldn't move to start position " +
+                std::to_string(start) + " in file " + m_Name +
+                ", in call to POSIX lseek\n");
+        }
+    }
+
+    std::vector<struct iovec> iovecs;
+    iovecs.reserve(segments.size());
+    for (const Segment &segment : segments)
+    {
+        if (segment.Size > 0)
+        {
+            iovecs.push_back(
+                {const_cast<char *>(segment.Buffer), segment.Size});
+        }
+    }
+
+#ifdef IOV_MAX
+    const size_t maxIovecs = IOV_MAX;
+#else
+    const size_t maxIovecs = 1024;
+#endif
+
+    size_t first = 0;
+    while (first < iovecs.size())
+    {
+        const size_t count = std::min(maxIovecs, iovecs.size() - first);
+
+        ProfilerStart(profiling::TraceEvent::TransportWrite);
+        const auto writtenSize = writev(m_FileDescriptor, &iovecs[first],
+                                        static_cast<int>(count));
+        ProfilerStop(profiling::TraceEvent::TransportWrite,
+                     writtenSize > 0 ? static_cast<size_t>(writtenSize) : 0);
+
+        if (writtenSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::ios_base::failure(
+                "ERROR: couldn't write to file " + m_Name +
+                ", in call to FileDescriptor WriteV\n");
+        }
+
+        // skip written iovecs, a partial write continues inside one
+        size_t remaining = static_cast<size_t>(writtenSize);
+        while (first < iovecs.size() && remaining >= iovecs[first].iov_len)
+        {
+            remaining -= iovecs[first].iov_len;
+            ++first;
+        }
+        if (remaining > 0)
+        {
+            iovecs[first].iov_base =
+                static_cast<char *>(iovecs[first].iov_base) + remaining;
+            iovecs[first].iov_len -= remaining;
+        }
+    }
+}
+
 void FilePOSIX::Read(char *buffer, size_t size, size_t start)
 {
     auto lf_Read = [&](char *buffer, size_t size) {
         while (size > 0)
         {
-            ProfilerStart("read");
+            ProfilerStart(profiling::TraceEvent::TransportRead);
             const auto readSize = read(m_FileDescriptor, buffer, size);
-            ProfilerStop("read");
+            ProfilerStop(profiling::TraceEvent::TransportRead, size);
 
             if (readSize == -1)
             {
@@ -210,9 +285,9 @@ void FilePOSIX::Flush() {}
 
 void FilePOSIX::Close()
 {
-    ProfilerStart("close");
+    ProfilerStart(profiling::TraceEvent::TransportClose);
     const int status = close(m_FileDescriptor);
-    ProfilerStop("close");
+    ProfilerStop(profiling::TraceEvent::TransportClose);
 
     if (status == -1)
     {
@@ -80,10 +80,10 @@ void FileStdio::SetBuffer(char *buffer, size_t size)
 void FileStdio::Write(const char *buffer, size_t size, size_t start)
 {
     auto lf_Write = [&](const char *buffer, size_t size) {
-        ProfilerStart("write");
+        ProfilerStart(profiling::TraceEvent::TransportWrite);
         const auto writtenSize =
             std::fwrite(buffer, sizeof(char), size, m_File);
-        ProfilerStop("write");
+        ProfilerStop(profiling::TraceEvent::TransportWrite, size);
 
         CheckFile("couldn't write to file " + m_Name +
                   ", in call to stdio fwrite");
@@ -134,9 +134,9 @@ void FileStdio::Write(const char *buffer, size_t size, size_t start)
 void FileStdio::Read(char *buffer, size_t size, size_t start)
 {
     auto lf_Read = [&](char *buffer, size_t size) {
-        ProfilerStart("read");
+        ProfilerStart(profiling::TraceEvent::TransportRead);
         const auto readSize = std::fread(buffer, sizeof(char), size, m_File);
-        ProfilerStop("read");
+        ProfilerStop(profiling::TraceEvent::TransportRead, size);
 
         CheckFile("couldn't read to file " + m_Name +
                   ", in call to stdio fread");
@@ -203,9 +203,9 @@ size_t FileStdio::GetSize()
 
 void FileStdio::Flush()
 {
-    ProfilerStart("write");
+    ProfilerStart(profiling::TraceEvent::TransportWrite);
     const int status = std::fflush(m_File);
-    ProfilerStop("write");
+    ProfilerStop(profiling::TraceEvent::TransportWrite);
 
     if (status == EOF)
     {
@@ -216,9 +216,9 @@ void FileStdio::Flush()
 
 void FileStdio::Close()
 {
-    ProfilerStart("close");
+    ProfilerStart(profiling::TraceEvent::TransportClose);
     const int status = std::fclose(m_File);
-    ProfilerStop("close");
+    ProfilerStop(profiling::TraceEvent::TransportClose);
 
     if (status == EOF)
     {
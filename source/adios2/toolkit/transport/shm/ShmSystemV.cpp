@@ -59,21 +59,21 @@ void ShmSystemV::Open(const std::string &name, const Mode openMode)
     switch (m_OpenMode)
     {
     case (Mode::Write):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         m_ShmID = shmget(key, m_Size, IPC_CREAT | 0666);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     case (Mode::Append):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         m_ShmID = shmget(key, m_Size, 0);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     case (Mode::Read):
-        ProfilerStart("open");
+        ProfilerStart(profiling::TraceEvent::TransportOpen);
         m_ShmID = shmget(key, m_Size, 0);
-        ProfilerStop("open");
+        ProfilerStop(profiling::TraceEvent::TransportOpen);
         break;
 
     default:
@@ -92,24 +92,24 @@ void ShmSystemV::Open(const std::string &name, const Mode openMode)
 void ShmSystemV::Write(const char *buffer, size_t size, size_t start)
 {
     CheckSizes(size, start, "in call to Write");
-    ProfilerStart("write");
+    ProfilerStart(profiling::TraceEvent::TransportWrite);
     std::memcpy(&m_Buffer[start], buffer, size);
-    ProfilerStop("write");
+    ProfilerStop(profiling::TraceEvent::TransportWrite, size);
 }
 
 void ShmSystemV::Read(char *buffer, size_t size, size_t start)
 {
     CheckSizes(size, start, "in call to Read");
-    ProfilerStart("read");
+    ProfilerStart(profiling::TraceEvent::TransportRead);
     std::memcpy(buffer, &m_Buffer[start], size);
-    ProfilerStop("read");
+    ProfilerStop(profiling::TraceEvent::TransportRead, size);
 }
 
 void ShmSystemV::Close()
 {
-    ProfilerStart("close");
+    ProfilerStart(profiling::TraceEvent::TransportClose);
     int result = shmdt(m_Buffer);
-    ProfilerStop("close");
+    ProfilerStop(profiling::TraceEvent::TransportClose);
     if (result < 1)
     {
         throw std::ios_base::failure(
@@ -120,9 +120,9 @@ void ShmSystemV::Close()
 
     if (m_RemoveAtClose)
     {
-        ProfilerStart("close");
+        ProfilerStart(profiling::TraceEvent::TransportClose);
         const int remove = shmctl(m_ShmID, IPC_RMID, NULL);
-        ProfilerStop("close");
+        ProfilerStop(profiling::TraceEvent::TransportClose);
         if (remove < 1)
         {
             throw std::ios_base::failure(
@@ -55,7 +55,7 @@ void SocketZmqP2P::Open(const std::string &ipAddress, const std::string &port,
     std::string openModeStr;
 
     int error = -1;
-    ProfilerStart("open");
+    ProfilerStart(profiling::TraceEvent::TransportOpen);
     if (m_OpenMode == Mode::Write)
     {
         openModeStr = "Write";
@@ -75,7 +75,7 @@ void SocketZmqP2P::Open(const std::string &ipAddress, const std::string &port,
         throw std::invalid_argument(
             "[SocketZmqP2P::Open] invalid OpenMode parameter");
     }
-    ProfilerStop("open");
+    ProfilerStop(profiling::TraceEvent::TransportOpen);
 
     if (m_DebugMode)
     {
@@ -114,10 +114,10 @@ void SocketZmqP2P::IWrite(const char *buffer, size_t size, Status &status,
 {
     int retInt = 0;
     char retChar[10];
-    ProfilerStart("write");
+    ProfilerStart(profiling::TraceEvent::TransportWrite);
     retInt = zmq_send(m_Socket, buffer, size, 0);
     zmq_recv(m_Socket, retChar, 4, 0);
-    ProfilerStop("write");
+    ProfilerStop(profiling::TraceEvent::TransportWrite, size);
     const std::string retString = retChar;
     if (retInt < 0 || retString != "OK")
     {
@@ -130,10 +130,10 @@ void SocketZmqP2P::IRead(char *buffer, size_t size, Status &status,
                          size_t start)
 {
     const std::string reply = "OK";
-    ProfilerStart("read");
+    ProfilerStart(profiling::TraceEvent::TransportRead);
     int bytes = zmq_recv(m_Socket, buffer, size, 0);
     zmq_send(m_Socket, reply.c_str(), 4, 0);
-    ProfilerStop("read");
+    ProfilerStop(profiling::TraceEvent::TransportRead, size);
     if (bytes > 0)
     {
         status.Bytes = bytes;
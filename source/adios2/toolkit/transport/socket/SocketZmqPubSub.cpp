@@ -51,7 +51,7 @@ void SocketZmqPubSub::Open(const std::string &ipAddress,
     std::string openModeStr;
 
     int error = -1;
-    ProfilerStart("open");
+    ProfilerStart(profiling::TraceEvent::TransportOpen);
     if (m_OpenMode == Mode::Write)
     {
         openModeStr = "Write";
@@ -70,7 +70,7 @@ void SocketZmqPubSub::Open(const std::string &ipAddress,
         throw std::invalid_argument(
             "[SocketZmqPubSub::Open] received invalid OpenMode parameter");
     }
-    ProfilerStop("open");
+    ProfilerStop(profiling::TraceEvent::TransportOpen);
 
     if (m_DebugMode)
     {
@@ -113,11 +113,11 @@ void SocketZmqPubSub::IWrite(const char *buffer, size_t size, Status &status,
                              size_t start)
 {
     int retInt = 0;
-    ProfilerStart("write");
+    ProfilerStart(profiling::TraceEvent::TransportWrite);
     std::cout << "before send\n";
     retInt = zmq_send(m_Socket, buffer, size, ZMQ_DONTWAIT);
     std::cout << "end send\n";
-    ProfilerStop("write");
+    ProfilerStop(profiling::TraceEvent::TransportWrite, size);
     if (retInt < 0)
     {
         throw std::ios_base::failure(
@@ -128,9 +128,9 @@ void SocketZmqPubSub::IWrite(const char *buffer, size_t size, Status &status,
 void SocketZmqPubSub::IRead(char *buffer, size_t size, Status &status,
                             size_t start)
 {
-    ProfilerStart("read");
+    ProfilerStart(profiling::TraceEvent::TransportRead);
     int bytes = zmq_recv(m_Socket, buffer, size, ZMQ_DONTWAIT);
-    ProfilerStop("read");
+    ProfilerStop(profiling::TraceEvent::TransportRead, size);
     if (bytes > 0)
     {
         status.Bytes = bytes;
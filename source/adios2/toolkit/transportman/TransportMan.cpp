@@ -18,9 +18,14 @@
 
 /// transports
 #ifndef _WIN32
+#include "adios2/toolkit/transport/file/FileMMAP.h"
 #include "adios2/toolkit/transport/file/FilePOSIX.h"
 #endif
 
+#ifdef ADIOS2_HAVE_AIO
+#include "adios2/toolkit/transport/file/FileAIO.h"
+#endif
+
 #include "adios2/toolkit/transport/file/FileFStream.h"
 #include "adios2/toolkit/transport/file/FileStdio.h"
 
@@ -193,6 +198,52 @@ void TransportMan::WriteFiles(const char *buffer, const size_t size,
     }
 }
 
+void TransportMan::WriteFiles(const std::vector<Transport::Segment> &segments,
+                              const int transportIndex)
+{
+    if (transportIndex == -1)
+    {
+        for (auto &transportPair : m_Transports)
+        {
+            auto &transport = transportPair.second;
+            if (transport->m_Type == "File")
+            {
+                transport->WriteV(segments);
+            }
+        }
+    }
+    else
+    {
+        auto itTransport = m_Transports.find(transportIndex);
+        CheckFile(itTransport, ", in call to WriteFiles with index " +
+                                   std::to_string(transportIndex));
+        itTransport->second->WriteV(segments);
+    }
+}
+
+void TransportMan::WriteFilesAt(const char *buffer, const size_t size,
+                                const size_t start, const int transportIndex)
+{
+    if (transportIndex == -1)
+    {
+        for (auto &transportPair : m_Transports)
+        {
+            auto &transport = transportPair.second;
+            if (transport->m_Type == "File")
+            {
+                transport->Write(buffer, size, start);
+            }
+        }
+    }
+    else
+    {
+        auto itTransport = m_Transports.find(transportIndex);
+        CheckFile(itTransport, ", in call to WriteFilesAt with index " +
+                                   std::to_string(transportIndex));
+        itTransport->second->Write(buffer, size, start);
+    }
+}
+
 size_t TransportMan::GetFileSize(const size_t transportIndex) const
 {
     auto itTransport = m_Transports.find(transportIndex);
@@ -201,6 +252,22 @@ size_t TransportMan::GetFileSize(const size_t transportIndex) const
     return itTransport->second->GetSize();
 }
 
+const char *TransportMan::GetFileMappedData(const size_t transportIndex) const
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to GetFileMappedData with index " +
+                               std::to_string(transportIndex));
+    return itTransport->second->GetMappedData();
+}
+
+size_t TransportMan::GetFileMappedSize(const size_t transportIndex) const
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to GetFileMappedSize with index " +
+                               std::to_string(transportIndex));
+    return itTransport->second->GetMappedSize();
+}
+
 void TransportMan::ReadFile(char *buffer, const size_t size, const size_t start,
                             const size_t transportIndex)
 {
@@ -272,6 +339,15 @@ bool TransportMan::AllTransportsClosed() const noexcept
     return allClose;
 }
 
+void TransportMan::SetTracer(profiling::Tracer *tracer) noexcept
+{
+    m_Tracer = tracer;
+    for (auto &transportPair : m_Transports)
+    {
+        transportPair.second->m_Tracer = tracer;
+    }
+}
+
 // PRIVATE
 std::shared_ptr<Transport>
 TransportMan::OpenFileTransport(const std::string &fileName,
@@ -296,6 +372,18 @@ TransportMan::OpenFileTransport(const std::string &fileName,
             transport =
                 std::make_shared<transport::FilePOSIX>(m_MPIComm, m_DebugMode);
         }
+        else if (library == "mmap" || library == "MMAP")
+        {
+            transport =
+                std::make_shared<transport::FileMMAP>(m_MPIComm, m_DebugMode);
+        }
+#endif
+#ifdef ADIOS2_HAVE_AIO
+        else if (library == "AIO" || library == "aio")
+        {
+            transport =
+                std::make_shared<transport::FileAIO>(m_MPIComm, m_DebugMode);
+        }
 #endif
         else
         {
@@ -303,7 +391,8 @@ TransportMan::OpenFileTransport(const std::string &fileName,
             {
                 throw std::invalid_argument(
                     "ERROR: invalid IO AddTransport library " + library +
-                    ", only POSIX, stdio, fstream are supported\n");
+                    ", only POSIX, mmap, AIO (Linux), stdio, fstream are "
+                    "supported\n");
             }
         }
     };
@@ -338,6 +427,9 @@ TransportMan::OpenFileTransport(const std::string &fileName,
                                 lf_GetTimeUnits(DefaultTimeUnit, parameters));
     }
 
+    transport->SetParameters(parameters);
+    transport->m_Tracer = m_Tracer;
+
     // open
     transport->Open(fileName, openMode);
     return transport;
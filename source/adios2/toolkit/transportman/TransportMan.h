@@ -117,8 +117,41 @@ public:
     void WriteFiles(const char *buffer, const size_t size,
                     const int transportIndex = -1);
 
+    /**
+     * Write segments, in order, to file transports with a single gathered
+     * write where the transport supports it
+     * @param segments
+     * @param transportIndex
+     */
+    void WriteFiles(const std::vector<Transport::Segment> &segments,
+                    const int transportIndex = -1);
+
+    /**
+     * Write to file transports at a fixed position, e.g. to patch a header
+     * @param buffer
+     * @param size
+     * @param start file position
+     * @param transportIndex
+     */
+    void WriteFilesAt(const char *buffer, const size_t size, const size_t start,
+                      const int transportIndex = -1);
+
     size_t GetFileSize(const size_t transportIndex = 0) const;
 
+    /**
+     * Contents of a memory mapped file, valid until CloseFiles
+     * @param transportIndex
+     * @return nullptr if the transport is not memory mapped
+     */
+    const char *GetFileMappedData(const size_t transportIndex = 0) const;
+
+    /**
+     * Length of the contents returned by GetFileMappedData
+     * @param transportIndex
+     * @return 0 if the transport is not memory mapped
+     */
+    size_t GetFileMappedSize(const size_t transportIndex = 0) const;
+
     /**
      * Read contents from a single file and assign it to buffer
      * @param buffer
@@ -146,9 +179,16 @@ public:
     /** Checks if all transports are closed */
     bool AllTransportsClosed() const noexcept;
 
+    /**
+     * Sets the tracer of current and later opened transports
+     * @param tracer not owned, must outlive the transports, nullptr: none
+     */
+    void SetTracer(profiling::Tracer *tracer) noexcept;
+
 protected:
     MPI_Comm m_MPIComm;
     const bool m_DebugMode = false;
+    profiling::Tracer *m_Tracer = nullptr;
 
     std::shared_ptr<Transport> OpenFileTransport(const std::string &fileName,
                                                  const Mode openMode,
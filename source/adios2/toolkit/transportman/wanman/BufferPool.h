@@ -0,0 +1,108 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BufferPool.h recycles char buffers handed out as shared pointers, buffers
+ * return to the pool keeping their capacity when their last reference drops
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORTMAN_WANMAN_BUFFERPOOL_H_
+#define ADIOS2_TOOLKIT_TRANSPORTMAN_WANMAN_BUFFERPOOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace adios2
+{
+namespace transportman
+{
+
+class BufferPool
+{
+
+public:
+    /** @param maxBuffers maximum number of idle buffers kept for reuse */
+    explicit BufferPool(const size_t maxBuffers)
+    : m_Pool(std::make_shared<Pool>()), m_MaxBuffers(maxBuffers)
+    {
+    }
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    /**
+     * Thread safe, returns an empty buffer with at least size capacity. The
+     * pool is shared with the deleter, buffers can outlive this object.
+     */
+    std::shared_ptr<std::vector<char>> Acquire(const size_t size)
+    {
+        std::unique_ptr<std::vector<char>> buffer;
+        {
+            std::lock_guard<std::mutex> l(m_Pool->Mutex);
+            auto &buffers = m_Pool->Buffers;
+            if (!buffers.empty())
+            {
+                // prefer the smallest buffer that is already large enough,
+                // otherwise grow the largest one
+                auto it = std::max_element(
+                    buffers.begin(), buffers.end(),
+                    [](const std::unique_ptr<std::vector<char>> &a,
+                       const std::unique_ptr<std::vector<char>> &b) {
+                        return a->capacity() < b->capacity();
+                    });
+                for (auto i = buffers.begin(); i != buffers.end(); ++i)
+                {
+                    if ((*i)->capacity() >= size &&
+                        (*i)->capacity() < (*it)->capacity())
+                    {
+                        it = i;
+                    }
+                }
+                buffer = std::move(*it);
+                buffers.erase(it);
+            }
+        }
+        if (buffer == nullptr)
+        {
+            buffer.reset(new std::vector<char>());
+        }
+        buffer->reserve(size);
+
+        std::shared_ptr<Pool> pool = m_Pool;
+        const size_t maxBuffers = m_MaxBuffers;
+        return std::shared_ptr<std::vector<char>>(
+            buffer.release(), [pool, maxBuffers](std::vector<char> *v) {
+                std::unique_ptr<std::vector<char>> recycled(v);
+                recycled->clear();
+                std::lock_guard<std::mutex> l(pool->Mutex);
+                if (pool->Buffers.size() < maxBuffers)
+                {
+                    pool->Buffers.push_back(std::move(recycled));
+                }
+            });
+    }
+
+    /** @return number of idle buffers waiting for reuse */
+    size_t Size() const
+    {
+        std::lock_guard<std::mutex> l(m_Pool->Mutex);
+        return m_Pool->Buffers.size();
+    }
+
+private:
+    struct Pool
+    {
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<std::vector<char>>> Buffers;
+    };
+    std::shared_ptr<Pool> m_Pool;
+    const size_t m_MaxBuffers;
+};
+
+} // end namespace transportman
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORTMAN_WANMAN_BUFFERPOOL_H_ */
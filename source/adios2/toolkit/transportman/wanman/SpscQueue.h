@@ -0,0 +1,89 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * SpscQueue.h bounded lock-free queue between one producer and one consumer
+ * thread
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORTMAN_WANMAN_SPSCQUEUE_H_
+#define ADIOS2_TOOLKIT_TRANSPORTMAN_WANMAN_SPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace adios2
+{
+namespace transportman
+{
+
+template <class T>
+class SpscQueue
+{
+
+public:
+    /** @param capacity maximum number of elements held at once */
+    explicit SpscQueue(const size_t capacity) : m_Slots(capacity + 1) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * Only called from the producer thread
+     * @return false if the queue is full, value is left untouched
+     */
+    bool Push(T &value)
+    {
+        const size_t tail = m_Tail.load(std::memory_order_relaxed);
+        const size_t next = Next(tail);
+        if (next == m_Head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        m_Slots[tail] = std::move(value);
+        m_Tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Only called from the consumer thread
+     * @return false if the queue is empty
+     */
+    bool Pop(T &value)
+    {
+        const size_t head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_Tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = std::move(m_Slots[head]);
+        m_Slots[head] = T();
+        m_Head.store(Next(head), std::memory_order_release);
+        return true;
+    }
+
+    bool Empty() const
+    {
+        return m_Head.load(std::memory_order_acquire) ==
+               m_Tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> m_Slots;
+    // head and tail a cache line apart, so that producer and consumer don't
+    // invalidate each other's line on every operation
+    std::atomic<size_t> m_Head{0};
+    char m_Padding[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_Tail{0};
+
+    size_t Next(const size_t index) const
+    {
+        return index + 1 == m_Slots.size() ? 0 : index + 1;
+    }
+};
+
+} // end namespace transportman
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORTMAN_WANMAN_SPSCQUEUE_H_ */
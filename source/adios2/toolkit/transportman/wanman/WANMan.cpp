@@ -8,6 +8,7 @@
  *      Author: Jason Wang wangr1@ornl.gov
  */
 
+#include <chrono>
 #include <fstream>  //TODO go away
 #include <iostream> //TODO go away
 
@@ -27,7 +28,8 @@ namespace transportman
 {
 
 WANMan::WANMan(MPI_Comm mpiComm, const bool debugMode)
-: m_MpiComm(mpiComm), m_DebugMode(debugMode)
+: m_MpiComm(mpiComm), m_DebugMode(debugMode),
+  m_BufferPool(m_MaxPooledBuffers)
 {
 }
 
@@ -37,15 +39,13 @@ WANMan::~WANMan()
     while (true)
     {
         int s = 0;
-        m_Mutex.lock();
-        for (const auto &i : m_BufferQueue)
+        for (const auto &i : m_BufferQueues)
         {
-            if (i.size() != 0)
+            if (!i->Queue.Empty())
             {
                 ++s;
             }
         }
-        m_Mutex.unlock();
         if (s == 0)
         {
             break;
@@ -57,9 +57,8 @@ WANMan::~WANMan()
         {
             break;
         }
-        // add a sleep here because this loop is occupying the buffer queue
-        // lock, and this sleep would make time for reader or writer thread and
-        // help it finish sooner.
+        // add a sleep here so that this loop does not compete with the reader
+        // or writer thread and help it finish sooner.
         std::this_thread::sleep_for(std::chrono::microseconds(1));
     }
     for (auto &readThread : m_ReadThreads)
@@ -81,10 +80,28 @@ void WANMan::OpenTransports(const std::vector<Params> &paramsVector,
                             const bool profile)
 {
     m_TransportsParameters = paramsVector;
-    m_BufferQueue.resize(paramsVector.size());
 
     for (size_t i = 0; i < paramsVector.size(); ++i)
     {
+        std::string maxInFlightBytes;
+        size_t maxBytes = 0;
+        if (GetStringParameter(paramsVector[i], "MaxInFlightBytes",
+                               maxInFlightBytes))
+        {
+            try
+            {
+                maxBytes = std::stoull(maxInFlightBytes);
+            }
+            catch (std::exception &e)
+            {
+                throw std::invalid_argument(
+                    "ERROR: MaxInFlightBytes " + maxInFlightBytes +
+                    " is not a number of bytes, in call to Open\n");
+            }
+        }
+        m_BufferQueues.emplace_back(
+            new BufferQueue(m_QueueCapacity, maxBytes));
+
         // Get parameters
         std::string library;
         GetStringParameter(paramsVector[i], "Library", library);
@@ -138,7 +155,7 @@ void WANMan::OpenTransports(const std::vector<Params> &paramsVector,
             {
                 m_Reading = true;
                 m_ReadThreads.emplace_back(
-                    std::thread(&WANMan::ReadThread, this, wanTransport));
+                    std::thread(&WANMan::ReadThread, this, wanTransport, i));
             }
             else if (mode == Mode::Write)
             {
@@ -183,22 +200,56 @@ void WANMan::Write(const std::vector<char> &buffer, size_t transportId)
 
 std::shared_ptr<std::vector<char>> WANMan::Read(size_t id)
 {
-    return PopBufferQueue(id);
+    if (id >= m_BufferQueues.size())
+    {
+        return nullptr;
+    }
+    std::shared_ptr<std::vector<char>> buffer = PopBufferQueue(id);
+    if (buffer != nullptr)
+    {
+        m_BufferQueues[id]->Bytes -= buffer->size();
+    }
+    return buffer;
+}
+
+std::shared_ptr<std::vector<char>> WANMan::AcquireBuffer(const size_t size)
+{
+    return m_BufferPool.Acquire(size);
 }
 
-void WANMan::PushBufferQueue(std::shared_ptr<std::vector<char>> v, size_t id)
+bool WANMan::PushBufferQueue(std::shared_ptr<std::vector<char>> v, size_t id)
 {
-    std::lock_guard<std::mutex> l(m_Mutex);
-    m_BufferQueue[id].push(v);
+    BufferQueue &q = *m_BufferQueues[id];
+    const size_t size = v->size();
+
+    // backpressure, a single buffer larger than the budget still goes through
+    while (q.MaxBytes > 0 && q.Bytes > 0 && q.Bytes + size > q.MaxBytes)
+    {
+        if (!m_Reading && !m_Writing)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+
+    q.Bytes += size;
+    while (!q.Queue.Push(v))
+    {
+        if (!m_Reading && !m_Writing)
+        {
+            q.Bytes -= size;
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+    return true;
 }
 
 std::shared_ptr<std::vector<char>> WANMan::PopBufferQueue(size_t id)
 {
-    std::lock_guard<std::mutex> l(m_Mutex);
-    if (m_BufferQueue[id].size() > 0)
+    std::shared_ptr<std::vector<char>> vec;
+    if (m_BufferQueues[id]->Queue.Pop(vec))
     {
-        std::shared_ptr<std::vector<char>> vec = m_BufferQueue[id].front();
-        m_BufferQueue[id].pop();
         return vec;
     }
     return nullptr;
@@ -216,11 +267,12 @@ void WANMan::WriteThread(std::shared_ptr<Transport> transport, size_t id)
             {
                 transport->IWrite(buffer->data(), buffer->size(), status);
             }
+            m_BufferQueues[id]->Bytes -= buffer->size();
         }
     }
 }
 
-void WANMan::ReadThread(std::shared_ptr<Transport> transport)
+void WANMan::ReadThread(std::shared_ptr<Transport> transport, size_t id)
 {
     std::vector<char> buffer(m_MaxReceiveBuffer);
     while (m_Reading)
@@ -230,9 +282,10 @@ void WANMan::ReadThread(std::shared_ptr<Transport> transport)
         if (status.Bytes > 0)
         {
             std::shared_ptr<std::vector<char>> bufferQ =
-                std::make_shared<std::vector<char>>(status.Bytes);
+                AcquireBuffer(status.Bytes);
+            bufferQ->resize(status.Bytes);
             std::memcpy(bufferQ->data(), buffer.data(), status.Bytes);
-            PushBufferQueue(bufferQ, 0);
+            PushBufferQueue(bufferQ, id);
         }
     }
 }
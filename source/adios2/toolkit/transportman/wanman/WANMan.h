@@ -11,13 +11,16 @@
 #ifndef ADIOS2_TOOLKIT_TRANSPORTMAN_WANMAN_WANMAN_H_
 #define ADIOS2_TOOLKIT_TRANSPORTMAN_WANMAN_WANMAN_H_
 
-#include <queue>
+#include <atomic>
+#include <mutex>
 #include <thread>
 
 #include "adios2/core/IO.h"
 #include "adios2/core/Operator.h"
 #include "adios2/toolkit/format/bp3/BP3.h"
 #include "adios2/toolkit/transportman/TransportMan.h"
+#include "adios2/toolkit/transportman/wanman/BufferPool.h"
+#include "adios2/toolkit/transportman/wanman/SpscQueue.h"
 
 namespace adios2
 {
@@ -43,16 +46,35 @@ public:
 
     void SetMaxReceiveBuffer(size_t size);
 
+    /**
+     * Returns an empty buffer with at least size capacity. It goes back to
+     * the pool, keeping its capacity, when its last reference is dropped,
+     * so steady streams stop allocating.
+     */
+    std::shared_ptr<std::vector<char>> AcquireBuffer(const size_t size);
+
 private:
     std::unordered_map<size_t, std::shared_ptr<Transport>> m_Transports;
     MPI_Comm m_MpiComm;
     bool m_DebugMode;
 
-    // Objects for buffer queue
-    std::vector<std::queue<std::shared_ptr<std::vector<char>>>> m_BufferQueue;
-    void PushBufferQueue(std::shared_ptr<std::vector<char>> v, size_t id);
+    // Objects for buffer queue, one per transport between the engine thread
+    // and the transport's read or write thread
+    struct BufferQueue
+    {
+        BufferQueue(const size_t capacity, const size_t maxBytes)
+        : Queue(capacity), MaxBytes(maxBytes)
+        {
+        }
+        SpscQueue<std::shared_ptr<std::vector<char>>> Queue;
+        // queued bytes, for writers until the transport wrote them
+        std::atomic<size_t> Bytes{0};
+        // 0 is unlimited
+        const size_t MaxBytes;
+    };
+    std::vector<std::unique_ptr<BufferQueue>> m_BufferQueues;
+    bool PushBufferQueue(std::shared_ptr<std::vector<char>> v, size_t id);
     std::shared_ptr<std::vector<char>> PopBufferQueue(size_t id);
-    std::mutex m_Mutex;
 
     // Functions for parsing parameters
     bool GetBoolParameter(const Params &params, const std::string &key);
@@ -62,19 +84,24 @@ private:
                          int &value);
 
     // For read thread
-    void ReadThread(std::shared_ptr<Transport> transport);
+    void ReadThread(std::shared_ptr<Transport> transport, size_t id);
     std::vector<std::thread> m_ReadThreads;
-    bool m_Reading = false;
+    std::atomic<bool> m_Reading{false};
 
     // For write thread
     void WriteThread(std::shared_ptr<Transport> transport, size_t id);
     std::vector<std::thread> m_WriteThreads;
-    bool m_Writing = false;
+    std::atomic<bool> m_Writing{false};
 
     // parameters
     std::vector<Params> m_TransportsParameters;
     size_t m_MaxReceiveBuffer = 256 * 1024 * 1024;
     int m_Timeout = 10;
+    size_t m_QueueCapacity = 1024;
+    size_t m_MaxPooledBuffers = 16;
+
+    // Recycled buffers, after m_MaxPooledBuffers that sizes it
+    BufferPool m_BufferPool;
 };
 
 } // end namespace transportman
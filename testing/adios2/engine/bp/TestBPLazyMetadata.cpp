@@ -0,0 +1,325 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPLazyMetadata : public ::testing::Test
+{
+public:
+    BPLazyMetadata() = default;
+};
+
+// i32 in every step, r64 only in odd steps
+void WriteSteps(adios2::ADIOS &adios, const std::string &fname,
+                const size_t Nx, const size_t NSteps)
+{
+    int mpiRank = 0, mpiSize = 1;
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    adios2::IO io = adios.DeclareIO("TestIO");
+    const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+    const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+    const adios2::Dims count{Nx};
+
+    auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count,
+                                              adios2::ConstantDims);
+    auto var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                             adios2::ConstantDims);
+
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    else
+    {
+        io.SetEngine("BP4");
+    }
+
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+    std::vector<int32_t> I32(Nx);
+    std::vector<double> R64(Nx);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        std::iota(I32.begin(), I32.end(),
+                  static_cast<int32_t>(step * 1000 + mpiRank * Nx));
+        std::iota(R64.begin(), R64.end(),
+                  static_cast<double>(step * 1000 + mpiRank * Nx));
+
+        bpWriter.BeginStep();
+        bpWriter.Put(var_i32, I32.data());
+        if (step % 2 == 1)
+        {
+            bpWriter.Put(var_r64, R64.data());
+        }
+        bpWriter.EndStep();
+    }
+    bpWriter.Close();
+}
+
+//******************************************************************************
+// Streaming, variables parsed at BeginStep, at most 2 steps kept
+//******************************************************************************
+
+TEST_F(BPLazyMetadata, ADIOS2BPLazyMetadataStreaming)
+{
+    const std::string fname("ADIOS2BPLazyMetadataStreaming.bp");
+
+    int mpiRank = 0;
+    const size_t Nx = 8;
+    const size_t NSteps = 7;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    WriteSteps(adios, fname, Nx, NSteps);
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    else
+    {
+        io.SetEngine("BP4");
+    }
+    io.SetParameters({{"LazyMetadata", "On"}, {"MaxParsedSteps", "2"}});
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    std::vector<int32_t> I32(Nx);
+    std::vector<double> R64(Nx);
+    const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+
+    size_t t = 0;
+    while (bpReader.BeginStep() == adios2::StepStatus::OK)
+    {
+        EXPECT_EQ(bpReader.CurrentStep(), t);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_TRUE(var_i32);
+        var_i32.SetSelection(sel);
+        bpReader.Get(var_i32, I32.data());
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        if (t % 2 == 1)
+        {
+            ASSERT_TRUE(var_r64);
+            var_r64.SetSelection(sel);
+            bpReader.Get(var_r64, R64.data());
+        }
+        else
+        {
+            EXPECT_FALSE(var_r64);
+        }
+        bpReader.EndStep();
+
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            ASSERT_EQ(I32[i], static_cast<int32_t>(t * 1000 + mpiRank * Nx + i))
+                << "t=" << t << " i=" << i << " rank=" << mpiRank;
+            if (t % 2 == 1)
+            {
+                ASSERT_EQ(R64[i],
+                          static_cast<double>(t * 1000 + mpiRank * Nx + i))
+                    << "t=" << t << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+        ++t;
+    }
+
+    EXPECT_EQ(t, NSteps);
+    bpReader.Close();
+}
+
+//******************************************************************************
+// Random access, steps parsed on demand by Get
+//******************************************************************************
+
+TEST_F(BPLazyMetadata, ADIOS2BPLazyMetadataStepSelection)
+{
+    const std::string fname("ADIOS2BPLazyMetadataStepSelection.bp");
+
+    int mpiRank = 0;
+    const size_t Nx = 8;
+    const size_t NSteps = 6;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    WriteSteps(adios, fname, Nx, NSteps);
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    else
+    {
+        io.SetEngine("BP4");
+    }
+    io.SetParameter("LazyMetadata", "On");
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    // steps are counted at Open, blocks are parsed by Get
+    auto var_i32 = io.InquireVariable<int32_t>("i32");
+    ASSERT_TRUE(var_i32);
+    EXPECT_EQ(var_i32.Steps(), NSteps);
+    EXPECT_EQ(var_i32.StepsStart(), 0);
+
+    var_i32.SetSelection({{mpiRank * Nx}, {Nx}});
+    var_i32.SetStepSelection({NSteps - 2, 2});
+
+    std::vector<int32_t> I32(2 * Nx);
+    bpReader.Get(var_i32, I32.data(), adios2::Mode::Sync);
+    EXPECT_EQ(var_i32.Steps(), NSteps);
+
+    for (size_t s = 0; s < 2; ++s)
+    {
+        const size_t step = NSteps - 2 + s;
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            ASSERT_EQ(I32[s * Nx + i],
+                      static_cast<int32_t>(step * 1000 + mpiRank * Nx + i))
+                << "step=" << step << " i=" << i << " rank=" << mpiRank;
+        }
+    }
+
+    // first written in the second step
+    auto var_r64 = io.InquireVariable<double>("r64");
+    ASSERT_TRUE(var_r64);
+    EXPECT_EQ(var_r64.Steps(), NSteps / 2);
+
+    bpReader.Close();
+}
+
+//******************************************************************************
+// BlocksInfo parses the steps it needs, Steps() counts all steps at Open
+//******************************************************************************
+
+TEST_F(BPLazyMetadata, ADIOS2BPLazyMetadataBlocksInfo)
+{
+    const std::string fname("ADIOS2BPLazyMetadataBlocksInfo.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 8;
+    const size_t NSteps = 6;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    WriteSteps(adios, fname, Nx, NSteps);
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    else
+    {
+        io.SetEngine("BP4");
+    }
+    io.SetParameter("LazyMetadata", "On");
+
+    adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+    auto var_i32 = io.InquireVariable<int32_t>("i32");
+    ASSERT_TRUE(var_i32);
+    EXPECT_EQ(var_i32.Steps(), NSteps);
+
+    // only written in odd steps, defined from step 1
+    auto var_r64 = io.InquireVariable<double>("r64");
+    ASSERT_TRUE(var_r64);
+    EXPECT_EQ(var_r64.Steps(), NSteps / 2);
+    const auto r64BlocksInfo = bpReader.BlocksInfo(var_r64, 1);
+    EXPECT_EQ(r64BlocksInfo.size(), static_cast<size_t>(mpiSize));
+    EXPECT_TRUE(bpReader.BlocksInfo(var_r64, 0).empty());
+
+    // parses steps up to 3 only
+    const auto blocksInfo = bpReader.BlocksInfo(var_i32, 3);
+    ASSERT_EQ(blocksInfo.size(), static_cast<size_t>(mpiSize));
+    for (size_t b = 0; b < blocksInfo.size(); ++b)
+    {
+        EXPECT_EQ(blocksInfo[b].Start[0], b * Nx);
+        EXPECT_EQ(blocksInfo[b].Count[0], Nx);
+    }
+    EXPECT_EQ(var_i32.Steps(), NSteps);
+    EXPECT_EQ(var_r64.Steps(), NSteps / 2);
+
+    // parses all steps
+    const auto allStepsBlocksInfo = bpReader.AllStepsBlocksInfo(var_r64);
+    ASSERT_EQ(allStepsBlocksInfo.size(), NSteps / 2);
+    for (const auto &stepBlocksInfo : allStepsBlocksInfo)
+    {
+        EXPECT_EQ(stepBlocksInfo.first % 2, 1);
+        EXPECT_EQ(stepBlocksInfo.second.size(), static_cast<size_t>(mpiSize));
+    }
+    EXPECT_EQ(var_i32.Steps(), NSteps);
+    EXPECT_EQ(var_r64.Steps(), NSteps / 2);
+
+    bpReader.Close();
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
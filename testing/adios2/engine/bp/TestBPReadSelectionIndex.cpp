@@ -0,0 +1,193 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+//******************************************************************************
+// 2D global array written as many blocks per rank, out of order and with an
+// empty block, read back with selections of different sizes and positions
+//******************************************************************************
+
+class BPReadSelectionIndex : public ::testing::Test
+{
+public:
+    BPReadSelectionIndex() = default;
+};
+
+TEST_F(BPReadSelectionIndex, ADIOS2BPReadSelectionIndex2D)
+{
+    const std::string fname("ADIOS2BPReadSelectionIndex2D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // blocks of Nx x Ny, NBx x NBy blocks per rank, ranks stacked in x
+    const size_t Nx = 4;
+    const size_t Ny = 5;
+    const size_t NBx = 6;
+    const size_t NBy = 3;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t gNx = Nx * NBx * mpiSize;
+    const size_t gNy = Ny * NBy;
+    auto lf_Value = [gNy](const size_t step, const size_t x, const size_t y) {
+        return static_cast<int32_t>(step * 100000 + x * gNy + y);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        auto var = io.DefineVariable<int32_t>("i32", {gNx, gNy}, {0, 0},
+                                              {Nx, Ny});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<int32_t> data(Nx * Ny);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+
+            // reversed order, blocks are not sorted by start in metadata
+            for (size_t b = NBx * NBy; b-- > 0;)
+            {
+                const size_t startX = (mpiRank * NBx + b / NBy) * Nx;
+                const size_t startY = (b % NBy) * Ny;
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    for (size_t j = 0; j < Ny; ++j)
+                    {
+                        data[i * Ny + j] =
+                            lf_Value(step, startX + i, startY + j);
+                    }
+                }
+                var.SetSelection({{startX, startY}, {Nx, Ny}});
+                bpWriter.Put(var, data.data(), adios2::Mode::Sync);
+            }
+
+            var.SetSelection({{0, 0}, {0, 0}});
+            bpWriter.Put(var, data.data(), adios2::Mode::Sync);
+
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<int32_t>("i32");
+        ASSERT_TRUE(var);
+        ASSERT_EQ(var.Steps(), NSteps);
+        ASSERT_EQ(var.Shape()[0], gNx);
+        ASSERT_EQ(var.Shape()[1], gNy);
+
+        const adios2::Box<adios2::Dims> selections[] = {
+            // inside one block
+            {{1, 1}, {2, 3}},
+            // across blocks in both dimensions
+            {{Nx - 1, Ny - 2}, {2 * Nx + 1, Ny + 4}},
+            // last rows and columns
+            {{gNx - 3, gNy - 2}, {3, 2}},
+            // single element at a block corner
+            {{gNx / 2, Ny}, {1, 1}},
+            // full array
+            {{0, 0}, {gNx, gNy}}};
+
+        std::vector<int32_t> data;
+        // repeated to read again from the built indices
+        for (size_t repeat = 0; repeat < 2; ++repeat)
+        {
+            for (const adios2::Box<adios2::Dims> &selection : selections)
+            {
+                const size_t countX = selection.second[0];
+                const size_t countY = selection.second[1];
+
+                var.SetSelection(selection);
+                var.SetStepSelection({0, NSteps});
+                bpReader.Get(var, data, adios2::Mode::Sync);
+                ASSERT_EQ(data.size(), NSteps * countX * countY);
+
+                for (size_t step = 0; step < NSteps; ++step)
+                {
+                    for (size_t i = 0; i < countX; ++i)
+                    {
+                        for (size_t j = 0; j < countY; ++j)
+                        {
+                            const size_t index =
+                                (step * countX + i) * countY + j;
+                            ASSERT_EQ(data[index],
+                                      lf_Value(step, selection.first[0] + i,
+                                               selection.first[1] + j))
+                                << "step=" << step << " i=" << i << " j=" << j
+                                << " rank=" << mpiRank;
+                        }
+                    }
+                }
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
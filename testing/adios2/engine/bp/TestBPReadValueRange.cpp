@@ -0,0 +1,221 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+//******************************************************************************
+// 3D global array written as many blocks per rank, queried by value range
+// with different selections, with (StatsLevel=0) or without (StatsLevel=1)
+// block min and max
+//******************************************************************************
+
+class BPReadValueRange : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPReadValueRange() = default;
+};
+
+TEST_P(BPReadValueRange, ADIOS2BPReadValueRange3D)
+{
+    const std::string statsLevel = GetParam();
+    const std::string fname("ADIOS2BPReadValueRange3D_" + statsLevel + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // blocks of Nx x Ny x Nz, NBx blocks per rank, ranks stacked in x
+    const size_t Nx = 3;
+    const size_t Ny = 4;
+    const size_t Nz = 5;
+    const size_t NBx = 4;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t gNx = Nx * NBx * mpiSize;
+    auto lf_Value = [](const size_t step, const size_t x, const size_t y,
+                       const size_t z) {
+        return static_cast<double>(step * 100000 + x * 100 + y * 10 + z);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameter("StatsLevel", statsLevel);
+
+        auto var = io.DefineVariable<double>("r64", {gNx, Ny, Nz}, {0, 0, 0},
+                                             {Nx, Ny, Nz});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(Nx * Ny * Nz);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t b = 0; b < NBx; ++b)
+            {
+                const size_t startX = (mpiRank * NBx + b) * Nx;
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    for (size_t j = 0; j < Ny; ++j)
+                    {
+                        for (size_t k = 0; k < Nz; ++k)
+                        {
+                            data[(i * Ny + j) * Nz + k] =
+                                lf_Value(step, startX + i, j, k);
+                        }
+                    }
+                }
+                var.SetSelection({{startX, 0, 0}, {Nx, Ny, Nz}});
+                bpWriter.Put(var, data.data(), adios2::Mode::Sync);
+            }
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(var);
+        ASSERT_EQ(var.Steps(), NSteps);
+
+        auto lf_Check = [&](const adios2::Box<adios2::Dims> &selection,
+                            const size_t step, const double min,
+                            const double max) {
+            var.SetSelection(selection);
+            var.SetStepSelection({step, 1});
+
+            std::vector<adios2::Dims> coordinates;
+            std::vector<double> values;
+            bpReader.GetInRange(var, min, max, coordinates, values);
+            ASSERT_EQ(coordinates.size(), values.size());
+
+            std::map<adios2::Dims, double> found;
+            for (size_t i = 0; i < coordinates.size(); ++i)
+            {
+                ASSERT_EQ(coordinates[i].size(), 3);
+                EXPECT_EQ(values[i], lf_Value(step, coordinates[i][0],
+                                              coordinates[i][1],
+                                              coordinates[i][2]));
+                found[coordinates[i]] = values[i];
+            }
+            EXPECT_EQ(found.size(), coordinates.size());
+
+            size_t expected = 0;
+            const adios2::Dims &start = selection.first;
+            const adios2::Dims &count = selection.second;
+            for (size_t x = start[0]; x < start[0] + count[0]; ++x)
+            {
+                for (size_t y = start[1]; y < start[1] + count[1]; ++y)
+                {
+                    for (size_t z = start[2]; z < start[2] + count[2]; ++z)
+                    {
+                        const double value = lf_Value(step, x, y, z);
+                        if (value >= min && value <= max)
+                        {
+                            ++expected;
+                            EXPECT_EQ(found.count({x, y, z}), 1)
+                                << "x=" << x << " y=" << y << " z=" << z
+                                << " step=" << step << " rank=" << mpiRank;
+                        }
+                    }
+                }
+            }
+            EXPECT_EQ(coordinates.size(), expected);
+
+            // selection is kept for other Gets
+            EXPECT_EQ(var.Start(), start);
+            EXPECT_EQ(var.Count(), count);
+        };
+
+        const adios2::Box<adios2::Dims> all = {{0, 0, 0}, {gNx, Ny, Nz}};
+        // a few cells in a single block
+        lf_Check(all, 0, lf_Value(0, 4, 1, 1), lf_Value(0, 4, 1, 3));
+        // across blocks
+        lf_Check(all, 1, lf_Value(1, Nx - 1, 2, 0), lf_Value(1, 2 * Nx, 0, 2));
+        // every element
+        lf_Check(all, 1, lf_Value(1, 0, 0, 0), lf_Value(1, gNx, 0, 0));
+        // nothing, between steps
+        lf_Check(all, 0, lf_Value(0, gNx, 0, 0), lf_Value(1, 0, 0, 0) - 1);
+        // part of the array
+        lf_Check({{1, 1, 2}, {gNx - 2, 2, 3}}, 0, lf_Value(0, 1, 2, 0),
+                 lf_Value(0, gNx - 2, 2, 3));
+
+        var.SetStepSelection({0, NSteps});
+        std::vector<adios2::Dims> coordinates;
+        std::vector<double> values;
+        EXPECT_THROW(bpReader.GetInRange(var, 0., 1., coordinates, values),
+                     std::invalid_argument);
+
+        var.SetStepSelection({0, 1});
+        EXPECT_THROW(bpReader.GetInRange(var, 1., 0., coordinates, values),
+                     std::invalid_argument);
+
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(StatsLevel, BPReadValueRange,
+                        ::testing::Values("0", "1"));
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
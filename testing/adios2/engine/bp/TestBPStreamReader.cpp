@@ -0,0 +1,226 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPStreamReader : public ::testing::Test
+{
+public:
+    BPStreamReader() = default;
+};
+
+namespace
+{
+
+const size_t Nx = 10;
+
+std::vector<int32_t> GenerateStep(const size_t step, const int mpiRank)
+{
+    std::vector<int32_t> data(Nx);
+    std::iota(data.begin(), data.end(),
+              static_cast<int32_t>(step * 1000 + mpiRank * Nx));
+    return data;
+}
+
+void WriteStep(adios2::Engine &writer, adios2::Variable<int32_t> &var,
+               const size_t step, const int mpiRank)
+{
+    const std::vector<int32_t> data = GenerateStep(step, mpiRank);
+    writer.BeginStep();
+    writer.Put(var, data.data(), adios2::Mode::Sync);
+    writer.EndStep();
+}
+
+void CheckStep(adios2::IO &io, adios2::Engine &reader, const size_t step,
+               const int mpiRank)
+{
+    EXPECT_EQ(reader.CurrentStep(), step);
+
+    auto var = io.InquireVariable<int32_t>("i32");
+    ASSERT_TRUE(var);
+    var.SetSelection({{mpiRank * Nx}, {Nx}});
+
+    std::vector<int32_t> data;
+    reader.Get(var, data, adios2::Mode::Sync);
+
+    const std::vector<int32_t> expected = GenerateStep(step, mpiRank);
+    ASSERT_EQ(data.size(), Nx);
+    for (size_t i = 0; i < Nx; ++i)
+    {
+        EXPECT_EQ(data[i], expected[i])
+            << "step=" << step << " i=" << i << " rank=" << mpiRank;
+    }
+}
+
+std::string GetEngine()
+{
+    return engineName.empty() ? std::string("BP4") : engineName;
+}
+
+} // end anonymous namespace
+
+//******************************************************************************
+// Reader follows the file while it is written, writer and reader steps are
+// interleaved in the same process
+//******************************************************************************
+
+TEST_F(BPStreamReader, ADIOS2BPFollowWriter)
+{
+    const std::string fname("ADIOS2BPStreamReaderFollow.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine(GetEngine());
+    auto var = writeIO.DefineVariable<int32_t>(
+        "i32", {static_cast<size_t>(Nx * mpiSize)},
+        {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+
+    adios2::Engine writer = writeIO.Open(fname, adios2::Mode::Write);
+    WriteStep(writer, var, 0, mpiRank);
+
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine(GetEngine());
+    readIO.SetParameter("StreamReader", "On");
+    adios2::Engine reader = readIO.Open(fname, adios2::Mode::Read);
+
+    ASSERT_EQ(reader.BeginStep(adios2::StepMode::NextAvailable, 0.f),
+              adios2::StepStatus::OK);
+    CheckStep(readIO, reader, 0, mpiRank);
+    reader.EndStep();
+
+    // nothing new yet
+    EXPECT_EQ(reader.BeginStep(adios2::StepMode::NextAvailable, 0.1f),
+              adios2::StepStatus::NotReady);
+
+    WriteStep(writer, var, 1, mpiRank);
+
+    ASSERT_EQ(reader.BeginStep(adios2::StepMode::NextAvailable, 0.f),
+              adios2::StepStatus::OK);
+    CheckStep(readIO, reader, 1, mpiRank);
+    reader.EndStep();
+
+    WriteStep(writer, var, 2, mpiRank);
+    WriteStep(writer, var, 3, mpiRank);
+    WriteStep(writer, var, 4, mpiRank);
+
+    // skips steps 2 and 3
+    ASSERT_EQ(reader.BeginStep(adios2::StepMode::LatestAvailable, 0.f),
+              adios2::StepStatus::OK);
+    CheckStep(readIO, reader, 4, mpiRank);
+    reader.EndStep();
+
+    EXPECT_EQ(reader.BeginStep(adios2::StepMode::NextAvailable, 0.f),
+              adios2::StepStatus::NotReady);
+
+    WriteStep(writer, var, 5, mpiRank);
+    writer.Close();
+
+    ASSERT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+    CheckStep(readIO, reader, 5, mpiRank);
+    reader.EndStep();
+
+    // writer closed the file, no waiting
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::EndOfStream);
+    reader.Close();
+}
+
+//******************************************************************************
+// Stream reader on a complete file reads all steps and doesn't wait at the end
+//******************************************************************************
+
+TEST_F(BPStreamReader, ADIOS2BPClosedFile)
+{
+    const std::string fname("ADIOS2BPStreamReaderClosed.bp");
+    const size_t NSteps = 3;
+
+    int mpiRank = 0, mpiSize = 1;
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(GetEngine());
+        auto var = io.DefineVariable<int32_t>(
+            "i32", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            WriteStep(writer, var, step, mpiRank);
+        }
+        writer.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(GetEngine());
+        io.SetParameter("StreamReader", "On");
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+
+        size_t step = 0;
+        while (reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            CheckStep(io, reader, step, mpiRank);
+            reader.EndStep();
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        reader.Close();
+    }
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,140 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+//******************************************************************************
+// Ranks write blocks of different sizes, aggregated with Aggregator=Direct
+//******************************************************************************
+
+class BPWriteDirectAggregateReadTest
+: public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteDirectAggregateReadTest() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPWriteDirectAggregateReadTest, ADIOS2BPWriteDirectAggregateRead1D)
+{
+    const std::string substreams = GetParam();
+    const std::string fname("ADIOS2BPWriteDirectAggregateRead1D_" +
+                            substreams + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+
+    const size_t Nx = 100;
+    const size_t NSteps = 3;
+
+    // rank r writes (r + 1) * Nx elements
+    const size_t count = (mpiRank + 1) * Nx;
+    const size_t start = Nx * mpiRank * (mpiRank + 1) / 2;
+    const size_t gNx = Nx * mpiSize * (mpiSize + 1) / 2;
+
+    auto lf_Value = [](const size_t step, const size_t index) {
+        return static_cast<double>(step * 100000 + index);
+    };
+
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameters({{"Substreams", substreams}, {"Aggregator", "Direct"}});
+
+        auto var = io.DefineVariable<double>("r64", {gNx}, {start}, {count},
+                                             adios2::ConstantDims);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(count);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                data[i] = lf_Value(step, start + i);
+            }
+            bpWriter.BeginStep();
+            bpWriter.Put(var, data.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(var);
+        ASSERT_EQ(var.Steps(), NSteps);
+        ASSERT_EQ(var.Shape()[0], gNx);
+
+        std::vector<double> data;
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            var.SetStepSelection({step, 1});
+            bpReader.Get(var, data, adios2::Mode::Sync);
+            ASSERT_EQ(data.size(), gNx);
+
+            for (size_t i = 0; i < gNx; ++i)
+            {
+                ASSERT_EQ(data[i], lf_Value(step, i))
+                    << "step=" << step << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Substreams, BPWriteDirectAggregateReadTest,
+                        ::testing::Values("1", "2", "3"));
+
+int main(int argc, char **argv)
+{
+    MPI_Init(nullptr, nullptr);
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+
+    return result;
+}
@@ -0,0 +1,143 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadAIO : public ::testing::Test
+{
+public:
+    BPWriteReadAIO() = default;
+};
+
+//******************************************************************************
+// 1D, several chunks per write with unaligned head and tail
+//******************************************************************************
+
+void WriteRead1D(const std::string &fname, const adios2::Params &transport)
+{
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10001;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        auto var = io.DefineVariable<double>(
+            "r64", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.AddTransport("file", transport);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(data.begin(), data.end(),
+                      static_cast<double>(step * 100000 + mpiRank * Nx));
+            bpWriter.BeginStep();
+            bpWriter.Put(var, data.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.AddTransport("file", transport);
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var);
+        ASSERT_EQ(var.Steps(), NSteps);
+        ASSERT_EQ(var.Shape()[0], mpiSize * Nx);
+
+        var.SetSelection({{mpiRank * Nx}, {Nx}});
+
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            var.SetStepSelection({step, 1});
+            bpReader.Get(var, data.data(), adios2::Mode::Sync);
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(data[i], static_cast<double>(step * 100000 +
+                                                       mpiRank * Nx + i))
+                    << "step=" << step << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+TEST_F(BPWriteReadAIO, ADIOS2BPWriteRead1DDirectIO)
+{
+    WriteRead1D("ADIOS2BPWriteReadAIO1DDirectIO.bp",
+                {{"Library", "AIO"}, {"QueueDepth", "4"}, {"ChunkSize", "8192"}});
+}
+
+TEST_F(BPWriteReadAIO, ADIOS2BPWriteRead1DBuffered)
+{
+    WriteRead1D("ADIOS2BPWriteReadAIO1DBuffered.bp",
+                {{"Library", "AIO"}, {"QueueDepth", "2"}, {"DirectIO", "Off"}});
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,352 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#include "../SmallTestData.h"
+
+std::string engineName; // comes from command line
+
+class BPWriteReadAsyncWrite : public ::testing::Test
+{
+public:
+    BPWriteReadAsyncWrite() = default;
+
+    SmallTestData m_TestData;
+};
+
+//******************************************************************************
+// 1D 1x8 test data, every step flushed by the background writer
+//******************************************************************************
+
+TEST_F(BPWriteReadAsyncWrite, ADIOS2BPWriteRead1D8)
+{
+    const std::string fname("ADIOS2BPWriteReadAsyncWrite1D8.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 8;
+    const size_t NSteps = 5;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count,
+                                                  adios2::ConstantDims);
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                                 adios2::ConstantDims);
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameter("AsyncWrite", "On");
+        io.SetParameter("AsyncQueueDepth", "1");
+        io.AddTransport("file");
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            SmallTestData currentTestData = generateNewSmallTestData(
+                m_TestData, static_cast<int>(step), mpiRank, mpiSize);
+
+            bpWriter.BeginStep();
+            bpWriter.Put(var_i32, currentTestData.I32.data());
+            bpWriter.Put(var_r64, currentTestData.R64.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        EXPECT_TRUE(var_i32);
+        ASSERT_EQ(var_i32.Steps(), NSteps);
+        ASSERT_EQ(var_i32.Shape()[0], mpiSize * Nx);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        ASSERT_EQ(var_r64.Steps(), NSteps);
+        ASSERT_EQ(var_r64.Shape()[0], mpiSize * Nx);
+
+        const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+        var_i32.SetSelection(sel);
+        var_r64.SetSelection(sel);
+
+        std::array<int32_t, Nx> I32;
+        std::array<double, Nx> R64;
+
+        size_t t = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            SmallTestData currentTestData = generateNewSmallTestData(
+                m_TestData, static_cast<int>(t), mpiRank, mpiSize);
+
+            bpReader.Get(var_i32, I32.data());
+            bpReader.Get(var_r64, R64.data());
+            bpReader.EndStep();
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                EXPECT_EQ(I32[i], currentTestData.I32[i]) << msg;
+                EXPECT_EQ(R64[i], currentTestData.R64[i]) << msg;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// Data buffer larger than the default initial size, buffers are recycled
+//******************************************************************************
+
+TEST_F(BPWriteReadAsyncWrite, ADIOS2BPWriteReadGrowingBuffer)
+{
+    const std::string fname("ADIOS2BPWriteReadAsyncWriteGrowing.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t NSteps = 4;
+    // larger than the default initial buffer size, forces resizes
+    const size_t Nx = 10000;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        auto var = io.DefineVariable<double>(
+            "r64", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameters({{"AsyncWrite", "On"}, {"AsyncQueueDepth", "2"}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(data.begin(), data.end(),
+                      static_cast<double>(step * 100000 + mpiRank * Nx));
+            bpWriter.BeginStep();
+            bpWriter.Put(var, data.data(), adios2::Mode::Sync);
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var);
+        ASSERT_EQ(var.Steps(), NSteps);
+
+        var.SetSelection({{mpiRank * Nx}, {Nx}});
+
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            var.SetStepSelection({step, 1});
+            bpReader.Get(var, data.data(), adios2::Mode::Sync);
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(data[i], static_cast<double>(step * 100000 +
+                                                       mpiRank * Nx + i))
+                    << "step=" << step << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// Stream reader follows the file while the background writers of all ranks
+// drain, every step it sees has the blocks of all ranks
+//******************************************************************************
+
+TEST_F(BPWriteReadAsyncWrite, ADIOS2BPStreamWhileWriting)
+{
+    const std::string fname("ADIOS2BPWriteReadAsyncWriteStream.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t NSteps = 10;
+    // large enough for the writes to lag behind EndStep
+    const size_t Nx = 100000;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    const std::string engine = engineName.empty() ? "BP4" : engineName;
+
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine(engine);
+    writeIO.SetParameters({{"AsyncWrite", "On"}, {"AsyncQueueDepth", "2"}});
+    auto var = writeIO.DefineVariable<double>(
+        "r64", {static_cast<size_t>(Nx * mpiSize)},
+        {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+
+    adios2::Engine writer = writeIO.Open(fname, adios2::Mode::Write);
+
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine(engine);
+    readIO.SetParameter("StreamReader", "On");
+    adios2::Engine reader = readIO.Open(fname, adios2::Mode::Read);
+
+    size_t readSteps = 0;
+    // reads all blocks of the steps published so far
+    auto lf_ReadAvailable = [&](const float timeoutSeconds) {
+        while (reader.BeginStep(adios2::StepMode::NextAvailable,
+                                timeoutSeconds) == adios2::StepStatus::OK)
+        {
+            EXPECT_EQ(reader.CurrentStep(), readSteps);
+
+            auto varRead = readIO.InquireVariable<double>("r64");
+            ASSERT_TRUE(varRead);
+            ASSERT_EQ(varRead.Shape()[0], Nx * mpiSize);
+
+            std::vector<double> data;
+            reader.Get(varRead, data, adios2::Mode::Sync);
+            reader.EndStep();
+
+            ASSERT_EQ(data.size(), Nx * mpiSize);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                ASSERT_EQ(data[i],
+                          static_cast<double>(readSteps * 10000000 + i))
+                    << "step=" << readSteps << " i=" << i
+                    << " rank=" << mpiRank;
+            }
+            ++readSteps;
+        }
+    };
+
+    std::vector<double> data(Nx);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        std::iota(data.begin(), data.end(),
+                  static_cast<double>(step * 10000000 + mpiRank * Nx));
+        writer.BeginStep();
+        writer.Put(var, data.data(), adios2::Mode::Sync);
+        writer.EndStep();
+
+        lf_ReadAvailable(0.f);
+    }
+
+    writer.Close();
+
+    lf_ReadAvailable(-1.f);
+    EXPECT_EQ(readSteps, NSteps);
+    reader.Close();
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
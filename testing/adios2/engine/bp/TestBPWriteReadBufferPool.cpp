@@ -0,0 +1,166 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+//******************************************************************************
+// Steps of shrinking size written without zeroing buffers, several engines in
+// a row share the pooled data buffer
+//******************************************************************************
+
+class BPWriteReadBufferPool
+: public ::testing::TestWithParam<std::tuple<std::string, std::string>>
+{
+public:
+    BPWriteReadBufferPool() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPWriteReadBufferPool, ADIOS2BPWriteReadShrinkingSteps)
+{
+    const std::string zeroBuffers = std::get<0>(GetParam());
+    const std::string bufferPool = std::get<1>(GetParam());
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t NxMax = 100000;
+    const size_t NSteps = 4;
+    const size_t NFiles = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    // step 0 is the largest, stale bytes of it stay in later buffers
+    auto lf_Nx = [&](const size_t step) { return NxMax >> (2 * step); };
+    auto lf_Value = [](const size_t file, const size_t step,
+                       const size_t index) {
+        return static_cast<double>(file * 10000000 + step * 1000000 + index);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    for (size_t f = 0; f < NFiles; ++f)
+    {
+        const std::string fname("ADIOS2BPWriteReadBufferPool_" + zeroBuffers +
+                                "_" + bufferPool + "_" + std::to_string(f) +
+                                ".bp");
+        {
+            adios2::IO io = adios.DeclareIO("WriteIO" + std::to_string(f));
+            if (!engineName.empty())
+            {
+                io.SetEngine(engineName);
+            }
+            else
+            {
+                io.SetEngine("BP4");
+            }
+            io.SetParameters(
+                {{"ZeroBuffers", zeroBuffers}, {"BufferPool", bufferPool}});
+
+            auto var = io.DefineVariable<double>("r64", {NxMax * mpiSize},
+                                                 {NxMax * mpiRank}, {NxMax});
+
+            adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+            std::vector<double> data;
+            for (size_t step = 0; step < NSteps; ++step)
+            {
+                const size_t Nx = lf_Nx(step);
+                data.resize(Nx);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = lf_Value(f, step, NxMax * mpiRank + i);
+                }
+                var.SetShape({NxMax * mpiSize});
+                var.SetSelection({{NxMax * mpiRank}, {Nx}});
+
+                bpWriter.BeginStep();
+                bpWriter.Put(var, data.data());
+                bpWriter.EndStep();
+            }
+            bpWriter.Close();
+        }
+
+        {
+            adios2::IO io = adios.DeclareIO("ReadIO" + std::to_string(f));
+            if (!engineName.empty())
+            {
+                io.SetEngine(engineName);
+            }
+            else
+            {
+                io.SetEngine("BP4");
+            }
+
+            adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+            auto var = io.InquireVariable<double>("r64");
+            ASSERT_TRUE(var);
+            ASSERT_EQ(var.Steps(), NSteps);
+
+            std::vector<double> data;
+            for (size_t step = 0; step < NSteps; ++step)
+            {
+                const size_t Nx = lf_Nx(step);
+                var.SetSelection({{NxMax * mpiRank}, {Nx}});
+                var.SetStepSelection({step, 1});
+                bpReader.Get(var, data, adios2::Mode::Sync);
+                ASSERT_EQ(data.size(), Nx);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    ASSERT_EQ(data[i], lf_Value(f, step, NxMax * mpiRank + i))
+                        << "file=" << f << " step=" << step << " i=" << i
+                        << " rank=" << mpiRank;
+                }
+            }
+            bpReader.Close();
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(ZeroPool, BPWriteReadBufferPool,
+                        ::testing::Combine(::testing::Values("On", "Off"),
+                                           ::testing::Values("On", "Off")));
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
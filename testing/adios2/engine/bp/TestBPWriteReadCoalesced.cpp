@@ -0,0 +1,207 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+//******************************************************************************
+// Variable written as many small blocks interleaved with another variable,
+// read back with different ReadGapThreshold, ReadMaxExtentSize and Threads
+// parameters
+//******************************************************************************
+
+class BPWriteReadCoalesced
+: public ::testing::TestWithParam<
+      std::tuple<std::string, std::string, std::string>>
+{
+public:
+    BPWriteReadCoalesced() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPWriteReadCoalesced, ADIOS2BPWriteReadManyBlocks)
+{
+    const std::string readGapThreshold = std::get<0>(GetParam());
+    const std::string readMaxExtentSize = std::get<1>(GetParam());
+    const std::string threads = std::get<2>(GetParam());
+    const std::string fname("ADIOS2BPWriteReadCoalesced_" + readGapThreshold +
+                            "_" + readMaxExtentSize + "_" + threads + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 16;
+    const size_t NBlocks = 32;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t gNx = Nx * NBlocks * mpiSize;
+    auto lf_Value = [](const size_t step, const size_t index) {
+        return static_cast<double>(step * 1000000 + index);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        auto var_a = io.DefineVariable<double>("a", {gNx}, {0}, {Nx});
+        auto var_b = io.DefineVariable<double>("b", {gNx}, {0}, {Nx});
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                const size_t start = (mpiRank * NBlocks + b) * Nx;
+                var_a.SetSelection({{start}, {Nx}});
+                var_b.SetSelection({{start}, {Nx}});
+
+                // b payloads end up between the a payloads
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = lf_Value(step, start + i);
+                }
+                bpWriter.Put(var_a, data.data(), adios2::Mode::Sync);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = -lf_Value(step, start + i);
+                }
+                bpWriter.Put(var_b, data.data(), adios2::Mode::Sync);
+            }
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameters({{"ReadGapThreshold", readGapThreshold},
+                          {"ReadMaxExtentSize", readMaxExtentSize},
+                          {"Threads", threads}});
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_a = io.InquireVariable<double>("a");
+        ASSERT_TRUE(var_a);
+        ASSERT_EQ(var_a.Steps(), NSteps);
+
+        // every block of every step
+        std::vector<double> all;
+        var_a.SetSelection({{0}, {gNx}});
+        var_a.SetStepSelection({0, NSteps});
+        bpReader.Get(var_a, all, adios2::Mode::Sync);
+        ASSERT_EQ(all.size(), gNx * NSteps);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < gNx; ++i)
+            {
+                ASSERT_EQ(all[step * gNx + i], lf_Value(step, i))
+                    << "step=" << step << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+
+        // selection starting and ending inside blocks
+        const size_t start = mpiRank * NBlocks * Nx + Nx / 2;
+        const size_t count = 4 * Nx;
+        std::vector<double> part;
+        var_a.SetSelection({{start}, {count}});
+        var_a.SetStepSelection({1, 1});
+        bpReader.Get(var_a, part, adios2::Mode::Sync);
+        ASSERT_EQ(part.size(), count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(part[i], lf_Value(1, start + i))
+                << "i=" << i << " rank=" << mpiRank;
+        }
+
+        // deferred gets of two variables
+        auto var_b = io.InquireVariable<double>("b");
+        ASSERT_TRUE(var_b);
+        std::vector<double> partA, partB;
+        var_a.SetStepSelection({0, 1});
+        var_b.SetSelection({{start}, {count}});
+        var_b.SetStepSelection({0, 1});
+        bpReader.Get(var_a, partA);
+        bpReader.Get(var_b, partB);
+        bpReader.PerformGets();
+        for (size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(partA[i], lf_Value(0, start + i))
+                << "i=" << i << " rank=" << mpiRank;
+            EXPECT_EQ(partB[i], -lf_Value(0, start + i))
+                << "i=" << i << " rank=" << mpiRank;
+        }
+
+        bpReader.Close();
+    }
+}
+
+// a 64 bytes extent is smaller than one block, 512 bytes spans a few blocks
+INSTANTIATE_TEST_CASE_P(
+    GapExtentThreads, BPWriteReadCoalesced,
+    ::testing::Combine(::testing::Values("0", "65536", "100000000"),
+                       ::testing::Values("64", "512", "16777216"),
+                       ::testing::Values("1", "3")));
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
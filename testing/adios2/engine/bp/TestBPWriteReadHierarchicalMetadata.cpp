@@ -0,0 +1,206 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+void HierarchicalMetadata1D(const std::string &subStreams)
+{
+    const std::string fname("ADIOS2BPWriteReadHierarchicalMetadata1D_" +
+                            (subStreams.empty() ? "node" : subStreams) +
+                            ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        auto var = io.DefineVariable<double>(
+            "r64", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+        // only put by even ranks
+        auto varEven = io.DefineVariable<int32_t>(
+            "i32", {}, {}, {Nx}, adios2::ConstantDims);
+        io.DefineAttribute<std::string>("units", "m/s", "r64");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameter("MetadataAggregation", "Hierarchical");
+        if (!subStreams.empty())
+        {
+            io.SetParameter("SubStreams", subStreams);
+        }
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(Nx);
+        std::vector<int32_t> dataEven(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(data.begin(), data.end(),
+                      static_cast<double>(step * 10000 + mpiRank * Nx));
+            std::iota(dataEven.begin(), dataEven.end(),
+                      static_cast<int32_t>(step * 10000 + mpiRank * Nx));
+            bpWriter.BeginStep();
+            bpWriter.Put(var, data.data());
+            if (mpiRank % 2 == 0)
+            {
+                bpWriter.Put(varEven, dataEven.data());
+            }
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var);
+        ASSERT_EQ(var.Steps(), NSteps);
+        ASSERT_EQ(var.Shape()[0], mpiSize * Nx);
+
+        auto varEven = io.InquireVariable<int32_t>("i32");
+        EXPECT_TRUE(varEven);
+        ASSERT_EQ(varEven.Steps(), NSteps);
+
+        auto units = io.InquireAttribute<std::string>("units", "r64");
+        ASSERT_TRUE(units);
+        EXPECT_EQ(units.Data().front(), "m/s");
+
+        std::vector<double> data(Nx);
+        std::vector<int32_t> dataEven(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            // blocks must stay in writer rank order
+            const auto blocks = bpReader.BlocksInfo(var, step);
+            ASSERT_EQ(blocks.size(), static_cast<size_t>(mpiSize));
+            for (size_t b = 0; b < blocks.size(); ++b)
+            {
+                EXPECT_EQ(blocks[b].Start[0], b * Nx);
+            }
+
+            const auto blocksEven = bpReader.BlocksInfo(varEven, step);
+            ASSERT_EQ(blocksEven.size(),
+                      static_cast<size_t>((mpiSize + 1) / 2));
+
+            // read the block of the next rank
+            const size_t blockRank = (mpiRank + 1) % mpiSize;
+            var.SetSelection({{blockRank * Nx}, {Nx}});
+            var.SetStepSelection({step, 1});
+            bpReader.Get(var, data.data(), adios2::Mode::Sync);
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(data[i], static_cast<double>(step * 10000 +
+                                                       blockRank * Nx + i))
+                    << "step=" << step << " i=" << i << " rank=" << mpiRank;
+            }
+
+            // block b was put by rank 2 * b
+            const size_t blockEven = mpiRank % blocksEven.size();
+            varEven.SetBlockSelection(blockEven);
+            varEven.SetStepSelection({step, 1});
+            bpReader.Get(varEven, dataEven.data(), adios2::Mode::Sync);
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(dataEven[i],
+                          static_cast<int32_t>(step * 10000 +
+                                               2 * blockEven * Nx + i))
+                    << "step=" << step << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+class BPWriteReadHierarchicalMetadata
+: public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadHierarchicalMetadata() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPWriteReadHierarchicalMetadata, ADIOS2BPWriteRead1D)
+{
+    HierarchicalMetadata1D(GetParam());
+}
+
+// groups from shared memory nodes, groups from aggregator substreams
+INSTANTIATE_TEST_CASE_P(SubStreams, BPWriteReadHierarchicalMetadata,
+                        ::testing::Values("", "2"));
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
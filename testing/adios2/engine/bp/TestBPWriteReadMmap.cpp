@@ -0,0 +1,310 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadMmap : public ::testing::Test
+{
+public:
+    BPWriteReadMmap() = default;
+};
+
+//******************************************************************************
+// 1D, every step read back through the mapped subfiles
+//******************************************************************************
+
+TEST_F(BPWriteReadMmap, ADIOS2BPWriteRead1D)
+{
+    const std::string fname("ADIOS2BPWriteReadMmap1D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        auto var_r64 = io.DefineVariable<double>(
+            "r64", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+        auto var_i32 = io.DefineVariable<int32_t>("i32");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.AddTransport("file", {{"Library", "mmap"}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(data.begin(), data.end(),
+                      static_cast<double>(step * 100000 + mpiRank * Nx));
+            bpWriter.BeginStep();
+            bpWriter.Put(var_r64, data.data());
+            bpWriter.Put(var_i32, static_cast<int32_t>(step));
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.AddTransport("file", {{"Library", "mmap"}});
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        ASSERT_EQ(var_r64.Steps(), NSteps);
+        ASSERT_EQ(var_r64.Shape()[0], mpiSize * Nx);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        EXPECT_TRUE(var_i32);
+
+        var_r64.SetSelection({{mpiRank * Nx}, {Nx}});
+
+        std::vector<double> data(Nx);
+        size_t t = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            int32_t i32 = -1;
+            bpReader.Get(var_r64, data.data());
+            bpReader.Get(var_i32, i32);
+            bpReader.EndStep();
+
+            EXPECT_EQ(i32, static_cast<int32_t>(t));
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(data[i],
+                          static_cast<double>(t * 100000 + mpiRank * Nx + i))
+                    << "step=" << t << " i=" << i << " rank=" << mpiRank;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// 2D, strided selection crossing the blocks of all ranks
+//******************************************************************************
+
+TEST_F(BPWriteReadMmap, ADIOS2BPWriteRead2DSelection)
+{
+    const std::string fname("ADIOS2BPWriteReadMmap2D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10;
+    const size_t Ny = 20;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    // global array Ny x (Nx * mpiSize), each rank writes an Ny x Nx block
+    const size_t gNx = Nx * mpiSize;
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        auto var = io.DefineVariable<float>(
+            "r32", {Ny, gNx}, {0, static_cast<size_t>(Nx * mpiRank)},
+            {Ny, Nx}, adios2::ConstantDims);
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<float> data(Ny * Nx);
+        for (size_t j = 0; j < Ny; ++j)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                data[j * Nx + i] =
+                    static_cast<float>(j * gNx + mpiRank * Nx + i);
+            }
+        }
+        bpWriter.Put(var, data.data());
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.AddTransport("file", {{"Library", "mmap"}});
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<float>("r32");
+        EXPECT_TRUE(var);
+
+        // interior rows, columns straddling every block boundary
+        const size_t startY = 3, countY = 11;
+        const size_t startX = Nx / 2, countX = gNx - Nx / 2 - 1;
+        var.SetSelection({{startY, startX}, {countY, countX}});
+
+        std::vector<float> data(countY * countX);
+        bpReader.Get(var, data.data(), adios2::Mode::Sync);
+
+        for (size_t j = 0; j < countY; ++j)
+        {
+            for (size_t i = 0; i < countX; ++i)
+            {
+                const float expected =
+                    static_cast<float>((startY + j) * gNx + startX + i);
+                ASSERT_EQ(data[j * countX + i], expected)
+                    << "j=" << j << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// BP4 subfile shorter than its metadata says, reads fail instead of touching
+// pages past the mapping
+//******************************************************************************
+
+TEST_F(BPWriteReadMmap, ADIOS2BPTruncatedSubfile)
+{
+    if (engineName != "BP4")
+    {
+        return;
+    }
+
+    const std::string fname("ADIOS2BPWriteReadMmapTruncated.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        auto var_r64 = io.DefineVariable<double>(
+            "r64", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+
+        io.SetEngine(engineName);
+        io.AddTransport("file", {{"Library", "mmap"}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(Nx);
+        std::iota(data.begin(), data.end(), static_cast<double>(mpiRank * Nx));
+        bpWriter.BeginStep();
+        bpWriter.Put(var_r64, data.data());
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    // each rank cuts the end of its own subfile
+    const std::string subFileName =
+        fname + "/data." + std::to_string(mpiRank);
+    struct stat subFileStat;
+    ASSERT_EQ(stat(subFileName.c_str(), &subFileStat), 0);
+    ASSERT_EQ(truncate(subFileName.c_str(), subFileStat.st_size / 2), 0);
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        io.AddTransport("file", {{"Library", "mmap"}});
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(var_r64);
+        var_r64.SetSelection({{mpiRank * Nx}, {Nx}});
+
+        std::vector<double> data(Nx);
+        EXPECT_THROW(bpReader.Get(var_r64, data.data(), adios2::Mode::Sync),
+                     std::ios_base::failure);
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
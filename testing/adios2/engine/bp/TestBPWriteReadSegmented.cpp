@@ -0,0 +1,181 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+//******************************************************************************
+// Data buffer grows by segments (BufferChunkSize), written with gathered
+// writes, through the background writer or joined for aggregation
+//******************************************************************************
+
+class BPWriteReadSegmented : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadSegmented() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPWriteReadSegmented, ADIOS2BPWriteReadSegmented)
+{
+    const std::string mode = GetParam();
+    const std::string fname("ADIOS2BPWriteReadSegmented_" + mode + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 5000;
+    const size_t NVars = 6;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    auto lf_Value = [](const size_t step, const size_t v, const size_t index) {
+        return static_cast<double>(step * 1000000 + v * 100000 + index);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        // each variable block is larger than a segment
+        io.SetParameters({{"BufferChunkSize", "16Kb"}});
+        if (mode == "AsyncWrite")
+        {
+            io.SetParameter("AsyncWrite", "On");
+        }
+        else if (mode == "Aggregate")
+        {
+            io.SetParameter("Substreams", "1");
+        }
+
+        io.DefineAttribute<std::string>("mode", mode);
+
+        std::vector<adios2::Variable<double>> vars;
+        for (size_t v = 0; v < NVars; ++v)
+        {
+            vars.push_back(io.DefineVariable<double>(
+                "r64_" + std::to_string(v), {Nx * mpiSize}, {Nx * mpiRank},
+                {Nx}, adios2::ConstantDims));
+        }
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<std::vector<double>> data(NVars, std::vector<double>(Nx));
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t v = 0; v < NVars; ++v)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[v][i] = lf_Value(step, v, Nx * mpiRank + i);
+                }
+                // deferred and sync puts take different resize paths
+                if (v % 2 == 0)
+                {
+                    bpWriter.Put(vars[v], data[v].data());
+                }
+                else
+                {
+                    bpWriter.Put(vars[v], data[v].data(), adios2::Mode::Sync);
+                }
+            }
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto attr = io.InquireAttribute<std::string>("mode");
+        ASSERT_TRUE(attr);
+        EXPECT_EQ(attr.Data().front(), mode);
+
+        std::vector<double> data;
+        for (size_t v = 0; v < NVars; ++v)
+        {
+            auto var = io.InquireVariable<double>("r64_" + std::to_string(v));
+            ASSERT_TRUE(var);
+            ASSERT_EQ(var.Steps(), NSteps);
+
+            var.SetSelection({{Nx * mpiRank}, {Nx}});
+            for (size_t step = 0; step < NSteps; ++step)
+            {
+                var.SetStepSelection({step, 1});
+                bpReader.Get(var, data, adios2::Mode::Sync);
+                ASSERT_EQ(data.size(), Nx);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    ASSERT_EQ(data[i], lf_Value(step, v, Nx * mpiRank + i))
+                        << "var=" << v << " step=" << step << " i=" << i
+                        << " rank=" << mpiRank;
+                }
+            }
+        }
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Modes, BPWriteReadSegmented,
+                        ::testing::Values("Sync", "AsyncWrite", "Aggregate"));
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
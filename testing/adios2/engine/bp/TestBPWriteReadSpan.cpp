@@ -0,0 +1,315 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+//******************************************************************************
+// Blocks filled in place through spans, mixed with regular Puts, with a
+// contiguous or segmented (BufferChunkSize) data buffer
+//******************************************************************************
+
+class BPWriteReadSpan : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadSpan() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPWriteReadSpan, ADIOS2BPWriteReadSpan1D)
+{
+    const std::string chunkSize = GetParam();
+    const std::string fname("ADIOS2BPWriteReadSpan1D_" + chunkSize + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 3000;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const size_t gNx = Nx * mpiSize;
+    const size_t start = Nx * mpiRank;
+    auto lf_Value = [](const size_t step, const size_t index) {
+        return static_cast<double>(step * 100000 + index);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameter("BufferChunkSize", chunkSize);
+
+        auto var_r64 = io.DefineVariable<double>("r64", {gNx}, {start}, {Nx},
+                                                 adios2::ConstantDims);
+        auto var_i32 = io.DefineVariable<int32_t>("i32", {gNx}, {start}, {Nx},
+                                                  adios2::ConstantDims);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<int32_t> dataI32(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                dataI32[i] = -static_cast<int32_t>(step * 100000 + start + i);
+            }
+            bpWriter.Put(var_i32, dataI32.data());
+
+            adios2::Variable<double>::Span span = bpWriter.Put(var_r64);
+            ASSERT_EQ(span.size(), Nx);
+            EXPECT_THROW(span.at(Nx), std::invalid_argument);
+
+            // other Puts may move the buffer, fill through the span
+            bpWriter.Put(var_i32, dataI32.data(), adios2::Mode::Sync);
+            for (size_t i = 0; i < Nx / 2; ++i)
+            {
+                span[i] = lf_Value(step, start + i);
+            }
+            double *data = span.data();
+            for (size_t i = Nx / 2; i < Nx; ++i)
+            {
+                data[i] = lf_Value(step, start + i);
+            }
+
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(var_r64);
+        ASSERT_EQ(var_r64.Steps(), NSteps);
+        ASSERT_EQ(var_r64.Shape()[0], gNx);
+        EXPECT_EQ(var_r64.Min(), lf_Value(0, 0));
+        EXPECT_EQ(var_r64.Max(), lf_Value(NSteps - 1, gNx - 1));
+
+        std::vector<double> data;
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            const std::vector<adios2::Variable<double>::Info> blocksInfo =
+                bpReader.BlocksInfo(var_r64, step);
+            ASSERT_EQ(blocksInfo.size(), static_cast<size_t>(mpiSize));
+            for (const auto &blockInfo : blocksInfo)
+            {
+                const size_t blockStart = blockInfo.Start[0];
+                EXPECT_EQ(blockInfo.Min, lf_Value(step, blockStart));
+                EXPECT_EQ(blockInfo.Max, lf_Value(step, blockStart + Nx - 1));
+            }
+
+            var_r64.SetStepSelection({step, 1});
+            bpReader.Get(var_r64, data, adios2::Mode::Sync);
+            ASSERT_EQ(data.size(), gNx);
+            for (size_t i = 0; i < gNx; ++i)
+            {
+                ASSERT_EQ(data[i], lf_Value(step, i))
+                    << "step=" << step << " i=" << i << " rank=" << mpiRank;
+            }
+        }
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        ASSERT_TRUE(var_i32);
+        std::vector<int32_t> dataI32;
+        var_i32.SetSelection({{start}, {Nx}});
+        var_i32.SetStepSelection({NSteps - 1, 1});
+        bpReader.Get(var_i32, dataI32, adios2::Mode::Sync);
+        ASSERT_EQ(dataI32.size(), Nx);
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            ASSERT_EQ(dataI32[i],
+                      -static_cast<int32_t>((NSteps - 1) * 100000 + start + i));
+        }
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// Span initial value, kept for elements the application doesn't set
+//******************************************************************************
+
+TEST_P(BPWriteReadSpan, ADIOS2BPWriteReadSpanValue)
+{
+    const std::string chunkSize = GetParam();
+    const std::string fname("ADIOS2BPWriteReadSpanValue_" + chunkSize + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameter("BufferChunkSize", chunkSize);
+
+        auto var = io.DefineVariable<float>("r32", {Nx * mpiSize},
+                                            {Nx * mpiRank}, {Nx});
+
+        // Close without steps computes the bounds too
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        adios2::Variable<float>::Span span = bpWriter.Put(var, 0, 7.f);
+        span[Nx - 1] = 10.f;
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var = io.InquireVariable<float>("r32");
+        ASSERT_TRUE(var);
+        EXPECT_EQ(var.Min(), 7.f);
+        EXPECT_EQ(var.Max(), 10.f);
+
+        std::vector<float> data;
+        var.SetSelection({{Nx * mpiRank}, {Nx}});
+        bpReader.Get(var, data, adios2::Mode::Sync);
+        ASSERT_EQ(data.size(), Nx);
+        for (size_t i = 0; i < Nx - 1; ++i)
+        {
+            EXPECT_EQ(data[i], 7.f);
+        }
+        EXPECT_EQ(data[Nx - 1], 10.f);
+
+        bpReader.Close();
+    }
+}
+
+//******************************************************************************
+// Flush would move the reserved payloads, refused until EndStep
+//******************************************************************************
+
+TEST_P(BPWriteReadSpan, ADIOS2BPWriteSpanFlush)
+{
+    const std::string chunkSize = GetParam();
+    const std::string fname("ADIOS2BPWriteSpanFlush_" + chunkSize + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    adios2::IO io = adios.DeclareIO("TestIO");
+    if (!engineName.empty())
+    {
+        io.SetEngine(engineName);
+    }
+    else
+    {
+        io.SetEngine("BP4");
+    }
+    io.SetParameter("BufferChunkSize", chunkSize);
+
+    auto var =
+        io.DefineVariable<float>("r32", {Nx * mpiSize}, {Nx * mpiRank}, {Nx});
+
+    adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+    bpWriter.BeginStep();
+    adios2::Variable<float>::Span span = bpWriter.Put(var, 0, 1.f);
+    span[0] = 2.f;
+    EXPECT_THROW(bpWriter.Flush(), std::runtime_error);
+    bpWriter.EndStep();
+    EXPECT_NO_THROW(bpWriter.Flush());
+    bpWriter.Close();
+}
+
+INSTANTIATE_TEST_CASE_P(ChunkSize, BPWriteReadSpan,
+                        ::testing::Values("0Kb", "16Kb"));
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,178 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+std::string engineName; // comes from command line
+
+void TraceJSON1D(const std::string &tracing)
+{
+    const std::string fname("ADIOS2BPWriteTraceJSON1D_" + tracing + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        auto var = io.DefineVariable<double>(
+            "r64", {static_cast<size_t>(Nx * mpiSize)},
+            {static_cast<size_t>(Nx * mpiRank)}, {Nx}, adios2::ConstantDims);
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BP4");
+        }
+        io.SetParameter("Tracing", tracing);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(data.begin(), data.end(),
+                      static_cast<double>(step * 10000 + mpiRank * Nx));
+            bpWriter.BeginStep();
+            bpWriter.Put(var, data.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    // trace.json is written by rank 0 at Close
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    std::ifstream traceJSONFile(fname + "/trace.json");
+    if (tracing == "Off")
+    {
+        EXPECT_FALSE(traceJSONFile.good());
+        return;
+    }
+    ASSERT_TRUE(traceJSONFile.good());
+
+    const json traceJSON = json::parse(traceJSONFile);
+    ASSERT_TRUE(traceJSON.is_array());
+
+    std::set<int> processes;
+    std::set<size_t> serializeSteps;
+    size_t serializeCount = 0;
+    size_t writeCount = 0;
+    size_t metadataCount = 0;
+    size_t transportOpenCount = 0;
+    size_t transportWriteCount = 0;
+    size_t transportWriteBytes = 0;
+
+    for (const json &event : traceJSON)
+    {
+        const std::string phase = event.at("ph");
+        if (phase == "M")
+        {
+            EXPECT_EQ(event.at("name"), "process_name");
+            processes.insert(event.at("pid").get<int>());
+            continue;
+        }
+
+        ASSERT_EQ(phase, "X");
+        EXPECT_GE(event.at("dur").get<double>(), 0.);
+
+        const std::string name = event.at("name");
+        const size_t bytes = event.at("args").at("bytes").get<size_t>();
+        if (name == "serialize")
+        {
+            // payload and block characteristics
+            EXPECT_GE(bytes, Nx * sizeof(double));
+            serializeSteps.insert(event.at("args").at("step").get<size_t>());
+            ++serializeCount;
+        }
+        else if (name == "write")
+        {
+            ++writeCount;
+        }
+        else if (name == "metadata")
+        {
+            ++metadataCount;
+        }
+        else if (name == "transport_open")
+        {
+            ++transportOpenCount;
+        }
+        else if (name == "transport_write")
+        {
+            transportWriteBytes += bytes;
+            ++transportWriteCount;
+        }
+    }
+
+    EXPECT_EQ(processes.size(), static_cast<size_t>(mpiSize));
+    EXPECT_EQ(serializeCount, NSteps * mpiSize);
+    EXPECT_EQ(serializeSteps.size(), NSteps);
+    EXPECT_EQ(*serializeSteps.rbegin(), NSteps - 1);
+    EXPECT_GE(writeCount, NSteps);
+    EXPECT_GE(metadataCount, NSteps * mpiSize);
+    // data, metadata and metadata index files
+    EXPECT_GE(transportOpenCount, static_cast<size_t>(mpiSize) + 2);
+    EXPECT_GE(transportWriteCount, NSteps * mpiSize);
+    EXPECT_GE(transportWriteBytes, NSteps * mpiSize * Nx * sizeof(double));
+}
+
+TEST(BPWriteTraceJSON, ADIOS2BPWriteTraceJSON1D) { TraceJSON1D("On"); }
+
+TEST(BPWriteTraceJSON, ADIOS2BPWriteTraceJSON1D_Off) { TraceJSON1D("Off"); }
+
+//******************************************************************************
+// main
+//******************************************************************************
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
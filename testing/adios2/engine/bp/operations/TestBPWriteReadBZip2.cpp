@@ -0,0 +1,205 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+struct BZip2Chunks
+{
+    std::string ChunkSize;
+    std::string Threads;
+};
+
+void BZip2Chunked2D(const BZip2Chunks &chunks, const bool selection)
+{
+    // Each process would write a Ny x Nx array and all processes would
+    // form a (mpiSize * Ny) x Nx 2D array
+    const std::string fname("BPWriteReadBZip2_" + chunks.ChunkSize + "_" +
+                            chunks.Threads + (selection ? "Sel" : "") +
+                            ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t Ny = 50;
+
+    // Number of steps
+    const size_t NSteps = 2;
+
+    std::vector<int32_t> i32s(Nx * Ny);
+    std::vector<double> r64s(Nx * Ny);
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const adios2::Dims shape{static_cast<size_t>(Ny * mpiSize), Nx};
+        const adios2::Dims start{static_cast<size_t>(Ny * mpiRank), 0};
+        const adios2::Dims count{Ny, Nx};
+
+        auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count,
+                                                  adios2::ConstantDims);
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                                 adios2::ConstantDims);
+
+        adios2::Operator bzip2Op =
+            adios.DefineOperator("bzip2Compressor", "bzip2");
+
+        var_i32.AddOperation(bzip2Op, {{"ChunkSize", chunks.ChunkSize},
+                                       {"Threads", chunks.Threads}});
+        var_r64.AddOperation(bzip2Op, {{"ChunkSize", chunks.ChunkSize},
+                                       {"Threads", chunks.Threads}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(i32s.begin(), i32s.end(),
+                      static_cast<int32_t>(step * 1000 + mpiRank));
+            std::iota(r64s.begin(), r64s.end(),
+                      static_cast<double>(step * 1000 + mpiRank));
+
+            bpWriter.BeginStep();
+            bpWriter.Put<int32_t>("i32", i32s.data());
+            bpWriter.Put<double>("r64", r64s.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("Threads", chunks.Threads);
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        EXPECT_TRUE(var_i32);
+        ASSERT_EQ(var_i32.Steps(), NSteps);
+        ASSERT_EQ(var_i32.Shape()[0], mpiSize * Ny);
+        ASSERT_EQ(var_i32.Shape()[1], Nx);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        ASSERT_EQ(var_r64.Steps(), NSteps);
+
+        // selection: a few rows in the middle of this rank's block
+        const size_t rowStart = selection ? Ny / 2 - 3 : 0;
+        const size_t rows = selection ? 6 : Ny;
+        const adios2::Box<adios2::Dims> sel(
+            {static_cast<size_t>(mpiRank * Ny) + rowStart, 0}, {rows, Nx});
+        var_i32.SetSelection(sel);
+        var_r64.SetSelection(sel);
+
+        std::vector<int32_t> readI32s;
+        std::vector<double> readR64s;
+
+        size_t t = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            bpReader.Get(var_i32, readI32s);
+            bpReader.Get(var_r64, readR64s);
+            bpReader.EndStep();
+
+            for (size_t i = 0; i < rows * Nx; ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                const size_t index = rowStart * Nx + i;
+                ASSERT_EQ(readI32s[i],
+                          static_cast<int32_t>(t * 1000 + mpiRank + index))
+                    << msg;
+                ASSERT_EQ(readR64s[i],
+                          static_cast<double>(t * 1000 + mpiRank + index))
+                    << msg;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+
+        bpReader.Close();
+    }
+}
+
+class BPWriteReadBZip2 : public ::testing::TestWithParam<BZip2Chunks>
+{
+public:
+    BPWriteReadBZip2() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPWriteReadBZip2, ADIOS2BPWriteReadBZip2Chunked2D)
+{
+    BZip2Chunked2D(GetParam(), false);
+}
+
+TEST_P(BPWriteReadBZip2, ADIOS2BPWriteReadBZip2Chunked2DSel)
+{
+    BZip2Chunked2D(GetParam(), true);
+}
+
+// single chunk (default), several chunks compressed in place, and chunk sizes
+// that are not a multiple of the element size compressed by several threads
+INSTANTIATE_TEST_CASE_P(BZip2Chunks, BPWriteReadBZip2,
+                        ::testing::Values(BZip2Chunks{"0", "1"},
+                                          BZip2Chunks{"4096", "1"},
+                                          BZip2Chunks{"3001", "4"}));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
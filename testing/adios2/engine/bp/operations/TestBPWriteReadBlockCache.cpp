@@ -0,0 +1,186 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadBlockCache : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadBlockCache() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+// reads each row of a bzip2 compressed block with a separate Get, so every
+// block is decompressed once per row without the cache
+TEST_P(BPWriteReadBlockCache, ADIOS2BPWriteReadBlockCacheRows)
+{
+    const std::string blockCacheSize = GetParam();
+    const std::string fname("BPWriteReadBlockCache_" + blockCacheSize +
+                            ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t Ny = 50;
+
+    // Number of steps
+    const size_t NSteps = 3;
+
+    std::vector<int32_t> i32s(Nx * Ny);
+    std::vector<double> r64s(Nx * Ny);
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const adios2::Dims shape{static_cast<size_t>(Ny * mpiSize), Nx};
+        const adios2::Dims start{static_cast<size_t>(Ny * mpiRank), 0};
+        const adios2::Dims count{Ny, Nx};
+
+        auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count,
+                                                  adios2::ConstantDims);
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                                 adios2::ConstantDims);
+
+        adios2::Operator bzip2Op =
+            adios.DefineOperator("bzip2Compressor", "bzip2");
+
+        var_i32.AddOperation(bzip2Op, {});
+        var_r64.AddOperation(bzip2Op, {});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(i32s.begin(), i32s.end(),
+                      static_cast<int32_t>(step * 1000 + mpiRank));
+            std::iota(r64s.begin(), r64s.end(),
+                      static_cast<double>(step * 1000 + mpiRank));
+
+            bpWriter.BeginStep();
+            bpWriter.Put<int32_t>("i32", i32s.data());
+            bpWriter.Put<double>("r64", r64s.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("BlockCacheSize", blockCacheSize);
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        EXPECT_TRUE(var_i32);
+        ASSERT_EQ(var_i32.Steps(), NSteps);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        ASSERT_EQ(var_r64.Steps(), NSteps);
+
+        std::vector<int32_t> readI32s;
+        std::vector<double> readR64s;
+
+        // rows are read twice, the second pass only hits the cache
+        for (size_t pass = 0; pass < 2; ++pass)
+        {
+            for (size_t t = 0; t < NSteps; ++t)
+            {
+                var_i32.SetStepSelection({t, 1});
+                var_r64.SetStepSelection({t, 1});
+
+                for (size_t row = 0; row < Ny; ++row)
+                {
+                    const adios2::Box<adios2::Dims> sel(
+                        {static_cast<size_t>(mpiRank * Ny) + row, 0}, {1, Nx});
+                    var_i32.SetSelection(sel);
+                    var_r64.SetSelection(sel);
+
+                    bpReader.Get(var_i32, readI32s, adios2::Mode::Sync);
+                    bpReader.Get(var_r64, readR64s, adios2::Mode::Sync);
+
+                    for (size_t i = 0; i < Nx; ++i)
+                    {
+                        std::stringstream ss;
+                        ss << "pass=" << pass << " t=" << t << " row=" << row
+                           << " i=" << i << " rank=" << mpiRank;
+                        std::string msg = ss.str();
+
+                        const size_t index = row * Nx + i;
+                        ASSERT_EQ(readI32s[i], static_cast<int32_t>(
+                                                   t * 1000 + mpiRank + index))
+                            << msg;
+                        ASSERT_EQ(readR64s[i], static_cast<double>(
+                                                   t * 1000 + mpiRank + index))
+                            << msg;
+                    }
+                }
+            }
+        }
+
+        bpReader.Close();
+    }
+}
+
+// off, room for one decompressed i32 block (20000 bytes) but only the
+// compressed r64 blocks, and room for all decompressed blocks
+INSTANTIATE_TEST_CASE_P(BlockCacheSize, BPWriteReadBlockCache,
+                        ::testing::Values("0Kb", "32Kb", "1Mb"));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
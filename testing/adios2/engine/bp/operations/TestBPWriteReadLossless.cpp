@@ -0,0 +1,224 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+struct LosslessOperation
+{
+    std::string Type;
+    std::string Shuffle;
+};
+
+void Lossless2D(const LosslessOperation &operation)
+{
+    // Each process would write a Ny x Nx array and all processes would
+    // form a (mpiSize * Ny) x Nx 2D array
+    const std::string fname("BPWriteReadLossless_" + operation.Type + "_" +
+                            operation.Shuffle + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t Ny = 50;
+
+    // Number of steps
+    const size_t NSteps = 2;
+
+    std::vector<int8_t> i8s(Nx * Ny);
+    std::vector<int32_t> i32s(Nx * Ny);
+    std::vector<double> r64s(Nx * Ny);
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const adios2::Dims shape{static_cast<size_t>(Ny * mpiSize), Nx};
+        const adios2::Dims start{static_cast<size_t>(Ny * mpiRank), 0};
+        const adios2::Dims count{Ny, Nx};
+
+        auto var_i8 = io.DefineVariable<int8_t>("i8", shape, start, count,
+                                                adios2::ConstantDims);
+        auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count,
+                                                  adios2::ConstantDims);
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                                 adios2::ConstantDims);
+
+        adios2::Operator losslessOp =
+            adios.DefineOperator("losslessCompressor", operation.Type);
+
+        var_i8.AddOperation(losslessOp, {{"Shuffle", operation.Shuffle}});
+        var_i32.AddOperation(losslessOp, {{"Shuffle", operation.Shuffle}});
+        var_r64.AddOperation(losslessOp, {{"Shuffle", operation.Shuffle}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx * Ny; ++i)
+            {
+                i8s[i] = static_cast<int8_t>((step + mpiRank + i) % 128);
+            }
+            std::iota(i32s.begin(), i32s.end(),
+                      static_cast<int32_t>(step * 1000 + mpiRank));
+            std::iota(r64s.begin(), r64s.end(),
+                      static_cast<double>(step * 1000 + mpiRank));
+
+            bpWriter.BeginStep();
+            bpWriter.Put<int8_t>("i8", i8s.data());
+            bpWriter.Put<int32_t>("i32", i32s.data());
+            bpWriter.Put<double>("r64", r64s.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_i8 = io.InquireVariable<int8_t>("i8");
+        EXPECT_TRUE(var_i8);
+        ASSERT_EQ(var_i8.Steps(), NSteps);
+
+        auto var_i32 = io.InquireVariable<int32_t>("i32");
+        EXPECT_TRUE(var_i32);
+        ASSERT_EQ(var_i32.Steps(), NSteps);
+        ASSERT_EQ(var_i32.Shape()[0], mpiSize * Ny);
+        ASSERT_EQ(var_i32.Shape()[1], Nx);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        ASSERT_EQ(var_r64.Steps(), NSteps);
+
+        const adios2::Box<adios2::Dims> sel(
+            {static_cast<size_t>(mpiRank * Ny), 0}, {Ny, Nx});
+        var_i8.SetSelection(sel);
+        var_i32.SetSelection(sel);
+        var_r64.SetSelection(sel);
+
+        std::vector<int8_t> readI8s;
+        std::vector<int32_t> readI32s;
+        std::vector<double> readR64s;
+
+        size_t t = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            bpReader.Get(var_i8, readI8s);
+            bpReader.Get(var_i32, readI32s);
+            bpReader.Get(var_r64, readR64s);
+            bpReader.EndStep();
+
+            for (size_t i = 0; i < Nx * Ny; ++i)
+            {
+                std::stringstream ss;
+                ss << "t=" << t << " i=" << i << " rank=" << mpiRank;
+                std::string msg = ss.str();
+
+                // lossless, exact values
+                ASSERT_EQ(readI8s[i],
+                          static_cast<int8_t>((t + mpiRank + i) % 128))
+                    << msg;
+                ASSERT_EQ(readI32s[i],
+                          static_cast<int32_t>(t * 1000 + mpiRank + i))
+                    << msg;
+                ASSERT_EQ(readR64s[i],
+                          static_cast<double>(t * 1000 + mpiRank + i))
+                    << msg;
+            }
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+
+        bpReader.Close();
+    }
+}
+
+class BPWriteReadLossless : public ::testing::TestWithParam<LosslessOperation>
+{
+public:
+    BPWriteReadLossless() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_P(BPWriteReadLossless, ADIOS2BPWriteReadLossless2D)
+{
+    Lossless2D(GetParam());
+}
+
+std::vector<LosslessOperation> LosslessOperations()
+{
+    std::vector<LosslessOperation> operations;
+#ifdef ADIOS2_HAVE_LZ4
+    operations.push_back({"lz4", "none"});
+    operations.push_back({"lz4", "byte"});
+    operations.push_back({"lz4", "bit"});
+#endif
+#ifdef ADIOS2_HAVE_ZSTD
+    operations.push_back({"zstd", "none"});
+    operations.push_back({"zstd", "byte"});
+    operations.push_back({"zstd", "bit"});
+#endif
+    return operations;
+}
+
+INSTANTIATE_TEST_CASE_P(LosslessOperations, BPWriteReadLossless,
+                        ::testing::ValuesIn(LosslessOperations()));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -938,6 +938,136 @@ void ZfpRate2DSmallSel(const double rate)
     }
 }
 
+void ZfpRate3DSlices(const double rate)
+{
+    // Each process would write a Nx x Ny x Nz array, it is read back one 2D
+    // slice at a time, fixed rate blocks outside the slice are not decoded
+    const std::string fname("BPWriteReadZfp3DSlices_" + std::to_string(rate) +
+                            ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows
+    const size_t Nx = 10;
+    const size_t Ny = 20;
+    const size_t Nz = 15;
+
+    // Number of steps
+    const size_t NSteps = 1;
+
+    std::vector<float> r32s(Nx * Ny * Nz);
+    std::vector<double> r64s(Nx * Ny * Nz);
+
+    std::iota(r32s.begin(), r32s.end(), 0.f);
+    std::iota(r64s.begin(), r64s.end(), 0.);
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize), Ny, Nz};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank), 0, 0};
+        const adios2::Dims count{Nx, Ny, Nz};
+
+        auto var_r32 = io.DefineVariable<float>("r32", shape, start, count,
+                                                adios2::ConstantDims);
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                                 adios2::ConstantDims);
+
+        // add operations
+        adios2::Operator zfpOp = adios.DefineOperator("zfpCompressor", "zfp");
+
+        var_r32.AddOperation(zfpOp, {{"rate", std::to_string(rate)}});
+        var_r64.AddOperation(zfpOp, {{"rate", std::to_string(rate)}});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        for (auto step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            bpWriter.Put<float>("r32", r32s.data());
+            bpWriter.Put<double>("r64", r64s.data());
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r32 = io.InquireVariable<float>("r32");
+        EXPECT_TRUE(var_r32);
+        ASSERT_EQ(var_r32.Steps(), NSteps);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        ASSERT_EQ(var_r64.Steps(), NSteps);
+
+        unsigned int t = 0;
+        std::vector<float> decompressedR32s;
+        std::vector<double> decompressedR64s;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            for (size_t x = 0; x < Nx; ++x)
+            {
+                const adios2::Box<adios2::Dims> sel(
+                    {static_cast<std::size_t>(mpiRank) * Nx + x, 0, 0},
+                    {1, Ny, Nz});
+                var_r32.SetSelection(sel);
+                var_r64.SetSelection(sel);
+
+                bpReader.Get(var_r32, decompressedR32s, adios2::Mode::Sync);
+                bpReader.Get(var_r64, decompressedR64s, adios2::Mode::Sync);
+
+                for (size_t i = 0; i < Ny * Nz; ++i)
+                {
+                    std::stringstream ss;
+                    ss << "t=" << t << " x=" << x << " i=" << i
+                       << " rank=" << mpiRank;
+                    std::string msg = ss.str();
+
+                    ASSERT_LT(
+                        std::abs(decompressedR32s[i] - r32s[x * Ny * Nz + i]),
+                        1E-4)
+                        << msg;
+                    ASSERT_LT(
+                        std::abs(decompressedR64s[i] - r64s[x * Ny * Nz + i]),
+                        1E-4)
+                        << msg;
+                }
+            }
+            bpReader.EndStep();
+            ++t;
+        }
+
+        EXPECT_EQ(t, NSteps);
+
+        bpReader.Close();
+    }
+}
+
 class BPWriteReadZfp : public ::testing::TestWithParam<double>
 {
 public:
@@ -957,6 +1087,10 @@ TEST_P(BPWriteReadZfp, ADIOS2BPWriteReadZfp2DSmallSel)
 {
     ZfpRate2DSmallSel(GetParam());
 }
+TEST_P(BPWriteReadZfp, ADIOS2BPWriteReadZfp3DSlices)
+{
+    ZfpRate3DSlices(GetParam());
+}
 
 INSTANTIATE_TEST_CASE_P(ZfpRate, BPWriteReadZfp, ::testing::Values(8., 9., 10));
 
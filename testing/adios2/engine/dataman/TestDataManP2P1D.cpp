@@ -42,6 +42,33 @@ TEST_F(DataManEngineTest, WriteRead_1D_P2P)
     r.join();
     std::cout << "Reader thread ended" << std::endl;
 }
+
+TEST_F(DataManEngineTest, WriteRead_1D_P2P_BinaryMetadata)
+{
+    // set parameters
+    Dims shape = {10};
+    Dims start = {0};
+    Dims count = {10};
+    size_t steps = 200;
+    adios2::Params engineParams = {{"WorkflowMode", "p2p"},
+                                   {"MetadataFormat", "binary-schema-once"}};
+    std::vector<adios2::Params> transportParams = {{{"Library", "ZMQ"},
+                                                    {"IPAddress", "127.0.0.1"},
+                                                    {"Port", "12307"},
+                                                    {"Timeout", "5"}}};
+
+    // run workflow
+    auto r = std::thread(DataManReaderP2P, shape, start, count, steps,
+                         engineParams, transportParams);
+    std::cout << "Reader thread started" << std::endl;
+    auto w = std::thread(DataManWriter, shape, start, count, steps,
+                         engineParams, transportParams);
+    std::cout << "Writer thread started" << std::endl;
+    w.join();
+    std::cout << "Writer thread ended" << std::endl;
+    r.join();
+    std::cout << "Reader thread ended" << std::endl;
+}
 #endif // ZEROMQ
 
 int main(int argc, char **argv)
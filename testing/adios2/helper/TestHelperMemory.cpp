@@ -0,0 +1,268 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <complex>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+#include <adios2/ADIOSTypes.h>
+#include <adios2/helper/adiosMath.h>
+#include <adios2/helper/adiosMemory.h>
+#include <adios2/helper/adiosSystem.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template <class T>
+std::vector<T> GenerateValues(const size_t size)
+{
+    std::vector<T> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        // not monotonic, extremes away from the ends
+        values[i] = static_cast<T>((i * 7919) % 1000) - static_cast<T>(500);
+    }
+    return values;
+}
+
+template <class T>
+void CheckCopyMinMax(const size_t size, const unsigned int threads)
+{
+    const std::vector<T> values = GenerateValues<T>(size);
+
+    // offset position as in a serialization buffer
+    const size_t offset = 3;
+    std::vector<char> buffer(offset + size * sizeof(T));
+    size_t position = offset;
+
+    T min, max;
+    adios2::helper::CopyToBufferMinMaxThreads(buffer, position, values.data(),
+                                              size, min, max, threads);
+
+    ASSERT_EQ(position, offset + size * sizeof(T));
+    EXPECT_EQ(std::memcmp(buffer.data() + offset, values.data(),
+                          size * sizeof(T)),
+              0);
+
+    auto bounds = std::minmax_element(values.begin(), values.end());
+    EXPECT_EQ(min, *bounds.first) << "size=" << size << " threads=" << threads;
+    EXPECT_EQ(max, *bounds.second) << "size=" << size << " threads=" << threads;
+}
+
+} // end anonymous namespace
+
+TEST(ADIOS2HelperMemory, ADIOS2HelperMemoryCopyToBufferMinMax)
+{
+    // within one block, several blocks, uneven thread split
+    for (const size_t size : {1, 10, 2048, 10001, 100003})
+    {
+        for (const unsigned int threads : {1, 3})
+        {
+            CheckCopyMinMax<double>(size, threads);
+            CheckCopyMinMax<int16_t>(size, threads);
+            CheckCopyMinMax<int64_t>(size, threads);
+            CheckCopyMinMax<float>(size, threads);
+        }
+    }
+}
+
+TEST(ADIOS2HelperMemory, ADIOS2HelperMemoryCopyToBufferMinMaxComplex)
+{
+    const size_t size = 5000;
+    std::vector<std::complex<double>> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        values[i] = std::complex<double>(static_cast<double>(i % 97 + 1),
+                                         -static_cast<double>(i % 89));
+    }
+    // smallest and largest modulus
+    values[1234] = std::complex<double>(0., 0.5);
+    values[4321] = std::complex<double>(-500., 1.);
+
+    for (const unsigned int threads : {1, 3})
+    {
+        std::vector<char> buffer(size * sizeof(std::complex<double>));
+        size_t position = 0;
+        std::complex<double> min, max;
+        adios2::helper::CopyToBufferMinMaxThreads(
+            buffer, position, values.data(), size, min, max, threads);
+
+        EXPECT_EQ(min, std::complex<double>(0., 0.5));
+        EXPECT_EQ(max, std::complex<double>(-500., 1.));
+        EXPECT_EQ(std::memcmp(buffer.data(), values.data(), buffer.size()), 0);
+    }
+}
+
+TEST(ADIOS2HelperMemory, ADIOS2HelperMemoryShuffle)
+{
+    // whole element groups, remaining elements, trailing partial element
+    for (const size_t size : {0, 7, 64, 100, 1003, 4096})
+    {
+        for (const size_t elementSize : {1, 4, 8, 16})
+        {
+            std::vector<char> in(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                in[i] = static_cast<char>((i * 7919) % 251);
+            }
+            std::vector<char> shuffled(size), out(size);
+
+            adios2::helper::ByteShuffle(in.data(), shuffled.data(), size,
+                                        elementSize);
+            adios2::helper::ByteUnshuffle(shuffled.data(), out.data(), size,
+                                          elementSize);
+            EXPECT_EQ(in, out) << "byte size=" << size
+                               << " elementSize=" << elementSize;
+
+            adios2::helper::BitShuffle(in.data(), shuffled.data(), size,
+                                       elementSize);
+            adios2::helper::BitUnshuffle(shuffled.data(), out.data(), size,
+                                         elementSize);
+            EXPECT_EQ(in, out) << "bit size=" << size
+                               << " elementSize=" << elementSize;
+        }
+    }
+
+    // 16 uint16_t equal to 1: byte planes are 0x01 x16 then 0x00 x16, bit
+    // planes are 0xFFFF for the lowest bit and 0 otherwise
+    const std::vector<uint16_t> ones(16, 1);
+    const char *in = reinterpret_cast<const char *>(ones.data());
+    std::vector<char> shuffled(32);
+
+    adios2::helper::ByteShuffle(in, shuffled.data(), 32, 2);
+    const size_t lowByte = adios2::helper::IsLittleEndian() ? 0 : 16;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        EXPECT_EQ(shuffled[i], (i / 16 * 16 == lowByte) ? 1 : 0) << i;
+    }
+
+    adios2::helper::BitShuffle(in, shuffled.data(), 32, 2);
+    const size_t lowPlane = adios2::helper::IsLittleEndian() ? 0 : 16;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        const bool set = i == lowPlane || i == lowPlane + 1;
+        EXPECT_EQ(static_cast<uint8_t>(shuffled[i]), set ? 0xFF : 0) << i;
+    }
+}
+
+TEST(ADIOS2HelperMemory, ADIOS2HelperMemorySmallDims)
+{
+    using adios2::helper::SmallDims;
+
+    // inline storage, conversions both ways
+    const adios2::Dims dims{4, 5, 6};
+    SmallDims small(dims);
+    ASSERT_EQ(small.size(), 3);
+    EXPECT_EQ(adios2::Dims(small), dims);
+
+    // grow past the inline capacity and shrink back, values are kept
+    const size_t large = SmallDims::InlineCapacity + 2;
+    small.resize(large, 7);
+    ASSERT_EQ(small.size(), large);
+    EXPECT_EQ(small[2], 6);
+    EXPECT_EQ(small.back(), 7);
+    small.resize(2);
+    EXPECT_EQ(adios2::Dims(small), adios2::Dims({4, 5}));
+    small.push_back(9);
+    EXPECT_EQ(small, SmallDims({4, 5, 9}));
+
+    // box arithmetic with inline and heap dimensions
+    for (const size_t ndims : {size_t(3), large})
+    {
+        const adios2::Dims start1(ndims, 2), count1(ndims, 4);
+        const adios2::Dims start2(ndims, 4), count2(ndims, 5);
+
+        const adios2::Box<SmallDims> intersection =
+            adios2::helper::IntersectionBox(
+                adios2::helper::StartEndBox(start1, count1),
+                adios2::helper::StartEndBox(start2, count2));
+        EXPECT_EQ(intersection.first, SmallDims(ndims, 4));
+        EXPECT_EQ(intersection.second, SmallDims(ndims, 5));
+
+        const adios2::Box<SmallDims> startCount =
+            adios2::helper::IntersectionStartCount(start1, count1, start2,
+                                                   count2);
+        EXPECT_EQ(startCount.first, SmallDims(ndims, 4));
+        EXPECT_EQ(startCount.second, SmallDims(ndims, 2));
+
+        // last point of block 1 is its last element
+        size_t lastIndex = 1;
+        for (size_t d = 0; d < ndims; ++d)
+        {
+            lastIndex *= count1[d];
+        }
+        EXPECT_EQ(adios2::helper::LinearIndex(
+                      adios2::helper::StartEndBox(start1, count1),
+                      SmallDims(ndims, 5), true),
+                  lastIndex - 1);
+    }
+
+    // no intersection
+    const adios2::Box<SmallDims> empty = adios2::helper::IntersectionBox(
+        adios2::helper::StartEndBox({0, 0}, {2, 2}),
+        adios2::helper::StartEndBox({0, 3}, {2, 2}));
+    EXPECT_TRUE(empty.first.empty());
+}
+
+TEST(ADIOS2HelperMemory, ADIOS2HelperMemoryNdCopy)
+{
+    // 3D row major block copied into a larger selection, recursive and
+    // iterative (safe mode) versions
+    const adios2::Dims inStart{1, 2, 3}, inCount{2, 3, 4};
+    const adios2::Dims outStart{0, 0, 0}, outCount{4, 6, 8};
+
+    std::vector<int32_t> in(2 * 3 * 4);
+    std::iota(in.begin(), in.end(), 1);
+
+    for (const bool safeMode : {false, true})
+    {
+        std::vector<int32_t> out(4 * 6 * 8, 0);
+
+        const int status = adios2::helper::NdCopy<int32_t>(
+            reinterpret_cast<const char *>(in.data()), inStart, inCount, true,
+            true, reinterpret_cast<char *>(out.data()), outStart, outCount,
+            true, true, adios2::Dims(), adios2::Dims(), adios2::Dims(),
+            adios2::Dims(), safeMode);
+        ASSERT_EQ(status, 0);
+
+        size_t copied = 0;
+        for (size_t i = 0; i < inCount[0]; ++i)
+        {
+            for (size_t j = 0; j < inCount[1]; ++j)
+            {
+                for (size_t k = 0; k < inCount[2]; ++k)
+                {
+                    const size_t x = inStart[0] + i, y = inStart[1] + j,
+                                 z = inStart[2] + k;
+                    EXPECT_EQ(out[(x * outCount[1] + y) * outCount[2] + z],
+                              in[(i * inCount[1] + j) * inCount[2] + k])
+                        << "safeMode=" << safeMode << " " << x << "," << y
+                        << "," << z;
+                    ++copied;
+                }
+            }
+        }
+        EXPECT_EQ(static_cast<size_t>(
+                      std::count(out.begin(), out.end(), 0)),
+                  out.size() - copied);
+    }
+}
+
+int main(int argc, char **argv)
+{
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
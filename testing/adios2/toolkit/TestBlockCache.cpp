@@ -0,0 +1,92 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2/toolkit/format/BlockCache.h>
+
+#include <gtest/gtest.h>
+
+TEST(BlockCache, HitsAndMisses)
+{
+    adios2::BlockCache cache;
+    EXPECT_FALSE(cache.IsActive());
+    cache.SetCapacity(100);
+    EXPECT_TRUE(cache.IsActive());
+
+    EXPECT_EQ(cache.Find(0, 0, true), nullptr);
+    EXPECT_EQ(cache.m_Misses, 1);
+    EXPECT_EQ(cache.m_Hits, 0);
+
+    cache.Insert(0, 0, true, std::vector<char>(10, 'a'));
+    EXPECT_EQ(cache.GetSize(), 10);
+
+    // Contains doesn't count
+    EXPECT_TRUE(cache.Contains(0, 0, true));
+    EXPECT_FALSE(cache.Contains(0, 0, false));
+    EXPECT_FALSE(cache.Contains(1, 0, true));
+    EXPECT_EQ(cache.m_Misses, 1);
+    EXPECT_EQ(cache.m_Hits, 0);
+
+    const std::vector<char> *payload = cache.Find(0, 0, true);
+    ASSERT_NE(payload, nullptr);
+    EXPECT_EQ(*payload, std::vector<char>(10, 'a'));
+    EXPECT_EQ(cache.m_Hits, 1);
+
+    // decompressed and as stored payloads are distinct entries
+    EXPECT_EQ(cache.Find(0, 0, false), nullptr);
+    EXPECT_EQ(cache.m_Misses, 2);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetSize(), 0);
+    EXPECT_EQ(cache.Find(0, 0, true), nullptr);
+    EXPECT_EQ(cache.m_Hits, 1);
+    EXPECT_EQ(cache.m_Misses, 3);
+}
+
+TEST(BlockCache, LeastRecentlyUsedEviction)
+{
+    adios2::BlockCache cache;
+    cache.SetCapacity(30);
+
+    cache.Insert(0, 0, true, std::vector<char>(10, 'a'));
+    cache.Insert(0, 10, true, std::vector<char>(10, 'b'));
+    cache.Insert(0, 20, true, std::vector<char>(10, 'c'));
+    EXPECT_EQ(cache.GetSize(), 30);
+
+    // first block becomes most recently used, second is evicted next
+    ASSERT_NE(cache.Find(0, 0, true), nullptr);
+    cache.Insert(1, 0, true, std::vector<char>(10, 'd'));
+    EXPECT_EQ(cache.GetSize(), 30);
+    EXPECT_TRUE(cache.Contains(0, 0, true));
+    EXPECT_FALSE(cache.Contains(0, 10, true));
+    EXPECT_TRUE(cache.Contains(0, 20, true));
+    EXPECT_TRUE(cache.Contains(1, 0, true));
+
+    // larger than capacity is ignored
+    EXPECT_FALSE(cache.Fits(31));
+    cache.Insert(2, 0, true, std::vector<char>(31, 'e'));
+    EXPECT_FALSE(cache.Contains(2, 0, true));
+    EXPECT_EQ(cache.GetSize(), 30);
+
+    // shrinking evicts least recently used first
+    cache.SetCapacity(10);
+    EXPECT_EQ(cache.GetSize(), 10);
+    EXPECT_TRUE(cache.Contains(1, 0, true));
+
+    cache.SetCapacity(0);
+    EXPECT_FALSE(cache.IsActive());
+    EXPECT_EQ(cache.GetSize(), 0);
+}
+
+int main(int argc, char **argv)
+{
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
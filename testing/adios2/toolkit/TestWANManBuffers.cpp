@@ -0,0 +1,175 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstddef>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <adios2/toolkit/transportman/wanman/BufferPool.h>
+#include <adios2/toolkit/transportman/wanman/SpscQueue.h>
+
+#include <gtest/gtest.h>
+
+using adios2::transportman::BufferPool;
+using adios2::transportman::SpscQueue;
+
+TEST(SpscQueue, OrderFullEmpty)
+{
+    SpscQueue<int> queue(3);
+    int value = -1;
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.Pop(value));
+    EXPECT_EQ(value, -1);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        int pushed = i;
+        EXPECT_TRUE(queue.Push(pushed));
+    }
+    EXPECT_FALSE(queue.Empty());
+
+    // full, the value is left untouched
+    int extra = 3;
+    EXPECT_FALSE(queue.Push(extra));
+    EXPECT_EQ(extra, 3);
+
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.Push(extra));
+
+    // wraps around in order
+    for (int i = 1; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.Pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.Pop(value));
+}
+
+TEST(SpscQueue, MovesOwnership)
+{
+    SpscQueue<std::shared_ptr<int>> queue(1);
+    std::shared_ptr<int> value = std::make_shared<int>(7);
+    std::weak_ptr<int> watch = value;
+    EXPECT_TRUE(queue.Push(value));
+    EXPECT_EQ(value, nullptr);
+
+    std::shared_ptr<int> popped;
+    EXPECT_TRUE(queue.Pop(popped));
+    EXPECT_EQ(*popped, 7);
+
+    // the slot doesn't keep a reference
+    popped.reset();
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(SpscQueue, ProducerConsumer)
+{
+    const size_t count = 100000;
+    SpscQueue<size_t> queue(16);
+
+    std::thread producer([&queue, count]() {
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t value = i;
+            while (!queue.Push(value))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t expected = 0;
+    size_t mismatches = 0;
+    while (expected < count)
+    {
+        size_t value;
+        if (queue.Pop(value))
+        {
+            if (value != expected)
+            {
+                ++mismatches;
+            }
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(BufferPool, Reuse)
+{
+    BufferPool pool(2);
+    EXPECT_EQ(pool.Size(), 0);
+
+    std::shared_ptr<std::vector<char>> buffer = pool.Acquire(100);
+    EXPECT_TRUE(buffer->empty());
+    EXPECT_GE(buffer->capacity(), 100);
+    buffer->resize(100, 'a');
+    const char *data = buffer->data();
+
+    // back to the pool empty, keeping its memory
+    buffer.reset();
+    EXPECT_EQ(pool.Size(), 1);
+    buffer = pool.Acquire(50);
+    EXPECT_EQ(pool.Size(), 0);
+    EXPECT_TRUE(buffer->empty());
+    EXPECT_EQ(buffer->data(), data);
+    buffer.reset();
+
+    // the smallest buffer that fits is preferred
+    std::shared_ptr<std::vector<char>> small = pool.Acquire(10);
+    std::shared_ptr<std::vector<char>> large = pool.Acquire(1000);
+    const char *largeData = large->data();
+    small.reset();
+    large.reset();
+    EXPECT_EQ(pool.Size(), 2);
+    large = pool.Acquire(500);
+    EXPECT_EQ(large->data(), largeData);
+    EXPECT_EQ(pool.Size(), 1);
+    large.reset();
+}
+
+TEST(BufferPool, MaxBuffers)
+{
+    BufferPool pool(2);
+    std::vector<std::shared_ptr<std::vector<char>>> buffers;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        buffers.push_back(pool.Acquire(10));
+    }
+    buffers.clear();
+    EXPECT_EQ(pool.Size(), 2);
+}
+
+TEST(BufferPool, OutlivesPool)
+{
+    std::shared_ptr<std::vector<char>> buffer;
+    {
+        BufferPool pool(1);
+        buffer = pool.Acquire(10);
+    }
+    buffer->push_back('a');
+    EXPECT_EQ(buffer->size(), 1);
+    buffer.reset();
+}
+
+int main(int argc, char **argv)
+{
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
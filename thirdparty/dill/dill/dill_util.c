@@ -814,12 +814,13 @@ free_code_blocks(dill_stream s)
     }
     if (s->p->virtual.code_base && (s->p->virtual.code_base != s->p->code_base) ) {
 	int vsize = (long)s->p->virtual.code_limit - (long)s->p->virtual.code_base + END_OF_CODE_BUFFER;
-        if (munmap(s->p->code_base, vsize) == -1) perror("unmap v");
-    }
-    if (s->p->native.code_base && (s->p->native.code_base != s->p->code_base) ) {
-	int nsize = (long)s->p->native.code_limit - (long)s->p->native.code_base + END_OF_CODE_BUFFER;
-        if (munmap(s->p->code_base, nsize) == -1) perror("unmap n");
+        if (munmap(s->p->virtual.code_base, vsize) == -1) perror("unmap v");
     }
+    /*
+     * The native buffer is not unmapped here, handles returned by
+     * dill_finalize() run from it without owning it (their size is 0).
+     * dill_get_handle() takes it over and clears native.code_base.
+     */
 #else
     if (s->p->code_base) free(s->p->code_base);
     if (s->p->virtual.code_base && (s->p->virtual.code_base != s->p->code_base) ) 